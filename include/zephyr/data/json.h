@@ -615,6 +615,10 @@ typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
  * (2) no UTF-8 validation is performed; and
  * (3) only integer numbers are supported (no strtod() in the minimal libc).
  *
+ * Keys are looked up starting after the field decoded last: listing the
+ * fields in the descriptor in the order documents usually carry them makes
+ * the lookup of each key take constant time.
+ *
  * @param json Pointer to JSON-encoded value to be parsed
  * @param len Length of JSON-encoded value
  * @param descr Pointer to the descriptor array
@@ -1038,6 +1042,248 @@ int json_mixed_arr_encode_buf(const struct json_mixed_arr_descr *descr,
 ssize_t json_calc_mixed_arr_len(const struct json_mixed_arr_descr *descr,
 				size_t descr_len, void *val);
 
+/**
+ * @brief Maximum container nesting depth of the streaming parser.
+ */
+#define JSON_STREAM_MAX_DEPTH 32
+
+/**
+ * @brief Token reported by the streaming JSON parser.
+ *
+ * Strings are reported as they appear in the document, without the quotes
+ * and without unescaping, like the descriptor based parser does. Numbers
+ * and the true, false and null literals are reported with their textual
+ * representation. None of the text is NUL terminated.
+ *
+ * The pointers are only valid for the duration of the callback: they point
+ * either into the chunk being fed or, for tokens that span chunks, into the
+ * token buffer of the parser.
+ */
+struct json_stream_token {
+	/** JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END, JSON_TOK_ARRAY_START,
+	 *  JSON_TOK_ARRAY_END, JSON_TOK_STRING, JSON_TOK_NUMBER, JSON_TOK_TRUE,
+	 *  JSON_TOK_FALSE or JSON_TOK_NULL.
+	 */
+	enum json_tokens type;
+	/** Key of the object member this value belongs to, NULL if the value
+	 *  is an array element, the root value or a container end.
+	 */
+	const char *key;
+	/** Length of @a key. */
+	size_t key_len;
+	/** Value text, NULL for containers. */
+	const char *value;
+	/** Length of @a value. */
+	size_t value_len;
+};
+
+/**
+ * @brief Callback invoked by the streaming parser for every token.
+ *
+ * @param tok		Token being reported.
+ * @param user_data	User data given to json_stream_init().
+ *
+ * @return 0 to continue parsing, a negative error code to abort it. The
+ *         error code is returned by json_stream_feed() and json_stream_finish().
+ */
+typedef int (*json_stream_cb_t)(const struct json_stream_token *tok, void *user_data);
+
+/**
+ * @brief Streaming JSON parser state.
+ *
+ * The members are internal, use json_stream_init() to set the parser up.
+ */
+struct json_stream_parser {
+	json_stream_cb_t cb;
+	void *user_data;
+	char *buf;
+	size_t buf_size;
+	size_t buf_len;
+	size_t tok_off;
+	const char *key;
+	size_t key_len;
+	const char *lit;
+	uint32_t objects;
+	int err;
+	uint8_t depth;
+	uint8_t state;
+	uint8_t flags;
+	uint8_t count;
+};
+
+/**
+ * @brief Initialize a streaming JSON parser.
+ *
+ * The streaming parser accepts a document split in chunks of any size, which
+ * do not have to be kept around once fed, and reports its values through
+ * @p cb as soon as they are complete. It does not allocate memory: tokens are
+ * reported from the chunk being fed whenever they are entirely contained in
+ * it, only tokens spanning two or more chunks (and the key of the value being
+ * parsed when the chunk ends) are copied into @p buf. The buffer must hence
+ * be large enough for the longest key plus the longest string or number of
+ * the document; it can be NULL if the document is always fed in one chunk.
+ *
+ * Containers can be nested up to @ref JSON_STREAM_MAX_DEPTH levels.
+ *
+ * @param parser	Parser to initialize.
+ * @param buf		Buffer for tokens spanning chunks.
+ * @param buf_size	Size of @p buf.
+ * @param cb		Callback invoked for every token.
+ * @param user_data	User data passed to @p cb.
+ */
+void json_stream_init(struct json_stream_parser *parser, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data);
+
+/**
+ * @brief Feed a chunk of a JSON document to a streaming parser.
+ *
+ * @param parser	Parser initialized with json_stream_init().
+ * @param data		Chunk of the document.
+ * @param len		Length of @p data.
+ *
+ * @retval 0 if the chunk was consumed.
+ * @retval -EINVAL if the document is malformed.
+ * @retval -ENOMEM if a token does not fit in the token buffer or the
+ *         document nests containers too deeply.
+ * @retval <0 error returned by the callback.
+ *
+ * Errors are sticky: once an error has been returned, the parser must be
+ * initialized again.
+ */
+int json_stream_feed(struct json_stream_parser *parser, const char *data, size_t len);
+
+/**
+ * @brief Signal the end of the JSON document to a streaming parser.
+ *
+ * Reports a number ending the document, if any, and checks that the
+ * document is complete.
+ *
+ * @param parser	Parser initialized with json_stream_init().
+ *
+ * @retval 0 if a complete JSON value has been parsed.
+ * @retval -EINVAL if the document is malformed or truncated.
+ * @retval <0 error returned by json_stream_feed() or by the callback.
+ */
+int json_stream_finish(struct json_stream_parser *parser);
+
+/**
+ * @brief Compact random access representation of a parsed JSON document.
+ *
+ * A tape holds one 32-bit entry per value and per object key, in document
+ * order. Container start entries store the index of their matching end
+ * entry so that whole subtrees can be skipped in constant time. Strings and
+ * numbers are copied NUL terminated into a separate string area.
+ *
+ * The value of the document is the entry at index 0. Object members are
+ * stored as a key entry of type JSON_TOK_STRING followed by the value.
+ */
+struct json_tape {
+	/** Tape entries. */
+	uint32_t *entries;
+	/** Capacity of @a entries. */
+	size_t max_entries;
+	/** Number of entries in use. */
+	size_t len;
+	/** String area. */
+	char *strings;
+	/** Size of @a strings. */
+	size_t strings_size;
+	/** Bytes of @a strings in use. */
+	size_t strings_len;
+	/** Innermost open container while the tape is being built. */
+	uint32_t open;
+};
+
+/**
+ * @brief Initialize an empty tape.
+ *
+ * @param tape		Tape to initialize.
+ * @param entries	Storage for the tape entries.
+ * @param max_entries	Number of entries in @p entries, at most 2^24.
+ * @param strings	Storage for the strings and numbers.
+ * @param strings_size	Size of @p strings, at most 2^24 bytes.
+ */
+void json_tape_init(struct json_tape *tape, uint32_t *entries, size_t max_entries,
+		    char *strings, size_t strings_size);
+
+/**
+ * @brief Streaming parser callback appending the tokens to a tape.
+ *
+ * Pass this function to json_stream_init() along with the tape as user data
+ * to build the tape of a document.
+ *
+ * @param tok		Token to append.
+ * @param user_data	Tape initialized with json_tape_init().
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if the tape entries or string area are exhausted.
+ */
+int json_tape_stream_cb(const struct json_stream_token *tok, void *user_data);
+
+/**
+ * @brief Get the type of a tape entry.
+ *
+ * @param tape	Tape.
+ * @param idx	Entry index.
+ *
+ * @return Type of the entry, JSON_TOK_EOF if @p idx is out of range.
+ */
+enum json_tokens json_tape_type(const struct json_tape *tape, size_t idx);
+
+/**
+ * @brief Get the text of a string, key or number tape entry.
+ *
+ * @param tape	Tape.
+ * @param idx	Entry index.
+ *
+ * @return NUL terminated text of the entry, NULL if the entry is not a
+ *         string or a number.
+ */
+const char *json_tape_str(const struct json_tape *tape, size_t idx);
+
+/**
+ * @brief Get the index following a value on a tape.
+ *
+ * Skips the whole subtree if @p idx is a container start.
+ *
+ * @param tape	Tape.
+ * @param idx	Index of a value entry.
+ *
+ * @return Index of the entry following the value.
+ */
+size_t json_tape_next(const struct json_tape *tape, size_t idx);
+
+/**
+ * @brief Look up the value of an object member on a tape.
+ *
+ * Keys are compared as they appear in the document, escape sequences
+ * included.
+ *
+ * @param tape	Tape.
+ * @param obj	Index of a JSON_TOK_OBJECT_START entry.
+ * @param key	NUL terminated key to look up.
+ * @param idx	Index of the value on success.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p obj is not an object.
+ * @retval -ENOENT if the object has no member named @p key.
+ */
+int json_tape_obj_get(const struct json_tape *tape, size_t obj, const char *key, size_t *idx);
+
+/**
+ * @brief Look up an array element on a tape.
+ *
+ * @param tape	Tape.
+ * @param arr	Index of a JSON_TOK_ARRAY_START entry.
+ * @param n	Position of the element in the array.
+ * @param idx	Index of the element on success.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p arr is not an array.
+ * @retval -ENOENT if the array has @p n elements or less.
+ */
+int json_tape_arr_get(const struct json_tape *tape, size_t arr, size_t n, size_t *idx);
+
 #ifdef __cplusplus
 }
 #endif
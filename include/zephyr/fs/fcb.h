@@ -84,6 +84,27 @@ struct fcb_entry_ctx {
  */
 #define FCB_FLAGS_CRC_DISABLED BIT(0)
 
+/**
+ * @brief FCB sector RAM index structure.
+ *
+ * Describes which elements of a sector are recorded in the element array
+ * of the index, see @ref fcb.f_index. The content is internal state.
+ */
+struct fcb_sector_index {
+	uint32_t fsi_end_off;
+	/**< Offset of the first element that is not recorded in the index */
+
+	uint32_t fsi_hint_off;
+	/**< Offset of the element at fsi_hint_pos, speeds up sequential lookups */
+
+	uint16_t fsi_cnt; /**< Number of elements recorded in the index */
+
+	uint16_t fsi_hint_pos; /**< Position of the last element looked up */
+
+	bool fsi_complete;
+	/**< Whether there are no elements past fsi_end_off in the sector */
+};
+
 /**
  * @brief FCB instance structure
  *
@@ -112,6 +133,23 @@ struct fcb {
 	struct flash_sector *f_sectors;
 	/**< Array of sectors, must be contiguous */
 
+#ifdef CONFIG_FCB_SECTOR_INDEX
+	struct fcb_sector_index *f_index;
+	/**< Optional array of f_sector_cnt sector indexes. When set, fcb_init
+	 * reads the elements of the used sectors and records them in RAM, so
+	 * that walking over elements and looking for the append position do
+	 * not need to read flash. Leave NULL to not use an index.
+	 */
+
+	uint16_t *f_index_elems;
+	/**< Array of f_sector_cnt * f_index_elem_cnt element records used by
+	 * f_index. Elements of a sector that do not fit are read from flash.
+	 */
+
+	uint16_t f_index_elem_cnt;
+	/**< Number of elements that can be recorded per sector */
+#endif
+
 	/* Flash circular buffer internal state */
 	struct k_mutex f_mtx;
 	/**< Locking for accessing the FCB data, internal state */
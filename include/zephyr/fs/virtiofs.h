@@ -14,6 +14,7 @@ extern "C" {
 
 struct virtiofs_fs_data {
 	uint32_t max_write;
+	uint32_t flags;
 };
 
 #ifdef __cplusplus
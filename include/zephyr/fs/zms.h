@@ -141,6 +141,47 @@ int zms_clear(struct zms_fs *fs);
  */
 ssize_t zms_write(struct zms_fs *fs, zms_id_t id, const void *data, size_t len);
 
+/**
+ * @brief Entry of an atomic multi-entry write, see @ref zms_write_multi().
+ */
+struct zms_write_entry {
+	/** ID of the entry to be written */
+	zms_id_t id;
+	/** Pointer to the data to be written */
+	const void *data;
+	/** Number of bytes to be written (maximum 64 KiB), 0 deletes the entry */
+	size_t len;
+};
+
+/**
+ * @brief Write several entries to the file system in a single transaction.
+ *
+ * The data and the ATEs of all the entries are packed in as few flash write operations as
+ * possible and committed with a single commit ATE. If the write is interrupted (power loss or
+ * device error), either all or none of the entries are found after the file system is mounted
+ * again.
+ *
+ * @note All the entries of a transaction must fit in one sector. Rewrites of data already
+ * stored are not skipped, even if @kconfig{CONFIG_ZMS_NO_DOUBLE_WRITE} is enabled.
+ * Available only if @kconfig{CONFIG_ZMS_WRITE_MULTI} is enabled.
+ *
+ * @param fs Pointer to the file system.
+ * @param entries Array of entries to be written. When an ID appears more than once, the last
+ * occurrence wins.
+ * @param count Number of entries in the array.
+ *
+ * @retval 0 on success.
+ * @retval -EACCES if ZMS is still not initialized.
+ * @retval -ENXIO if there is a device error.
+ * @retval -EIO if there is a memory read/write error.
+ * @retval -EINVAL if `fs` or `entries` is NULL, `count` is invalid, any entry is invalid or the
+ * entries do not fit in one sector.
+ * @retval -ENOSPC if no space is left on the device.
+ * @retval -ENOTSUP if an ATE does not fit in the buffer set by
+ * CONFIG_ZMS_WRITE_MULTI_BUF_SIZE.
+ */
+int zms_write_multi(struct zms_fs *fs, const struct zms_write_entry *entries, size_t count);
+
 /**
  * @brief Delete an entry from the file system
  *
@@ -170,6 +170,30 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	       struct icmsg_data_t *dev_data,
 	       const void *msg, size_t len);
 
+/** @brief Send a message gathered from several fragments to the remote icmsg instance.
+ *
+ *  The fragments are sent as a single message, without assembling them in
+ *  an intermediate buffer first.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] iov Array of message fragments.
+ *  @param[in] iovcnt Number of fragments in @p iov.
+ *
+ *  @retval Number of sent bytes.
+ *  @retval -EBUSY when the instance has not finished handshake with the remote
+ *                 instance.
+ *  @retval -ENODATA when the requested data to send is empty.
+ *  @retval -EBADMSG when the requested data to send is too big.
+ *  @retval -ENOBUFS when there are no TX buffers available.
+ *  @retval other errno codes from dependent modules.
+ */
+int icmsg_send_iov(const struct icmsg_config_t *conf,
+		   struct icmsg_data_t *dev_data,
+		   const struct pbuf_iovec *iov, size_t iovcnt);
+
 /**
  * @}
  */
@@ -37,8 +37,6 @@ struct icmsg_me_data_t {
 
 	struct k_mutex send_mutex;
 	const struct ipc_ept_cfg *epts[CONFIG_IPC_SERVICE_BACKEND_ICMSG_ME_NUM_EP];
-
-	uint8_t send_buffer[CONFIG_IPC_SERVICE_BACKEND_ICMSG_ME_SEND_BUF_SIZE] __aligned(4);
 };
 
 
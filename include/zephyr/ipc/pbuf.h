@@ -217,6 +217,30 @@ int pbuf_rx_init(struct pbuf *pb);
 
 int pbuf_write(struct pbuf *pb, const char *buf, uint16_t len);
 
+/** @brief Fragment of a packet written with @ref pbuf_writev. */
+struct pbuf_iovec {
+	/** Pointer to the fragment data. */
+	const void *buf;
+	/** Length of the fragment. */
+	uint16_t len;
+};
+
+/**
+ * @brief Write a packet gathered from several fragments to the packet buffer.
+ *
+ * Fragments are copied back to back into a single packet, so that a header
+ * and a payload held in separate buffers do not need to be assembled first.
+ *
+ * @param pb	 A buffer to which to write.
+ * @param iov	 Array of fragments.
+ * @param iovcnt Number of fragments in @p iov.
+ * @retval int	 Number of bytes written, negative error code on fail.
+ *		 -EINVAL, if any of input parameter is incorrect or the packet
+ *		 would be empty or longer than UINT16_MAX.
+ *		 -ENOMEM, if the packet is bigger than the buffer can fit.
+ */
+int pbuf_writev(struct pbuf *pb, const struct pbuf_iovec *iov, size_t iovcnt);
+
 /**
  * @brief Read specified amount of data from the packet buffer.
  *
@@ -235,6 +259,32 @@ int pbuf_write(struct pbuf *pb, const char *buf, uint16_t len);
  */
 int pbuf_read(struct pbuf *pb, char *buf, uint16_t len);
 
+/**
+ * @brief Claim the next packet in place.
+ *
+ * The packet remains in the buffer, so the writer cannot reuse its space,
+ * until it is released with @ref pbuf_release. A packet which wraps around
+ * the end of the buffer is not contiguous and cannot be accessed in place:
+ * its length is returned with @p buf set to NULL and it must be read with
+ * @ref pbuf_read instead.
+ *
+ * @param pb	A buffer from which the packet will be claimed.
+ * @param buf	Location where the packet address is written.
+ * @retval int	Packet length, negative error code on fail.
+ *		0, if the buffer is empty.
+ *		-EINVAL, if any of input parameter is incorrect.
+ *		-EAGAIN, if not whole message is ready yet.
+ */
+int pbuf_claim(struct pbuf *pb, char **buf);
+
+/**
+ * @brief Release a packet claimed with @ref pbuf_claim.
+ *
+ * @param pb	A buffer from which the packet was claimed.
+ * @param len	Length of the claimed packet.
+ */
+void pbuf_release(struct pbuf *pb, uint16_t len);
+
 /**
  * @brief Read handshake word from pbuf.
  *
@@ -89,6 +89,27 @@ struct coap_client_option {
 };
 
 /** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_COAP_CLIENT_BLOCK2_WINDOW) && (CONFIG_COAP_CLIENT_BLOCK2_WINDOW > 1)
+#define COAP_CLIENT_BLOCK2_WINDOW CONFIG_COAP_CLIENT_BLOCK2_WINDOW
+#else
+#define COAP_CLIENT_BLOCK2_WINDOW 1
+#endif
+
+#if COAP_CLIENT_BLOCK2_WINDOW > 1
+/* One outstanding Block2 request of a windowed block-wise transfer */
+struct coap_client_block_slot {
+	struct coap_pending pending;
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint32_t num;
+	uint16_t id;
+	uint16_t len;
+	int16_t code;
+	bool used;
+	bool more;
+	uint8_t data[CONFIG_COAP_CLIENT_BLOCK_SIZE];
+};
+#endif
+
 struct coap_client_internal_request {
 	uint8_t request_token[COAP_TOKEN_MAX_LEN];
 	uint32_t offset;
@@ -106,6 +127,15 @@ struct coap_client_internal_request {
 	/* For GETs with observe option set */
 	bool is_observe;
 	int last_response_id;
+
+#if COAP_CLIENT_BLOCK2_WINDOW > 1
+	/* Windowed Block2 transfer state */
+	bool window_active;
+	uint32_t window_next;
+	uint32_t window_deliver;
+	uint32_t window_end;
+	struct coap_client_block_slot window[COAP_CLIENT_BLOCK2_WINDOW];
+#endif
 };
 
 struct coap_client {
@@ -47,6 +47,12 @@ struct coap_service_data {
 	int sock_fd;
 	struct coap_observer observers[CONFIG_COAP_SERVICE_OBSERVERS];
 	struct coap_pending pending[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+#if defined(CONFIG_COAP_SERVER_RESOURCE_INDEX)
+	/* Resource position + 1 per hash slot, 0 for an empty slot */
+	uint16_t res_index[CONFIG_COAP_SERVER_RESOURCE_INDEX_SIZE];
+	uint16_t res_first_wildcard;
+	uint8_t res_index_state;
+#endif
 };
 
 struct coap_service {
@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -104,11 +105,30 @@ enum http_hpack_static_key {
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
 #endif
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE
+#else
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE 0
+#endif
+
+/* Per entry overhead accounted in the dynamic table size, RFC7541 ch 4.1. */
+#define HTTP_HPACK_ENTRY_OVERHEAD 32
+/* Default SETTINGS_HEADER_TABLE_SIZE value, RFC9113 ch 6.5.2. */
+#define HTTP_HPACK_DEFAULT_TABLE_SIZE 4096
+
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_ENTRIES \
+	(HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE / HTTP_HPACK_ENTRY_OVERHEAD)
+
+struct http_hpack_dynamic_table;
+
 /** @endcond */
 
 /** HTTP2 header field with decoding buffer. */
 struct http_hpack_header_buf {
-	/** A pointer to the decoded header field name. */
+	/** A pointer to the decoded header field name. NULL if the decoded
+	 *  representation did not carry a header field (dynamic table size
+	 *  update).
+	 */
 	const char *name;
 
 	/** A pointer to the decoded header field value. */
@@ -127,6 +147,63 @@ struct http_hpack_header_buf {
 	size_t datalen;
 };
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE) || defined(__DOXYGEN__)
+
+/** @cond INTERNAL_HIDDEN */
+
+struct http_hpack_dynamic_entry {
+	uint16_t offset;
+	uint16_t name_len;
+	uint16_t value_len;
+};
+
+/** @endcond */
+
+/**
+ * HPACK dynamic table (RFC7541, ch 2.3.2).
+ *
+ * The table keeps the header fields inserted by the peer (decoder side) or
+ * by the local encoder (encoder side) of a single HTTP/2 connection.
+ */
+struct http_hpack_dynamic_table {
+	/** Entries, stored as a ring buffer, oldest entry first. */
+	struct http_hpack_dynamic_entry entries[HTTP_SERVER_HPACK_DYNAMIC_TABLE_ENTRIES];
+
+	/** Storage for header field names and values of the entries. */
+	uint8_t data[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE];
+
+	/** Index of the oldest entry in the entries array. */
+	uint16_t first;
+
+	/** Number of entries in the table. */
+	uint16_t count;
+
+	/** Offset of the oldest entry data. */
+	uint16_t data_start;
+
+	/** Offset past the newest entry data. */
+	uint16_t data_end;
+
+	/** Current table size, as defined in RFC7541, ch 4.1. */
+	uint32_t size;
+
+	/** Current maximum table size. */
+	uint32_t max_size;
+
+	/** Upper limit for the maximum table size (SETTINGS_HEADER_TABLE_SIZE). */
+	uint32_t size_limit;
+
+	/** Smallest maximum size set since the last size update was signaled
+	 *  (encoder only).
+	 */
+	uint32_t min_size;
+
+	/** Dynamic table size update is to be signaled (encoder only). */
+	bool size_update;
+};
+
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 /** @cond INTERNAL_HIDDEN */
 
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
@@ -137,6 +214,19 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 			     struct http_hpack_header_buf *header);
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header);
+int http_hpack_decode_header_dynamic(struct http_hpack_dynamic_table *table,
+				     const uint8_t *buf, size_t datalen,
+				     struct http_hpack_header_buf *header);
+int http_hpack_encode_header_dynamic(struct http_hpack_dynamic_table *table,
+				     uint8_t *buf, size_t buflen,
+				     struct http_hpack_header_buf *header);
+void http_hpack_dynamic_table_init(struct http_hpack_dynamic_table *table,
+				   uint32_t size_limit, bool encoder);
+void http_hpack_dynamic_table_set_limit(struct http_hpack_dynamic_table *table,
+					uint32_t size_limit);
+void http_hpack_dynamic_table_set_decoder_limit(struct http_hpack_dynamic_table *table,
+						uint32_t size_limit);
+void http_hpack_dynamic_table_flush(struct http_hpack_dynamic_table *table);
 
 /** @endcond */
 
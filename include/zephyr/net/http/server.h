@@ -440,6 +440,16 @@ struct http_client_ctx {
 	/** HTTP/2 header parser context. */
 	struct http_hpack_header_buf header_field;
 
+/** @cond INTERNAL_HIDDEN */
+	/** HPACK dynamic table for request header fields. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE,
+		   (struct http_hpack_dynamic_table hpack_decoder));
+
+	/** HPACK dynamic table for response header fields. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE,
+		   (struct http_hpack_dynamic_table hpack_encoder));
+/** @endcond */
+
 	/** HTTP/2 streams context. */
 	struct http2_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
@@ -869,6 +869,23 @@ struct mqtt_transport {
 #endif
 };
 
+/** @brief Outgoing QoS 1 or QoS 2 PUBLISH message awaiting acknowledgment. */
+struct mqtt_inflight_msg {
+	/** Length of the PUBLISH packet stored for retransmission, 0 if the
+	 *  packet is not stored.
+	 */
+	uint32_t len;
+
+	/** Message id of the PUBLISH message. */
+	uint16_t message_id;
+
+	/** Slot of the in-flight buffer holding the stored packet. */
+	uint8_t slot;
+
+	/** Set once PUBREC is received, only PUBREL is retransmitted then. */
+	bool released;
+};
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -895,6 +912,28 @@ struct mqtt_internal {
 	/** Internal. MQTT 5.0 disconnect reason set in case of processing errors. */
 	enum mqtt_disconnect_reason_code disconnect_reason;
 #endif /* CONFIG_MQTT_VERSION_5_0 */
+
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW) || defined(__DOXYGEN__)
+	/** Internal. In-flight messages, in the order they were published. */
+	struct mqtt_inflight_msg inflight[CONFIG_MQTT_INFLIGHT_WINDOW_SIZE];
+
+	/** Internal. Number of in-flight messages. */
+	uint16_t inflight_count;
+
+	/** Internal. Number of in-flight messages allowed on the connection. */
+	uint16_t inflight_max;
+
+	/** Internal. Bitmask of the in-flight buffer slots in use. */
+	uint32_t inflight_slots;
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
+#if defined(CONFIG_MQTT_TX_BATCH) || defined(__DOXYGEN__)
+	/** Internal. Length of the packets batched in the transmit buffer. */
+	uint32_t tx_batch_len;
+
+	/** Internal. PUBLISH packets are batched. */
+	bool tx_batch;
+#endif /* CONFIG_MQTT_TX_BATCH */
 };
 
 /**
@@ -977,6 +1016,18 @@ struct mqtt_client {
 	/** Size of transmit buffer. */
 	uint32_t tx_buf_size;
 
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW) || defined(__DOXYGEN__)
+	/** Buffer used to store in-flight PUBLISH packets for retransmission,
+	 *  split into @kconfig{CONFIG_MQTT_INFLIGHT_WINDOW_SIZE} slots. Can be
+	 *  NULL, in which case the window is still enforced but the messages
+	 *  are not retransmitted by the library.
+	 */
+	uint8_t *inflight_buf;
+
+	/** Size of in-flight buffer. */
+	uint32_t inflight_buf_size;
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
 	/** Keepalive interval for this client in seconds.
 	 *  Default is CONFIG_MQTT_KEEPALIVE.
 	 */
@@ -1088,10 +1139,54 @@ int mqtt_connect(struct mqtt_client *client);
  *                  Shall not be NULL.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ * @retval -EAGAIN The in-flight window is full
+ *         (@kconfig{CONFIG_MQTT_INFLIGHT_WINDOW} only).
+ * @retval -EMSGSIZE A QoS 1 or QoS 2 packet does not fit into an in-flight
+ *         buffer slot (@kconfig{CONFIG_MQTT_INFLIGHT_WINDOW} only).
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW) || defined(__DOXYGEN__)
+/**
+ * @brief API to get the number of outgoing QoS 1 and QoS 2 messages that are
+ *        not yet fully acknowledged by the broker.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return Number of in-flight messages or a negative error code (errno.h).
+ */
+int mqtt_inflight_count(struct mqtt_client *client);
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
+#if defined(CONFIG_MQTT_TX_BATCH) || defined(__DOXYGEN__)
+/**
+ * @brief API to start batching of outgoing PUBLISH packets.
+ *
+ * Until @ref mqtt_batch_end is called, PUBLISH packets are copied into the
+ * transmit buffer instead of being sent right away, so that several small
+ * packets are written to the transport at once. The batch is flushed
+ * whenever the transmit buffer is full and before any other packet is sent.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_batch_begin(struct mqtt_client *client);
+
+/**
+ * @brief API to send the batched PUBLISH packets and stop batching.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_batch_end(struct mqtt_client *client);
+#endif /* CONFIG_MQTT_TX_BATCH */
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -361,6 +361,18 @@ struct net_pkt {
 	uint8_t ipv4_pmtu : 1;
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GRO)
+	/* More packets were queued behind this one in the RX queue */
+	uint8_t rx_burst : 1;
+#endif /* CONFIG_NET_TCP_GRO */
+
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Size of the TCP segments this packet is split into before it is
+	 * passed to L2, 0 if the packet is sent as is.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 	/* @endcond */
 };
 
@@ -873,6 +885,56 @@ static inline void net_pkt_set_ipv4_pmtu(struct net_pkt *pkt, bool value)
 }
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GRO)
+static inline bool net_pkt_rx_burst(struct net_pkt *pkt)
+{
+	return !!pkt->rx_burst;
+}
+
+static inline void net_pkt_set_rx_burst(struct net_pkt *pkt, bool value)
+{
+	pkt->rx_burst = value;
+}
+#else
+static inline bool net_pkt_rx_burst(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_rx_burst(struct net_pkt *pkt, bool value)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(value);
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
 static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
 {
@@ -96,10 +96,45 @@ extern struct npf_rule npf_default_ok;
 /** @brief Default rule list termination for rejecting a packet */
 extern struct npf_rule npf_default_drop;
 
+/** @cond INTERNAL_HIDDEN */
+
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+/* Rules compatible with one interface or Ethernet type value */
+struct npf_index_key {
+	uintptr_t value;
+	uint32_t rules;
+};
+
+/*
+ * Lookup tables compiled from a rule list, bit N of a rule bitmap stands
+ * for the Nth rule of the list.
+ */
+struct npf_rule_index {
+	struct npf_rule *rules[CONFIG_NET_PKT_FILTER_COMPILED_MAX_RULES];
+	/* Tests already covered by the key lookups, per rule */
+	uint32_t skip[CONFIG_NET_PKT_FILTER_COMPILED_MAX_RULES];
+	struct npf_index_key ifaces[CONFIG_NET_PKT_FILTER_COMPILED_MAX_KEYS];
+	struct npf_index_key types[CONFIG_NET_PKT_FILTER_COMPILED_MAX_KEYS];
+	/* Rules without an interface or Ethernet type condition */
+	uint32_t any_iface;
+	uint32_t any_type;
+	uint8_t nb_rules;
+	uint8_t nb_ifaces;
+	uint8_t nb_types;
+	bool valid;
+};
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
+/** @endcond */
+
 /** @brief rule set for a given test location */
 struct npf_rule_list {
 	sys_slist_t rule_head;   /**< List head */
 	struct k_spinlock lock;  /**< Lock protecting the list access */
+/** @cond INTERNAL_HIDDEN */
+	IF_ENABLED(CONFIG_NET_PKT_FILTER_COMPILED,
+		   (struct npf_rule_index index;)) /**< Compiled rule lookup */
+/** @endcond */
 };
 
 /** @brief  rule list applied to outgoing packets */
@@ -19,6 +19,8 @@
 
 #include <stdint.h>
 
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
@@ -33,6 +35,12 @@ struct prometheus_counter {
 	struct prometheus_metric base;
 	/** Value of the Prometheus counter metric */
 	uint64_t value;
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS) || defined(__DOXYGEN__)
+	/** Per-CPU increments not yet merged into the value */
+	atomic_t pending[CONFIG_MP_MAX_NUM_CPUS];
+	/** Serializes the merging of the pending increments */
+	struct k_spinlock lock;
+#endif
 	/** User data */
 	void *user_data;
 };
@@ -104,6 +112,17 @@ static inline int prometheus_counter_inc(struct prometheus_counter *counter)
  */
 int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value);
 
+/**
+ * @brief Get the value of a Prometheus counter metric
+ *
+ * With @kconfig{CONFIG_PROMETHEUS_PERCPU_METRICS} the increments are first
+ * merged into the counter value, which should not be read directly.
+ *
+ * @param counter Pointer to the counter metric to read.
+ * @return Current value of the counter.
+ */
+uint64_t prometheus_counter_get(struct prometheus_counter *counter);
+
 /**
  * @}
  */
@@ -49,6 +49,73 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 				 size_t buffer_size, int *written);
 
+/**
+ * @brief Streaming formatter context
+ *
+ * Keeps the position in the exposition data between the calls of
+ * prometheus_format_stream(). Initialize it with prometheus_format_stream_init().
+ */
+struct prometheus_format_context {
+	/** @cond INTERNAL_HIDDEN */
+	struct prometheus_collector *collector;
+	struct prometheus_metric *metric;
+	int line;
+	size_t len;
+	size_t offset;
+	bool locked;
+	bool done;
+	char buf[CONFIG_PROMETHEUS_FORMAT_LINE_LEN];
+	/** @endcond */
+};
+
+/**
+ * @brief Start streaming the exposition data of a collector
+ *
+ * @param ctx Pointer to the streaming formatter context.
+ * @param collector Pointer to the collector containing the data to format.
+ *
+ * @return 0 on success, negative errno on error.
+ */
+int prometheus_format_stream_init(struct prometheus_format_context *ctx,
+				  struct prometheus_collector *collector);
+
+/**
+ * @brief Format the next chunk of exposition data for Prometheus
+ *
+ * Fills the buffer with the next part of the exposition data of the collector,
+ * in the same format as prometheus_format_exposition(), so that the output can
+ * be sent chunk by chunk, for instance from a dynamic HTTP resource handler,
+ * without formatting the whole exposition data in one buffer. Metric lines may
+ * span several chunks. The buffer is not NUL terminated.
+ *
+ * The collector is locked by the first call and stays locked until the end of
+ * the exposition data is reached, an error is returned or the stream is aborted
+ * with prometheus_format_stream_abort(), so that metrics cannot be registered
+ * under the cursor. All the calls for one stream must be made from the same
+ * thread.
+ *
+ * @param ctx Pointer to the streaming formatter context.
+ * @param buffer Pointer to the buffer where the chunk will be stored.
+ * @param buffer_size Size of the buffer.
+ *
+ * @return Number of bytes stored in the buffer, which is less than
+ *         @p buffer_size once the end of the exposition data is reached,
+ *         negative errno on error.
+ */
+int prometheus_format_stream(struct prometheus_format_context *ctx, char *buffer,
+			     size_t buffer_size);
+
+/**
+ * @brief Abort streaming the exposition data of a collector
+ *
+ * Releases the collector if the stream was started but not completed, for
+ * instance because the client went away. The context has to be initialized
+ * again with prometheus_format_stream_init() before it can be reused.
+ *
+ * @param ctx Pointer to the streaming formatter context.
+ */
+void prometheus_format_stream_abort(struct prometheus_format_context *ctx);
+
 /**
  * @}
  */
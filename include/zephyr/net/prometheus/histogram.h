@@ -17,6 +17,8 @@
  * @{
  */
 
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
@@ -32,8 +34,30 @@ struct prometheus_histogram_bucket {
 	double upper_bound;
 	/** Cumulative count of observations in the bucket */
 	unsigned long count;
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS) || defined(__DOXYGEN__)
+	/** Per-CPU observations not yet merged into the count */
+	atomic_t pending[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS)
+/* Observations made on one CPU since the last merge */
+struct prometheus_histogram_shard {
+	atomic_t count;
+#if defined(CONFIG_64BIT)
+	/* Bit pattern of the double sum, updated with compare and swap */
+	atomic_t sum;
+#else
+	double sum;
+	struct k_spinlock lock;
+#endif
+};
+#endif
+
+/** @endcond */
+
 /**
  * @brief Type used to represent a Prometheus histogram metric.
  *
@@ -51,6 +75,12 @@ struct prometheus_histogram {
 	double sum;
 	/** Total count of observations in the histogram */
 	unsigned long count;
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS) || defined(__DOXYGEN__)
+	/** Per-CPU observations not yet merged into the sum and count */
+	struct prometheus_histogram_shard shards[CONFIG_MP_MAX_NUM_CPUS];
+	/** Serializes the merging of the shards */
+	struct k_spinlock lock;
+#endif
 	/** User data */
 	void *user_data;
 };
@@ -105,6 +135,18 @@ struct prometheus_histogram {
  */
 int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value);
 
+/**
+ * @brief Merge the pending observations of a Prometheus histogram metric
+ *
+ * With @kconfig{CONFIG_PROMETHEUS_PERCPU_METRICS} the observations are
+ * accumulated per CPU. This function merges them into the sum, count and
+ * bucket counts of the histogram, which can then be read. It does nothing
+ * if the option is disabled.
+ *
+ * @param histogram Pointer to the histogram metric to merge.
+ */
+void prometheus_histogram_merge(struct prometheus_histogram *histogram);
+
 /**
  * @}
  */
@@ -91,6 +91,23 @@ struct zperf_results {
 	uint32_t packet_size;         /**< Packet size */
 	uint32_t nb_packets_errors;   /**< Number of packet errors */
 	bool is_multicast;            /**< True if this session used IP multicast */
+#if defined(CONFIG_NET_ZPERF_CPU_LOAD) || defined(__DOXYGEN__)
+	/** CPU utilization during the session, in per mille */
+	uint16_t cpu_load_permille;
+#endif
+#if defined(CONFIG_NET_ZPERF_HISTOGRAM) || defined(__DOXYGEN__)
+	/**
+	 * UDP server only: number of datagrams per one-way delay, relative to
+	 * the fastest datagram. Bucket N counts delays of 2^N to
+	 * 2^(N+1) - 1 microseconds.
+	 */
+	uint32_t latency_hist[CONFIG_NET_ZPERF_HISTOGRAM_BUCKETS];
+	/**
+	 * UDP server only: number of datagrams per transit time difference
+	 * with the previous datagram, using the same buckets.
+	 */
+	uint32_t jitter_hist[CONFIG_NET_ZPERF_HISTOGRAM_BUCKETS];
+#endif
 };
 
 /**
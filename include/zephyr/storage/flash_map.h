@@ -348,6 +348,73 @@ const char *flash_area_label(const struct flash_area *fa);
  */
 uint8_t flash_area_erased_val(const struct flash_area *fa);
 
+#if defined(CONFIG_FLASH_MAP_TELEMETRY) || defined(__DOXYGEN__)
+/** Operation types accounted by the flash area telemetry */
+enum flash_area_telemetry_op {
+	/** flash_area_read() */
+	FLASH_AREA_TELEMETRY_READ,
+	/** flash_area_write() */
+	FLASH_AREA_TELEMETRY_WRITE,
+	/** flash_area_erase() and flash_area_flatten() */
+	FLASH_AREA_TELEMETRY_ERASE,
+	/** flash_area_copy(), accounted to the destination flash area */
+	FLASH_AREA_TELEMETRY_COPY,
+	/** Number of operation types */
+	FLASH_AREA_TELEMETRY_OPS,
+};
+
+/** Telemetry of one operation type of a flash area */
+struct flash_area_op_telemetry {
+	/** Number of operations, including failed ones */
+	uint32_t count;
+	/** Number of failed operations */
+	uint32_t errors;
+	/** Number of bytes processed by successful operations */
+	uint64_t bytes;
+	/** Total time spent in the operations [us] */
+	uint64_t total_us;
+	/** Longest operation [us] */
+	uint32_t max_us;
+	/**
+	 * Latency histogram, bucket n counts the operations that took from
+	 * 2^n to 2^(n+1) - 1 us, see @kconfig{CONFIG_FLASH_MAP_TELEMETRY_HIST_BUCKETS}.
+	 */
+	uint32_t latency[CONFIG_FLASH_MAP_TELEMETRY_HIST_BUCKETS];
+};
+
+/** Telemetry of a flash area */
+struct flash_area_telemetry {
+	/** Telemetry of each operation type, see @ref flash_area_telemetry_op */
+	struct flash_area_op_telemetry ops[FLASH_AREA_TELEMETRY_OPS];
+	/** Number of sectors sharing an erase counter, 0 until the first erase */
+	uint32_t sectors_per_counter;
+	/** Number of sector erases, counter n covers sectors starting from
+	 * n * sectors_per_counter
+	 */
+	uint32_t sector_erases[CONFIG_FLASH_MAP_TELEMETRY_SECTORS];
+};
+
+/**
+ * Retrieve the telemetry of a flash area
+ *
+ * @param[in]  fa  Flash area.
+ * @param[out] telemetry Snapshot of the telemetry.
+ *
+ * @return 0 on success, -ENOENT if no telemetry is kept for the flash area.
+ */
+int flash_area_telemetry_get(const struct flash_area *fa,
+			     struct flash_area_telemetry *telemetry);
+
+/**
+ * Clear the telemetry of a flash area
+ *
+ * @param[in] fa Flash area.
+ *
+ * @return 0 on success, -ENOENT if no telemetry is kept for the flash area.
+ */
+int flash_area_telemetry_reset(const struct flash_area *fa);
+#endif /* CONFIG_FLASH_MAP_TELEMETRY */
+
 #if USE_PARTITION_MANAGER
 #include <flash_map_pm.h>
 #else
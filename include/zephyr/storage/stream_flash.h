@@ -25,6 +25,9 @@
 
 #include <stdbool.h>
 #include <zephyr/drivers/flash.h>
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+#include <zephyr/kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +43,10 @@ extern "C" {
  * This enables verifying that the data has been correctly stored (for
  * instance by using a SHA function). The write buffer 'buf' provided in
  * stream_flash_init is used as a read buffer for this purpose.
+ * When asynchronous writes are enabled for the context with
+ * stream_flash_async_enable, the callback is invoked from the Stream Flash
+ * work queue thread, with whichever of the two write buffers has been
+ * programmed.
  *
  * @param buf Pointer to the data read.
  * @param len The length of the data read.
@@ -74,6 +81,14 @@ struct stream_flash_ctx {
 #endif
 	size_t write_block_size;	/* Offset/size device write alignment */
 	uint8_t erase_value;
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	struct k_work work;		/* Programs the pending buffer */
+	struct k_sem idle;		/* Available when no buffer is being programmed */
+	uint8_t *spare_buf;		/* Write buffer not currently being filled */
+	size_t pending_bytes;		/* Number of bytes in the buffer being programmed */
+	int pending_rc;			/* Result of the last asynchronous program */
+	bool async;			/* Asynchronous writes enabled */
+#endif
 };
 
 /**
@@ -95,6 +110,36 @@ struct stream_flash_ctx {
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+/**
+ * @brief Enable asynchronous double-buffered writes for an initialized context.
+ *
+ * Once enabled, a write buffer that gets full is handed over to a dedicated
+ * work queue, which erases (when needed) and programs it, while
+ * stream_flash_buffered_write returns and the caller keeps filling the second
+ * buffer. The caller only blocks when both buffers are full, or when flushing,
+ * in which case stream_flash_buffered_write returns once all the buffered data
+ * has been programmed.
+ *
+ * An error of an asynchronous program is reported by the next call to
+ * stream_flash_buffered_write; the context has to be re-initialized after
+ * that. stream_flash_bytes_written only accounts for data that has been
+ * programmed successfully, so progress stored with stream_flash_progress_save
+ * never points past data that is not in the flash yet.
+ * stream_flash_erase_page, stream_flash_progress_load and
+ * stream_flash_progress_save wait for the buffer being programmed first.
+ *
+ * Available only when CONFIG_STREAM_FLASH_ASYNC is enabled. The setting is
+ * cleared by stream_flash_init, which must not be called on a context that has
+ * not been flushed.
+ *
+ * @param ctx context initialized with stream_flash_init
+ * @param buf Second write buffer, of the same length as the one given to
+ *            stream_flash_init
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_async_enable(struct stream_flash_ctx *ctx, uint8_t *buf);
+
 /**
  * @brief Read number of bytes written to the flash.
  *
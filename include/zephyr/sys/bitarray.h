@@ -41,7 +41,34 @@ struct sys_bitarray {
 
 	/* Spinlock guarding access to this bit array */
 	struct k_spinlock lock;
+
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+	/* Summary bitmaps over the bundles, NULL if not used */
+	uint32_t *summary;
+#endif
 };
+
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+/* Words of one summary: a bit per bundle, then a bit per word of those */
+#define _SYS_BITARRAY_SUMMARY_WORDS(num_bundles)			\
+	(DIV_ROUND_UP(num_bundles, 32) +				\
+	 DIV_ROUND_UP(DIV_ROUND_UP(num_bundles, 32), 32))
+
+/*
+ * The full and the empty bundle summaries are stored back to back. The
+ * empty one is stored inverted, so a new, cleared bit array starts out with
+ * both of them zeroed.
+ */
+#define _SYS_BITARRAY_SUMMARY_DEFINE(name, num_bundles, sba_mod)	\
+	sba_mod uint32_t _sys_bitarray_summary_##name			\
+		[2 * _SYS_BITARRAY_SUMMARY_WORDS(num_bundles)] = {0};
+
+#define _SYS_BITARRAY_SUMMARY_INIT(name)				\
+	.summary = _sys_bitarray_summary_##name,
+#else
+#define _SYS_BITARRAY_SUMMARY_DEFINE(name, num_bundles, sba_mod)
+#define _SYS_BITARRAY_SUMMARY_INIT(name)
+#endif
 /** @endcond */
 
 /** Bitarray structure */
@@ -58,11 +85,15 @@ typedef struct sys_bitarray sys_bitarray_t;
 	sba_mod uint32_t _sys_bitarray_bundles_##name			\
 		[DIV_ROUND_UP(DIV_ROUND_UP(total_bits, 8),		\
 			       sizeof(uint32_t))] = {0};		\
+	_SYS_BITARRAY_SUMMARY_DEFINE(name,				\
+		DIV_ROUND_UP(DIV_ROUND_UP(total_bits, 8),		\
+			     sizeof(uint32_t)), sba_mod)		\
 	sba_mod sys_bitarray_t name = {					\
 		.num_bits = (total_bits),				\
 		.num_bundles = DIV_ROUND_UP(				\
 			DIV_ROUND_UP(total_bits, 8), sizeof(uint32_t)),	\
 		.bundles = _sys_bitarray_bundles_##name,		\
+		_SYS_BITARRAY_SUMMARY_INIT(name)			\
 	}
 
 /**
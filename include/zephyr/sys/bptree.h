@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @defgroup bptree_apis B+tree
+ * @ingroup datastructure_apis
+ *
+ * @brief B+tree ordered map over a caller-supplied node pool
+ *
+ * This implements an ordered map from 64-bit keys to pointers that
+ * guarantees O(log(N)) runtime for insert, remove and lookup, and
+ * O(1) amortized stepping between consecutive entries.
+ *
+ * Unlike @ref rbtree_apis, the keys are stored in the tree nodes
+ * themselves. Each node holds up to @kconfig{CONFIG_SYS_BPTREE_ORDER}
+ * - 1 sorted keys in an array, so a search touches a handful of
+ * contiguous nodes instead of one node per tree level, and entries
+ * are stored in leaves linked in key order, so iterating over a range
+ * does not need to walk the tree. This makes it suited to large
+ * ordered sets, at the cost of not being intrusive: the tree stores
+ * a pointer to the user data next to each key.
+ *
+ * Nodes are taken from a pool of @ref sys_bptree_node supplied by the
+ * user, and returned to it as entries are removed. No other memory is
+ * allocated.
+ *
+ * @{
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_BPTREE_H_
+#define ZEPHYR_INCLUDE_SYS_BPTREE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_SYS_BPTREE_ORDER
+#define Z_BPTREE_ORDER CONFIG_SYS_BPTREE_ORDER
+#else
+#define Z_BPTREE_ORDER 16
+#endif
+
+#define Z_BPTREE_MAX_KEYS (Z_BPTREE_ORDER - 1)
+/** @endcond */
+
+/**
+ * @brief B+tree node
+ *
+ * Only meant to be declared by the user, as the storage for the pool
+ * passed to @ref sys_bptree_init or @ref SYS_BPTREE_DEFINE.
+ */
+struct sys_bptree_node {
+	/** @cond INTERNAL_HIDDEN */
+	uint16_t n_keys;
+	bool leaf;
+	uint64_t keys[Z_BPTREE_MAX_KEYS];
+	union {
+		struct sys_bptree_node *children[Z_BPTREE_ORDER];
+		struct {
+			void *values[Z_BPTREE_MAX_KEYS];
+			struct sys_bptree_node *next;
+		};
+	};
+	/** @endcond */
+};
+
+/**
+ * @brief B+tree structure
+ */
+struct sys_bptree {
+	/** @cond INTERNAL_HIDDEN */
+	struct sys_bptree_node *root;
+	struct sys_bptree_node *pool;
+	size_t pool_size;
+	size_t pool_used;
+	struct sys_bptree_node *free_list;
+	/** @endcond */
+	/** Number of entries in the tree */
+	size_t size;
+};
+
+/**
+ * @brief B+tree iterator
+ *
+ * Positioned with @ref sys_bptree_first or @ref sys_bptree_lower_bound.
+ * Any change to the tree invalidates it.
+ */
+struct sys_bptree_iter {
+	/** @cond INTERNAL_HIDDEN */
+	const struct sys_bptree_node *node;
+	uint16_t pos;
+	/** @endcond */
+};
+
+/**
+ * @brief Static initializer of a B+tree
+ *
+ * @param _pool Array of @ref sys_bptree_node to take the nodes from.
+ * @param _pool_size Number of nodes in @p _pool.
+ */
+#define SYS_BPTREE_INITIALIZER(_pool, _pool_size)                                                  \
+	{                                                                                          \
+		.pool = (_pool),                                                                   \
+		.pool_size = (_pool_size),                                                         \
+	}
+
+/**
+ * @brief Statically define a B+tree and its node pool
+ *
+ * @param name Name of the B+tree.
+ * @param n_nodes Number of nodes in the pool.
+ */
+#define SYS_BPTREE_DEFINE(name, n_nodes)                                                           \
+	static struct sys_bptree_node _bptree_pool_##name[n_nodes];                                \
+	struct sys_bptree name = SYS_BPTREE_INITIALIZER(_bptree_pool_##name, n_nodes)
+
+/**
+ * @brief Number of pool nodes always sufficient to hold a number of entries
+ *
+ * Every node but the root is at least about half full, so this is
+ * roughly 4 * @p n_entries / (@kconfig{CONFIG_SYS_BPTREE_ORDER} - 2).
+ *
+ * @param n_entries Maximum number of entries in the tree.
+ */
+#define SYS_BPTREE_POOL_SIZE(n_entries)                                                            \
+	(2 * DIV_ROUND_UP((n_entries), Z_BPTREE_MAX_KEYS / 2) + 2)
+
+/**
+ * @brief Initialize a B+tree
+ *
+ * @param tree Pointer to the B+tree.
+ * @param pool Array of nodes to take the nodes from.
+ * @param pool_size Number of nodes in @p pool.
+ */
+void sys_bptree_init(struct sys_bptree *tree, struct sys_bptree_node *pool, size_t pool_size);
+
+/**
+ * @brief Insert an entry into a B+tree
+ *
+ * @param tree Pointer to the B+tree.
+ * @param key Key of the entry.
+ * @param value Value of the entry.
+ *
+ * @retval 0 on success.
+ * @retval -EEXIST if @p key is already in the tree. Its value is left
+ *         unchanged.
+ * @retval -ENOMEM if the node pool is exhausted.
+ */
+int sys_bptree_insert(struct sys_bptree *tree, uint64_t key, void *value);
+
+/**
+ * @brief Remove an entry from a B+tree
+ *
+ * @param tree Pointer to the B+tree.
+ * @param key Key of the entry to remove.
+ * @param value Location to store the value of the removed entry, or NULL.
+ *
+ * @retval true if the entry was removed.
+ * @retval false if @p key is not in the tree.
+ */
+bool sys_bptree_remove(struct sys_bptree *tree, uint64_t key, void **value);
+
+/**
+ * @brief Look up an entry of a B+tree
+ *
+ * @param tree Pointer to the B+tree.
+ * @param key Key of the entry.
+ * @param value Location to store the value of the entry, or NULL.
+ *
+ * @retval true if the entry was found.
+ * @retval false if @p key is not in the tree.
+ */
+bool sys_bptree_get(const struct sys_bptree *tree, uint64_t key, void **value);
+
+/**
+ * @brief Position an iterator on the first entry of a B+tree
+ *
+ * @param tree Pointer to the B+tree.
+ * @param it Iterator to position.
+ */
+void sys_bptree_first(const struct sys_bptree *tree, struct sys_bptree_iter *it);
+
+/**
+ * @brief Position an iterator on the first entry not less than a key
+ *
+ * Iterating from there up to the first key not less than an upper
+ * bound visits the entries of a key range.
+ *
+ * @param tree Pointer to the B+tree.
+ * @param key Lower bound of the keys.
+ * @param it Iterator to position.
+ */
+void sys_bptree_lower_bound(const struct sys_bptree *tree, uint64_t key,
+			    struct sys_bptree_iter *it);
+
+/**
+ * @brief Get the entry of an iterator and advance it to the next entry
+ *
+ * @param it Iterator.
+ * @param key Location to store the key of the entry, or NULL.
+ * @param value Location to store the value of the entry, or NULL.
+ *
+ * @retval true if an entry was returned.
+ * @retval false if the iterator is past the last entry.
+ */
+bool sys_bptree_iter_next(struct sys_bptree_iter *it, uint64_t *key, void **value);
+
+/**
+ * @brief Number of entries in a B+tree
+ *
+ * @param tree Pointer to the B+tree.
+ *
+ * @return Number of entries.
+ */
+static inline size_t sys_bptree_size(const struct sys_bptree *tree)
+{
+	return tree->size;
+}
+
+/**
+ * @brief Iterate over the entries of a B+tree in key order
+ *
+ * The tree must not be changed during the loop.
+ *
+ * @param tree Pointer to the B+tree.
+ * @param it Name of a struct sys_bptree_iter variable to use as the iterator.
+ * @param key Name of a uint64_t variable receiving the keys.
+ * @param value Name of a void * variable receiving the values.
+ */
+#define SYS_BPTREE_FOR_EACH(tree, it, key, value)                                                  \
+	for (sys_bptree_first((tree), &(it)); sys_bptree_iter_next(&(it), &(key), &(value));)
+
+/**
+ * @brief Iterate over the entries of a B+tree in a key range
+ *
+ * Visits the entries whose keys are in [@p from, @p to). The tree must not
+ * be changed during the loop.
+ *
+ * @param tree Pointer to the B+tree.
+ * @param it Name of a struct sys_bptree_iter variable to use as the iterator.
+ * @param from Lowest key of the range.
+ * @param to First key past the range.
+ * @param key Name of a uint64_t variable receiving the keys.
+ * @param value Name of a void * variable receiving the values.
+ */
+#define SYS_BPTREE_FOR_EACH_RANGE(tree, it, from, to, key, value)                                  \
+	for (sys_bptree_lower_bound((tree), (from), &(it));                                        \
+	     sys_bptree_iter_next(&(it), &(key), &(value)) && (key) < (to);)
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* ZEPHYR_INCLUDE_SYS_BPTREE_H_ */
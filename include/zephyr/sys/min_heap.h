@@ -49,6 +49,27 @@ typedef int (*min_heap_cmp_t)(const void *a,
 typedef bool (*min_heap_eq_t)(const void *node,
 			       const void *other);
 
+/**
+ * @brief Index tracking function for handle-based access to heap nodes.
+ *
+ * Called whenever an element is stored at a new index of the heap, so
+ * that the user can record it, typically in the object the element
+ * refers to. The recorded index can then be passed to
+ * min_heap_update() and min_heap_remove() without searching the heap.
+ *
+ * @param node Pointer to the element at its new position.
+ * @param index New index of the element.
+ */
+typedef void (*min_heap_index_cb_t)(void *node, size_t index);
+
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_MIN_HEAP_ARITY
+#define Z_MIN_HEAP_ARITY CONFIG_MIN_HEAP_ARITY
+#else
+#define Z_MIN_HEAP_ARITY 2
+#endif
+/** @endcond */
+
 /**
  * @brief min-heap data structure with user-provided comparator.
  */
@@ -63,6 +84,8 @@ struct min_heap {
 	size_t size;
 	/** Comparator function */
 	min_heap_cmp_t cmp;
+	/** Optional index tracking function */
+	min_heap_index_cb_t index_cb;
 };
 
 /**
@@ -120,6 +143,25 @@ struct min_heap {
 void min_heap_init(struct min_heap *heap, void *storage, size_t cap,
 		   size_t elem_size, min_heap_cmp_t cmp);
 
+/**
+ * @brief Set the index tracking function of a min-heap.
+ *
+ * Must be called while the heap is empty. Once set, @p index_cb is
+ * called with the new index of every element that is pushed or moved
+ * within the heap.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param index_cb Index tracking function, or NULL to disable tracking.
+ */
+static inline void min_heap_set_index_cb(struct min_heap *heap,
+					 min_heap_index_cb_t index_cb)
+{
+	__ASSERT_NO_MSG(heap != NULL);
+	__ASSERT_NO_MSG(heap->size == 0);
+
+	heap->index_cb = index_cb;
+}
+
 /**
  * @brief Push an element into the min-heap.
  *
@@ -134,6 +176,38 @@ void min_heap_init(struct min_heap *heap, void *storage, size_t cap,
  */
 int min_heap_push(struct min_heap *heap, const void *item);
 
+/**
+ * @brief Push several elements into the min-heap at once.
+ *
+ * Appends all elements and then restores the heap order bottom-up, which
+ * takes O(n) time for n elements in the heap, instead of O(count log n)
+ * for pushing them one by one. No element is inserted if they do not all
+ * fit in the heap.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param items Pointer to an array of @p count elements to insert.
+ * @param count Number of elements to insert.
+ *
+ * @return 0 on Success, -ENOMEM if the heap does not have room for
+ *         @p count elements.
+ */
+int min_heap_push_bulk(struct min_heap *heap, const void *items, size_t count);
+
+/**
+ * @brief Restore the heap order after an element has changed.
+ *
+ * Must be called after the key of the element at index @p id was changed
+ * in place, for instance through min_heap_get_element(). The element is
+ * moved up or down as needed in O(log n) time, which makes it suitable
+ * for decrease-key as well as increase-key operations.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param id Index of the changed element.
+ *
+ * @return true in success, false if @p id is not a valid index.
+ */
+bool min_heap_update(struct min_heap *heap, size_t id);
+
 /**
  * @brief Peek at the top element of the min-heap.
  *
@@ -150,7 +224,9 @@ void *min_heap_peek(const struct min_heap *heap);
  *
  * Removes the specified node from the min-heap based on the ID it stores
  * internally. The min-heap is rebalanced after removal to ensure
- * proper ordering.
+ * proper ordering. The ID can be obtained with min_heap_find(), or
+ * recorded by the index tracking function set with
+ * min_heap_set_index_cb().
  * The caller gains ownership of the returned element and is responsible for
  * any further management of its memory or reuse.
  *
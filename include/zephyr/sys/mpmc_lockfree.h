@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2010-2011 Dmitry Vyukov
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SYS_MPMC_LOCKFREE_H_
+#define ZEPHYR_SYS_MPMC_LOCKFREE_H_
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util_macro.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Multiple Producer Multiple Consumer (MPMC) Lockfree Queue API
+ * @defgroup mpmc_lockfree MPMC Lockfree Queue API
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @file mpmc_lockfree.h
+ *
+ * @brief A lock-free bounded multi producer multi consumer (MPMC) queue of
+ * fixed size elements. Ordering is First-In-First-Out.
+ *
+ * Based on the bounded MPMC queue described by Dmitry Vyukov. Elements are
+ * copied in and out of a power of two sized ring buffer. Each slot has a
+ * sequence number telling producers and consumers whether the slot may be
+ * written or read for the current lap around the ring, so a push or pop costs
+ * a single compare and swap on the queue position when uncontended.
+ *
+ * An MPMC queue is safe to produce or consume in any number of ISRs and
+ * threads, on any number of CPUs, with O(1) push/pop that never spin waiting
+ * for another context.
+ *
+ * @note A producer or consumer that is interrupted between reserving a slot
+ * and completing its copy holds up that slot only: until it resumes, pops (or
+ * pushes) reaching that slot report the queue as empty (or full) even if later
+ * slots are ready.
+ *
+ * The optional @ref mpmc_blocking wrapper adds timeouts, taking the
+ * scheduler path only when the queue is empty or full.
+ */
+
+/**
+ * @brief MPMC Queue
+ *
+ * @warning Not to be manipulated without the functions and macros!
+ */
+struct mpmc {
+	/* position of the next slot to push into */
+	atomic_t head;
+
+	/* position of the next slot to pop from */
+	atomic_t tail;
+
+	/*
+	 * Per slot sequence number, stored relative to the slot index so that
+	 * zero is the initial state and queues can live in .bss.
+	 */
+	atomic_t *seq;
+
+	/* element storage */
+	uint8_t *buffer;
+
+	/* size of an element in bytes */
+	size_t elem_size;
+
+	/* mask used to automatically wrap positions */
+	unsigned long mask;
+};
+
+/**
+ * @brief Statically initialize an mpmc
+ *
+ * @param _buf Buffer of @p _sz elements of @p _elem_size bytes
+ * @param _seq Array of @p _sz zero initialized atomic_t
+ * @param _elem_size Size of an element in bytes
+ * @param _sz Number of elements, must be power of 2 (ex: 2, 4, 8)
+ */
+#define MPMC_INITIALIZER(_buf, _seq, _elem_size, _sz)                                              \
+	{                                                                                          \
+		.head = ATOMIC_INIT(0),                                                            \
+		.tail = ATOMIC_INIT(0),                                                            \
+		.seq = (_seq),                                                                     \
+		.buffer = (uint8_t *)(_buf),                                                       \
+		.elem_size = (_elem_size),                                                         \
+		.mask = (_sz) - 1,                                                                 \
+	}
+
+/**
+ * @brief Define an mpmc with a fixed size
+ *
+ * @param _name Name of the mpmc symbol to be provided
+ * @param _elem_size Size of an element in bytes
+ * @param _sz Number of elements, must be power of 2 (ex: 2, 4, 8)
+ */
+#define MPMC_DEFINE(_name, _elem_size, _sz)                                                        \
+	BUILD_ASSERT(IS_POWER_OF_TWO(_sz));                                                        \
+	static atomic_t __mpmc_seq_##_name[_sz];                                                   \
+	static uint8_t __mpmc_buf_##_name[(_sz) * (_elem_size)];                                   \
+	struct mpmc _name = MPMC_INITIALIZER(__mpmc_buf_##_name, __mpmc_seq_##_name, _elem_size,  \
+					     _sz)
+
+/**
+ * @brief Initialize/reset an mpmc such that it is empty
+ *
+ * Note that this is not safe to do while the queue is in use.
+ *
+ * @param q MPMC to initialize/reset
+ * @param buf Buffer of @p sz elements of @p elem_size bytes
+ * @param seq Array of @p sz atomic_t
+ * @param elem_size Size of an element in bytes
+ * @param sz Number of elements, must be power of 2 (ex: 2, 4, 8)
+ */
+static inline void mpmc_init(struct mpmc *q, void *buf, atomic_t *seq, size_t elem_size,
+			     size_t sz)
+{
+	__ASSERT_NO_MSG(IS_POWER_OF_TWO(sz));
+
+	atomic_set(&q->head, 0);
+	atomic_set(&q->tail, 0);
+	q->seq = seq;
+	q->buffer = buf;
+	q->elem_size = elem_size;
+	q->mask = sz - 1;
+
+	for (size_t i = 0; i < sz; i++) {
+		atomic_set(&seq[i], 0);
+	}
+}
+
+/**
+ * @brief Push an element
+ *
+ * @param q Queue to push the element to
+ * @param data Element to copy into the queue
+ *
+ * @retval true The element was pushed
+ * @retval false The queue is full
+ */
+static inline bool mpmc_push(struct mpmc *q, const void *data)
+{
+	unsigned long pos = (unsigned long)atomic_get(&q->head);
+	unsigned long lap;
+	long diff;
+
+	for (;;) {
+		lap = pos & ~q->mask;
+		diff = (long)((unsigned long)atomic_get(&q->seq[pos & q->mask]) - lap);
+
+		/* The slot has not been popped since the previous lap */
+		if (diff < 0) {
+			return false;
+		}
+
+		if (diff == 0 && atomic_cas(&q->head, (atomic_val_t)pos, (atomic_val_t)(pos + 1))) {
+			break;
+		}
+
+		/* Another producer took the slot, retry with the new head */
+		pos = (unsigned long)atomic_get(&q->head);
+	}
+
+	memcpy(&q->buffer[(pos & q->mask) * q->elem_size], data, q->elem_size);
+	atomic_set(&q->seq[pos & q->mask], (atomic_val_t)(lap + 1));
+
+	return true;
+}
+
+/**
+ * @brief Pop an element
+ *
+ * @param q Queue to pop the element from
+ * @param data Buffer the element is copied to
+ *
+ * @retval true An element was popped
+ * @retval false The queue is empty
+ */
+static inline bool mpmc_pop(struct mpmc *q, void *data)
+{
+	unsigned long pos = (unsigned long)atomic_get(&q->tail);
+	unsigned long lap;
+	long diff;
+
+	for (;;) {
+		lap = pos & ~q->mask;
+		diff = (long)((unsigned long)atomic_get(&q->seq[pos & q->mask]) - (lap + 1));
+
+		/* The slot has not been pushed in this lap */
+		if (diff < 0) {
+			return false;
+		}
+
+		if (diff == 0 && atomic_cas(&q->tail, (atomic_val_t)pos, (atomic_val_t)(pos + 1))) {
+			break;
+		}
+
+		/* Another consumer took the slot, retry with the new tail */
+		pos = (unsigned long)atomic_get(&q->tail);
+	}
+
+	memcpy(data, &q->buffer[(pos & q->mask) * q->elem_size], q->elem_size);
+	atomic_set(&q->seq[pos & q->mask], (atomic_val_t)(lap + q->mask + 1));
+
+	return true;
+}
+
+/**
+ * @brief Blocking MPMC Queue
+ *
+ * Wraps an @ref mpmc with semaphores that producers and consumers wait on
+ * when the queue is full or empty. They are only given when someone waits, so
+ * pushing to a queue that is not full and popping from one that is not empty
+ * never enters the kernel.
+ *
+ * @note The semaphores are embedded in the queue, which is therefore only
+ * usable from supervisor mode threads and ISRs.
+ */
+struct mpmc_blocking {
+	struct mpmc q;
+
+	/* given after a push when consumers wait */
+	struct k_sem readable;
+
+	/* given after a pop when producers wait */
+	struct k_sem writable;
+
+	/* number of consumers waiting for an element */
+	atomic_t pop_waiters;
+
+	/* number of producers waiting for a free slot */
+	atomic_t push_waiters;
+};
+
+/**
+ * @brief Define a blocking mpmc with a fixed size
+ *
+ * @param _name Name of the blocking mpmc symbol to be provided
+ * @param _elem_size Size of an element in bytes
+ * @param _sz Number of elements, must be power of 2 (ex: 2, 4, 8)
+ */
+#define MPMC_BLOCKING_DEFINE(_name, _elem_size, _sz)                                               \
+	BUILD_ASSERT(IS_POWER_OF_TWO(_sz));                                                        \
+	static atomic_t __mpmc_seq_##_name[_sz];                                                   \
+	static uint8_t __mpmc_buf_##_name[(_sz) * (_elem_size)];                                   \
+	struct mpmc_blocking _name = {                                                             \
+		.q = MPMC_INITIALIZER(__mpmc_buf_##_name, __mpmc_seq_##_name, _elem_size, _sz),    \
+		.readable = Z_SEM_INITIALIZER(_name.readable, 0, K_SEM_MAX_LIMIT),                 \
+		.writable = Z_SEM_INITIALIZER(_name.writable, 0, K_SEM_MAX_LIMIT),                 \
+		.pop_waiters = ATOMIC_INIT(0),                                                     \
+		.push_waiters = ATOMIC_INIT(0),                                                    \
+	}
+
+/**
+ * @brief Initialize/reset a blocking mpmc such that it is empty
+ *
+ * Note that this is not safe to do while the queue is in use.
+ *
+ * @param b Blocking MPMC to initialize/reset
+ * @param buf Buffer of @p sz elements of @p elem_size bytes
+ * @param seq Array of @p sz atomic_t
+ * @param elem_size Size of an element in bytes
+ * @param sz Number of elements, must be power of 2 (ex: 2, 4, 8)
+ */
+static inline void mpmc_blocking_init(struct mpmc_blocking *b, void *buf, atomic_t *seq,
+				      size_t elem_size, size_t sz)
+{
+	mpmc_init(&b->q, buf, seq, elem_size, sz);
+	k_sem_init(&b->readable, 0, K_SEM_MAX_LIMIT);
+	k_sem_init(&b->writable, 0, K_SEM_MAX_LIMIT);
+	atomic_set(&b->pop_waiters, 0);
+	atomic_set(&b->push_waiters, 0);
+}
+
+/**
+ * @brief Push an element, waiting for a free slot if the queue is full
+ *
+ * @funcprops \isr_ok with @p timeout set to K_NO_WAIT
+ *
+ * @param b Blocking MPMC to push the element to
+ * @param data Element to copy into the queue
+ * @param timeout Waiting period for a free slot, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 The element was pushed
+ * @retval -ENOMSG Returned without waiting, the queue is full
+ * @retval -EAGAIN Waiting period timed out
+ */
+static inline int mpmc_blocking_push(struct mpmc_blocking *b, const void *data,
+				     k_timeout_t timeout)
+{
+	k_timepoint_t end;
+
+	if (!mpmc_push(&b->q, data)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		end = sys_timepoint_calc(timeout);
+
+		/*
+		 * Announce the wait before retrying so that a consumer either
+		 * sees it or frees a slot before the retry.
+		 */
+		atomic_inc(&b->push_waiters);
+		while (!mpmc_push(&b->q, data)) {
+			if (k_sem_take(&b->writable, sys_timepoint_timeout(end)) != 0) {
+				atomic_dec(&b->push_waiters);
+				return -EAGAIN;
+			}
+		}
+		atomic_dec(&b->push_waiters);
+	}
+
+	if (atomic_get(&b->pop_waiters) > 0) {
+		k_sem_give(&b->readable);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Pop an element, waiting for one if the queue is empty
+ *
+ * @funcprops \isr_ok with @p timeout set to K_NO_WAIT
+ *
+ * @param b Blocking MPMC to pop the element from
+ * @param data Buffer the element is copied to
+ * @param timeout Waiting period for an element, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 An element was popped
+ * @retval -ENOMSG Returned without waiting, the queue is empty
+ * @retval -EAGAIN Waiting period timed out
+ */
+static inline int mpmc_blocking_pop(struct mpmc_blocking *b, void *data, k_timeout_t timeout)
+{
+	k_timepoint_t end;
+
+	if (!mpmc_pop(&b->q, data)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		end = sys_timepoint_calc(timeout);
+
+		atomic_inc(&b->pop_waiters);
+		while (!mpmc_pop(&b->q, data)) {
+			if (k_sem_take(&b->readable, sys_timepoint_timeout(end)) != 0) {
+				atomic_dec(&b->pop_waiters);
+				return -EAGAIN;
+			}
+		}
+		atomic_dec(&b->pop_waiters);
+	}
+
+	if (atomic_get(&b->push_waiters) > 0) {
+		k_sem_give(&b->writable);
+	}
+
+	return 0;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_SYS_MPMC_LOCKFREE_H_ */
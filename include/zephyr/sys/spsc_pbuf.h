@@ -161,6 +161,29 @@ struct spsc_pbuf *spsc_pbuf_init(void *buf, size_t blen, uint32_t flags);
  */
 int spsc_pbuf_write(struct spsc_pbuf *pb, const char *buf, uint16_t len);
 
+/** @brief Fragment of a packet written with @ref spsc_pbuf_writev. */
+struct spsc_pbuf_iovec {
+	/** Pointer to the fragment data. */
+	const void *buf;
+	/** Length of the fragment. */
+	uint16_t len;
+};
+
+/**
+ * @brief Write a packet gathered from several fragments to the packet buffer.
+ *
+ * Fragments are copied back to back into a single packet, so that a header
+ * and a payload held in separate buffers do not need to be assembled first.
+ *
+ * @param pb	 A buffer to which to write.
+ * @param iov	 Array of fragments.
+ * @param iovcnt Number of fragments in @p iov.
+ * @retval int	 Number of bytes written, negative error code on fail.
+ *		 -EINVAL, if the total length is 0 or not less than @ref SPSC_PBUF_MAX_LEN.
+ *		 -ENOMEM, if the packet is bigger than the buffer can fit.
+ */
+int spsc_pbuf_writev(struct spsc_pbuf *pb, const struct spsc_pbuf_iovec *iov, size_t iovcnt);
+
 /**
  * @brief Allocate space in the packet buffer.
  *
@@ -14,6 +14,7 @@
 #ifndef ZEPHYR_INCLUDE_SYS_UTIL_UFT8_H_
 #define ZEPHYR_INCLUDE_SYS_UTIL_UFT8_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 
 #ifdef __cplusplus
@@ -82,6 +83,20 @@ char *utf8_lcpy(char *dst, const char *src, size_t n);
  */
 int utf8_count_chars(const char *s);
 
+/**
+ * @brief Checks that a buffer holds well-formed UTF-8
+ *
+ * Validates @p n bytes of @p s according to RFC 3629. Overlong encodings,
+ * UTF-16 surrogates, code points above U+10FFFF and truncated sequences are
+ * rejected. ASCII text is checked a word at a time.
+ *
+ * @param s The input buffer, it does not need to be NULL-terminated
+ * @param n The number of bytes to check
+ *
+ * @return true if @p s is valid UTF-8, false otherwise.
+ */
+bool utf8_validate(const char *s, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_oa_rh.h>
+#include <zephyr/sys/util.h>
+
+struct oarh_entry {
+	uint64_t key;
+	uint64_t value;
+};
+
+/*
+ * The bucket table is followed by one byte per bucket holding the probe
+ * distance of its entry plus one, or DIST_EMPTY if the bucket is unused.
+ * Entries of a cluster are kept ordered by home bucket, so an entry is never
+ * further from its home bucket than the entry preceding it plus one.
+ */
+#define DIST_EMPTY 0
+#define DIST_MAX   UINT8_MAX
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+static inline uint8_t *sys_hashmap_oa_rh_dist(const struct sys_hashmap_data *data)
+{
+	return (uint8_t *)((struct oarh_entry *)data->buckets + data->n_buckets);
+}
+
+static inline size_t sys_hashmap_oa_rh_home(const struct sys_hashmap *map, uint64_t key)
+{
+	return map->hash_func(&key, sizeof(key)) & (map->data->n_buckets - 1);
+}
+
+static bool sys_hashmap_oa_rh_find(const struct sys_hashmap *map, uint64_t key, size_t *pos)
+{
+	const size_t mask = map->data->n_buckets - 1;
+	const struct oarh_entry *const buckets = map->data->buckets;
+	const uint8_t *dist;
+	size_t j;
+
+	if (map->data->n_buckets == 0) {
+		return false;
+	}
+
+	dist = sys_hashmap_oa_rh_dist(map->data);
+
+	/*
+	 * Stop at the first bucket whose entry is closer to its home bucket
+	 * than the key would be: the key would have displaced it.
+	 */
+	j = sys_hashmap_oa_rh_home(map, key);
+	for (unsigned int d = 1; dist[j] >= d; ++d, j = (j + 1) & mask) {
+		if (dist[j] == d && buckets[j].key == key) {
+			*pos = j;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int sys_hashmap_oa_rh_insert_no_rehash(struct sys_hashmap *map, uint64_t key,
+					      uint64_t value, uint64_t *old_value)
+{
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	const size_t mask = data->n_buckets - 1;
+	struct oarh_entry *const buckets = data->buckets;
+	uint8_t *const dist = sys_hashmap_oa_rh_dist(map->data);
+	unsigned int d = 1;
+	size_t prev;
+	size_t i;
+	size_t j;
+
+	__ASSERT_NO_MSG(data->n_buckets > 0);
+
+	j = sys_hashmap_oa_rh_home(map, key);
+	for (; dist[j] >= d; ++d, j = (j + 1) & mask) {
+		if (dist[j] == d && buckets[j].key == key) {
+			if (old_value != NULL) {
+				*old_value = buckets[j].value;
+			}
+
+			buckets[j].value = value;
+			return 0;
+		}
+	}
+
+	if (d > DIST_MAX) {
+		return -ENOSPC;
+	}
+
+	/*
+	 * Bucket j holds an entry closer to its home bucket than the new one.
+	 * Make room by moving the rest of the cluster one bucket further,
+	 * which keeps it ordered, provided no probe distance overflows.
+	 */
+	for (i = j; dist[i] != DIST_EMPTY; i = (i + 1) & mask) {
+		if (dist[i] == DIST_MAX || ((i + 1) & mask) == j) {
+			return -ENOSPC;
+		}
+	}
+
+	for (; i != j; i = prev) {
+		prev = (i - 1) & mask;
+		buckets[i] = buckets[prev];
+		dist[i] = dist[prev] + 1;
+	}
+
+	buckets[j].key = key;
+	buckets[j].value = value;
+	dist[j] = d;
+	++data->size;
+
+	return 1;
+}
+
+static int sys_hashmap_oa_rh_resize(struct sys_hashmap *map, size_t new_n_buckets)
+{
+	struct oarh_entry *new_buckets;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	const struct sys_hashmap_oa_rh_data old = *data;
+	const struct oarh_entry *old_buckets = old.buckets;
+	const uint8_t *old_dist = NULL;
+
+	if (old.n_buckets != 0) {
+		old_dist = sys_hashmap_oa_rh_dist((struct sys_hashmap_data *)&old);
+	}
+
+	new_buckets = map->alloc_func(NULL, new_n_buckets * (sizeof(*new_buckets) + 1));
+	if (new_buckets == NULL && new_n_buckets != 0) {
+		return -ENOMEM;
+	}
+
+	data->size = 0;
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+
+	if (new_buckets != NULL) {
+		/* ensure all buckets are empty */
+		memset(sys_hashmap_oa_rh_dist(map->data), DIST_EMPTY, new_n_buckets);
+	}
+
+	/* re-insert all entries into the hashmap */
+	for (size_t i = 0, j = 0; i < old.n_buckets && j < old.size; ++i) {
+		if (old_dist[i] == DIST_EMPTY) {
+			continue;
+		}
+
+		if (sys_hashmap_oa_rh_insert_no_rehash(map, old_buckets[i].key,
+						       old_buckets[i].value, NULL) < 0) {
+			/* too many colliding hashes, keep the old table */
+			map->alloc_func(new_buckets, 0);
+			*data = old;
+			return -ENOSPC;
+		}
+		++j;
+	}
+
+	/* free the old Hashmap */
+	map->alloc_func(old.buckets, 0);
+
+	return 0;
+}
+
+static int sys_hashmap_oa_rh_rehash(struct sys_hashmap *map, bool grow)
+{
+	size_t new_n_buckets = 0;
+
+	if (!sys_hashmap_should_rehash(map, grow, 0, &new_n_buckets)) {
+		return 0;
+	}
+
+	if (map->data->size != SIZE_MAX && map->data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	return sys_hashmap_oa_rh_resize(map, new_n_buckets);
+}
+
+static void sys_hashmap_oa_rh_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	struct oarh_entry *buckets = map->data->buckets;
+	const uint8_t *dist = sys_hashmap_oa_rh_dist(map->data);
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos == 0) {
+		it->state = buckets;
+	}
+
+	i = (struct oarh_entry *)it->state - buckets;
+	__ASSERT(i < map->data->n_buckets, "Invalid iterator state %p", it->state);
+
+	for (; i < map->data->n_buckets; ++i) {
+		if (dist[i] != DIST_EMPTY) {
+			it->state = &buckets[i + 1];
+			it->key = buckets[i].key;
+			it->value = buckets[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Open Addressing / Robin Hood Hashmap API
+ */
+
+static void sys_hashmap_oa_rh_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_oa_rh_iter_next;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_oa_rh_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	struct oarh_entry *buckets = data->buckets;
+	const uint8_t *dist;
+
+	if (data->buckets != NULL) {
+		dist = sys_hashmap_oa_rh_dist(map->data);
+
+		for (size_t i = 0, j = 0; cb != NULL && i < data->n_buckets && j < data->size;
+		     ++i) {
+			if (dist[i] != DIST_EMPTY) {
+				cb(buckets[i].key, buckets[i].value, cookie);
+				++j;
+			}
+		}
+
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+}
+
+static int sys_hashmap_oa_rh_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	int ret;
+
+	ret = sys_hashmap_oa_rh_rehash(map, true);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = sys_hashmap_oa_rh_insert_no_rehash(map, key, value, old_value);
+	if (ret == -ENOSPC &&
+	    map->data->size * 200 >= map->data->n_buckets * map->config->load_factor) {
+		/*
+		 * A probe distance would overflow: spread the entries, unless the
+		 * table is already sparse and more buckets would not help.
+		 */
+		ret = sys_hashmap_oa_rh_resize(map, map->data->n_buckets * 2);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = sys_hashmap_oa_rh_insert_no_rehash(map, key, value, old_value);
+	}
+
+	return ret;
+}
+
+static bool sys_hashmap_oa_rh_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	const size_t mask = data->n_buckets - 1;
+	struct oarh_entry *const buckets = data->buckets;
+	uint8_t *dist;
+	size_t next;
+	size_t j;
+
+	if (!sys_hashmap_oa_rh_find(map, key, &j)) {
+		return false;
+	}
+
+	dist = sys_hashmap_oa_rh_dist(map->data);
+
+	if (value != NULL) {
+		*value = buckets[j].value;
+	}
+
+	/* shift the entries following j back until one is in its home bucket */
+	for (next = (j + 1) & mask; dist[next] > 1; j = next, next = (next + 1) & mask) {
+		buckets[j] = buckets[next];
+		dist[j] = dist[next] - 1;
+	}
+
+	dist[j] = DIST_EMPTY;
+	--data->size;
+
+	/* ignore a possible -ENOMEM since the table will remain intact */
+	(void)sys_hashmap_oa_rh_rehash(map, false);
+
+	return true;
+}
+
+static bool sys_hashmap_oa_rh_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	size_t j;
+
+	if (!sys_hashmap_oa_rh_find(map, key, &j)) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = ((struct oarh_entry *)map->data->buckets)[j].value;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_oa_rh_api = {
+	.iter = sys_hashmap_oa_rh_iter,
+	.clear = sys_hashmap_oa_rh_clear,
+	.insert = sys_hashmap_oa_rh_insert,
+	.remove = sys_hashmap_oa_rh_remove,
+	.get = sys_hashmap_oa_rh_get,
+};
@@ -10,19 +10,38 @@
 
 LOG_MODULE_REGISTER(min_heap);
 
+#define PARENT(index) (((index) - 1) / Z_MIN_HEAP_ARITY)
+#define FIRST_CHILD(index) (Z_MIN_HEAP_ARITY * (index) + 1)
+
+/**
+ * @brief Report the index of a node to the user, if tracking is enabled.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param index Index of the node that was stored or moved.
+ */
+static inline void notify_index(struct min_heap *heap, size_t index)
+{
+	if (heap->index_cb != NULL) {
+		heap->index_cb(min_heap_get_element(heap, index), index);
+	}
+}
+
 /**
  * @brief Restore heap order by moving a node up the tree.
  *
  * Moves the node at the given index upward in the heap until the min-heap
- * property is restored.
+ * property is restored. The parents moved down are reported to the index
+ * tracking function, but not the node itself.
  *
  * @param heap Pointer to the min-heap.
  * @param index Index of the node to heapify upwards.
+ *
+ * @return Final index of the node.
  */
-static void heapify_up(struct min_heap *heap, size_t index)
+static size_t heapify_up(struct min_heap *heap, size_t index)
 {
 	while (index > 0) {
-		size_t parent = (index - 1) / 2;
+		size_t parent = PARENT(index);
 		void *curr = min_heap_get_element(heap, index);
 		void *par = min_heap_get_element(heap, parent);
 
@@ -30,42 +49,41 @@ static void heapify_up(struct min_heap *heap, size_t index)
 			break;
 		}
 		byteswp(curr, par, heap->elem_size);
+		notify_index(heap, index);
 		index = parent;
 	}
+
+	return index;
 }
 
 /**
  * @brief Restore heap order by moving a node down the tree.
  *
  * Moves the node at the specified index downward in the heap until the
- * min-heap property is restored.
+ * min-heap property is restored. The children moved up are reported to
+ * the index tracking function, but not the node itself.
  *
  * @param heap Pointer to the min-heap.
  * @param index Index of the node to heapify downward.
+ *
+ * @return Final index of the node.
  */
-
-static void heapify_down(struct min_heap *heap, size_t index)
+static size_t heapify_down(struct min_heap *heap, size_t index)
 {
-	/* Terminate the loop naturally when the left child is out of bounds */
-	for (size_t left = 2 * index + 1; left < heap->size; left = 2 * index + 1) {
+	/* Terminate the loop naturally when the first child is out of bounds */
+	for (size_t first = FIRST_CHILD(index); first < heap->size; first = FIRST_CHILD(index)) {
 
-		size_t right = left + 1;
+		size_t last = MIN(first + Z_MIN_HEAP_ARITY, heap->size);
 		size_t smallest = index;
 		void *elem_index = min_heap_get_element(heap, index);
-		void *elem_left = min_heap_get_element(heap, left);
 		void *elem_smallest = elem_index;
 
-		if (heap->cmp(elem_left, elem_index) < 0) {
-			smallest = left;
-			elem_smallest = elem_left;
-		}
-
-		if (right < heap->size) {
-			void *elem_right = min_heap_get_element(heap, right);
+		for (size_t child = first; child < last; child++) {
+			void *elem_child = min_heap_get_element(heap, child);
 
-			if (heap->cmp(elem_right, elem_smallest) < 0) {
-				smallest = right;
-				elem_smallest = elem_right;
+			if (heap->cmp(elem_child, elem_smallest) < 0) {
+				smallest = child;
+				elem_smallest = elem_child;
 			}
 		}
 
@@ -74,10 +92,75 @@ static void heapify_down(struct min_heap *heap, size_t index)
 		}
 
 		byteswp(elem_index, elem_smallest, heap->elem_size);
+		notify_index(heap, index);
 		index = smallest;
 	}
+
+	return index;
 }
 
+/**
+ * @brief Fill a hole in the heap with a node that was moved out of it.
+ *
+ * Moves the smallest child up into the hole, level by level, until
+ * @p node can be stored there. Unlike heapify_down(), every element is
+ * copied once instead of being swapped at each level, which makes popping
+ * cheaper. The children moved up are reported to the index tracking
+ * function, but not @p node.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param index Index of the hole.
+ * @param node Node to store, outside of the heap elements.
+ *
+ * @return Index where @p node was stored.
+ */
+static size_t sift_hole_down(struct min_heap *heap, size_t index, const void *node)
+{
+	for (size_t first = FIRST_CHILD(index); first < heap->size; first = FIRST_CHILD(index)) {
+
+		size_t last = MIN(first + Z_MIN_HEAP_ARITY, heap->size);
+		size_t smallest = first;
+		void *elem_smallest = min_heap_get_element(heap, first);
+
+		for (size_t child = first + 1; child < last; child++) {
+			void *elem_child = min_heap_get_element(heap, child);
+
+			if (heap->cmp(elem_child, elem_smallest) < 0) {
+				smallest = child;
+				elem_smallest = elem_child;
+			}
+		}
+
+		if (heap->cmp(elem_smallest, node) >= 0) {
+			break;
+		}
+
+		memcpy(min_heap_get_element(heap, index), elem_smallest, heap->elem_size);
+		notify_index(heap, index);
+		index = smallest;
+	}
+
+	memcpy(min_heap_get_element(heap, index), node, heap->elem_size);
+
+	return index;
+}
+
+/**
+ * @brief Move a node up or down until the min-heap property is restored.
+ *
+ * @param heap Pointer to the min-heap.
+ * @param index Index of the node to move.
+ */
+static void heapify(struct min_heap *heap, size_t index)
+{
+	size_t final = heapify_down(heap, index);
+
+	if (final == index) {
+		final = heapify_up(heap, index);
+	}
+
+	notify_index(heap, final);
+}
 
 void min_heap_init(struct min_heap *heap, void *storage, size_t cap,
 		   size_t elem_size, min_heap_cmp_t cmp)
@@ -86,6 +169,7 @@ void min_heap_init(struct min_heap *heap, void *storage, size_t cap,
 	heap->capacity = cap;
 	heap->elem_size = elem_size;
 	heap->cmp = cmp;
+	heap->index_cb = NULL;
 	heap->size = 0;
 }
 
@@ -107,12 +191,50 @@ int min_heap_push(struct min_heap *heap, const void *item)
 	void *dest = min_heap_get_element(heap, heap->size);
 
 	memcpy(dest, item, heap->elem_size);
-	heapify_up(heap, heap->size);
 	heap->size++;
+	notify_index(heap, heapify_up(heap, heap->size - 1));
+
+	return 0;
+}
+
+int min_heap_push_bulk(struct min_heap *heap, const void *items, size_t count)
+{
+	if (count > heap->capacity - heap->size) {
+		return -ENOMEM;
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	memcpy(min_heap_get_element(heap, heap->size), items, count * heap->elem_size);
+	heap->size += count;
+
+	/* Sift down every node that has children, from the last one up */
+	for (size_t i = DIV_ROUND_UP(heap->size - 1, Z_MIN_HEAP_ARITY); i > 0; i--) {
+		(void)heapify_down(heap, i - 1);
+	}
+
+	if (heap->index_cb != NULL) {
+		for (size_t i = 0; i < heap->size; i++) {
+			notify_index(heap, i);
+		}
+	}
 
 	return 0;
 }
 
+bool min_heap_update(struct min_heap *heap, size_t id)
+{
+	if (id >= heap->size) {
+		return false;
+	}
+
+	heapify(heap, id);
+
+	return true;
+}
+
 bool min_heap_remove(struct min_heap *heap, size_t id, void *out_buf)
 {
 	if (id >= heap->size) {
@@ -123,12 +245,17 @@ bool min_heap_remove(struct min_heap *heap, size_t id, void *out_buf)
 
 	memcpy(out_buf, removed, heap->elem_size);
 	heap->size--;
-	if (id != heap->size) {
-		void *last = min_heap_get_element(heap, heap->size);
+	if (id == heap->size) {
+		return true;
+	}
+
+	void *last = min_heap_get_element(heap, heap->size);
 
+	if (id > 0 && heap->cmp(last, min_heap_get_element(heap, PARENT(id))) < 0) {
 		memcpy(removed, last, heap->elem_size);
-		heapify_down(heap, id);
-		heapify_up(heap, id);
+		notify_index(heap, heapify_up(heap, id));
+	} else {
+		notify_index(heap, sift_hole_down(heap, id, last));
 	}
 
 	return true;
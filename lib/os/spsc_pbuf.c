@@ -246,6 +246,37 @@ int spsc_pbuf_write(struct spsc_pbuf *pb, const char *buf, uint16_t len)
 	return len;
 }
 
+int spsc_pbuf_writev(struct spsc_pbuf *pb, const struct spsc_pbuf_iovec *iov, size_t iovcnt)
+{
+	char *pbuf;
+	size_t len = 0;
+	int outlen;
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		len += iov[i].len;
+	}
+
+	if (len == 0 || len >= SPSC_PBUF_MAX_LEN) {
+		return -EINVAL;
+	}
+
+	outlen = spsc_pbuf_alloc(pb, len, &pbuf);
+	if (outlen != len) {
+		return outlen < 0 ? outlen : -ENOMEM;
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		if (iov[i].len > 0) {
+			memcpy(pbuf, iov[i].buf, iov[i].len);
+			pbuf += iov[i].len;
+		}
+	}
+
+	spsc_pbuf_commit(pb, len);
+
+	return len;
+}
+
 uint16_t spsc_pbuf_claim(struct spsc_pbuf *pb, char **buf)
 {
 	/* Length of the buffer and flags are immutable - avoid reloading. */
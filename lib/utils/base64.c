@@ -22,6 +22,7 @@
  *  - Reworked coding style
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <errno.h>
 #include <zephyr/sys/base64.h>
@@ -54,6 +55,34 @@ static const uint8_t base64_dec_map[128] = {
 
 #define BASE64_SIZE_T_MAX	((size_t) -1) /* SIZE_T_MAX is not standard */
 
+/*
+ * Decode a quantum of 4 base64 characters without padding, as found in
+ * the bulk of the input. Returns false if any of them needs the slow path
+ * (padding, whitespace or invalid characters).
+ */
+static inline bool base64_dec_quantum(const uint8_t *src, uint32_t *x)
+{
+	uint32_t a, b, c, d;
+
+	if (((src[0] | src[1] | src[2] | src[3]) & 0x80) != 0U) {
+		return false;
+	}
+
+	a = base64_dec_map[src[0]];
+	b = base64_dec_map[src[1]];
+	c = base64_dec_map[src[2]];
+	d = base64_dec_map[src[3]];
+
+	/* Any value of 64 and above is not a base64 digit */
+	if (((a | b | c | d) & 0xC0) != 0U) {
+		return false;
+	}
+
+	*x = (a << 18) | (b << 12) | (c << 6) | d;
+
+	return true;
+}
+
 /*
  * Encode a buffer into base64 format
  */
@@ -130,6 +159,18 @@ int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 
 	/* First pass: check for validity and get output length */
 	for (i = n = j = 0U; i < slen; i++) {
+		/* Skip over whole quanta before any padding was seen */
+		if (j == 0U) {
+			while ((slen - i) >= 4 && base64_dec_quantum(&src[i], &x)) {
+				i += 4;
+				n += 4;
+			}
+
+			if (i == slen) {
+				break;
+			}
+		}
+
 		/* Skip spaces before checking for EOL */
 		x = 0U;
 		while (i < slen && src[i] == ' ') {
@@ -188,6 +229,21 @@ int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 	}
 
 	for (j = 3U, n = x = 0U, p = dst; i > 0; i--, src++) {
+		/* Decode whole quanta at once between line breaks */
+		if (n == 0U) {
+			while (i >= 4 && base64_dec_quantum(src, &x)) {
+				p[0] = (unsigned char)(x >> 16);
+				p[1] = (unsigned char)(x >> 8);
+				p[2] = (unsigned char)(x);
+				p += 3;
+				src += 4;
+				i -= 4;
+			}
+
+			if (i == 0) {
+				break;
+			}
+		}
 
 		if (*src == '\r' || *src == '\n' || *src == ' ') {
 			continue;
@@ -26,6 +26,155 @@ struct bundle_data {
 	uint32_t smask, emask;
 };
 
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+/*
+ * A summary holds one bit per bundle in its first level, followed by one
+ * bit per word of the first level, so a search skips over 32 bundles per
+ * first level word and 1024 bundles per second level word.
+ */
+enum summary_kind {
+	/* Bundle has all bits set */
+	SUMMARY_FULL,
+	/* Bundle has all bits cleared */
+	SUMMARY_EMPTY,
+};
+
+/*
+ * The empty summary is stored inverted, so that the zero-initialized one of
+ * a new bit array has every bundle, and every bit past the last bundle, in it.
+ */
+static inline uint32_t summary_inv(enum summary_kind kind)
+{
+	return (kind == SUMMARY_EMPTY) ? ~0U : 0U;
+}
+
+static inline size_t summary_l1_words(sys_bitarray_t *bitarray)
+{
+	return DIV_ROUND_UP(bitarray->num_bundles, 32);
+}
+
+static inline uint32_t *summary_get(sys_bitarray_t *bitarray, enum summary_kind kind)
+{
+	return &bitarray->summary[kind * _SYS_BITARRAY_SUMMARY_WORDS(bitarray->num_bundles)];
+}
+
+static inline void summary_assign(uint32_t *words, size_t idx, bool val)
+{
+	if (val) {
+		words[idx / 32] |= BIT(idx % 32);
+	} else {
+		words[idx / 32] &= ~BIT(idx % 32);
+	}
+}
+
+/* Refresh the summaries after bundles sidx to eidx were modified */
+static void summary_update(sys_bitarray_t *bitarray, size_t sidx, size_t eidx)
+{
+	if (bitarray->summary == NULL) {
+		return;
+	}
+
+	for (int kind = SUMMARY_FULL; kind <= SUMMARY_EMPTY; kind++) {
+		uint32_t *l1 = summary_get(bitarray, kind);
+		uint32_t *l2 = l1 + summary_l1_words(bitarray);
+		uint32_t match = (kind == SUMMARY_FULL) ? ~0U : 0U;
+		uint32_t inv = summary_inv(kind);
+
+		for (size_t idx = sidx; idx <= eidx; idx++) {
+			summary_assign(l1, idx, (bitarray->bundles[idx] == match) != (inv != 0U));
+		}
+
+		for (size_t w = sidx / 32; w <= eidx / 32; w++) {
+			summary_assign(l2, w, (l1[w] == ~inv) != (inv != 0U));
+		}
+	}
+}
+
+/*
+ * Find the first bundle at or after idx which does not have its bit set
+ * in the summary. Returns the number of bundles if there is none.
+ */
+static size_t summary_skip(sys_bitarray_t *bitarray, enum summary_kind kind, size_t idx)
+{
+	uint32_t *l1 = summary_get(bitarray, kind);
+	size_t l1_words = summary_l1_words(bitarray);
+	uint32_t *l2 = l1 + l1_words;
+	size_t l2_words = DIV_ROUND_UP(l1_words, 32);
+	uint32_t inv = summary_inv(kind);
+	size_t w = idx / 32;
+	size_t t;
+	uint32_t bits;
+
+	while (w < l1_words) {
+		bits = ~(l1[w] ^ inv) & ~BIT_MASK(idx % 32);
+		if (bits != 0U) {
+			idx = w * 32 + find_lsb_set(bits) - 1;
+			return MIN(idx, bitarray->num_bundles);
+		}
+
+		/* Go to the next first level word which is not all ones */
+		w++;
+		t = w / 32;
+		if (t >= l2_words) {
+			break;
+		}
+
+		bits = ~(l2[t] ^ inv) & ~BIT_MASK(w % 32);
+		while (bits == 0U) {
+			if (++t >= l2_words) {
+				return bitarray->num_bundles;
+			}
+			bits = ~(l2[t] ^ inv);
+		}
+
+		w = t * 32 + find_lsb_set(bits) - 1;
+		idx = w * 32;
+	}
+
+	return bitarray->num_bundles;
+}
+#else
+static inline void summary_update(sys_bitarray_t *bitarray, size_t sidx, size_t eidx)
+{
+	ARG_UNUSED(bitarray);
+	ARG_UNUSED(sidx);
+	ARG_UNUSED(eidx);
+}
+#endif /* CONFIG_SYS_BITARRAY_SUMMARY */
+
+/*
+ * Find the first cleared bit at or after bit. The result is past the last
+ * bit of the bit array if there is none.
+ */
+static size_t find_next_clear(sys_bitarray_t *bitarray, size_t bit)
+{
+	size_t idx = bit / bundle_bitness(bitarray);
+	uint32_t bundle;
+
+	if (idx >= bitarray->num_bundles) {
+		return bitarray->num_bits;
+	}
+
+	bundle = ~bitarray->bundles[idx] & ~BIT_MASK(bit % bundle_bitness(bitarray));
+	while (bundle == 0U) {
+		idx++;
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+		/* Only consult the summary when running into a run of full bundles */
+		if ((bitarray->summary != NULL) && ((idx + 1) < bitarray->num_bundles) &&
+		    ((bitarray->bundles[idx] & bitarray->bundles[idx + 1]) == ~0U)) {
+			idx = summary_skip(bitarray, SUMMARY_FULL, idx);
+		}
+#endif
+		if (idx >= bitarray->num_bundles) {
+			return bitarray->num_bits;
+		}
+
+		bundle = ~bitarray->bundles[idx];
+	}
+
+	return idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1;
+}
+
 static void setup_bundle_data(sys_bitarray_t *bitarray,
 			      struct bundle_data *bd,
 			      size_t offset, size_t num_bits)
@@ -208,6 +357,8 @@ static void set_region(sys_bitarray_t *bitarray, size_t offset,
 			}
 		}
 	}
+
+	summary_update(bitarray, bd->sidx, bd->eidx);
 }
 
 int sys_bitarray_popcount_region(sys_bitarray_t *bitarray, size_t num_bits, size_t offset,
@@ -309,6 +460,7 @@ int sys_bitarray_xor(sys_bitarray_t *dst, sys_bitarray_t *other, size_t num_bits
 		}
 	}
 
+	summary_update(dst, bd.sidx, bd.eidx);
 	ret = 0;
 
 out:
@@ -337,6 +489,7 @@ int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] |= BIT(off);
+	summary_update(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -365,6 +518,7 @@ int sys_bitarray_clear_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	summary_update(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -441,6 +595,7 @@ int sys_bitarray_test_and_set_bit(sys_bitarray_t *bitarray, size_t bit, int *pre
 	}
 
 	bitarray->bundles[idx] |= BIT(off);
+	summary_update(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -480,6 +635,7 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 	}
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	summary_update(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -492,10 +648,10 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset)
 {
 	k_spinlock_key_t key;
-	uint32_t bit_idx;
+	size_t bit_idx;
 	int ret;
 	struct bundle_data bd;
-	size_t off_start, off_end;
+	size_t off_end;
 	size_t mismatch;
 
 	__ASSERT_NO_MSG(bitarray != NULL);
@@ -521,35 +677,17 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 			ret = -ENOSPC;
 		} else {
 			bitarray->bundles[0] |= BIT_MASK(num_bits) << off;
+			summary_update(bitarray, 0, 0);
 			*offset = off;
 			ret = 0;
 		}
 		goto out;
 	}
 
-	bit_idx = 0;
-
 	/* Find the first non-allocated bit by looking at bundles
 	 * instead of individual bits.
-	 *
-	 * On RISC-V 64-bit, it complains about undefined reference to `ffs`.
-	 * So don't use this on RISCV64.
 	 */
-	for (size_t idx = 0; idx < bitarray->num_bundles; idx++) {
-		if (~bitarray->bundles[idx] == 0U) {
-			/* bundle is all 1s => all allocated, skip */
-			bit_idx += bundle_bitness(bitarray);
-			continue;
-		}
-
-		if (bitarray->bundles[idx] != 0U) {
-			/* Find the first free bit in bundle if not all free */
-			off_start = find_lsb_set(~bitarray->bundles[idx]) - 1;
-			bit_idx += off_start;
-		}
-
-		break;
-	}
+	bit_idx = find_next_clear(bitarray, 0);
 
 	off_end = bitarray->num_bits - num_bits;
 	ret = -ENOSPC;
@@ -563,10 +701,10 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 			break;
 		}
 
-		/* Fast-forward to the bit just after
+		/* Fast-forward to the first free bit after
 		 * the mismatched bit.
 		 */
-		bit_idx = mismatch + 1;
+		bit_idx = find_next_clear(bitarray, mismatch + 1);
 	}
 
 out:
@@ -612,6 +750,15 @@ int sys_bitarray_find_nth_set(sys_bitarray_t *bitarray, size_t n, size_t num_bit
 		 * bundles.
 		 */
 		for (idx = bd.sidx + 1; idx < bd.eidx; idx++) {
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+			if (bitarray->summary != NULL) {
+				/* Skip the bundles without any bit set */
+				idx = summary_skip(bitarray, SUMMARY_EMPTY, idx);
+				if (idx >= bd.eidx) {
+					break;
+				}
+			}
+#endif
 			count = POPCOUNT(bitarray->bundles[idx]);
 			if (count >= n) {
 				mask = ~(mask & 0);
@@ -681,6 +828,7 @@ int sys_bitarray_free(sys_bitarray_t *bitarray, size_t num_bits,
 			ret = -EFAULT;
 		} else {
 			bitarray->bundles[0] &= ~mask;
+			summary_update(bitarray, 0, 0);
 			ret = 0;
 		}
 	} else if (match_region(bitarray, offset, num_bits, true, &bd, NULL)) {
@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/bptree.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Every node but the root holds at least MIN_KEYS keys. Insertion splits
+ * full nodes and removal refills nodes holding MIN_KEYS keys on the way
+ * down, so neither ever has to walk back up the tree.
+ *
+ * Internal nodes hold n_keys separators and n_keys + 1 children, all keys
+ * in children[i] being less than keys[i] and not less than keys[i - 1].
+ * Leaves hold the entries, and are chained in key order through next.
+ */
+#define MAX_KEYS Z_BPTREE_MAX_KEYS
+#define MIN_KEYS (MAX_KEYS / 2)
+
+/* Splitting a full internal node leaves MIN_KEYS keys on both sides */
+BUILD_ASSERT(Z_BPTREE_ORDER >= 4 && Z_BPTREE_ORDER % 2 == 0,
+	     "B+tree order must be an even number of at least 4");
+
+static struct sys_bptree_node *node_alloc(struct sys_bptree *tree, bool leaf)
+{
+	struct sys_bptree_node *node = tree->free_list;
+
+	if (node != NULL) {
+		tree->free_list = node->children[0];
+	} else if (tree->pool_used < tree->pool_size) {
+		node = &tree->pool[tree->pool_used++];
+	} else {
+		return NULL;
+	}
+
+	node->n_keys = 0;
+	node->leaf = leaf;
+	if (leaf) {
+		node->next = NULL;
+	}
+
+	return node;
+}
+
+static void node_free(struct sys_bptree *tree, struct sys_bptree_node *node)
+{
+	node->children[0] = tree->free_list;
+	tree->free_list = node;
+}
+
+/* Index of the first key of a node not less than key */
+static inline uint16_t lower_bound(const struct sys_bptree_node *node, uint64_t key)
+{
+	uint16_t lo = 0;
+	uint16_t hi = node->n_keys;
+
+	while (lo < hi) {
+		uint16_t mid = (lo + hi) / 2;
+
+		if (node->keys[mid] < key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Index of the first key of a node greater than key, i.e. of the child holding key */
+static inline uint16_t upper_bound(const struct sys_bptree_node *node, uint64_t key)
+{
+	uint16_t lo = 0;
+	uint16_t hi = node->n_keys;
+
+	while (lo < hi) {
+		uint16_t mid = (lo + hi) / 2;
+
+		if (node->keys[mid] <= key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static const struct sys_bptree_node *find_leaf(const struct sys_bptree *tree, uint64_t key)
+{
+	const struct sys_bptree_node *node = tree->root;
+
+	while (node != NULL && !node->leaf) {
+		node = node->children[upper_bound(node, key)];
+	}
+
+	return node;
+}
+
+/* Split the full child i of parent, which is not full, in two */
+static int split_child(struct sys_bptree *tree, struct sys_bptree_node *parent, uint16_t i)
+{
+	struct sys_bptree_node *child = parent->children[i];
+	struct sys_bptree_node *right = node_alloc(tree, child->leaf);
+	uint64_t sep;
+
+	if (right == NULL) {
+		return -ENOMEM;
+	}
+
+	if (child->leaf) {
+		right->n_keys = MAX_KEYS - MIN_KEYS;
+		memcpy(right->keys, &child->keys[MIN_KEYS], right->n_keys * sizeof(uint64_t));
+		memcpy(right->values, &child->values[MIN_KEYS], right->n_keys * sizeof(void *));
+		right->next = child->next;
+		child->next = right;
+		sep = right->keys[0];
+	} else {
+		/* The middle key moves up to the parent */
+		right->n_keys = MAX_KEYS - MIN_KEYS - 1;
+		memcpy(right->keys, &child->keys[MIN_KEYS + 1], right->n_keys * sizeof(uint64_t));
+		memcpy(right->children, &child->children[MIN_KEYS + 1],
+		       (right->n_keys + 1) * sizeof(struct sys_bptree_node *));
+		sep = child->keys[MIN_KEYS];
+	}
+
+	child->n_keys = MIN_KEYS;
+
+	memmove(&parent->keys[i + 1], &parent->keys[i], (parent->n_keys - i) * sizeof(uint64_t));
+	memmove(&parent->children[i + 2], &parent->children[i + 1],
+		(parent->n_keys - i) * sizeof(struct sys_bptree_node *));
+	parent->keys[i] = sep;
+	parent->children[i + 1] = right;
+	++parent->n_keys;
+
+	return 0;
+}
+
+/* Move the last entry of the left sibling of child i to the front of the child */
+static void borrow_left(struct sys_bptree_node *parent, uint16_t i)
+{
+	struct sys_bptree_node *child = parent->children[i];
+	struct sys_bptree_node *left = parent->children[i - 1];
+
+	memmove(&child->keys[1], &child->keys[0], child->n_keys * sizeof(uint64_t));
+
+	if (child->leaf) {
+		memmove(&child->values[1], &child->values[0], child->n_keys * sizeof(void *));
+		child->keys[0] = left->keys[left->n_keys - 1];
+		child->values[0] = left->values[left->n_keys - 1];
+		parent->keys[i - 1] = child->keys[0];
+	} else {
+		memmove(&child->children[1], &child->children[0],
+			(child->n_keys + 1) * sizeof(struct sys_bptree_node *));
+		child->keys[0] = parent->keys[i - 1];
+		child->children[0] = left->children[left->n_keys];
+		parent->keys[i - 1] = left->keys[left->n_keys - 1];
+	}
+
+	--left->n_keys;
+	++child->n_keys;
+}
+
+/* Move the first entry of the right sibling of child i to the end of the child */
+static void borrow_right(struct sys_bptree_node *parent, uint16_t i)
+{
+	struct sys_bptree_node *child = parent->children[i];
+	struct sys_bptree_node *right = parent->children[i + 1];
+
+	if (child->leaf) {
+		child->keys[child->n_keys] = right->keys[0];
+		child->values[child->n_keys] = right->values[0];
+		memmove(&right->values[0], &right->values[1], (right->n_keys - 1) * sizeof(void *));
+	} else {
+		child->keys[child->n_keys] = parent->keys[i];
+		child->children[child->n_keys + 1] = right->children[0];
+		parent->keys[i] = right->keys[0];
+		memmove(&right->children[0], &right->children[1],
+			right->n_keys * sizeof(struct sys_bptree_node *));
+	}
+
+	memmove(&right->keys[0], &right->keys[1], (right->n_keys - 1) * sizeof(uint64_t));
+	--right->n_keys;
+	++child->n_keys;
+
+	if (child->leaf) {
+		parent->keys[i] = right->keys[0];
+	}
+}
+
+/* Append child i + 1 to child i, both holding MIN_KEYS keys, and free it */
+static void merge_right(struct sys_bptree *tree, struct sys_bptree_node *parent, uint16_t i)
+{
+	struct sys_bptree_node *child = parent->children[i];
+	struct sys_bptree_node *right = parent->children[i + 1];
+
+	if (child->leaf) {
+		memcpy(&child->keys[child->n_keys], right->keys, right->n_keys * sizeof(uint64_t));
+		memcpy(&child->values[child->n_keys], right->values,
+		       right->n_keys * sizeof(void *));
+		child->n_keys += right->n_keys;
+		child->next = right->next;
+	} else {
+		/* The separator moves down from the parent */
+		child->keys[child->n_keys] = parent->keys[i];
+		memcpy(&child->keys[child->n_keys + 1], right->keys,
+		       right->n_keys * sizeof(uint64_t));
+		memcpy(&child->children[child->n_keys + 1], right->children,
+		       (right->n_keys + 1) * sizeof(struct sys_bptree_node *));
+		child->n_keys += right->n_keys + 1;
+	}
+
+	memmove(&parent->keys[i], &parent->keys[i + 1],
+		(parent->n_keys - i - 1) * sizeof(uint64_t));
+	memmove(&parent->children[i + 1], &parent->children[i + 2],
+		(parent->n_keys - i - 1) * sizeof(struct sys_bptree_node *));
+	--parent->n_keys;
+
+	node_free(tree, right);
+}
+
+/*
+ * Make child i of parent, which holds MIN_KEYS keys, hold more so that a
+ * key can be removed from it, and return the node now covering its keys.
+ */
+static struct sys_bptree_node *refill_child(struct sys_bptree *tree,
+					    struct sys_bptree_node *parent, uint16_t i)
+{
+	if (i > 0 && parent->children[i - 1]->n_keys > MIN_KEYS) {
+		borrow_left(parent, i);
+	} else if (i < parent->n_keys && parent->children[i + 1]->n_keys > MIN_KEYS) {
+		borrow_right(parent, i);
+	} else if (i < parent->n_keys) {
+		merge_right(tree, parent, i);
+	} else {
+		merge_right(tree, parent, --i);
+	}
+
+	return parent->children[i];
+}
+
+void sys_bptree_init(struct sys_bptree *tree, struct sys_bptree_node *pool, size_t pool_size)
+{
+	*tree = (struct sys_bptree)SYS_BPTREE_INITIALIZER(pool, pool_size);
+}
+
+int sys_bptree_insert(struct sys_bptree *tree, uint64_t key, void *value)
+{
+	struct sys_bptree_node *node = tree->root;
+	uint16_t i;
+	int ret;
+
+	if (node == NULL) {
+		node = node_alloc(tree, true);
+		if (node == NULL) {
+			return -ENOMEM;
+		}
+
+		tree->root = node;
+	} else if (node->n_keys == MAX_KEYS) {
+		node = node_alloc(tree, false);
+		if (node == NULL) {
+			return -ENOMEM;
+		}
+
+		node->children[0] = tree->root;
+		ret = split_child(tree, node, 0);
+		if (ret < 0) {
+			node_free(tree, node);
+			return ret;
+		}
+
+		tree->root = node;
+	}
+
+	while (!node->leaf) {
+		i = upper_bound(node, key);
+
+		if (node->children[i]->n_keys == MAX_KEYS) {
+			ret = split_child(tree, node, i);
+			if (ret < 0) {
+				return ret;
+			}
+
+			if (key >= node->keys[i]) {
+				++i;
+			}
+		}
+
+		node = node->children[i];
+	}
+
+	i = lower_bound(node, key);
+	if (i < node->n_keys && node->keys[i] == key) {
+		return -EEXIST;
+	}
+
+	memmove(&node->keys[i + 1], &node->keys[i], (node->n_keys - i) * sizeof(uint64_t));
+	memmove(&node->values[i + 1], &node->values[i], (node->n_keys - i) * sizeof(void *));
+	node->keys[i] = key;
+	node->values[i] = value;
+	++node->n_keys;
+	++tree->size;
+
+	return 0;
+}
+
+bool sys_bptree_remove(struct sys_bptree *tree, uint64_t key, void **value)
+{
+	struct sys_bptree_node *node = tree->root;
+	struct sys_bptree_node *child;
+	uint16_t i;
+
+	if (node == NULL) {
+		return false;
+	}
+
+	while (!node->leaf) {
+		i = upper_bound(node, key);
+		child = node->children[i];
+
+		if (child->n_keys == MIN_KEYS) {
+			child = refill_child(tree, node, i);
+
+			if (node->n_keys == 0) {
+				/* the last two children of the root were merged */
+				__ASSERT_NO_MSG(node == tree->root);
+				tree->root = child;
+				node_free(tree, node);
+			}
+		}
+
+		node = child;
+	}
+
+	i = lower_bound(node, key);
+	if (i == node->n_keys || node->keys[i] != key) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = node->values[i];
+	}
+
+	memmove(&node->keys[i], &node->keys[i + 1], (node->n_keys - i - 1) * sizeof(uint64_t));
+	memmove(&node->values[i], &node->values[i + 1], (node->n_keys - i - 1) * sizeof(void *));
+	--node->n_keys;
+	--tree->size;
+
+	if (node->n_keys == 0) {
+		__ASSERT_NO_MSG(node == tree->root);
+		tree->root = NULL;
+		node_free(tree, node);
+	}
+
+	return true;
+}
+
+bool sys_bptree_get(const struct sys_bptree *tree, uint64_t key, void **value)
+{
+	const struct sys_bptree_node *leaf = find_leaf(tree, key);
+	uint16_t i;
+
+	if (leaf == NULL) {
+		return false;
+	}
+
+	i = lower_bound(leaf, key);
+	if (i == leaf->n_keys || leaf->keys[i] != key) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = leaf->values[i];
+	}
+
+	return true;
+}
+
+void sys_bptree_first(const struct sys_bptree *tree, struct sys_bptree_iter *it)
+{
+	const struct sys_bptree_node *node = tree->root;
+
+	while (node != NULL && !node->leaf) {
+		node = node->children[0];
+	}
+
+	it->node = node;
+	it->pos = 0;
+}
+
+void sys_bptree_lower_bound(const struct sys_bptree *tree, uint64_t key,
+			    struct sys_bptree_iter *it)
+{
+	it->node = find_leaf(tree, key);
+	it->pos = (it->node != NULL) ? lower_bound(it->node, key) : 0;
+}
+
+bool sys_bptree_iter_next(struct sys_bptree_iter *it, uint64_t *key, void **value)
+{
+	while (it->node != NULL && it->pos >= it->node->n_keys) {
+		it->node = it->node->next;
+		it->pos = 0;
+	}
+
+	if (it->node == NULL) {
+		return false;
+	}
+
+	if (key != NULL) {
+		*key = it->node->keys[it->pos];
+	}
+
+	if (value != NULL) {
+		*value = it->node->values[it->pos];
+	}
+
+	++it->pos;
+
+	return true;
+}
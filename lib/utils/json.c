@@ -1081,11 +1081,49 @@ static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val)
 	return -EINVAL;
 }
 
+static inline bool field_matches(const struct json_obj_descr *descr,
+				 const struct json_obj_key_value *kv)
+{
+	size_t len = descr->field_name_len;
+
+	/* Field names often share a prefix, compare their last character first */
+	return kv->key_len == len &&
+	       (len == 0 || kv->key[len - 1] == descr->field_name[len - 1]) &&
+	       memcmp(kv->key, descr->field_name, len) == 0;
+}
+
+static size_t find_field(const struct json_obj_descr *descr, size_t descr_len,
+			 int64_t decoded_fields, const struct json_obj_key_value *kv,
+			 size_t hint)
+{
+	size_t i;
+
+	/* Documents usually list their fields in descriptor order, so start
+	 * looking right after the last field found: this makes the lookup
+	 * constant time for such documents, whatever the descriptor size.
+	 * Fields that have been decoded already are skipped.
+	 */
+	for (i = hint; i < descr_len; i++) {
+		if (!(decoded_fields & ((int64_t)1 << i)) && field_matches(&descr[i], kv)) {
+			return i;
+		}
+	}
+
+	for (i = 0; i < hint; i++) {
+		if (!(decoded_fields & ((int64_t)1 << i)) && field_matches(&descr[i], kv)) {
+			return i;
+		}
+	}
+
+	return descr_len;
+}
+
 static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
 			 size_t descr_len, void *val)
 {
 	struct json_obj_key_value kv;
 	int64_t decoded_fields = 0;
+	size_t hint = 0;
 	size_t i;
 	int ret;
 
@@ -1094,34 +1132,7 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
-
-			/* Field has been decoded already, skip */
-			if (decoded_fields & ((int64_t)1 << i)) {
-				continue;
-			}
-
-			/* Check if it's the i-th field */
-			if (kv.key_len != descr[i].field_name_len) {
-				continue;
-			}
-
-			if (memcmp(kv.key, descr[i].field_name,
-				   descr[i].field_name_len)) {
-				continue;
-			}
-
-			/* Store the decoded value */
-			ret = decode_value(obj, &descr[i], &kv.value,
-					   decode_field, val);
-			if (ret < 0) {
-				return ret;
-			}
-
-			decoded_fields |= (int64_t)1<<i;
-			break;
-		}
+		i = find_field(descr, descr_len, decoded_fields, &kv, hint);
 
 		/* Skip field, if no descriptor was found */
 		if (i >= descr_len) {
@@ -1129,7 +1140,19 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			if (ret < 0) {
 				return ret;
 			}
+
+			continue;
+		}
+
+		/* Store the decoded value */
+		ret = decode_value(obj, &descr[i], &kv.value,
+				   (char *)val + descr[i].offset, val);
+		if (ret < 0) {
+			return ret;
 		}
+
+		decoded_fields |= (int64_t)1<<i;
+		hint = (i + 1 < descr_len) ? i + 1 : 0;
 	}
 
 	return -EINVAL;
@@ -1233,15 +1256,23 @@ static int json_escape_internal(const char *str,
 	}
 
 	for (cur = str; ret == 0 && *cur; cur++) {
-		char escaped = escape_as(*cur);
+		const char *run = cur;
+		char bytes[2] = { '\\' };
 
-		if (escaped) {
-			char bytes[2] = { '\\', escaped };
+		/* Append runs of characters not needing escaping at once */
+		while (*cur != '\0' && escape_as(*cur) == 0) {
+			cur++;
+		}
 
-			ret = append_bytes(bytes, 2, data);
-		} else {
-			ret = append_bytes(cur, 1, data);
+		if (cur != run) {
+			ret = append_bytes(run, cur - run, data);
+			if (ret != 0 || *cur == '\0') {
+				break;
+			}
 		}
+
+		bytes[1] = escape_as(*cur);
+		ret = append_bytes(bytes, 2, data);
 	}
 
 	return ret;
@@ -1667,6 +1698,49 @@ static int encode(const struct json_obj_descr *descr, const void *val,
 	}
 }
 
+/* Encode the separator and the quoted key preceding a field value */
+static int key_encode(const struct json_obj_descr *descr, bool first,
+		      json_append_bytes_t append_bytes, void *data)
+{
+	/* Field names are at most 127 characters long */
+	char buf[sizeof(",\"\":") + BIT_MASK(7)];
+	size_t len = 0;
+	int ret;
+
+	if (!first) {
+		buf[len++] = ',';
+	}
+
+	for (size_t i = 0; i < descr->field_name_len; i++) {
+		if (escape_as(descr->field_name[i]) != 0) {
+			goto escape;
+		}
+	}
+
+	buf[len++] = '"';
+	memcpy(&buf[len], descr->field_name, descr->field_name_len);
+	len += descr->field_name_len;
+	buf[len++] = '"';
+	buf[len++] = ':';
+
+	return append_bytes(buf, len, data);
+
+escape:
+	if (!first) {
+		ret = append_bytes(",", 1, data);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	ret = str_encode(descr->field_name, append_bytes, data);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return append_bytes(":", 1, data);
+}
+
 int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 		    const void *val, json_append_bytes_t append_bytes,
 		    void *data)
@@ -1680,12 +1754,7 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 	}
 
 	for (i = 0; i < descr_len; i++) {
-		ret = str_encode(descr[i].field_name, append_bytes, data);
-		if (ret < 0) {
-			return ret;
-		}
-
-		ret = append_bytes(":", 1, data);
+		ret = key_encode(&descr[i], i == 0, append_bytes, data);
 		if (ret < 0) {
 			return ret;
 		}
@@ -1694,13 +1763,6 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 		if (ret < 0) {
 			return ret;
 		}
-
-		if (i < descr_len - 1) {
-			ret = append_bytes(",", 1, data);
-			if (ret < 0) {
-				return ret;
-			}
-		}
 	}
 
 	return append_bytes("}", 1, data);
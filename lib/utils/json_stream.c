@@ -0,0 +1,616 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <string.h>
+#include <zephyr/data/json.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+/* Parser states. The token states must stay contiguous, see in_token(). */
+enum {
+	STATE_VALUE,
+	STATE_VALUE_OR_END,
+	STATE_KEY,
+	STATE_KEY_OR_END,
+	STATE_COLON,
+	STATE_NEXT,
+	STATE_DONE,
+	STATE_STRING,
+	STATE_ESCAPE,
+	STATE_UNICODE,
+	STATE_NUMBER,
+	STATE_LITERAL,
+};
+
+/* The key of the value being parsed is known */
+#define FLAG_KEY        BIT(0)
+/* The key has been copied to the token buffer */
+#define FLAG_KEY_IN_BUF BIT(1)
+/* The token being parsed started in a previous chunk */
+#define FLAG_TOK_IN_BUF BIT(2)
+/* The string being parsed is an object key */
+#define FLAG_IS_KEY     BIT(3)
+
+static inline bool in_token(const struct json_stream_parser *p)
+{
+	return p->state >= STATE_STRING;
+}
+
+static inline bool in_object(const struct json_stream_parser *p)
+{
+	return (p->objects & BIT(p->depth - 1)) != 0;
+}
+
+static inline bool is_space(char chr)
+{
+	return chr == ' ' || chr == '\n' || chr == '\r' || chr == '\t';
+}
+
+static inline bool is_number(char chr)
+{
+	return (chr >= '0' && chr <= '9') || chr == '.' || chr == 'e' || chr == 'E' ||
+	       chr == '+' || chr == '-';
+}
+
+static int buf_append(struct json_stream_parser *p, const char *data, size_t len)
+{
+	if (len == 0) {
+		return 0;
+	}
+
+	if (len > p->buf_size - p->buf_len) {
+		return -ENOMEM;
+	}
+
+	memcpy(p->buf + p->buf_len, data, len);
+	p->buf_len += len;
+
+	return 0;
+}
+
+static int emit(struct json_stream_parser *p, enum json_tokens type, const char *value,
+		size_t value_len)
+{
+	struct json_stream_token tok = {
+		.type = type,
+		.value = value,
+		.value_len = value_len,
+	};
+
+	if ((p->flags & FLAG_KEY) != 0) {
+		tok.key = p->key;
+		tok.key_len = p->key_len;
+	}
+
+	p->flags &= ~(FLAG_KEY | FLAG_KEY_IN_BUF);
+	p->buf_len = 0;
+
+	return p->cb(&tok, p->user_data);
+}
+
+static void value_done(struct json_stream_parser *p)
+{
+	p->state = p->depth > 0 ? STATE_NEXT : STATE_DONE;
+}
+
+static int container_start(struct json_stream_parser *p, enum json_tokens type)
+{
+	if (p->depth == JSON_STREAM_MAX_DEPTH) {
+		return -ENOMEM;
+	}
+
+	WRITE_BIT(p->objects, p->depth, type == JSON_TOK_OBJECT_START);
+	p->depth++;
+	p->state = type == JSON_TOK_OBJECT_START ? STATE_KEY_OR_END : STATE_VALUE_OR_END;
+
+	return emit(p, type, NULL, 0);
+}
+
+static int container_end(struct json_stream_parser *p, enum json_tokens type)
+{
+	p->depth--;
+	value_done(p);
+
+	return emit(p, type, NULL, 0);
+}
+
+static int token_start(struct json_stream_parser *p, uint8_t state, const char *lit)
+{
+	p->state = state;
+	p->lit = lit;
+	p->count = 1;
+
+	return 0;
+}
+
+static int value_start(struct json_stream_parser *p, char chr)
+{
+	switch (chr) {
+	case '{':
+		return container_start(p, JSON_TOK_OBJECT_START);
+	case '[':
+		return container_start(p, JSON_TOK_ARRAY_START);
+	case '"':
+		p->flags &= ~FLAG_IS_KEY;
+		return token_start(p, STATE_STRING, NULL);
+	case 't':
+		return token_start(p, STATE_LITERAL, "true");
+	case 'f':
+		return token_start(p, STATE_LITERAL, "false");
+	case 'n':
+		return token_start(p, STATE_LITERAL, "null");
+#ifdef CONFIG_JSON_LIBRARY_FP_SUPPORT
+	case 'N':
+		return token_start(p, STATE_LITERAL, "NaN");
+	case 'I':
+		return token_start(p, STATE_LITERAL, "Infinity");
+#endif
+	case '-':
+		return token_start(p, STATE_NUMBER, NULL);
+	default:
+		if (chr >= '0' && chr <= '9') {
+			return token_start(p, STATE_NUMBER, NULL);
+		}
+
+		return -EINVAL;
+	}
+}
+
+/* Complete the token whose last chunk is [tok, pos) */
+static int token_end(struct json_stream_parser *p, enum json_tokens type, const char *tok,
+		     const char *pos)
+{
+	const char *value = tok;
+	size_t len = pos - tok;
+	bool buffered = (p->flags & FLAG_TOK_IN_BUF) != 0;
+	int ret;
+
+	if (buffered) {
+		ret = buf_append(p, tok, len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		value = p->buf + p->tok_off;
+		len = p->buf_len - p->tok_off;
+		p->flags &= ~FLAG_TOK_IN_BUF;
+	}
+
+	if (type == JSON_TOK_STRING && (p->flags & FLAG_IS_KEY) != 0) {
+		p->key = value;
+		p->key_len = len;
+		p->flags = (p->flags & ~FLAG_IS_KEY) | FLAG_KEY;
+		if (buffered) {
+			p->flags |= FLAG_KEY_IN_BUF;
+		}
+		p->state = STATE_COLON;
+
+		return 0;
+	}
+
+	if (type == JSON_TOK_NUMBER && len == 1 && value[0] == '-') {
+		return -EINVAL;
+	}
+
+	value_done(p);
+
+	return emit(p, type, value, len);
+}
+
+static enum json_tokens literal_type(const char *lit)
+{
+	switch (lit[0]) {
+	case 't':
+		return JSON_TOK_TRUE;
+	case 'f':
+		return JSON_TOK_FALSE;
+	case 'n':
+		return JSON_TOK_NULL;
+	default:
+		return JSON_TOK_NUMBER;
+	}
+}
+
+static int structural(struct json_stream_parser *p, char chr)
+{
+	switch (p->state) {
+	case STATE_VALUE_OR_END:
+		if (chr == ']') {
+			return container_end(p, JSON_TOK_ARRAY_END);
+		}
+		__fallthrough;
+	case STATE_VALUE:
+		return value_start(p, chr);
+	case STATE_KEY_OR_END:
+		if (chr == '}') {
+			return container_end(p, JSON_TOK_OBJECT_END);
+		}
+		__fallthrough;
+	case STATE_KEY:
+		if (chr != '"') {
+			return -EINVAL;
+		}
+
+		p->flags |= FLAG_IS_KEY;
+		return token_start(p, STATE_STRING, NULL);
+	case STATE_COLON:
+		if (chr != ':') {
+			return -EINVAL;
+		}
+
+		p->state = STATE_VALUE;
+		return 0;
+	case STATE_NEXT:
+		if (chr == ',') {
+			p->state = in_object(p) ? STATE_KEY : STATE_VALUE;
+			return 0;
+		}
+
+		if (chr == '}' && in_object(p)) {
+			return container_end(p, JSON_TOK_OBJECT_END);
+		}
+
+		if (chr == ']' && !in_object(p)) {
+			return container_end(p, JSON_TOK_ARRAY_END);
+		}
+
+		return -EINVAL;
+	default:
+		return -EINVAL;
+	}
+}
+
+/* Move the state that refers to the chunk being consumed to the token buffer */
+static int save_chunk(struct json_stream_parser *p, const char *tok, const char *end)
+{
+	int ret;
+
+	if ((p->flags & (FLAG_KEY | FLAG_KEY_IN_BUF)) == FLAG_KEY) {
+		__ASSERT_NO_MSG(p->buf_len == 0);
+
+		ret = buf_append(p, p->key, p->key_len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		p->key = p->buf;
+		p->flags |= FLAG_KEY_IN_BUF;
+	}
+
+	if (!in_token(p)) {
+		return 0;
+	}
+
+	if ((p->flags & FLAG_TOK_IN_BUF) == 0) {
+		p->tok_off = p->buf_len;
+		p->flags |= FLAG_TOK_IN_BUF;
+	}
+
+	return buf_append(p, tok, end - tok);
+}
+
+void json_stream_init(struct json_stream_parser *parser, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data)
+{
+	*parser = (struct json_stream_parser){
+		.cb = cb,
+		.user_data = user_data,
+		.buf = buf,
+		.buf_size = buf != NULL ? buf_size : 0,
+		.state = STATE_VALUE,
+	};
+}
+
+int json_stream_feed(struct json_stream_parser *parser, const char *data, size_t len)
+{
+	struct json_stream_parser *p = parser;
+	const char *pos = data;
+	const char *end = data + len;
+	const char *tok = data;
+	int ret = 0;
+
+	if (p->err != 0) {
+		return p->err;
+	}
+
+	while (pos < end && ret == 0) {
+		switch (p->state) {
+		case STATE_STRING:
+			while (pos < end && *pos != '"' && *pos != '\\') {
+				pos++;
+			}
+
+			if (pos == end) {
+				break;
+			}
+
+			if (*pos == '\\') {
+				p->state = STATE_ESCAPE;
+			} else {
+				ret = token_end(p, JSON_TOK_STRING, tok, pos);
+			}
+			pos++;
+			break;
+		case STATE_ESCAPE:
+			switch (*pos) {
+			case '"':
+			case '\\':
+			case '/':
+			case 'b':
+			case 'f':
+			case 'n':
+			case 'r':
+			case 't':
+				p->state = STATE_STRING;
+				break;
+			case 'u':
+				p->state = STATE_UNICODE;
+				p->count = 4;
+				break;
+			default:
+				ret = -EINVAL;
+				break;
+			}
+			pos++;
+			break;
+		case STATE_UNICODE:
+			if (isxdigit((unsigned char)*pos) == 0) {
+				ret = -EINVAL;
+			} else if (--p->count == 0) {
+				p->state = STATE_STRING;
+			}
+			pos++;
+			break;
+		case STATE_NUMBER:
+			while (pos < end && is_number(*pos)) {
+				pos++;
+			}
+
+			if (pos == end) {
+				break;
+			}
+
+#ifdef CONFIG_JSON_LIBRARY_FP_SUPPORT
+			if (*pos == 'I' && pos - tok +
+			    ((p->flags & FLAG_TOK_IN_BUF) != 0 ? p->buf_len - p->tok_off : 0) == 1) {
+				p->state = STATE_LITERAL;
+				p->lit = "-Infinity";
+				p->count = 1;
+				break;
+			}
+#endif
+			/* The terminating character is processed by the next state */
+			ret = token_end(p, JSON_TOK_NUMBER, tok, pos);
+			break;
+		case STATE_LITERAL:
+			if (*pos != p->lit[p->count]) {
+				ret = -EINVAL;
+				break;
+			}
+
+			pos++;
+			if (p->lit[++p->count] == '\0') {
+				ret = token_end(p, literal_type(p->lit), tok, pos);
+			}
+			break;
+		default:
+			if (is_space(*pos)) {
+				pos++;
+				break;
+			}
+
+			ret = structural(p, *pos);
+			pos++;
+			/* Strings start after the quote */
+			tok = p->state == STATE_STRING ? pos : pos - 1;
+			break;
+		}
+	}
+
+	/* Without a token buffer the document is fed in one chunk, a number
+	 * running up to its end is complete and cannot be saved anyway.
+	 */
+	if (ret == 0 && p->buf == NULL && p->state == STATE_NUMBER && p->depth == 0) {
+		ret = token_end(p, JSON_TOK_NUMBER, tok, end);
+	}
+
+	if (ret == 0) {
+		ret = save_chunk(p, tok, end);
+	}
+
+	p->err = ret;
+
+	return ret;
+}
+
+int json_stream_finish(struct json_stream_parser *parser)
+{
+	static const char empty[1];
+	int ret;
+
+	if (parser->err != 0) {
+		return parser->err;
+	}
+
+	if (parser->state == STATE_NUMBER) {
+		ret = token_end(parser, JSON_TOK_NUMBER, empty, empty);
+		if (ret < 0) {
+			parser->err = ret;
+			return ret;
+		}
+	}
+
+	return parser->state == STATE_DONE ? 0 : -EINVAL;
+}
+
+#define TAPE_PAYLOAD_MAX 0xffffffU
+#define TAPE_NONE        TAPE_PAYLOAD_MAX
+
+#define TAPE_ENTRY(type, payload) ((uint32_t)(type) | ((uint32_t)(payload) << 8))
+#define TAPE_TYPE(entry)          ((enum json_tokens)((entry) & 0xff))
+#define TAPE_PAYLOAD(entry)       ((entry) >> 8)
+
+void json_tape_init(struct json_tape *tape, uint32_t *entries, size_t max_entries,
+		    char *strings, size_t strings_size)
+{
+	*tape = (struct json_tape){
+		.entries = entries,
+		.max_entries = MIN(max_entries, TAPE_PAYLOAD_MAX),
+		.strings = strings,
+		.strings_size = MIN(strings_size, TAPE_PAYLOAD_MAX),
+		.open = TAPE_NONE,
+	};
+}
+
+static int tape_push(struct json_tape *tape, enum json_tokens type, uint32_t payload)
+{
+	if (tape->len == tape->max_entries) {
+		return -ENOMEM;
+	}
+
+	tape->entries[tape->len++] = TAPE_ENTRY(type, payload);
+
+	return 0;
+}
+
+static int tape_push_str(struct json_tape *tape, enum json_tokens type, const char *str,
+			 size_t len)
+{
+	size_t off = tape->strings_len;
+	int ret;
+
+	if (len >= tape->strings_size - off) {
+		return -ENOMEM;
+	}
+
+	ret = tape_push(tape, type, off);
+	if (ret < 0) {
+		return ret;
+	}
+
+	memcpy(tape->strings + off, str, len);
+	tape->strings[off + len] = '\0';
+	tape->strings_len += len + 1;
+
+	return 0;
+}
+
+int json_tape_stream_cb(const struct json_stream_token *tok, void *user_data)
+{
+	struct json_tape *tape = user_data;
+	uint32_t start;
+	int ret;
+
+	if (tok->key != NULL) {
+		ret = tape_push_str(tape, JSON_TOK_STRING, tok->key, tok->key_len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	switch (tok->type) {
+	case JSON_TOK_OBJECT_START:
+	case JSON_TOK_ARRAY_START:
+		/* Link open containers through the payload until they are closed */
+		start = tape->len;
+		ret = tape_push(tape, tok->type, tape->open);
+		if (ret == 0) {
+			tape->open = start;
+		}
+
+		return ret;
+	case JSON_TOK_OBJECT_END:
+	case JSON_TOK_ARRAY_END:
+		start = tape->open;
+		ret = tape_push(tape, tok->type, start);
+		if (ret == 0) {
+			tape->open = TAPE_PAYLOAD(tape->entries[start]);
+			tape->entries[start] = TAPE_ENTRY(TAPE_TYPE(tape->entries[start]),
+							  tape->len - 1);
+		}
+
+		return ret;
+	case JSON_TOK_STRING:
+	case JSON_TOK_NUMBER:
+		return tape_push_str(tape, tok->type, tok->value, tok->value_len);
+	default:
+		return tape_push(tape, tok->type, 0);
+	}
+}
+
+enum json_tokens json_tape_type(const struct json_tape *tape, size_t idx)
+{
+	if (idx >= tape->len) {
+		return JSON_TOK_EOF;
+	}
+
+	return TAPE_TYPE(tape->entries[idx]);
+}
+
+const char *json_tape_str(const struct json_tape *tape, size_t idx)
+{
+	switch (json_tape_type(tape, idx)) {
+	case JSON_TOK_STRING:
+	case JSON_TOK_NUMBER:
+		return tape->strings + TAPE_PAYLOAD(tape->entries[idx]);
+	default:
+		return NULL;
+	}
+}
+
+size_t json_tape_next(const struct json_tape *tape, size_t idx)
+{
+	switch (json_tape_type(tape, idx)) {
+	case JSON_TOK_OBJECT_START:
+	case JSON_TOK_ARRAY_START:
+		return TAPE_PAYLOAD(tape->entries[idx]) + 1;
+	default:
+		return idx + 1;
+	}
+}
+
+int json_tape_obj_get(const struct json_tape *tape, size_t obj, const char *key, size_t *idx)
+{
+	size_t i;
+
+	if (json_tape_type(tape, obj) != JSON_TOK_OBJECT_START) {
+		return -EINVAL;
+	}
+
+	for (i = obj + 1; json_tape_type(tape, i) == JSON_TOK_STRING;
+	     i = json_tape_next(tape, i + 1)) {
+		if (strcmp(json_tape_str(tape, i), key) == 0) {
+			*idx = i + 1;
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+int json_tape_arr_get(const struct json_tape *tape, size_t arr, size_t n, size_t *idx)
+{
+	size_t i;
+
+	if (json_tape_type(tape, arr) != JSON_TOK_ARRAY_START) {
+		return -EINVAL;
+	}
+
+	for (i = arr + 1; n > 0 && i < tape->len && json_tape_type(tape, i) != JSON_TOK_ARRAY_END;
+	     n--) {
+		i = json_tape_next(tape, i);
+	}
+
+	if (i >= tape->len || json_tape_type(tape, i) == JSON_TOK_ARRAY_END) {
+		return -ENOENT;
+	}
+
+	*idx = i;
+
+	return 0;
+}
@@ -16,6 +16,11 @@
 #define SEQUENCE_LEN_3_BYTE 0xE0
 #define SEQUENCE_LEN_4_BYTE 0xF0
 #define MSB_SET 0x80
+#define CONTINUATION_MIN 0x80
+#define CONTINUATION_MAX 0xBF
+
+/* MSB_SET in every byte of a word */
+#define MSB_SET_WORD ((uintptr_t)0x8080808080808080ULL)
 
 char *utf8_trunc(char *utf8_str)
 {
@@ -124,3 +129,72 @@ int utf8_count_chars(const char *s)
 
 	return count;
 }
+
+bool utf8_validate(const char *s, size_t n)
+{
+	const uint8_t *p = (const uint8_t *)s;
+	const uint8_t *end = p + n;
+
+	while (p < end) {
+		uint8_t lo = CONTINUATION_MIN;
+		uint8_t hi = CONTINUATION_MAX;
+		size_t len;
+
+		/* Skip runs of ASCII characters a word at a time */
+		while ((size_t)(end - p) >= sizeof(uintptr_t)) {
+			uintptr_t word;
+
+			memcpy(&word, p, sizeof(word));
+			if ((word & MSB_SET_WORD) != 0U) {
+				break;
+			}
+			p += sizeof(word);
+		}
+
+		if (p == end) {
+			break;
+		}
+
+		if (*p <= ASCII_CHAR) {
+			p++;
+			continue;
+		}
+
+		/* The ranges of the second byte exclude overlong encodings,
+		 * surrogates and code points above U+10FFFF.
+		 */
+		if (*p >= 0xC2 && *p <= 0xDF) {
+			len = 2;
+		} else if (*p >= 0xE0 && *p <= 0xEF) {
+			len = 3;
+			if (*p == 0xE0) {
+				lo = 0xA0;
+			} else if (*p == 0xED) {
+				hi = 0x9F;
+			}
+		} else if (*p >= 0xF0 && *p <= 0xF4) {
+			len = 4;
+			if (*p == 0xF0) {
+				lo = 0x90;
+			} else if (*p == 0xF4) {
+				hi = 0x8F;
+			}
+		} else {
+			return false;
+		}
+
+		if ((size_t)(end - p) < len || p[1] < lo || p[1] > hi) {
+			return false;
+		}
+
+		for (size_t i = 2; i < len; i++) {
+			if ((p[i] & SEQUENCE_FIRST_MASK) != MSB_SET) {
+				return false;
+			}
+		}
+
+		p += len;
+	}
+
+	return true;
+}
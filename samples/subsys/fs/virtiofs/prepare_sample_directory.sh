@@ -9,3 +9,4 @@ echo "a" > dir2/a
 echo "bb" > dir2/b
 echo "ccc" > dir2/c
 echo "this is a file on the host" > file
+head -c 1048576 /dev/urandom > big_file
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 #include <zephyr/device.h>
@@ -111,6 +112,88 @@ void print_file(const char *path)
 	}
 }
 
+#ifdef CONFIG_SAMPLE_VIRTIOFS_BENCHMARK
+static int walk_tree(const char *path)
+{
+	struct fs_dir_t dir;
+	struct fs_dirent entry;
+	char entry_path[128];
+	int count = 0;
+
+	fs_dir_t_init(&dir);
+	if (fs_opendir(&dir, path) != 0) {
+		return 0;
+	}
+
+	while (fs_readdir(&dir, &entry) == 0 && entry.name[0] != '\0') {
+		snprintf(entry_path, sizeof(entry_path), "%s/%s", path, entry.name);
+		count++;
+
+		if (entry.type == FS_DIR_ENTRY_DIR) {
+			count += walk_tree(entry_path);
+		} else {
+			/* like ls -l, stat every file found */
+			fs_stat(entry_path, &entry);
+		}
+	}
+
+	fs_closedir(&dir);
+
+	return count;
+}
+
+static ssize_t read_file(const char *path)
+{
+	static uint8_t chunk[CONFIG_SAMPLE_VIRTIOFS_BENCHMARK_CHUNK];
+	struct fs_file_t file;
+	ssize_t total = 0;
+	ssize_t read_c;
+
+	fs_file_t_init(&file);
+	if (fs_open(&file, path, FS_O_READ) != 0) {
+		return -1;
+	}
+
+	while ((read_c = fs_read(&file, chunk, sizeof(chunk))) > 0) {
+		total += read_c;
+	}
+
+	fs_close(&file);
+
+	return total;
+}
+
+static void benchmark(void)
+{
+	int64_t start;
+	int entries = 0;
+	ssize_t size = 0;
+
+	start = k_uptime_get();
+	for (int i = 0; i < CONFIG_SAMPLE_VIRTIOFS_BENCHMARK_ROUNDS; i++) {
+		entries = walk_tree(MOUNT_POINT);
+	}
+	printf(
+		"directory walk: %d entries, %" PRId64 " ms per round\n", entries,
+		(k_uptime_get() - start) / CONFIG_SAMPLE_VIRTIOFS_BENCHMARK_ROUNDS
+	);
+
+	start = k_uptime_get();
+	for (int i = 0; i < CONFIG_SAMPLE_VIRTIOFS_BENCHMARK_ROUNDS; i++) {
+		size = read_file(MOUNT_POINT"/big_file");
+	}
+	if (size < 0) {
+		printf("failed to read %s\n", MOUNT_POINT"/big_file");
+		return;
+	}
+	printf(
+		"sequential read: %zd bytes in %d byte chunks, %" PRId64 " ms per round\n", size,
+		CONFIG_SAMPLE_VIRTIOFS_BENCHMARK_CHUNK,
+		(k_uptime_get() - start) / CONFIG_SAMPLE_VIRTIOFS_BENCHMARK_ROUNDS
+	);
+}
+#endif /* CONFIG_SAMPLE_VIRTIOFS_BENCHMARK */
+
 int main(void)
 {
 	if (fs_mount(&mp) == 0) {
@@ -125,6 +208,11 @@ int main(void)
 		create_file("/virtiofs/second_file_created_by_zephyr", "lorem ipsum\n");
 
 		fs_mkdir("/virtiofs/dir_created_by_zephyr");
+
+#ifdef CONFIG_SAMPLE_VIRTIOFS_BENCHMARK
+		printf("\n");
+		benchmark();
+#endif
 	} else {
 		printf("failed to mount %s\n", MOUNT_POINT);
 	}
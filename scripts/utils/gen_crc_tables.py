@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+Utility script to generate the lookup tables of the software CRC
+implementations in subsys/crc:
+
+- crc32_ieee_table, slicing-by-8 tables for CRC-32 (IEEE), reflected 0xEDB88320
+- crc32c_table, slicing-by-8 tables for CRC-32C (Castagnoli), reflected 0x82F63B78
+- crc16_ccitt_table, byte table for CRC-16 (CCITT), reflected 0x8408
+- crc16_itu_t_table, byte table for CRC-16 (ITU-T), 0x1021
+
+Only the slices needed by the selected CONFIG_CRC_SW_* option are compiled in,
+tables a source file does not use are discarded by the compiler.
+
+.. note::
+    The script writes the header to stdout, it should be redirected to
+    $ZEPHYR_BASE/subsys/crc/crc_tables.h.
+
+Usage::
+
+    python $ZEPHYR_BASE/scripts/utils/gen_crc_tables.py > subsys/crc/crc_tables.h
+
+Copyright (c) 2025 The Zephyr Project Contributors
+SPDX-License-Identifier: Apache-2.0
+"""
+
+import sys
+
+SLICES = 8
+PER_LINE = 6
+
+HEADER = """\
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generated by scripts/utils/gen_crc_tables.py, do not edit. */
+
+#ifndef ZEPHYR_SUBSYS_CRC_CRC_TABLES_H_
+#define ZEPHYR_SUBSYS_CRC_CRC_TABLES_H_
+
+#include <stdint.h>
+
+#if defined(CONFIG_CRC_SW_SLICE_BY_8)
+#define CRC_SW_SLICES 8
+#elif defined(CONFIG_CRC_SW_SLICE_BY_4)
+#define CRC_SW_SLICES 4
+#else
+#define CRC_SW_SLICES 1
+#endif
+"""
+
+FOOTER = """
+#endif /* ZEPHYR_SUBSYS_CRC_CRC_TABLES_H_ */
+"""
+
+
+def reflected_table(poly, width):
+    table = []
+    for i in range(256):
+        crc = i
+        for _ in range(8):
+            crc = (crc >> 1) ^ (poly if crc & 1 else 0)
+        table.append(crc)
+    return table
+
+
+def normal_table(poly, width):
+    top = 1 << (width - 1)
+    mask = (1 << width) - 1
+    table = []
+    for i in range(256):
+        crc = i << (width - 8)
+        for _ in range(8):
+            crc = ((crc << 1) ^ (poly if crc & top else 0)) & mask
+        table.append(crc)
+    return table
+
+
+def reflected_slices(poly, width):
+    """Slice n gives the CRC of a byte followed by n zero bytes."""
+    slices = [reflected_table(poly, width)]
+    for _ in range(1, SLICES):
+        prev = slices[-1]
+        slices.append([(c >> 8) ^ slices[0][c & 0xFF] for c in prev])
+    return slices
+
+
+def write_values(out, values, width, indent):
+    digits = width // 4
+    for i in range(0, len(values), PER_LINE):
+        line = ", ".join(f"0x{v:0{digits}x}U" for v in values[i:i + PER_LINE])
+        out.write(f"{indent}{line},\n")
+
+
+def write_sliced(out, name, poly, width):
+    slices = reflected_slices(poly, width)
+    out.write(f"\n/* Polynomial 0x{poly:08x} (reflected) */\n")
+    out.write(f"static const uint32_t {name}[CRC_SW_SLICES][256] = {{\n")
+    for n, table in enumerate(slices):
+        if n == 1:
+            out.write("#if CRC_SW_SLICES > 1\n")
+        elif n == 4:
+            out.write("#if CRC_SW_SLICES > 4\n")
+        out.write("\t{\n")
+        write_values(out, table, width, "\t\t")
+        out.write("\t},\n")
+        if n == 3 or n == SLICES - 1:
+            out.write("#endif\n")
+    out.write("};\n")
+
+
+def write_byte(out, name, table, poly, width, reflected):
+    kind = " (reflected)" if reflected else ""
+    out.write(f"\n/* Polynomial 0x{poly:04x}{kind} */\n")
+    out.write(f"static const uint16_t {name}[256] = {{\n")
+    write_values(out, table, width, "\t")
+    out.write("};\n")
+
+
+def main():
+    out = sys.stdout
+    out.write(HEADER)
+
+    write_sliced(out, "crc32_ieee_table", 0xEDB88320, 32)
+    write_sliced(out, "crc32c_table", 0x82F63B78, 32)
+    write_byte(out, "crc16_ccitt_table", reflected_table(0x8408, 16), 0x8408, 16, True)
+    write_byte(out, "crc16_itu_t_table", normal_table(0x1021, 16), 0x1021, 16, False)
+
+    out.write(FOOTER)
+
+
+if __name__ == "__main__":
+    main()
@@ -6,6 +6,8 @@
 
 #include <zephyr/sys/crc.h>
 
+#include "crc_sw.h"
+
 uint16_t __weak crc16(uint16_t poly, uint16_t seed, const uint8_t *src, size_t len)
 {
 	uint16_t crc = seed;
@@ -48,6 +50,13 @@ uint16_t __weak crc16_reflect(uint16_t poly, uint16_t seed, const uint8_t *src,
 
 uint16_t __weak crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 {
+#if CRC_SW_BYTE_TABLES
+	for (; len > 0; len--, src++) {
+		seed = (seed >> 8) ^ crc16_ccitt_table[(seed ^ *src) & 0xff];
+	}
+
+	return seed;
+#else
 	for (; len > 0; len--) {
 		uint8_t e, f;
 
@@ -58,10 +67,18 @@ uint16_t __weak crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 	}
 
 	return seed;
+#endif
 }
 
 uint16_t __weak crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
 {
+#if CRC_SW_BYTE_TABLES
+	for (; len > 0; len--, src++) {
+		seed = (seed << 8) ^ crc16_itu_t_table[((seed >> 8) ^ *src) & 0xff];
+	}
+
+	return seed;
+#else
 	for (; len > 0; len--) {
 		seed = (seed >> 8U) | (seed << 8U);
 		seed ^= *src;
@@ -72,4 +89,5 @@ uint16_t __weak crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
 	}
 
 	return seed;
+#endif
 }
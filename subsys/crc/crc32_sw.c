@@ -6,6 +6,8 @@
 
 #include <zephyr/sys/crc.h>
 
+#include "crc_sw.h"
+
 uint32_t __weak crc32_ieee(const uint8_t *data, size_t len)
 {
 	return crc32_ieee_update(0x0, data, len);
@@ -13,6 +15,11 @@ uint32_t __weak crc32_ieee(const uint8_t *data, size_t len)
 
 uint32_t __weak crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
+#if CRC32_IEEE_ARCH
+	return ~crc32_ieee_arch_update(~crc, data, len);
+#elif CRC_SW_BYTE_TABLES
+	return ~crc32_sw_update(crc32_ieee_table, ~crc, data, len);
+#else
 	/* crc table generated from polynomial 0xedb88320 */
 	static const uint32_t table[16] = {
 		0x00000000U, 0x1db71064U, 0x3b6e20c8U, 0x26d930acU, 0x76dc4190U, 0x6b6b51f4U,
@@ -30,4 +37,5 @@ uint32_t __weak crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 	}
 
 	return (~crc);
+#endif
 }
@@ -6,12 +6,7 @@
 
 #include <zephyr/sys/crc.h>
 
-/* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
-static const uint32_t crc32c_table[16] = {
-	0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL, 0x417B1DBCUL, 0x5125DAD3UL,
-	0x61C69362UL, 0x7198540DUL, 0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
-	0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL,
-};
+#include "crc_sw.h"
 
 /* This value needs to be XORed with the final crc value once crc for
  * the entire stream is calculated. This is a requirement of crc32c algo.
@@ -30,10 +25,23 @@ uint32_t __weak crc32_c(uint32_t crc, const uint8_t *data, size_t len, bool firs
 		crc = CRC32C_INIT;
 	}
 
+#if CRC32_C_ARCH
+	crc = crc32_c_arch_update(crc, data, len);
+#elif CRC_SW_BYTE_TABLES
+	crc = crc32_sw_update(crc32c_table, crc, data, len);
+#else
+	/* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
+	static const uint32_t table[16] = {
+		0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL, 0x417B1DBCUL, 0x5125DAD3UL,
+		0x61C69362UL, 0x7198540DUL, 0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
+		0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL,
+	};
+
 	for (size_t i = 0; i < len; i++) {
-		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
-		crc = crc32c_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+		crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+		crc = table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
 	}
+#endif
 
 	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
 }
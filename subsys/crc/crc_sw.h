@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_CRC_CRC_SW_H_
+#define ZEPHYR_SUBSYS_CRC_CRC_SW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "crc_tables.h"
+
+#if defined(CONFIG_CRC_ARCH_INSTRUCTIONS) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC32_IEEE_ARCH 1
+#define CRC32_C_ARCH    1
+#elif defined(CONFIG_CRC_ARCH_INSTRUCTIONS) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define CRC32_IEEE_ARCH 0
+#define CRC32_C_ARCH    1
+#else
+#define CRC32_IEEE_ARCH 0
+#define CRC32_C_ARCH    0
+#endif
+
+/* The 16 entry tables are used unless a larger table size was selected */
+#if defined(CONFIG_CRC_SW_TABLE_256) || defined(CONFIG_CRC_SW_SLICE_BY_4) ||                     \
+	defined(CONFIG_CRC_SW_SLICE_BY_8)
+#define CRC_SW_BYTE_TABLES 1
+#else
+#define CRC_SW_BYTE_TABLES 0
+#endif
+
+/*
+ * Reflected CRC-32 over a table set from crc_tables.h. With slicing-by-N the
+ * input is consumed N bytes per iteration, slice n of the table holding the
+ * CRC of a byte followed by n zero bytes. The CRC register is neither
+ * pre-inverted nor post-inverted here.
+ */
+static inline uint32_t crc32_sw_update(const uint32_t table[CRC_SW_SLICES][256], uint32_t crc,
+				       const uint8_t *data, size_t len)
+{
+#if CRC_SW_SLICES > 1
+	for (; len >= CRC_SW_SLICES; len -= CRC_SW_SLICES, data += CRC_SW_SLICES) {
+		uint32_t lo = crc ^ sys_get_le32(data);
+
+#if CRC_SW_SLICES == 8
+		uint32_t hi = sys_get_le32(data + 4);
+
+		crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+#else
+		crc = table[3][lo & 0xff] ^ table[2][(lo >> 8) & 0xff] ^
+		      table[1][(lo >> 16) & 0xff] ^ table[0][lo >> 24];
+#endif
+	}
+#endif /* CRC_SW_SLICES > 1 */
+
+	for (; len > 0; len--, data++) {
+		crc = (crc >> 8) ^ table[0][(crc ^ *data) & 0xff];
+	}
+
+	return crc;
+}
+
+#if CRC32_IEEE_ARCH
+/* ARMv8 CRC32 instructions, same register convention as crc32_sw_update() */
+static inline uint32_t crc32_ieee_arch_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+#if defined(__aarch64__)
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = __crc32d(crc, sys_get_le64(data));
+	}
+#endif
+	for (; len >= 4; len -= 4, data += 4) {
+		crc = __crc32w(crc, sys_get_le32(data));
+	}
+
+	for (; len > 0; len--, data++) {
+		crc = __crc32b(crc, *data);
+	}
+
+	return crc;
+}
+#endif /* CRC32_IEEE_ARCH */
+
+#if CRC32_C_ARCH
+/* ARMv8 CRC32C or SSE4.2 CRC32 instructions */
+static inline uint32_t crc32_c_arch_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+#if defined(__ARM_FEATURE_CRC32)
+#if defined(__aarch64__)
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = __crc32cd(crc, sys_get_le64(data));
+	}
+#endif
+	for (; len >= 4; len -= 4, data += 4) {
+		crc = __crc32cw(crc, sys_get_le32(data));
+	}
+
+	for (; len > 0; len--, data++) {
+		crc = __crc32cb(crc, *data);
+	}
+#else
+#if defined(__x86_64__)
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = (uint32_t)_mm_crc32_u64(crc, sys_get_le64(data));
+	}
+#endif
+	for (; len >= 4; len -= 4, data += 4) {
+		crc = _mm_crc32_u32(crc, sys_get_le32(data));
+	}
+
+	for (; len > 0; len--, data++) {
+		crc = _mm_crc32_u8(crc, *data);
+	}
+#endif
+	return crc;
+}
+#endif /* CRC32_C_ARCH */
+
+#endif /* ZEPHYR_SUBSYS_CRC_CRC_SW_H_ */
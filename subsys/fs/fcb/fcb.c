@@ -86,6 +86,8 @@ int fcb_erase_sector(const struct fcb *fcbp, const struct flash_sector *sector)
 		return -EIO;
 	}
 
+	fcb_index_reset(fcbp, sector);
+
 	return 0;
 }
 
@@ -156,6 +158,14 @@ int fcb_init(int f_area_id, struct fcb *fcbp)
 	fcbp->f_active.fe_sector = newest_sector;
 	fcbp->f_active.fe_elem_off = fcb_len_in_flash(fcbp, sizeof(struct fcb_disk_area));
 	fcbp->f_active_id = newest;
+	k_mutex_init(&fcbp->f_mtx);
+
+#ifdef CONFIG_FCB_SECTOR_INDEX
+	if (fcbp->f_index != NULL && fcb_index_init(fcbp) == 0) {
+		/* Append position found in the index */
+		return 0;
+	}
+#endif
 
 	while (1) {
 		rc = fcb_getnext_in_sector(fcbp, &fcbp->f_active);
@@ -167,7 +177,6 @@ int fcb_init(int f_area_id, struct fcb *fcbp)
 			break;
 		}
 	}
-	k_mutex_init(&fcbp->f_mtx);
 	return rc;
 }
 
@@ -266,6 +275,9 @@ int fcb_sector_hdr_init(struct fcb *fcbp, struct flash_sector *sector, uint16_t
 	if (rc != 0) {
 		return -EIO;
 	}
+
+	fcb_index_reset(fcbp, sector);
+
 	return 0;
 }
 
@@ -61,6 +61,7 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 {
 	struct flash_sector *sector;
 	struct fcb_entry *active;
+	uint16_t data_len = len;
 	int cnt;
 	int rc;
 	uint8_t tmp_str[MAX(8, fcb->f_align)];
@@ -107,6 +108,8 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 	append_loc->fe_elem_off = active->fe_elem_off;
 	append_loc->fe_data_off = active->fe_elem_off + cnt;
 
+	fcb_index_append(fcb, append_loc, data_len);
+
 	active->fe_elem_off = append_loc->fe_data_off + len;
 
 	k_mutex_unlock(&fcb->f_mtx);
@@ -136,5 +139,8 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	if (rc) {
 		return -EIO;
 	}
+
+	fcb_index_append_finish(fcb, loc);
+
 	return 0;
 }
@@ -51,6 +51,11 @@ fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc)
 		 */
 		loc->fe_sector = fcb->f_oldest;
 	}
+#ifdef CONFIG_FCB_SECTOR_INDEX
+	if (fcb->f_index != NULL) {
+		return fcb_index_getnext(fcb, loc);
+	}
+#endif
 	if (loc->fe_elem_off == 0U) {
 		/*
 		 * If offset is zero, we serve the first entry from the sector.
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/sys/crc.h>
+#include <zephyr/fs/fcb.h>
+#include "fcb_priv.h"
+
+/*
+ * The index records the length of each element of a sector, in order; the
+ * offsets of the elements are recomputed from the lengths. Elements that do not
+ * pass the endmarker check are recorded with FCB_INDEX_INVALID set, so that
+ * they are skipped like when reading from flash. Elements appended but not
+ * finished yet are recorded with FCB_INDEX_PENDING set and checked in flash
+ * when walked over, as their endmarker may still match by chance.
+ */
+#define FCB_INDEX_INVALID	BIT(15)
+#define FCB_INDEX_PENDING	BIT(14)
+#define FCB_INDEX_LEN_MASK	FCB_MAX_LEN
+
+struct fcb_index_reader {
+	const struct flash_sector *sector;
+	uint32_t off;
+	uint32_t len;
+	uint8_t buf[CONFIG_FCB_SECTOR_INDEX_READ_SIZE];
+};
+
+static struct fcb_sector_index *fcb_index_get(const struct fcb *fcbp,
+					      const struct flash_sector *sector)
+{
+	return &fcbp->f_index[sector - fcbp->f_sectors];
+}
+
+static uint16_t *fcb_index_elems(const struct fcb *fcbp, const struct flash_sector *sector)
+{
+	return &fcbp->f_index_elems[(sector - fcbp->f_sectors) * fcbp->f_index_elem_cnt];
+}
+
+static uint32_t fcb_index_data_off(const struct fcb *fcbp, uint32_t elem_off, uint16_t len)
+{
+	return elem_off + fcb_len_in_flash(fcbp, (len < 0x80) ? 1 : 2);
+}
+
+static uint32_t fcb_index_next_off(const struct fcb *fcbp, uint32_t elem_off, uint16_t len)
+{
+	return fcb_index_data_off(fcbp, elem_off, len) + fcb_len_in_flash(fcbp, len) +
+	       fcb_len_in_flash(fcbp, FCB_CRC_SZ);
+}
+
+void fcb_index_reset(const struct fcb *fcbp, const struct flash_sector *sector)
+{
+	struct fcb_sector_index *idx;
+
+	if (fcbp->f_index == NULL) {
+		return;
+	}
+
+	idx = fcb_index_get(fcbp, sector);
+	idx->fsi_end_off = fcb_len_in_flash(fcbp, sizeof(struct fcb_disk_area));
+	idx->fsi_hint_off = idx->fsi_end_off;
+	idx->fsi_cnt = 0U;
+	idx->fsi_hint_pos = 0U;
+	idx->fsi_complete = true;
+}
+
+/* Get len bytes at offset off of the sector, reading as much as fits in the
+ * reader buffer when they are not already there.
+ */
+static int fcb_index_read(struct fcb *fcbp, struct fcb_index_reader *rd, uint32_t off,
+			  uint32_t len, const uint8_t **data)
+{
+	int rc;
+
+	if (off + len > rd->sector->fs_size) {
+		return -EIO;
+	}
+
+	if (off < rd->off || off + len > rd->off + rd->len) {
+		rd->off = off;
+		rd->len = MIN(sizeof(rd->buf), rd->sector->fs_size - off);
+		rc = fcb_flash_read(fcbp, rd->sector, off, rd->buf, rd->len);
+		if (rc) {
+			rd->len = 0U;
+			return -EIO;
+		}
+	}
+
+	*data = &rd->buf[off - rd->off];
+	return 0;
+}
+
+/* Same as fcb_elem_info(), reading through the reader buffer */
+static int fcb_index_elem_info(struct fcb *fcbp, struct fcb_index_reader *rd,
+			       struct fcb_entry *loc)
+{
+	const uint8_t *data;
+	uint8_t len_buf[2];
+	uint8_t crc8;
+	uint8_t fl_em;
+	uint16_t len;
+	uint32_t off;
+	uint32_t end;
+	uint32_t blk_sz;
+	int cnt;
+	int rc;
+
+	if (loc->fe_elem_off + 2 > loc->fe_sector->fs_size) {
+		return -ENOTSUP;
+	}
+
+	rc = fcb_index_read(fcbp, rd, loc->fe_elem_off, sizeof(len_buf), &data);
+	if (rc) {
+		return rc;
+	}
+	memcpy(len_buf, data, sizeof(len_buf));
+
+	cnt = fcb_get_len(fcbp, len_buf, &len);
+	if (cnt < 0) {
+		return cnt;
+	}
+	loc->fe_data_off = loc->fe_elem_off + fcb_len_in_flash(fcbp, cnt);
+	loc->fe_data_len = len;
+
+	rc = fcb_index_read(fcbp, rd, loc->fe_data_off + fcb_len_in_flash(fcbp, len),
+			    sizeof(fl_em), &data);
+	if (rc) {
+		return rc;
+	}
+	fl_em = *data;
+
+#if defined(CONFIG_FCB_ALLOW_FIXED_ENDMARKER)
+	if ((fcbp->f_flags & FCB_FLAGS_CRC_DISABLED) && (fl_em == FCB_FIXED_ENDMARKER)) {
+		return 0;
+	}
+#endif
+
+	crc8 = CRC8_CCITT_INITIAL_VALUE;
+	crc8 = crc8_ccitt(crc8, len_buf, cnt);
+
+	off = loc->fe_data_off;
+	end = loc->fe_data_off + len;
+	for (; off < end; off += blk_sz) {
+		blk_sz = MIN(end - off, sizeof(rd->buf));
+
+		rc = fcb_index_read(fcbp, rd, off, blk_sz, &data);
+		if (rc) {
+			return rc;
+		}
+		crc8 = crc8_ccitt(crc8, data, blk_sz);
+	}
+
+	return (fl_em == crc8) ? 0 : -EBADMSG;
+}
+
+static void fcb_index_sector_build(struct fcb *fcbp, struct fcb_index_reader *rd,
+				   struct flash_sector *sector)
+{
+	struct fcb_sector_index *idx = fcb_index_get(fcbp, sector);
+	uint16_t *elems = fcb_index_elems(fcbp, sector);
+	struct fcb_entry loc;
+	int rc;
+
+	fcb_index_reset(fcbp, sector);
+
+	rd->sector = sector;
+	rd->len = 0U;
+	loc.fe_sector = sector;
+	loc.fe_elem_off = idx->fsi_end_off;
+
+	while (true) {
+		rc = fcb_index_elem_info(fcbp, rd, &loc);
+		if (rc == -ENOTSUP) {
+			/* No more elements */
+			return;
+		}
+		if ((rc != 0 && rc != -EBADMSG) || idx->fsi_cnt == fcbp->f_index_elem_cnt) {
+			/* Leave the rest of the sector to be read from flash */
+			idx->fsi_complete = false;
+			return;
+		}
+
+		elems[idx->fsi_cnt++] = loc.fe_data_len | ((rc != 0) ? FCB_INDEX_INVALID : 0);
+		loc.fe_elem_off = fcb_index_next_off(fcbp, loc.fe_elem_off, loc.fe_data_len);
+		idx->fsi_end_off = loc.fe_elem_off;
+	}
+}
+
+int fcb_index_init(struct fcb *fcbp)
+{
+	struct fcb_index_reader rd;
+	struct flash_sector *sector;
+	struct fcb_sector_index *idx;
+	uint16_t *elems;
+	uint32_t off;
+	int i;
+
+	for (i = 0; i < fcbp->f_sector_cnt; i++) {
+		fcb_index_reset(fcbp, &fcbp->f_sectors[i]);
+	}
+
+	sector = fcbp->f_oldest;
+	while (true) {
+		fcb_index_sector_build(fcbp, &rd, sector);
+		if (sector == fcbp->f_active.fe_sector) {
+			break;
+		}
+		sector = fcb_getnext_sector(fcbp, sector);
+	}
+
+	idx = fcb_index_get(fcbp, sector);
+	if (idx->fsi_complete) {
+		fcbp->f_active.fe_elem_off = idx->fsi_end_off;
+		return 0;
+	}
+
+	/* The append position has to be found by reading the flash, from the
+	 * last element recorded.
+	 */
+	if (idx->fsi_cnt > 0) {
+		elems = fcb_index_elems(fcbp, sector);
+		off = fcb_len_in_flash(fcbp, sizeof(struct fcb_disk_area));
+		for (i = 0; i < idx->fsi_cnt - 1; i++) {
+			off = fcb_index_next_off(fcbp, off, elems[i] & FCB_INDEX_LEN_MASK);
+		}
+		fcbp->f_active.fe_elem_off = off;
+	}
+
+	return 1;
+}
+
+void fcb_index_append(struct fcb *fcbp, const struct fcb_entry *loc, uint16_t len)
+{
+	struct fcb_sector_index *idx;
+
+	if (fcbp->f_index == NULL) {
+		return;
+	}
+
+	idx = fcb_index_get(fcbp, loc->fe_sector);
+	if (!idx->fsi_complete) {
+		return;
+	}
+
+	/* Something, e.g. an aborted append, left a gap the index does not know */
+	if (idx->fsi_end_off != loc->fe_elem_off ||
+	    idx->fsi_cnt == fcbp->f_index_elem_cnt) {
+		idx->fsi_complete = false;
+		return;
+	}
+
+	/* Pending until the endmarker gets written by fcb_append_finish() */
+	fcb_index_elems(fcbp, loc->fe_sector)[idx->fsi_cnt] = len | FCB_INDEX_PENDING;
+	idx->fsi_hint_pos = idx->fsi_cnt;
+	idx->fsi_hint_off = loc->fe_elem_off;
+	idx->fsi_cnt++;
+	idx->fsi_end_off = fcb_index_next_off(fcbp, loc->fe_elem_off, len);
+}
+
+/* Position of the element at offset off, or -ENOENT if it is not recorded */
+static int fcb_index_find(struct fcb *fcbp, struct fcb_sector_index *idx, const uint16_t *elems,
+			  uint32_t off)
+{
+	uint16_t pos = 0U;
+	uint32_t cur = fcb_len_in_flash(fcbp, sizeof(struct fcb_disk_area));
+
+	if (off >= idx->fsi_hint_off && idx->fsi_hint_pos < idx->fsi_cnt) {
+		pos = idx->fsi_hint_pos;
+		cur = idx->fsi_hint_off;
+	}
+
+	while (pos < idx->fsi_cnt && cur < off) {
+		cur = fcb_index_next_off(fcbp, cur, elems[pos] & FCB_INDEX_LEN_MASK);
+		pos++;
+	}
+
+	if (pos == idx->fsi_cnt || cur != off) {
+		return -ENOENT;
+	}
+
+	idx->fsi_hint_pos = pos;
+	idx->fsi_hint_off = cur;
+	return pos;
+}
+
+void fcb_index_append_finish(struct fcb *fcbp, const struct fcb_entry *loc)
+{
+	struct fcb_sector_index *idx;
+	uint16_t *elems;
+	int pos;
+
+	if (fcbp->f_index == NULL) {
+		return;
+	}
+
+	if (k_mutex_lock(&fcbp->f_mtx, K_FOREVER)) {
+		return;
+	}
+
+	idx = fcb_index_get(fcbp, loc->fe_sector);
+	elems = fcb_index_elems(fcbp, loc->fe_sector);
+	pos = fcb_index_find(fcbp, idx, elems, loc->fe_elem_off);
+	if (pos >= 0) {
+		elems[pos] &= FCB_INDEX_LEN_MASK;
+	}
+
+	k_mutex_unlock(&fcbp->f_mtx);
+}
+
+/*
+ * Find the element following loc in its sector; the first one if
+ * loc->fe_elem_off is 0.
+ * Returns 0 when found, -ENOTSUP if there are no more elements in the sector,
+ * -ENOENT when the following element is not recorded, with loc->fe_elem_off
+ * set to its offset, and -EAGAIN when loc itself is not recorded.
+ */
+static int fcb_index_getnext_in_sector(struct fcb *fcbp, struct fcb_entry *loc)
+{
+	struct fcb_sector_index *idx = fcb_index_get(fcbp, loc->fe_sector);
+	const uint16_t *elems = fcb_index_elems(fcbp, loc->fe_sector);
+	bool valid;
+	uint32_t off;
+	uint16_t len;
+	int pos;
+
+	if (loc->fe_elem_off == 0U) {
+		pos = 0;
+		off = fcb_len_in_flash(fcbp, sizeof(struct fcb_disk_area));
+	} else {
+		pos = fcb_index_find(fcbp, idx, elems, loc->fe_elem_off);
+		if (pos < 0) {
+			return -EAGAIN;
+		}
+		off = fcb_index_next_off(fcbp, loc->fe_elem_off, elems[pos] & FCB_INDEX_LEN_MASK);
+		pos++;
+	}
+
+	for (; pos < idx->fsi_cnt; pos++) {
+		len = elems[pos] & FCB_INDEX_LEN_MASK;
+		loc->fe_elem_off = off;
+		if (elems[pos] & FCB_INDEX_PENDING) {
+			valid = (fcb_elem_info(fcbp, loc) == 0);
+		} else {
+			valid = !(elems[pos] & FCB_INDEX_INVALID);
+			loc->fe_data_off = fcb_index_data_off(fcbp, off, len);
+			loc->fe_data_len = len;
+		}
+		if (valid) {
+			idx->fsi_hint_pos = pos;
+			idx->fsi_hint_off = off;
+			return 0;
+		}
+		off = fcb_index_next_off(fcbp, off, len);
+	}
+
+	if (idx->fsi_complete) {
+		return -ENOTSUP;
+	}
+
+	loc->fe_elem_off = off;
+	return -ENOENT;
+}
+
+int fcb_index_getnext(struct fcb *fcbp, struct fcb_entry *loc)
+{
+	int rc;
+
+	while (true) {
+		rc = fcb_index_getnext_in_sector(fcbp, loc);
+		if (rc == -ENOENT) {
+			rc = fcb_elem_info(fcbp, loc);
+			if (rc == -EBADMSG) {
+				rc = fcb_getnext_in_sector(fcbp, loc);
+			}
+		} else if (rc == -EAGAIN) {
+			rc = fcb_getnext_in_sector(fcbp, loc);
+		}
+		if (rc == 0) {
+			return 0;
+		}
+
+		/* Moving to next sector */
+		if (loc->fe_sector == fcbp->f_active.fe_sector) {
+			return -ENOTSUP;
+		}
+		loc->fe_sector = fcb_getnext_sector(fcbp, loc->fe_sector);
+		loc->fe_elem_off = 0U;
+	}
+}
@@ -19,6 +19,8 @@ extern "C" {
 #define FCB_CRC_SZ	sizeof(uint8_t)
 #define FCB_TMP_BUF_SZ	32
 
+#define FCB_FIXED_ENDMARKER 0xab
+
 #define FCB_ID_GT(a, b) (((int16_t)(a) - (int16_t)(b)) > 0)
 
 #define MK32(val) ((((uint32_t)(val)) << 24) |			\
@@ -56,7 +58,7 @@ struct fcb_disk_area {
 int fcb_put_len(const struct fcb *fcbp, uint8_t *buf, uint16_t len);
 int fcb_get_len(const struct fcb *fcbp, uint8_t *buf, uint16_t *len);
 
-static inline int fcb_len_in_flash(struct fcb *fcbp, uint16_t len)
+static inline int fcb_len_in_flash(const struct fcb *fcbp, uint16_t len)
 {
 	if (fcbp->f_align <= 1U) {
 		return len;
@@ -78,6 +80,26 @@ int fcb_elem_endmarker(struct fcb *fcbp, struct fcb_entry *loc, uint8_t *crc8p);
 int fcb_sector_hdr_init(struct fcb *fcbp, struct flash_sector *sector, uint16_t id);
 int fcb_sector_hdr_read(struct fcb *fcbp, struct flash_sector *sector, struct fcb_disk_area *fdap);
 
+#ifdef CONFIG_FCB_SECTOR_INDEX
+int fcb_index_init(struct fcb *fcbp);
+void fcb_index_reset(const struct fcb *fcbp, const struct flash_sector *sector);
+void fcb_index_append(struct fcb *fcbp, const struct fcb_entry *loc, uint16_t len);
+void fcb_index_append_finish(struct fcb *fcbp, const struct fcb_entry *loc);
+int fcb_index_getnext(struct fcb *fcbp, struct fcb_entry *loc);
+#else
+static inline void fcb_index_reset(const struct fcb *fcbp, const struct flash_sector *sector)
+{
+}
+
+static inline void fcb_index_append(struct fcb *fcbp, const struct fcb_entry *loc, uint16_t len)
+{
+}
+
+static inline void fcb_index_append_finish(struct fcb *fcbp, const struct fcb_entry *loc)
+{
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
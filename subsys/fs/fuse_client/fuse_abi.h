@@ -59,10 +59,18 @@
 #define FUSE_RELEASEDIR 29
 #define FUSE_CREATE 35
 #define FUSE_DESTROY 38
+#define FUSE_READDIRPLUS 44
 #define FUSE_LSEEK 46
 
 #define FUSE_ROOT_INODE 1
 
+/* fuse_init_in::flags and fuse_init_out::flags */
+#define FUSE_DO_READDIRPLUS	(1 << 13)
+
+/* fuse_open_out::open_flags */
+#define FOPEN_DIRECT_IO		(1 << 0)
+#define FOPEN_KEEP_CACHE	(1 << 1)
+
 struct fuse_in_header {
 	uint32_t len;
 	uint32_t opcode;
@@ -266,6 +274,11 @@ struct fuse_dirent {
 	char name[];
 };
 
+struct fuse_direntplus {
+	struct fuse_entry_out entry_out;
+	struct fuse_dirent dirent;
+};
+
 struct fuse_forget_in {
 	uint64_t nlookup;
 };
@@ -29,7 +29,7 @@ void fuse_fill_header(struct fuse_in_header *hdr, uint32_t len, uint32_t opcode,
 	hdr->total_extlen = 0;
 }
 
-void fuse_create_init_req(struct fuse_init_req *req)
+void fuse_create_init_req(struct fuse_init_req *req, uint32_t flags)
 {
 	fuse_fill_header(
 		&req->in_header, sizeof(struct fuse_in_header) + sizeof(struct fuse_init_in),
@@ -38,7 +38,7 @@ void fuse_create_init_req(struct fuse_init_req *req)
 	req->init_in.major = FUSE_MAJOR_VERSION;
 	req->init_in.minor = FUSE_MINOR_VERSION;
 	req->init_in.max_readahead = 0;
-	req->init_in.flags = 0;
+	req->init_in.flags = flags;
 	req->init_in.flags2 = 0;
 }
 
@@ -77,6 +77,13 @@ void fuse_create_read_req(
 	req->read_in.flags = 0;
 }
 
+void fuse_create_readdirplus_req(
+	struct fuse_read_req *req, uint64_t inode, uint64_t fh, uint64_t offset, uint32_t size)
+{
+	fuse_create_read_req(req, inode, fh, offset, size, FUSE_DIR);
+	req->in_header.opcode = FUSE_READDIRPLUS;
+}
+
 void fuse_create_release_req(struct fuse_release_req *req, uint64_t inode, uint64_t fh,
 	enum fuse_object_type type)
 {
@@ -227,6 +234,8 @@ const char *fuse_opcode_to_string(uint32_t opcode)
 		return "FUSE_CREATE";
 	case FUSE_DESTROY:
 		return "FUSE_DESTROY";
+	case FUSE_READDIRPLUS:
+		return "FUSE_READDIRPLUS";
 	case FUSE_LSEEK:
 		return "FUSE_LSEEK";
 	default:
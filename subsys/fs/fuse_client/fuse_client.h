@@ -127,13 +127,15 @@ enum fuse_object_type {
 
 void fuse_fill_header(struct fuse_in_header *hdr, uint32_t len, uint32_t opcode, uint64_t nodeid);
 
-void fuse_create_init_req(struct fuse_init_req *req);
+void fuse_create_init_req(struct fuse_init_req *req, uint32_t flags);
 void fuse_create_open_req(struct fuse_open_req *req, uint64_t inode, uint32_t flags,
 	enum fuse_object_type type);
 void fuse_create_lookup_req(struct fuse_lookup_req *req, uint64_t inode, uint32_t fname_len);
 void fuse_create_read_req(
 	struct fuse_read_req *req, uint64_t inode, uint64_t fh, uint64_t offset, uint32_t size,
 	enum fuse_object_type type);
+void fuse_create_readdirplus_req(
+	struct fuse_read_req *req, uint64_t inode, uint64_t fh, uint64_t offset, uint32_t size);
 void fuse_create_release_req(struct fuse_release_req *req, uint64_t inode, uint64_t fh,
 	enum fuse_object_type type);
 void fuse_create_destroy_req(struct fuse_destroy_req *req);
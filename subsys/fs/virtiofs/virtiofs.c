@@ -7,7 +7,9 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/byteorder.h>
 #include <errno.h>
+#include <string.h>
 #include "virtiofs.h"
+#include "virtiofs_cache.h"
 #include <zephyr/drivers/virtio.h>
 
 LOG_MODULE_REGISTER(virtiofs, CONFIG_VIRTIOFS_LOG_LEVEL);
@@ -140,7 +142,9 @@ int virtiofs_init(const struct device *dev, struct fuse_init_out *response)
 
 	virtio_finalize_init(dev);
 
-	fuse_create_init_req(&req);
+	fuse_create_init_req(
+		&req, IS_ENABLED(CONFIG_VIRTIOFS_READDIRPLUS) ? FUSE_DO_READDIRPLUS : 0
+	);
 
 	struct virtq_buf buf[] = {
 		{ .addr = &req.in_header, .len = sizeof(req.in_header) + sizeof(req.init_in) },
@@ -187,6 +191,61 @@ int virtiofs_init(const struct device *dev, struct fuse_init_out *response)
 	return 0;
 }
 
+static void virtiofs_send_forget(const struct device *dev, uint64_t inode, uint64_t nlookup);
+
+/* looks up a single path component and adds the result to the entry cache */
+static int virtiofs_lookup_one(
+	const struct device *dev, uint64_t inode, const char *name, uint32_t name_len,
+	struct fuse_lookup_req *req)
+{
+	uint64_t evict_nodeid;
+	uint64_t evict_nlookup;
+
+	fuse_create_lookup_req(req, inode, name_len + 1);
+
+	struct virtq_buf buf[] = {
+		{ .addr = &req->in_header, .len = sizeof(struct fuse_in_header) },
+		{ .addr = (void *)name, .len = name_len },
+		/*
+		 * despite length being part of in_header this still has to be null
+		 * terminated
+		 */
+		{ .addr = "", .len = 1},
+		{ .addr = &req->out_header,
+		  .len = sizeof(struct fuse_out_header) + sizeof(struct fuse_entry_out) }
+	};
+
+	LOG_INF(
+		"sending FUSE_LOOKUP for \"%s\", nodeid=%" PRIu64 ", unique=%" PRIu64,
+		name, inode, req->in_header.unique
+	);
+	uint32_t used_len = virtiofs_send_receive(dev, REQUEST_QUEUE, buf, 4, 3);
+
+	LOG_INF("received FUSE_LOOKUP response, unique=%" PRIu64, req->out_header.unique);
+
+	int valid_ret = virtiofs_validate_response(
+		&req->out_header, FUSE_LOOKUP, used_len,
+		sizeof(struct fuse_out_header) + sizeof(struct fuse_entry_out)
+	);
+
+	if (valid_ret != 0) {
+		return valid_ret;
+	}
+
+#ifdef CONFIG_VIRTIOFS_DEBUG
+	fuse_dump_entry_out(&req->entry_out);
+#endif
+
+	virtiofs_entry_cache_insert(
+		dev, inode, name, name_len, &req->entry_out, true, &evict_nodeid, &evict_nlookup
+	);
+	if (evict_nodeid != 0 && evict_nodeid != FUSE_ROOT_INODE) {
+		virtiofs_send_forget(dev, evict_nodeid, evict_nlookup);
+	}
+
+	return 0;
+}
+
 /**
  * @brief lookups object in the virtiofs filesystem
  *
@@ -220,57 +279,38 @@ int virtiofs_lookup(
 			curr_len++;
 		}
 
-		fuse_create_lookup_req(&req, curr_inode, curr_len + 1);
-
-		struct virtq_buf buf[] = {
-			{ .addr = &req.in_header, .len = sizeof(struct fuse_in_header) },
-			{ .addr = (void *)curr, .len = curr_len },
-			/*
-			 * despite length being part of in_header this still has to be null
-			 * terminated
-			 */
-			{ .addr = "", .len = 1},
-			{ .addr = &req.out_header,
-			  .len = sizeof(struct fuse_out_header) + sizeof(struct fuse_entry_out) }
-		};
-
-		LOG_INF(
-			"sending FUSE_LOOKUP for \"%s\", nodeid=%" PRIu64 ", unique=%" PRIu64,
-			curr, curr_inode, req.in_header.unique
-		);
-		uint32_t used_len = virtiofs_send_receive(dev, REQUEST_QUEUE, buf, 4, 3);
-
-		LOG_INF("received FUSE_LOOKUP response, unique=%" PRIu64, req.out_header.unique);
+		bool is_curr_parent = true;
 
-		int valid_ret = virtiofs_validate_response(
-			&req.out_header, FUSE_LOOKUP, used_len,
-			sizeof(struct fuse_out_header) + sizeof(struct fuse_entry_out)
-		);
+		for (const char *c = curr; c < path + path_len; c++) {
+			if (*c == '/') {
+				is_curr_parent = false;
+			}
+		}
 
 		if (parent_inode) {
 			*parent_inode = curr_inode;
 		}
 
-		*response = req.entry_out;
-		if (valid_ret != 0) {
-			if (parent_inode && (curr + curr_len + 1 != path + path_len)) {
-				/* there is no immediate parent */
-				if (*parent_inode != inode) {
-					virtiofs_forget(dev, *parent_inode, 1);
+		/*
+		 * only the attributes of the object we are looking for are used by the callers,
+		 * for the intermediate directories a valid entry is enough
+		 */
+		if (virtiofs_entry_cache_lookup(
+			dev, curr_inode, curr, curr_len, is_curr_parent, &req.entry_out)) {
+			*response = req.entry_out;
+		} else {
+			int valid_ret = virtiofs_lookup_one(dev, curr_inode, curr, curr_len, &req);
+
+			*response = req.entry_out;
+			if (valid_ret != 0) {
+				if (parent_inode && (curr + curr_len + 1 != path + path_len)) {
+					/* there is no immediate parent */
+					if (*parent_inode != inode) {
+						virtiofs_forget(dev, *parent_inode, 1);
+					}
+					*parent_inode = 0;
 				}
-				*parent_inode = 0;
-			}
-			return valid_ret;
-		}
-
-#ifdef CONFIG_VIRTIOFS_DEBUG
-		fuse_dump_entry_out(&req.entry_out);
-#endif
-		bool is_curr_parent = true;
-
-		for (const char *c = curr; c < path + path_len; c++) {
-			if (*c == '/') {
-				is_curr_parent = false;
+				return valid_ret;
 			}
 		}
 
@@ -362,6 +402,54 @@ int virtiofs_read(
 	return req.out_header.len - sizeof(req.out_header);
 }
 
+#ifdef CONFIG_VIRTIOFS_PAGE_CACHE
+/**
+ * @brief reads consecutive data of a file into a list of buffers with a single FUSE_READ
+ *
+ * @param bufs buffers of buf_size bytes each, at most CONFIG_VIRTIOFS_READAHEAD_PAGES
+ * @return number of bytes read or error code on failure
+ */
+int virtiofs_readv(
+	const struct device *dev, uint64_t inode, uint64_t fh, uint64_t offset,
+	uint8_t **bufs, uint32_t buf_count, uint32_t buf_size)
+{
+	struct virtq_buf buf[2 + CONFIG_VIRTIOFS_READAHEAD_PAGES];
+	struct fuse_read_req req;
+
+	if (buf_count == 0 || buf_count > CONFIG_VIRTIOFS_READAHEAD_PAGES) {
+		return -EINVAL;
+	}
+
+	fuse_create_read_req(&req, inode, fh, offset, buf_count * buf_size, FUSE_FILE);
+
+	buf[0].addr = &req.in_header;
+	buf[0].len = req.in_header.len;
+	buf[1].addr = &req.out_header;
+	buf[1].len = sizeof(struct fuse_out_header);
+	for (uint32_t i = 0; i < buf_count; i++) {
+		buf[2 + i].addr = bufs[i];
+		buf[2 + i].len = buf_size;
+	}
+
+	LOG_INF(
+		"sending FUSE_READ, nodeid=%" PRIu64 ", fh=%" PRIu64 ", offset=%" PRIu64
+		", size=%" PRIu32 ", unique=%" PRIu64,
+		inode, fh, offset, buf_count * buf_size, req.in_header.unique
+	);
+	uint32_t used_len = virtiofs_send_receive(dev, REQUEST_QUEUE, buf, 2 + buf_count, 1);
+
+	LOG_INF("received FUSE_READ response, unique=%" PRIu64, req.out_header.unique);
+
+	int valid_ret = virtiofs_validate_response(&req.out_header, FUSE_READ, used_len, -1);
+
+	if (valid_ret != 0) {
+		return valid_ret;
+	}
+
+	return req.out_header.len - sizeof(req.out_header);
+}
+#endif /* CONFIG_VIRTIOFS_PAGE_CACHE */
+
 int virtiofs_release(const struct device *dev, uint64_t inode, uint64_t fh,
 	enum fuse_object_type type)
 {
@@ -407,6 +495,9 @@ int virtiofs_destroy(const struct device *dev)
 
 	LOG_INF("received FUSE_DESTROY response, unique=%" PRIu64, req.in_header.unique);
 
+	/* the daemon drops all the node references on FUSE_DESTROY */
+	virtiofs_entry_cache_clear(dev);
+
 	return virtiofs_validate_response(&req.out_header, FUSE_DESTROY, used_len, -1);
 }
 
@@ -474,6 +565,9 @@ int virtiofs_write(
 
 	LOG_INF("received FUSE_WRITE response, unique=%" PRIu64, req.out_header.unique);
 
+	/* size and modification time of the file have changed */
+	virtiofs_entry_cache_invalidate_attr(dev, inode);
+
 	int valid_ret = virtiofs_validate_response(
 		&req.out_header, FUSE_WRITE, used_len, buf[2].len
 	);
@@ -553,9 +647,12 @@ int virtiofs_setattr(
 	);
 
 	if (valid_ret != 0) {
+		virtiofs_entry_cache_invalidate_attr(dev, inode);
 		return valid_ret;
 	}
 
+	virtiofs_entry_cache_update_attr(dev, inode, response);
+
 #ifdef CONFIG_VIRTIOFS_DEBUG
 	fuse_dump_attr_out(response);
 #endif
@@ -620,7 +717,17 @@ int virtiofs_mkdir(const struct device *dev, uint64_t inode, const char *dirname
 	return 0;
 }
 
-int virtiofs_unlink(const struct device *dev, const char *fname, enum fuse_object_type type)
+/**
+ * @brief removes a file or an empty directory
+ *
+ * @param parent_inode inode of the directory containing the object, used to invalidate its
+ * cached entry
+ * @param fname path of the object relative to the root
+ * @return 0 or error code on failure
+ */
+int virtiofs_unlink(
+	const struct device *dev, uint64_t parent_inode, const char *fname,
+	enum fuse_object_type type)
 {
 	struct fuse_unlink_req req;
 	uint32_t fname_len = strlen(fname) + 1;
@@ -644,10 +751,21 @@ int virtiofs_unlink(const struct device *dev, const char *fname, enum fuse_objec
 		type == FUSE_DIR ? "FUSE_RMDIR" : "FUSE_UNLINK", req.out_header.unique
 	);
 
-	return virtiofs_validate_response(
+	int valid_ret = virtiofs_validate_response(
 		&req.out_header, type == FUSE_DIR ? FUSE_RMDIR : FUSE_UNLINK, used_len,
 		sizeof(req.out_header)
 	);
+
+	if (valid_ret != 0) {
+		return valid_ret;
+	}
+
+	const char *name = strrchr(fname, '/');
+
+	name = name != NULL ? name + 1 : fname;
+	virtiofs_entry_cache_invalidate(dev, parent_inode, name, strlen(name));
+
+	return 0;
 }
 
 int virtiofs_rename(
@@ -675,9 +793,18 @@ int virtiofs_rename(
 
 	LOG_INF("received FUSE_RENAME response, unique=%" PRIu64, req.out_header.unique);
 
-	return virtiofs_validate_response(
+	int valid_ret = virtiofs_validate_response(
 		&req.out_header, FUSE_RENAME, used_len, sizeof(req.out_header)
 	);
+
+	if (valid_ret != 0) {
+		return valid_ret;
+	}
+
+	virtiofs_entry_cache_invalidate(dev, old_dir_inode, old_name, old_len - 1);
+	virtiofs_entry_cache_invalidate(dev, new_dir_inode, new_name, new_len - 1);
+
+	return 0;
 }
 
 int virtiofs_statfs(const struct device *dev, struct fuse_kstatfs *response)
@@ -747,12 +874,83 @@ int virtiofs_readdir(
 	return req.out_header.len - sizeof(req.out_header);
 }
 
-void virtiofs_forget(const struct device *dev, uint64_t inode, uint64_t nlookup)
+/**
+ * @brief reads a single directory entry together with its attributes
+ *
+ * Unlike FUSE_READDIR each returned entry is looked up by the daemon, the reference is
+ * handed over to the entry cache or forgotten right away.
+ *
+ * @return number of bytes read, 0 at the end of directory or error code on failure
+ */
+int virtiofs_readdirplus(
+	const struct device *dev, uint64_t inode, uint64_t fh, uint64_t offset,
+	struct fuse_direntplus *dirent, uint8_t *name_buf, uint32_t name_size)
 {
-	if (inode == FUSE_ROOT_INODE) {
-		return;
+	struct fuse_read_req req;
+	uint64_t evict_nodeid;
+	uint64_t evict_nlookup;
+
+	fuse_create_readdirplus_req(&req, inode, fh, offset, sizeof(*dirent) + name_size);
+
+	struct virtq_buf buf[] = {
+		{ .addr = &req.in_header, .len = req.in_header.len },
+		{ .addr = &req.out_header, .len = sizeof(struct fuse_out_header) },
+		{ .addr = dirent, .len = sizeof(*dirent) },
+		{ .addr = name_buf, .len = name_size }
+	};
+
+	LOG_INF(
+		"sending FUSE_READDIRPLUS, nodeid=%" PRIu64 ", fh=%" PRIu64 ", offset=%" PRIu64
+		", size=%" PRIu32 ", unique=%" PRIu64,
+		inode, fh, offset, (uint32_t)sizeof(*dirent) + name_size, req.in_header.unique
+	);
+	uint32_t used_len = virtiofs_send_receive(dev, REQUEST_QUEUE, buf, 4, 1);
+
+	LOG_INF("received FUSE_READDIRPLUS response, unique=%" PRIu64, req.out_header.unique);
+
+	int valid_ret = virtiofs_validate_response(
+		&req.out_header, FUSE_READDIRPLUS, used_len, -1
+	);
+
+	if (valid_ret != 0) {
+		return valid_ret;
+	}
+
+	int read_c = req.out_header.len - sizeof(req.out_header);
+
+	/*
+	 * entries without node id weren't looked up and neither are "." and "..", see
+	 * fuse_direntplus_link() in Linux
+	 */
+	if (read_c < sizeof(*dirent) || dirent->entry_out.nodeid == 0 ||
+	    (dirent->dirent.namelen == 1 && name_buf[0] == '.') ||
+	    (dirent->dirent.namelen == 2 && name_buf[0] == '.' && name_buf[1] == '.')) {
+		return read_c;
+	}
+
+	/* the name didn't fit, so the entry can't be cached but it was still looked up */
+	if (dirent->dirent.namelen > name_size) {
+		virtiofs_send_forget(dev, dirent->entry_out.nodeid, 1);
+		return read_c;
 	}
 
+#ifdef CONFIG_VIRTIOFS_DEBUG
+	fuse_dump_entry_out(&dirent->entry_out);
+#endif
+
+	virtiofs_entry_cache_insert(
+		dev, inode, (const char *)name_buf, dirent->dirent.namelen, &dirent->entry_out,
+		false, &evict_nodeid, &evict_nlookup
+	);
+	if (evict_nodeid != 0 && evict_nodeid != FUSE_ROOT_INODE) {
+		virtiofs_send_forget(dev, evict_nodeid, evict_nlookup);
+	}
+
+	return read_c;
+}
+
+static void virtiofs_send_forget(const struct device *dev, uint64_t inode, uint64_t nlookup)
+{
 	struct fuse_forget_req req;
 
 	fuse_fill_header(&req.in_header, sizeof(req.in_header), FUSE_FORGET, inode);
@@ -776,3 +974,17 @@ void virtiofs_forget(const struct device *dev, uint64_t inode, uint64_t nlookup)
 	 * FUSE_FORGET has no reply), so there is no error code to return
 	 */
 }
+
+void virtiofs_forget(const struct device *dev, uint64_t inode, uint64_t nlookup)
+{
+	if (inode == FUSE_ROOT_INODE) {
+		return;
+	}
+
+	/* references lent by the entry cache stay with it until the entry is evicted */
+	if (virtiofs_entry_cache_put(dev, inode, nlookup)) {
+		return;
+	}
+
+	virtiofs_send_forget(dev, inode, nlookup);
+}
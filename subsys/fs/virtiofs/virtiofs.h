@@ -19,6 +19,9 @@ int virtiofs_open(
 int virtiofs_read(
 	const struct device *dev, uint64_t inode, uint64_t fh,
 	uint64_t offset, uint32_t size, uint8_t *buf);
+int virtiofs_readv(
+	const struct device *dev, uint64_t inode, uint64_t fh, uint64_t offset,
+	uint8_t **bufs, uint32_t buf_count, uint32_t buf_size);
 int virtiofs_release(const struct device *dev, uint64_t inode, uint64_t fh,
 	enum fuse_object_type type);
 int virtiofs_destroy(const struct device *dev);
@@ -36,7 +39,9 @@ int virtiofs_setattr(
 	struct fuse_attr_out *response);
 int virtiofs_fsync(const struct device *dev, uint64_t inode, uint64_t fh);
 int virtiofs_mkdir(const struct device *dev, uint64_t inode, const char *dirname, uint32_t mode);
-int virtiofs_unlink(const struct device *dev, const char *fname, enum fuse_object_type type);
+int virtiofs_unlink(
+	const struct device *dev, uint64_t parent_inode, const char *fname,
+	enum fuse_object_type type);
 int virtiofs_rename(
 	const struct device *dev, uint64_t old_dir_inode, const char *old_name,
 	uint64_t new_dir_inode, const char *new_name);
@@ -44,6 +49,9 @@ int virtiofs_statfs(const struct device *dev, struct fuse_kstatfs *response);
 int virtiofs_readdir(
 	const struct device *dev, uint64_t inode, uint64_t fh, uint64_t offset,
 	uint8_t *dirent_buf, uint32_t dirent_size, uint8_t *name_buf, uint32_t name_size);
+int virtiofs_readdirplus(
+	const struct device *dev, uint64_t inode, uint64_t fh, uint64_t offset,
+	struct fuse_direntplus *dirent, uint8_t *name_buf, uint32_t name_size);
 void virtiofs_forget(const struct device *dev, uint64_t inode, uint64_t nlookup);
 
 #endif /* ZEPHYR_SUBSYS_FS_VIRTIOFS_VIRTIOFS_H_ */
@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <errno.h>
+#include <string.h>
+#include "virtiofs_cache.h"
+
+static K_MUTEX_DEFINE(cache_lock);
+
+#ifdef CONFIG_VIRTIOFS_ENTRY_CACHE
+struct virtiofs_entry {
+	const struct device *dev;
+	uint64_t parent;
+	uint64_t nodeid;
+	struct fuse_attr attr;
+	/* uptime in ms until which the name and the attributes can be used */
+	int64_t entry_expiry;
+	int64_t attr_expiry;
+	/* host references owned by the entry, 0 if the slot is free */
+	uint64_t nlookup;
+	/* references lent to callers of virtiofs_lookup() */
+	uint32_t refs;
+	uint32_t lru;
+	/* 0 if the entry can't be found by name anymore */
+	uint8_t name_len;
+	char name[CONFIG_VIRTIOFS_ENTRY_CACHE_NAME_LEN];
+};
+
+static struct virtiofs_entry entries[CONFIG_VIRTIOFS_ENTRY_CACHE_SIZE];
+static uint32_t entry_lru;
+
+static int64_t virtiofs_expiry(int64_t now, uint64_t sec, uint32_t nsec)
+{
+	/* anything above a day is as good as forever and can't overflow */
+	if (sec > 24 * 60 * 60) {
+		return INT64_MAX;
+	}
+
+	return now + sec * MSEC_PER_SEC + nsec / NSEC_PER_MSEC;
+}
+
+static struct virtiofs_entry *virtiofs_entry_find(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct virtiofs_entry *e = &entries[i];
+
+		if (e->nlookup != 0 && e->dev == dev && e->parent == parent &&
+		    e->name_len == name_len && memcmp(e->name, name, name_len) == 0) {
+			return e;
+		}
+	}
+
+	return NULL;
+}
+
+static void virtiofs_entry_set_attr(
+	struct virtiofs_entry *e, const struct fuse_attr *attr, int64_t attr_expiry)
+{
+	/* like the page cache of Linux, drop the cached data of files changed on the host */
+	if (e->attr.size != attr->size || e->attr.mtime != attr->mtime ||
+	    e->attr.mtimensec != attr->mtimensec) {
+		virtiofs_page_cache_invalidate(e->dev, e->nodeid);
+	}
+
+	e->attr = *attr;
+	e->attr_expiry = attr_expiry;
+}
+
+bool virtiofs_entry_cache_lookup(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len,
+	bool need_attr, struct fuse_entry_out *response)
+{
+	int64_t now = k_uptime_get();
+	struct virtiofs_entry *e;
+	bool hit = false;
+
+	if (name_len == 0 || name_len > sizeof(e->name)) {
+		return false;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	e = virtiofs_entry_find(dev, parent, name, name_len);
+	if (e != NULL && e->entry_expiry > now && (!need_attr || e->attr_expiry > now)) {
+		memset(response, 0, sizeof(*response));
+		response->nodeid = e->nodeid;
+		response->attr = e->attr;
+		e->refs++;
+		e->lru = ++entry_lru;
+		hit = true;
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return hit;
+}
+
+static struct virtiofs_entry *virtiofs_entry_victim(void)
+{
+	struct virtiofs_entry *victim = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct virtiofs_entry *e = &entries[i];
+
+		if (e->nlookup == 0) {
+			return e;
+		}
+
+		/* entries still used by callers can't be forgotten, unreachable ones go first */
+		if (e->refs != 0) {
+			continue;
+		}
+
+		if (victim == NULL || (e->name_len == 0 && victim->name_len != 0) ||
+		    ((e->name_len == 0) == (victim->name_len == 0) &&
+		     (int32_t)(e->lru - victim->lru) < 0)) {
+			victim = e;
+		}
+	}
+
+	return victim;
+}
+
+void virtiofs_entry_cache_insert(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len,
+	const struct fuse_entry_out *entry, bool lent, uint64_t *evict_nodeid,
+	uint64_t *evict_nlookup)
+{
+	int64_t now = k_uptime_get();
+	struct virtiofs_entry *e;
+
+	*evict_nodeid = 0;
+	*evict_nlookup = 0;
+
+	if (name_len == 0 || name_len > sizeof(e->name)) {
+		goto uncached;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	e = virtiofs_entry_find(dev, parent, name, name_len);
+	if (e != NULL && e->nodeid != entry->nodeid) {
+		/* the name now refers to another node, keep the old one until it's unused */
+		e->name_len = 0;
+		e = NULL;
+	}
+
+	if (e == NULL) {
+		e = virtiofs_entry_victim();
+		if (e == NULL) {
+			k_mutex_unlock(&cache_lock);
+			goto uncached;
+		}
+
+		if (e->nlookup != 0) {
+			*evict_nodeid = e->nodeid;
+			*evict_nlookup = e->nlookup;
+		}
+
+		/*
+		 * nothing is known about the node since its previous entry was evicted, so its
+		 * cached pages can't be trusted anymore
+		 */
+		virtiofs_page_cache_invalidate(dev, entry->nodeid);
+
+		e->dev = dev;
+		e->parent = parent;
+		e->nodeid = entry->nodeid;
+		e->attr = entry->attr;
+		e->nlookup = 0;
+		e->refs = 0;
+		e->name_len = name_len;
+		memcpy(e->name, name, name_len);
+	}
+
+	e->nlookup++;
+	e->refs += lent ? 1 : 0;
+	e->lru = ++entry_lru;
+	e->entry_expiry = virtiofs_expiry(now, entry->entry_valid, entry->entry_valid_nsec);
+	virtiofs_entry_set_attr(
+		e, &entry->attr, virtiofs_expiry(now, entry->attr_valid, entry->attr_valid_nsec)
+	);
+
+	k_mutex_unlock(&cache_lock);
+
+	return;
+
+uncached:
+	/* a lent reference is dropped by the caller, otherwise it has to be forgotten now */
+	if (!lent) {
+		*evict_nodeid = entry->nodeid;
+		*evict_nlookup = 1;
+	}
+}
+
+bool virtiofs_entry_cache_put(const struct device *dev, uint64_t nodeid, uint64_t nlookup)
+{
+	bool absorbed = false;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct virtiofs_entry *e = &entries[i];
+
+		if (e->nlookup != 0 && e->dev == dev && e->nodeid == nodeid &&
+		    e->refs >= nlookup) {
+			e->refs -= nlookup;
+			absorbed = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return absorbed;
+}
+
+void virtiofs_entry_cache_invalidate(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct virtiofs_entry *e = &entries[i];
+
+		if (e->nlookup != 0 && e->dev == dev && e->parent == parent &&
+		    e->name_len == name_len && memcmp(e->name, name, name_len) == 0) {
+			e->name_len = 0;
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void virtiofs_entry_cache_invalidate_attr(const struct device *dev, uint64_t nodeid)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct virtiofs_entry *e = &entries[i];
+
+		if (e->nlookup != 0 && e->dev == dev && e->nodeid == nodeid) {
+			e->attr_expiry = 0;
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void virtiofs_entry_cache_update_attr(
+	const struct device *dev, uint64_t nodeid, const struct fuse_attr_out *attr)
+{
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct virtiofs_entry *e = &entries[i];
+
+		if (e->nlookup != 0 && e->dev == dev && e->nodeid == nodeid) {
+			virtiofs_entry_set_attr(
+				e, &attr->attr,
+				virtiofs_expiry(now, attr->attr_valid, attr->attr_valid_nsec)
+			);
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void virtiofs_entry_cache_clear(const struct device *dev)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (entries[i].dev == dev) {
+			entries[i].nlookup = 0;
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+#endif /* CONFIG_VIRTIOFS_ENTRY_CACHE */
+
+#ifdef CONFIG_VIRTIOFS_PAGE_CACHE
+enum virtiofs_page_state {
+	VIRTIOFS_PAGE_FREE,
+	VIRTIOFS_PAGE_VALID,
+	/* reserved for a FUSE_READ in progress */
+	VIRTIOFS_PAGE_BUSY,
+	/* invalidated while the FUSE_READ was in progress, freed on commit */
+	VIRTIOFS_PAGE_DROPPED,
+};
+
+struct virtiofs_page {
+	const struct device *dev;
+	uint64_t nodeid;
+	uint64_t index;
+	uint32_t lru;
+	/* number of valid bytes, less than the page size for the last page of a file */
+	uint32_t len;
+	uint8_t state;
+};
+
+static struct virtiofs_page pages[CONFIG_VIRTIOFS_PAGE_CACHE_PAGES];
+static uint8_t page_data[CONFIG_VIRTIOFS_PAGE_CACHE_PAGES][VIRTIOFS_PAGE_SIZE] __aligned(8);
+static uint32_t page_lru;
+
+static struct virtiofs_page *virtiofs_page_find(
+	const struct device *dev, uint64_t nodeid, uint64_t index)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pages); i++) {
+		struct virtiofs_page *p = &pages[i];
+
+		if ((p->state == VIRTIOFS_PAGE_VALID || p->state == VIRTIOFS_PAGE_BUSY) &&
+		    p->dev == dev && p->nodeid == nodeid && p->index == index) {
+			return p;
+		}
+	}
+
+	return NULL;
+}
+
+int virtiofs_page_cache_read(
+	const struct device *dev, uint64_t nodeid, uint64_t index, uint32_t offset,
+	uint8_t *dest, uint32_t size)
+{
+	struct virtiofs_page *p;
+	int ret = -ENOENT;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	p = virtiofs_page_find(dev, nodeid, index);
+	if (p != NULL && p->state == VIRTIOFS_PAGE_VALID) {
+		ret = offset < p->len ? MIN(size, p->len - offset) : 0;
+		memcpy(dest, page_data[p - pages] + offset, ret);
+		p->lru = ++page_lru;
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return ret;
+}
+
+static struct virtiofs_page *virtiofs_page_victim(void)
+{
+	struct virtiofs_page *victim = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(pages); i++) {
+		struct virtiofs_page *p = &pages[i];
+
+		if (p->state == VIRTIOFS_PAGE_FREE) {
+			return p;
+		}
+
+		if (p->state == VIRTIOFS_PAGE_VALID &&
+		    (victim == NULL || (int32_t)(p->lru - victim->lru) < 0)) {
+			victim = p;
+		}
+	}
+
+	return victim;
+}
+
+uint32_t virtiofs_page_cache_reserve(
+	const struct device *dev, uint64_t nodeid, uint64_t index, uint32_t count,
+	uint8_t **buffers)
+{
+	uint32_t reserved = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	while (reserved < count) {
+		struct virtiofs_page *p;
+
+		if (virtiofs_page_find(dev, nodeid, index + reserved) != NULL) {
+			break;
+		}
+
+		p = virtiofs_page_victim();
+		if (p == NULL) {
+			break;
+		}
+
+		p->dev = dev;
+		p->nodeid = nodeid;
+		p->index = index + reserved;
+		p->len = 0;
+		p->state = VIRTIOFS_PAGE_BUSY;
+		buffers[reserved++] = page_data[p - pages];
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return reserved;
+}
+
+void virtiofs_page_cache_commit(uint8_t **buffers, uint32_t count, int len)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (uint32_t i = 0; i < count; i++) {
+		struct virtiofs_page *p = &pages[(buffers[i] - page_data[0]) / VIRTIOFS_PAGE_SIZE];
+
+		if (len < 0 || p->state == VIRTIOFS_PAGE_DROPPED) {
+			p->state = VIRTIOFS_PAGE_FREE;
+			continue;
+		}
+
+		/* pages past the end of file are kept empty, so that reads there hit as well */
+		p->len = CLAMP(len - (int)(i * VIRTIOFS_PAGE_SIZE), 0, VIRTIOFS_PAGE_SIZE);
+		p->lru = ++page_lru;
+		p->state = VIRTIOFS_PAGE_VALID;
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void virtiofs_page_cache_invalidate(const struct device *dev, uint64_t nodeid)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(pages); i++) {
+		struct virtiofs_page *p = &pages[i];
+
+		if (p->state == VIRTIOFS_PAGE_FREE || p->dev != dev ||
+		    (nodeid != 0 && p->nodeid != nodeid)) {
+			continue;
+		}
+
+		p->state = p->state == VIRTIOFS_PAGE_VALID ? VIRTIOFS_PAGE_FREE
+							   : VIRTIOFS_PAGE_DROPPED;
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+#endif /* CONFIG_VIRTIOFS_PAGE_CACHE */
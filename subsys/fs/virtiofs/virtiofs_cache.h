@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * RAM caches of the virtiofs client. They only keep track of data, all FUSE requests are
+ * issued by their users (virtiofs.c and virtiofs_zfs.c).
+ */
+
+#ifndef ZEPHYR_SUBSYS_FS_VIRTIOFS_VIRTIOFS_CACHE_H_
+#define ZEPHYR_SUBSYS_FS_VIRTIOFS_VIRTIOFS_CACHE_H_
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <../fuse_client/fuse_client.h>
+
+#ifdef CONFIG_VIRTIOFS_ENTRY_CACHE
+/*
+ * Each cache entry owns the host lookup references (nlookup) of its node and lends them to
+ * the callers of virtiofs_lookup(). The matching virtiofs_forget() is absorbed by the cache,
+ * FUSE_FORGET is only sent when an entry is evicted.
+ */
+
+/**
+ * @brief looks up a name in the entry cache
+ *
+ * @param need_attr if true the attributes must still be valid as well
+ * @param response filled with the cached node id and attributes on hit
+ * @return true on hit, the caller then holds a reference it has to drop with virtiofs_forget()
+ */
+bool virtiofs_entry_cache_lookup(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len,
+	bool need_attr, struct fuse_entry_out *response);
+
+/**
+ * @brief adds the result of a FUSE_LOOKUP or a FUSE_READDIRPLUS entry to the cache
+ *
+ * @param lent true if the caller keeps the reference and will drop it with virtiofs_forget()
+ * @param evict_nodeid set to the node whose references have to be sent in FUSE_FORGET, 0 if none
+ * @param evict_nlookup set to the number of references to forget
+ */
+void virtiofs_entry_cache_insert(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len,
+	const struct fuse_entry_out *entry, bool lent, uint64_t *evict_nodeid,
+	uint64_t *evict_nlookup);
+
+/**
+ * @brief returns references lent by the cache
+ *
+ * @return true if the references were lent by the cache and no FUSE_FORGET is needed
+ */
+bool virtiofs_entry_cache_put(const struct device *dev, uint64_t nodeid, uint64_t nlookup);
+
+/* makes the entry with the given name in the parent directory unreachable */
+void virtiofs_entry_cache_invalidate(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len);
+
+/* marks the attributes of a node as expired */
+void virtiofs_entry_cache_invalidate_attr(const struct device *dev, uint64_t nodeid);
+
+/* updates the attributes of a node, e.g. with the result of FUSE_SETATTR */
+void virtiofs_entry_cache_update_attr(
+	const struct device *dev, uint64_t nodeid, const struct fuse_attr_out *attr);
+
+/* drops all the entries of a device without forgetting them, used on FUSE_DESTROY */
+void virtiofs_entry_cache_clear(const struct device *dev);
+#else
+static inline bool virtiofs_entry_cache_lookup(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len,
+	bool need_attr, struct fuse_entry_out *response)
+{
+	return false;
+}
+
+static inline void virtiofs_entry_cache_insert(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len,
+	const struct fuse_entry_out *entry, bool lent, uint64_t *evict_nodeid,
+	uint64_t *evict_nlookup)
+{
+	*evict_nodeid = lent ? 0 : entry->nodeid;
+	*evict_nlookup = 1;
+}
+
+static inline bool virtiofs_entry_cache_put(
+	const struct device *dev, uint64_t nodeid, uint64_t nlookup)
+{
+	return false;
+}
+
+static inline void virtiofs_entry_cache_invalidate(
+	const struct device *dev, uint64_t parent, const char *name, uint32_t name_len)
+{
+}
+
+static inline void virtiofs_entry_cache_invalidate_attr(const struct device *dev, uint64_t nodeid)
+{
+}
+
+static inline void virtiofs_entry_cache_update_attr(
+	const struct device *dev, uint64_t nodeid, const struct fuse_attr_out *attr)
+{
+}
+
+static inline void virtiofs_entry_cache_clear(const struct device *dev)
+{
+}
+#endif /* CONFIG_VIRTIOFS_ENTRY_CACHE */
+
+#ifdef CONFIG_VIRTIOFS_PAGE_CACHE
+#define VIRTIOFS_PAGE_SIZE CONFIG_VIRTIOFS_PAGE_CACHE_PAGE_SIZE
+
+/**
+ * @brief copies data from a cached page
+ *
+ * @param offset offset within the page
+ * @param size number of bytes to copy, must not cross the page boundary
+ * @return number of bytes copied, less than size at the end of file, -ENOENT on miss
+ */
+int virtiofs_page_cache_read(
+	const struct device *dev, uint64_t nodeid, uint64_t index, uint32_t offset,
+	uint8_t *dest, uint32_t size);
+
+/**
+ * @brief reserves pages to be filled with a single FUSE_READ
+ *
+ * Reservation stops at the first page that is already cached or when no page can be evicted.
+ *
+ * @param index index of the first page
+ * @param count maximum number of pages to reserve
+ * @param pages filled with the buffers of the reserved pages
+ * @return number of pages reserved
+ */
+uint32_t virtiofs_page_cache_reserve(
+	const struct device *dev, uint64_t nodeid, uint64_t index, uint32_t count,
+	uint8_t **pages);
+
+/**
+ * @brief publishes reserved pages after the FUSE_READ completed
+ *
+ * @param len number of bytes read into the pages, negative on failure to release them
+ */
+void virtiofs_page_cache_commit(uint8_t **pages, uint32_t count, int len);
+
+/* drops the cached pages of a node, nodeid == 0 drops all the pages of the device */
+void virtiofs_page_cache_invalidate(const struct device *dev, uint64_t nodeid);
+#else
+static inline void virtiofs_page_cache_invalidate(const struct device *dev, uint64_t nodeid)
+{
+}
+#endif /* CONFIG_VIRTIOFS_PAGE_CACHE */
+
+#endif /* ZEPHYR_SUBSYS_FS_VIRTIOFS_VIRTIOFS_CACHE_H_ */
@@ -12,6 +12,7 @@
 #include "../fs_impl.h"
 #include <string.h>
 #include "virtiofs.h"
+#include "virtiofs_cache.h"
 
 #define MODE_FTYPE_MASK 0170000
 #define MODE_FTYPE_DIR 040000
@@ -24,6 +25,12 @@ struct virtiofs_file {
 	uint64_t nodeid;
 	uint64_t offset;
 	uint32_t open_flags;
+#ifdef CONFIG_VIRTIOFS_PAGE_CACHE
+	/* offset following the previous read, used to detect sequential reads */
+	uint64_t next_read;
+	/* daemon asked to bypass the page cache (FOPEN_DIRECT_IO) */
+	bool direct_io;
+#endif
 };
 
 struct virtiofs_dir {
@@ -87,6 +94,26 @@ static const char *strip_path(const char *fpath)
 	return c;
 }
 
+static void virtiofs_zfs_init_file(
+	struct virtiofs_file *file, const struct device *dev, uint64_t nodeid,
+	const struct fuse_open_out *open_ret, int flags)
+{
+	file->fh = open_ret->fh;
+	file->nodeid = nodeid;
+	file->offset = 0;
+	file->open_flags = flags;
+
+#ifdef CONFIG_VIRTIOFS_PAGE_CACHE
+	file->next_read = 0;
+	file->direct_io = (open_ret->open_flags & FOPEN_DIRECT_IO) != 0;
+
+	/* same as Linux, cached data of a file is only reused if the daemon allows it */
+	if (!(open_ret->open_flags & FOPEN_KEEP_CACHE)) {
+		virtiofs_page_cache_invalidate(dev, nodeid);
+	}
+#endif
+}
+
 /*
  * despite the similarity of fuse/virtiofs to posix fs functions there are some notable differences:
  * - open() is split into lookup+open in case of existing files and lookup+create in case of
@@ -117,10 +144,9 @@ static int virtiofs_zfs_open_existing(
 			return ret;
 		}
 
-		file->fh = open_ret.fh;
-		file->nodeid = lookup_ret.nodeid;
-		file->offset = 0;
-		file->open_flags = flags;
+		virtiofs_zfs_init_file(
+			file, filp->mp->storage_dev, lookup_ret.nodeid, &open_ret, flags
+		);
 
 		filp->filep = file;
 	}
@@ -149,10 +175,10 @@ static int virtiofs_zfs_open_create(
 			return ret;
 		}
 
-		file->fh = create_ret.open_out.fh;
-		file->nodeid = create_ret.entry_out.nodeid;
-		file->offset = 0;
-		file->open_flags = flags;
+		virtiofs_zfs_init_file(
+			file, filp->mp->storage_dev, create_ret.entry_out.nodeid,
+			&create_ret.open_out, flags
+		);
 
 		filp->filep = file;
 	}
@@ -209,15 +235,115 @@ static int virtiofs_zfs_close(struct fs_file_t *filp)
 	return 0;
 }
 
+#ifdef CONFIG_VIRTIOFS_PAGE_CACHE
+#define VIRTIOFS_READAHEAD_SIZE (CONFIG_VIRTIOFS_READAHEAD_PAGES * VIRTIOFS_PAGE_SIZE)
+
+static int virtiofs_zfs_fill_pages(struct fs_file_t *filp, uint64_t index, uint32_t count)
+{
+	struct virtiofs_file *file = filp->filep;
+	uint8_t *pages[CONFIG_VIRTIOFS_READAHEAD_PAGES];
+	uint32_t reserved = virtiofs_page_cache_reserve(
+		filp->mp->storage_dev, file->nodeid, index, count, pages
+	);
+
+	if (reserved == 0) {
+		return -ENOMEM;
+	}
+
+	int ret = virtiofs_readv(
+		filp->mp->storage_dev, file->nodeid, file->fh, index * VIRTIOFS_PAGE_SIZE, pages,
+		reserved, VIRTIOFS_PAGE_SIZE
+	);
+
+	virtiofs_page_cache_commit(pages, reserved, ret);
+
+	return ret < 0 ? ret : 0;
+}
+
+static ssize_t virtiofs_zfs_read_cached(struct fs_file_t *filp, uint8_t *dest, size_t nbytes)
+{
+	struct virtiofs_file *file = filp->filep;
+	bool sequential = file->offset == file->next_read;
+	size_t read_c = 0;
+
+	while (read_c < nbytes) {
+		uint64_t pos = file->offset + read_c;
+		uint64_t index = pos / VIRTIOFS_PAGE_SIZE;
+		uint32_t in_page = pos % VIRTIOFS_PAGE_SIZE;
+		uint32_t size = MIN(nbytes - read_c, VIRTIOFS_PAGE_SIZE - in_page);
+		int ret = virtiofs_page_cache_read(
+			filp->mp->storage_dev, file->nodeid, index, in_page, dest + read_c, size
+		);
+
+		if (ret == -ENOENT) {
+			/*
+			 * fetch the pages covering the rest of the request, or the whole readahead
+			 * window when the file is read sequentially
+			 */
+			uint32_t count = sequential ? CONFIG_VIRTIOFS_READAHEAD_PAGES
+				: DIV_ROUND_UP(in_page + nbytes - read_c, VIRTIOFS_PAGE_SIZE);
+
+			ret = virtiofs_zfs_fill_pages(
+				filp, index, MIN(count, CONFIG_VIRTIOFS_READAHEAD_PAGES)
+			);
+			if (ret == 0) {
+				ret = virtiofs_page_cache_read(
+					filp->mp->storage_dev, file->nodeid, index, in_page,
+					dest + read_c, size
+				);
+			}
+
+			/* the cache is busy or the page was dropped meanwhile, go to the host */
+			if (ret == -ENOMEM || ret == -ENOENT) {
+				ret = virtiofs_read(
+					filp->mp->storage_dev, file->nodeid, file->fh, pos, size,
+					dest + read_c
+				);
+			}
+		}
+
+		if (ret < 0) {
+			if (read_c == 0) {
+				return ret;
+			}
+			break;
+		}
+
+		read_c += ret;
+
+		/* end of file */
+		if (ret < size) {
+			break;
+		}
+	}
+
+	file->offset += read_c;
+	file->next_read = file->offset;
+
+	return read_c;
+}
+#endif /* CONFIG_VIRTIOFS_PAGE_CACHE */
+
 static ssize_t virtiofs_zfs_read(struct fs_file_t *filp, void *dest, size_t nbytes)
 {
 	struct virtiofs_file *file = filp->filep;
+
+#ifdef CONFIG_VIRTIOFS_PAGE_CACHE
+	/* reads spanning the whole readahead window gain nothing from an extra copy */
+	if (!file->direct_io && nbytes < VIRTIOFS_READAHEAD_SIZE) {
+		return virtiofs_zfs_read_cached(filp, dest, nbytes);
+	}
+#endif
+
 	int read_c = virtiofs_read(
 		filp->mp->storage_dev, file->nodeid, file->fh, file->offset, nbytes, dest
 	);
 
 	if (read_c >= 0) {
 		file->offset += read_c;
+#ifdef CONFIG_VIRTIOFS_PAGE_CACHE
+		file->next_read = file->offset;
+#endif
 	}
 
 	return read_c;
@@ -308,6 +434,9 @@ static ssize_t virtio_zfs_write(struct fs_file_t *filp, const void *src, size_t
 			curr_size, curr_addr
 		);
 
+		/* after the write completed, so that no read in progress can cache stale data */
+		virtiofs_page_cache_invalidate(filp->mp->storage_dev, file->nodeid);
+
 		if (ret >= 0) {
 			write_c += ret;
 		} else {
@@ -349,7 +478,11 @@ static int virtiofs_zfs_truncate(struct fs_file_t *filp, off_t length)
 	attrs.size = length;
 	attrs.valid = FATTR_SIZE;
 
-	return virtiofs_setattr(filp->mp->storage_dev, file->nodeid, &attrs, &setattr_ret);
+	int ret = virtiofs_setattr(filp->mp->storage_dev, file->nodeid, &attrs, &setattr_ret);
+
+	virtiofs_page_cache_invalidate(filp->mp->storage_dev, file->nodeid);
+
+	return ret;
 }
 
 static int virtiofs_zfs_sync(struct fs_file_t *filp)
@@ -417,11 +550,83 @@ static int virtiofs_zfs_opendir(struct fs_dir_t *dirp, const char *fs_path)
 	return ret;
 }
 
+static int virtiofs_zfs_fill_dirent(
+	struct fs_dir_t *dirp, struct fs_dirent *entry, uint32_t type, const struct fuse_attr *attr)
+{
+	struct virtiofs_dir *dir = dirp->dirp;
+
+	if (type == DT_REG) {
+		struct fuse_entry_out lookup_ret;
+
+		/* attributes come with FUSE_READDIRPLUS, otherwise the file has to be looked up */
+		if (attr == NULL) {
+			int ret = virtiofs_lookup(
+				dirp->mp->storage_dev, dir->nodeid, entry->name, &lookup_ret, NULL
+			);
+
+			if (ret != 0) {
+				return ret;
+			}
+
+			virtiofs_forget(dirp->mp->storage_dev, lookup_ret.nodeid, 1);
+			attr = &lookup_ret.attr;
+		}
+
+		entry->type = FS_DIR_ENTRY_FILE;
+		entry->size = attr->size;
+	} else if (type == DT_DIR) {
+		entry->type = FS_DIR_ENTRY_DIR;
+		entry->size = 0;
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static int virtiofs_zfs_readdirplus(struct fs_dir_t *dirp, struct fs_dirent *entry)
+{
+	struct virtiofs_dir *dir = dirp->dirp;
+	struct fuse_direntplus de;
+
+	int read_c = virtiofs_readdirplus(
+		dirp->mp->storage_dev, dir->nodeid, dir->fh, dir->offset, &de,
+		(uint8_t *)&entry->name, sizeof(entry->name)
+	);
+
+	if (read_c < 0) {
+		return read_c;
+	}
+
+	/* end of dir */
+	if (read_c == 0) {
+		entry->name[0] = '\0';
+		return 0;
+	}
+
+	if (read_c < sizeof(de) || de.dirent.namelen >= sizeof(entry->name) - 1) {
+		return -EIO;
+	}
+
+	entry->name[de.dirent.namelen] = '\0';
+
+	dir->offset = de.dirent.off;
+
+	return virtiofs_zfs_fill_dirent(
+		dirp, entry, de.dirent.type, de.entry_out.nodeid != 0 ? &de.entry_out.attr : NULL
+	);
+}
+
 static int virtiofs_zfs_readdir(struct fs_dir_t *dirp, struct fs_dirent *entry)
 {
 	struct virtiofs_dir *dir = dirp->dirp;
+	struct virtiofs_fs_data *fs_data = dirp->mp->fs_data;
 	struct fuse_dirent de;
 
+	if (IS_ENABLED(CONFIG_VIRTIOFS_READDIRPLUS) && (fs_data->flags & FUSE_DO_READDIRPLUS)) {
+		return virtiofs_zfs_readdirplus(dirp, entry);
+	}
+
 	int read_c = virtiofs_readdir(
 		dirp->mp->storage_dev, dir->nodeid, dir->fh, dir->offset,
 		(uint8_t *)&de, sizeof(de), (uint8_t *)&entry->name, sizeof(entry->name)
@@ -445,28 +650,7 @@ static int virtiofs_zfs_readdir(struct fs_dir_t *dirp, struct fs_dirent *entry)
 
 	dir->offset = de.off;
 
-	if (de.type == DT_REG) {
-		struct fuse_entry_out lookup_ret;
-		int ret = virtiofs_lookup(
-			dirp->mp->storage_dev, dir->nodeid, entry->name, &lookup_ret, NULL
-		);
-
-		if (ret != 0) {
-			return ret;
-		}
-
-		virtiofs_forget(dirp->mp->storage_dev, lookup_ret.nodeid, 1);
-
-		entry->type = FS_DIR_ENTRY_FILE;
-		entry->size = lookup_ret.attr.size;
-	} else if (de.type == DT_DIR) {
-		entry->type = FS_DIR_ENTRY_DIR;
-		entry->size = 0;
-	} else {
-		return -ENOTSUP;
-	}
-
-	return 0;
+	return virtiofs_zfs_fill_dirent(dirp, entry, de.type, NULL);
 }
 
 static int virtiofs_zfs_closedir(struct fs_dir_t *dirp)
@@ -495,6 +679,7 @@ static int virtiofs_zfs_mount(struct fs_mount_t *mountp)
 		struct virtiofs_fs_data *fs_data = mountp->fs_data;
 
 		fs_data->max_write = out.max_write;
+		fs_data->flags = out.flags;
 	}
 
 	return ret;
@@ -502,6 +687,8 @@ static int virtiofs_zfs_mount(struct fs_mount_t *mountp)
 
 static int virtiofs_zfs_unmount(struct fs_mount_t *mountp)
 {
+	virtiofs_page_cache_invalidate(mountp->storage_dev, 0);
+
 	return virtiofs_destroy(mountp->storage_dev);
 }
 
@@ -540,40 +727,36 @@ static int virtiofs_zfs_stat(
 static int virtiofs_zfs_unlink(struct fs_mount_t *mountp, const char *name)
 {
 	const char *path = virtiofs_strip_prefix(name, mountp);
-	struct fs_dirent d;
-	int ret = virtiofs_zfs_stat(mountp, name, &d);
+	uint64_t parent_inode = FUSE_ROOT_INODE;
+	struct fuse_entry_out lookup_ret;
+	int ret;
+
+	/*
+	 * The parent is needed to invalidate the cached entry. Even if unlink doesn't take
+	 * nodeid as a param it still fails with -EIO if the file wasn't looked up using some
+	 * virtiofsd versions. It happens at least with the one from Debian's package
+	 * (Debian 1:7.2+dfsg-7+deb12u7). Virtiofsd 1.12.0 built from sources doesn't need it
+	 */
+	ret = virtiofs_lookup(
+		mountp->storage_dev, FUSE_ROOT_INODE, path, &lookup_ret, &parent_inode
+	);
 
 	if (ret != 0) {
+		if (parent_inode != 0 && parent_inode != FUSE_ROOT_INODE) {
+			virtiofs_forget(mountp->storage_dev, parent_inode, 1);
+		}
 		return ret;
 	}
 
-	if (d.type == FS_DIR_ENTRY_FILE) {
-#ifdef CONFIG_VIRTIOFS_VIRTIOFSD_UNLINK_QUIRK
-		struct fuse_entry_out lookup_ret;
-		/*
-		 * Even if unlink doesn't take nodeid as a param it still fails with -EIO if the
-		 * file wasn't looked up using some virtiofsd versions. It happens at least with
-		 * the one from Debian's package (Debian 1:7.2+dfsg-7+deb12u7). Virtiofsd 1.12.0
-		 * built from sources doesn't need it
-		 */
-		ret = virtiofs_lookup(
-			mountp->storage_dev, FUSE_ROOT_INODE, path, &lookup_ret, NULL
-		);
-
-		if (ret != 0) {
-			return ret;
-		}
-#endif
-
-		ret = virtiofs_unlink(mountp->storage_dev, path, FUSE_FILE);
-
-#ifdef CONFIG_VIRTIOFS_VIRTIOFSD_UNLINK_QUIRK
-		virtiofs_forget(mountp->storage_dev, lookup_ret.nodeid, 1);
-#endif
+	if ((lookup_ret.attr.mode & MODE_FTYPE_MASK) == MODE_FTYPE_DIR) {
+		ret = virtiofs_unlink(mountp->storage_dev, parent_inode, path, FUSE_DIR);
 	} else {
-		ret = virtiofs_unlink(mountp->storage_dev, path, FUSE_DIR);
+		ret = virtiofs_unlink(mountp->storage_dev, parent_inode, path, FUSE_FILE);
 	}
 
+	virtiofs_forget(mountp->storage_dev, lookup_ret.nodeid, 1);
+	virtiofs_forget(mountp->storage_dev, parent_inode, 1);
+
 	return ret;
 }
 
@@ -546,17 +546,38 @@ static bool zms_empty_ate_valid(struct zms_fs *fs, const struct zms_ate *entry)
 		(entry->len == 0xffff) && (entry->id == ZMS_HEAD_ID));
 }
 
+/* zms_tx_marker_get returns the transaction marker held by a header ATE
+ * (ZMS_TX_BEGIN_MARKER or ZMS_TX_COMMIT_MARKER), 0 if the ATE is not a transaction marker.
+ * The caller is responsible for validating the ATE itself.
+ */
+static uint16_t zms_tx_marker_get(const struct zms_ate *entry)
+{
+	uint16_t marker;
+
+	if ((entry->id != ZMS_HEAD_ID) || entry->len) {
+		return 0;
+	}
+
+	marker = ZMS_GET_TX_MARKER(entry->offset);
+	if ((marker != ZMS_TX_BEGIN_MARKER) && (marker != ZMS_TX_COMMIT_MARKER)) {
+		return 0;
+	}
+
+	return marker;
+}
+
 /* zms_gc_done_ate_valid validates a garbage collector done ATE
  * Valid gc_done_ate:
  * - valid ate
  * - len = 0
  * - id = ZMS_HEAD_ID
+ * - not a transaction marker
  * return true if valid, false otherwise
  */
 static bool zms_gc_done_ate_valid(struct zms_fs *fs, const struct zms_ate *entry)
 {
 	return (zms_ate_valid_different_sector(fs, entry, entry->cycle_cnt) && (!entry->len) &&
-		(entry->id == ZMS_HEAD_ID));
+		(entry->id == ZMS_HEAD_ID) && !zms_tx_marker_get(entry));
 }
 
 /* zms_sector_closed checks whether the current sector is closed, which would imply
@@ -596,31 +617,38 @@ static int zms_validate_closed_sector(struct zms_fs *fs, uint64_t addr, struct z
 	return 0;
 }
 
-/* store an entry in flash */
-static int zms_flash_write_entry(struct zms_fs *fs, zms_id_t id, const void *data, size_t len)
+/* prepare the ATE of an entry whose data (if not stored in the ATE) is written at data_addr */
+static void zms_entry_ate_init(struct zms_fs *fs, struct zms_ate *entry, zms_id_t id,
+			       const void *data, size_t len, uint64_t data_addr)
 {
-	int rc;
-	struct zms_ate entry;
-
 	/* Initialize all members to 0 */
-	memset(&entry, 0, sizeof(struct zms_ate));
+	memset(entry, 0, sizeof(struct zms_ate));
 
-	entry.id = id;
-	entry.len = (uint16_t)len;
-	entry.cycle_cnt = fs->sector_cycle;
+	entry->id = id;
+	entry->len = (uint16_t)len;
+	entry->cycle_cnt = fs->sector_cycle;
 
 	if (len > ZMS_DATA_IN_ATE_SIZE) {
 #ifdef CONFIG_ZMS_DATA_CRC
 		/* only compute CRC if data is to be stored outside of entry */
-		entry.data_crc = crc32_ieee(data, len);
+		entry->data_crc = crc32_ieee(data, len);
 #endif
-		entry.offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
+		entry->offset = (uint32_t)SECTOR_OFFSET(data_addr);
 	} else if ((len > 0) && (len <= ZMS_DATA_IN_ATE_SIZE)) {
 		/* Copy data into entry for small data (at most ZMS_DATA_IN_ATE_SIZE bytes) */
-		memcpy(&entry.data, data, len);
+		memcpy(&entry->data, data, len);
 	}
 
-	zms_ate_crc8_update(&entry);
+	zms_ate_crc8_update(entry);
+}
+
+/* store an entry in flash */
+static int zms_flash_write_entry(struct zms_fs *fs, zms_id_t id, const void *data, size_t len)
+{
+	int rc;
+	struct zms_ate entry;
+
+	zms_entry_ate_init(fs, &entry, id, data, len, fs->data_wra);
 
 	if (len > ZMS_DATA_IN_ATE_SIZE) {
 		rc = zms_flash_data_wrt(fs, data, len);
@@ -741,9 +769,9 @@ static void zms_sector_advance(struct zms_fs *fs, uint64_t *addr)
 }
 
 /* allocation entry close (this closes the current sector) by writing offset
- * of last ate to the sector end.
+ * of the most recent ate to consider in this sector to the sector end.
  */
-static int zms_sector_close(struct zms_fs *fs)
+static int zms_sector_close_at(struct zms_fs *fs, uint32_t last_ate_offset)
 {
 	int rc;
 	struct zms_ate close_ate;
@@ -754,7 +782,7 @@ static int zms_sector_close(struct zms_fs *fs)
 
 	close_ate.id = ZMS_HEAD_ID;
 	close_ate.len = 0U;
-	close_ate.offset = (uint32_t)SECTOR_OFFSET(fs->ate_wra + fs->ate_size);
+	close_ate.offset = last_ate_offset;
 	close_ate.cycle_cnt = fs->sector_cycle;
 
 	/* When we close the sector, we must write all non used ATE with
@@ -799,6 +827,12 @@ static int zms_sector_close(struct zms_fs *fs)
 	return 0;
 }
 
+/* close the current sector after the last written ate */
+static int zms_sector_close(struct zms_fs *fs)
+{
+	return zms_sector_close_at(fs, (uint32_t)SECTOR_OFFSET(fs->ate_wra + fs->ate_size));
+}
+
 static int zms_add_gc_done_ate(struct zms_fs *fs)
 {
 	struct zms_ate gc_done_ate;
@@ -1164,6 +1198,118 @@ gc_done:
 	return rc;
 }
 
+#ifdef CONFIG_ZMS_WRITE_MULTI
+/* Discard a transaction that is not committed or torn: the current sector is closed
+ * before the begin marker of the transaction, so that its ATEs are never walked through, and
+ * the garbage collector is run on the next sector.
+ */
+static int zms_tx_discard(struct zms_fs *fs, uint64_t begin_addr)
+{
+	int rc;
+
+	LOG_WRN("Discarding uncommitted transaction at %llx", begin_addr);
+
+	if (flash_params_get_erase_cap(fs->flash_parameters) & FLASH_ERASE_C_EXPLICIT) {
+		/* Data of the transaction may have been written past fs->data_wra and cannot
+		 * be overwritten with garbage ATEs. Skip filling the free space, this sector
+		 * will be erased anyway before being used again.
+		 */
+		fs->data_wra = fs->ate_wra + fs->ate_size;
+	}
+
+	rc = zms_sector_close_at(fs, (uint32_t)SECTOR_OFFSET(begin_addr + fs->ate_size));
+	if (rc) {
+		return rc;
+	}
+
+	return zms_gc(fs);
+}
+
+/* Search the open sector for a transaction that is not complete and discard it, along with
+ * everything written after it. A transaction is complete when its begin marker is followed by
+ * as many valid ATEs as both markers count, and then by its commit marker. Otherwise the write
+ * was interrupted or torn.
+ */
+static int zms_tx_recover(struct zms_fs *fs)
+{
+	int rc;
+	bool tx_open = false;
+	bool tx_torn = false;
+	uint64_t addr;
+	uint64_t begin_addr = 0U;
+	uint64_t discard_addr = 0U;
+	size_t tx_count = 0U;
+	size_t tx_entries = 0U;
+	uint8_t cycle_cnt;
+	uint16_t marker;
+	struct zms_ate ate;
+
+	rc = zms_get_sector_cycle(fs, fs->ate_wra, &cycle_cnt);
+	if (rc == -ENOENT) {
+		/* sector never used */
+		return 0;
+	} else if (rc) {
+		/* bad flash read */
+		return rc;
+	}
+
+	/* walk the open sector from the oldest ATE to the most recent one */
+	addr = zms_close_ate_addr(fs, fs->ate_wra) - fs->ate_size;
+	while (addr > fs->ate_wra) {
+		rc = zms_flash_ate_rd(fs, addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (zms_ate_valid_different_sector(fs, &ate, cycle_cnt)) {
+			marker = zms_tx_marker_get(&ate);
+			if (marker == ZMS_TX_BEGIN_MARKER) {
+				if (tx_open && !tx_torn) {
+					/* begin marker without a commit marker */
+					tx_torn = true;
+					discard_addr = begin_addr;
+				}
+				tx_open = true;
+				begin_addr = addr;
+				tx_count = ZMS_GET_TX_COUNT(ate.offset);
+				tx_entries = 0U;
+			} else if (marker == ZMS_TX_COMMIT_MARKER) {
+				if (tx_open && !tx_torn &&
+				    ((ZMS_GET_TX_COUNT(ate.offset) != tx_count) ||
+				     (tx_entries != tx_count))) {
+					/* some ATEs of the transaction are missing */
+					tx_torn = true;
+					discard_addr = begin_addr;
+				}
+				tx_open = false;
+			} else if (tx_open) {
+				tx_entries++;
+			}
+		}
+		addr -= fs->ate_size;
+	}
+
+	if (tx_open && !tx_torn) {
+		tx_torn = true;
+		discard_addr = begin_addr;
+	}
+
+	if (!tx_torn) {
+		return 0;
+	}
+
+	fs->sector_cycle = cycle_cnt;
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+	/* The lookup cache is not built yet: make the gc search from the end of the fs.
+	 * The cache will be rebuilt afterwards.
+	 */
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+#endif
+
+	return zms_tx_discard(fs, discard_addr);
+}
+#endif /* CONFIG_ZMS_WRITE_MULTI */
+
 int zms_clear(struct zms_fs *fs)
 {
 	int rc;
@@ -1459,6 +1605,11 @@ static int zms_init(struct zms_fs *fs)
 	}
 
 end:
+#ifdef CONFIG_ZMS_WRITE_MULTI
+	if (!rc) {
+		rc = zms_tx_recover(fs);
+	}
+#endif
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	if (!rc) {
 		rc = zms_lookup_cache_rebuild(fs);
@@ -1699,6 +1850,250 @@ int zms_delete(struct zms_fs *fs, zms_id_t id)
 	return zms_write(fs, id, NULL, 0);
 }
 
+#ifdef CONFIG_ZMS_WRITE_MULTI
+BUILD_ASSERT(CONFIG_ZMS_WRITE_MULTI_BUF_SIZE >= MAX(ZMS_BLOCK_SIZE, sizeof(struct zms_ate)),
+	     "The multi-entry write buffer must be able to hold an ATE");
+
+/* transaction begin or commit marker write */
+static int zms_tx_marker_wrt(struct zms_fs *fs, uint64_t addr, uint16_t marker, size_t count)
+{
+	struct zms_ate marker_ate;
+
+	/* Initialize all members to 0xff */
+	memset(&marker_ate, 0xff, sizeof(struct zms_ate));
+
+	marker_ate.id = ZMS_HEAD_ID;
+	marker_ate.len = 0U;
+	marker_ate.offset = FIELD_PREP(ZMS_TX_MARKER_MASK, marker) |
+			    FIELD_PREP(ZMS_TX_COUNT_MASK, count);
+	marker_ate.cycle_cnt = fs->sector_cycle;
+
+	zms_ate_crc8_update(&marker_ate);
+
+	return zms_flash_al_wrt(fs, addr, &marker_ate, sizeof(struct zms_ate));
+}
+
+/* Write the data of the transaction entries that are not stored in their ATE, starting at
+ * data_addr. Consecutive data are gathered in buf and written with a single flash write.
+ */
+static int zms_tx_data_wrt(struct zms_fs *fs, const struct zms_write_entry *entries,
+			   size_t count, uint64_t data_addr, uint8_t *buf)
+{
+	int rc;
+	size_t fill = 0U;
+	size_t al_len;
+
+	for (size_t i = 0; i < count; i++) {
+		if (entries[i].len <= ZMS_DATA_IN_ATE_SIZE) {
+			continue;
+		}
+
+		al_len = zms_al_size(fs, entries[i].len);
+		if (fill + al_len > CONFIG_ZMS_WRITE_MULTI_BUF_SIZE) {
+			rc = zms_flash_al_wrt(fs, data_addr, buf, fill);
+			if (rc) {
+				return rc;
+			}
+			data_addr += fill;
+			fill = 0U;
+		}
+
+		if (al_len > CONFIG_ZMS_WRITE_MULTI_BUF_SIZE) {
+			/* too large to be gathered, write it directly */
+			rc = zms_flash_al_wrt(fs, data_addr, entries[i].data, entries[i].len);
+			if (rc) {
+				return rc;
+			}
+			data_addr += al_len;
+			continue;
+		}
+
+		memcpy(buf + fill, entries[i].data, entries[i].len);
+		(void)memset(buf + fill + entries[i].len, fs->flash_parameters->erase_value,
+			     al_len - entries[i].len);
+		fill += al_len;
+	}
+
+	return zms_flash_al_wrt(fs, data_addr, buf, fill);
+}
+
+/* Write the ATEs of the transaction entries, the first one at ate_addr and the following ones
+ * towards lower addresses. The ATEs are gathered in buf and written with a single flash write
+ * as long as they fit in it.
+ */
+static int zms_tx_ate_wrt(struct zms_fs *fs, const struct zms_write_entry *entries,
+			  size_t count, uint64_t ate_addr, uint64_t data_addr, uint8_t *buf)
+{
+	int rc;
+	const size_t chunk_max = CONFIG_ZMS_WRITE_MULTI_BUF_SIZE / fs->ate_size;
+	size_t chunk;
+	struct zms_ate entry;
+
+	for (size_t i = 0; i < count; i += chunk) {
+		chunk = MIN(chunk_max, count - i);
+
+		/* The most recent ATE of the chunk has the lowest address */
+		(void)memset(buf, fs->flash_parameters->erase_value, chunk * fs->ate_size);
+		for (size_t j = 0; j < chunk; j++) {
+			const struct zms_write_entry *wr = &entries[i + j];
+
+			zms_entry_ate_init(fs, &entry, wr->id, wr->data, wr->len, data_addr);
+			if (wr->len > ZMS_DATA_IN_ATE_SIZE) {
+				data_addr += zms_al_size(fs, wr->len);
+			}
+			memcpy(buf + (chunk - 1 - j) * fs->ate_size, &entry, sizeof(entry));
+		}
+
+		rc = zms_flash_al_wrt(fs, ate_addr - (chunk - 1) * fs->ate_size, buf,
+				      chunk * fs->ate_size);
+		if (rc) {
+			return rc;
+		}
+		ate_addr -= chunk * fs->ate_size;
+	}
+
+	return 0;
+}
+
+/* Store the entries of a transaction in the current sector: the begin marker first, so that
+ * an interrupted transaction is always detected when mounting, then the data, the ATEs of
+ * the entries and finally the commit marker. fs->ate_wra and fs->data_wra are only updated
+ * once the transaction is committed, so that the entries do not become visible before.
+ */
+static int zms_flash_write_multi(struct zms_fs *fs, const struct zms_write_entry *entries,
+				 size_t count)
+{
+	int rc;
+	uint64_t begin_addr = fs->ate_wra;
+	uint64_t data_end = fs->data_wra;
+	uint8_t buf[CONFIG_ZMS_WRITE_MULTI_BUF_SIZE];
+
+	for (size_t i = 0; i < count; i++) {
+		if (entries[i].len > ZMS_DATA_IN_ATE_SIZE) {
+			data_end += zms_al_size(fs, entries[i].len);
+		}
+	}
+
+	rc = zms_tx_marker_wrt(fs, begin_addr, ZMS_TX_BEGIN_MARKER, count);
+	if (rc) {
+		goto abort;
+	}
+
+	rc = zms_tx_data_wrt(fs, entries, count, fs->data_wra, buf);
+	if (rc) {
+		goto abort;
+	}
+
+	rc = zms_tx_ate_wrt(fs, entries, count, begin_addr - fs->ate_size, fs->data_wra, buf);
+	if (rc) {
+		goto abort;
+	}
+
+	rc = zms_tx_marker_wrt(fs, begin_addr - (count + 1) * fs->ate_size, ZMS_TX_COMMIT_MARKER,
+			       count);
+	if (rc) {
+		goto abort;
+	}
+
+	fs->ate_wra = begin_addr - (count + 2) * fs->ate_size;
+	fs->data_wra = data_end;
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+	for (size_t i = 0; i < count; i++) {
+		fs->lookup_cache[zms_lookup_cache_pos(entries[i].id)] =
+			begin_addr - (i + 1) * fs->ate_size;
+	}
+#endif
+
+	return 0;
+
+abort:
+	/* The space of the transaction may be partially written, skip it */
+	fs->ate_wra = begin_addr - (count + 2) * fs->ate_size;
+	fs->data_wra = data_end;
+	(void)zms_tx_discard(fs, begin_addr);
+
+	return rc;
+}
+
+int zms_write_multi(struct zms_fs *fs, const struct zms_write_entry *entries, size_t count)
+{
+	int rc;
+	uint32_t gc_count;
+	size_t required_space;
+
+	if (!fs) {
+		LOG_ERR("Invalid fs");
+		return -EINVAL;
+	}
+
+	if (!fs->ready) {
+		LOG_ERR("zms not initialized");
+		return -EACCES;
+	}
+
+	if ((entries == NULL) || (count == 0) || (count > ZMS_TX_MAX_ENTRIES)) {
+		return -EINVAL;
+	}
+
+	/* The ATEs are written through the gather buffer, at least one at a time */
+	if (fs->ate_size > CONFIG_ZMS_WRITE_MULTI_BUF_SIZE) {
+		LOG_ERR("ATE size %zu exceeds the multi-entry write buffer", fs->ate_size);
+		return -ENOTSUP;
+	}
+
+	/* One ATE per entry, the begin and commit ATEs and the data stored out of the ATEs */
+	required_space = (count + 2) * fs->ate_size;
+	for (size_t i = 0; i < count; i++) {
+		if ((entries[i].len > UINT16_MAX) ||
+		    ((entries[i].len > 0) && (entries[i].data == NULL))) {
+			return -EINVAL;
+		}
+		if (entries[i].len > ZMS_DATA_IN_ATE_SIZE) {
+			required_space += zms_al_size(fs, entries[i].len);
+		}
+	}
+
+	/* The whole transaction must fit in one sector next to 1 ate for sector close,
+	 * 1 ate for empty, 1 ate for gc done, and 1 ate to always allow a delete.
+	 */
+	if (required_space > (fs->sector_size - 4 * fs->ate_size)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+
+	gc_count = 0;
+	while (1) {
+		if (gc_count == fs->sector_count) {
+			/* gc'ed all sectors, no extra space will be created
+			 * by extra gc.
+			 */
+			rc = -ENOSPC;
+			goto end;
+		}
+
+		if (fs->ate_wra >= (fs->data_wra + required_space)) {
+			rc = zms_flash_write_multi(fs, entries, count);
+			break;
+		}
+		rc = zms_sector_close(fs);
+		if (rc) {
+			LOG_ERR("Failed to close the sector, returned = %d", rc);
+			goto end;
+		}
+		rc = zms_gc(fs);
+		if (rc) {
+			LOG_ERR("Garbage collection failed, returned = %d", rc);
+			goto end;
+		}
+		gc_count++;
+	}
+end:
+	k_mutex_unlock(&fs->zms_lock);
+	return rc;
+}
+#endif /* CONFIG_ZMS_WRITE_MULTI */
+
 ssize_t zms_read_hist(struct zms_fs *fs, zms_id_t id, void *data, size_t len, uint32_t cnt)
 {
 	int rc;
@@ -41,6 +41,19 @@
 
 #define ZMS_INVALID_SECTOR_NUM -1
 
+/*
+ * Transaction markers written by zms_write_multi(). They are ATEs with ID = ZMS_HEAD_ID and
+ * len = 0 like the close and GC done ATEs, but their offset field holds a marker that can never
+ * be a valid sector offset, followed by the number of entries in the transaction.
+ */
+#define ZMS_TX_MARKER_MASK   GENMASK(31, 16)
+#define ZMS_TX_COUNT_MASK    GENMASK(15, 0)
+#define ZMS_GET_TX_MARKER(x) FIELD_GET(ZMS_TX_MARKER_MASK, x)
+#define ZMS_GET_TX_COUNT(x)  FIELD_GET(ZMS_TX_COUNT_MASK, x)
+#define ZMS_TX_BEGIN_MARKER  0xFFB0
+#define ZMS_TX_COMMIT_MARKER 0xFFC0
+#define ZMS_TX_MAX_ENTRIES   ZMS_TX_COUNT_MASK
+
 #define ZMS_ATE_FORMAT_ID_32BIT 0
 #define ZMS_ATE_FORMAT_ID_64BIT 1
 
@@ -110,6 +110,32 @@ static uint32_t data_available(struct icmsg_data_t *dev_data)
 	return pbuf_read(dev_data->rx_pb, NULL, 0);
 }
 
+static uint32_t rx_claim(struct icmsg_data_t *dev_data, uint8_t *rx_buffer, uint16_t size,
+			 const uint8_t **rx_data)
+{
+	if (IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_RX_IN_PLACE)) {
+		char *buf;
+		int len = pbuf_claim(dev_data->rx_pb, &buf);
+
+		if (len > 0 && buf != NULL) {
+			*rx_data = (const uint8_t *)buf;
+			return len;
+		}
+	}
+
+	/* Copy the message, also if it is wrapped around the end of the buffer. */
+	*rx_data = rx_buffer;
+	return pbuf_read(dev_data->rx_pb, (char *)rx_buffer, size);
+}
+
+static void rx_release(struct icmsg_data_t *dev_data, const uint8_t *rx_buffer,
+		       const uint8_t *rx_data, uint32_t len)
+{
+	if (IS_ENABLED(CONFIG_IPC_SERVICE_ICMSG_RX_IN_PLACE) && rx_data != rx_buffer) {
+		pbuf_release(dev_data->rx_pb, len);
+	}
+}
+
 #ifdef CONFIG_MULTITHREADING
 static void submit_mbox_work(struct icmsg_data_t *dev_data)
 {
@@ -153,6 +179,7 @@ static bool callback_process(struct icmsg_data_t *dev_data)
 {
 	int ret;
 	uint8_t rx_buffer[CONFIG_PBUF_RX_READ_BUF_SIZE] __aligned(4);
+	const uint8_t *rx_data = rx_buffer;
 	uint32_t len = 0;
 	uint32_t len_available;
 	bool rerun = false;
@@ -259,7 +286,7 @@ static bool callback_process(struct icmsg_data_t *dev_data)
 		len_available = data_available(dev_data);
 
 		if (len_available > 0 && sizeof(rx_buffer) >= len_available) {
-			len = pbuf_read(dev_data->rx_pb, rx_buffer, sizeof(rx_buffer));
+			len = rx_claim(dev_data, rx_buffer, sizeof(rx_buffer), &rx_data);
 		}
 
 		if (state == ICMSG_STATE_CONNECTED_SID_ENABLED &&
@@ -271,6 +298,7 @@ static bool callback_process(struct icmsg_data_t *dev_data)
 				pbuf_handshake_read(dev_data->tx_pb));
 
 			if (remote_sid_req != dev_data->remote_sid) {
+				rx_release(dev_data, rx_buffer, rx_data, len);
 				atomic_set(&dev_data->state, ICMSG_STATE_DISCONNECTED);
 				if (dev_data->cb->unbound) {
 					dev_data->cb->unbound(dev_data->ctx);
@@ -292,14 +320,18 @@ static bool callback_process(struct icmsg_data_t *dev_data)
 
 		if (state != ICMSG_STATE_INITIALIZING_SID_DISABLED || !UNBOUND_DISABLED) {
 			if (dev_data->cb->received) {
-				dev_data->cb->received(rx_buffer, len, dev_data->ctx);
+				dev_data->cb->received(rx_data, len, dev_data->ctx);
 			}
+
+			rx_release(dev_data, rx_buffer, rx_data, len);
 		} else {
 			/* Allow magic number longer than sizeof(magic) for future protocol
 			 * version.
 			 */
 			bool endpoint_invalid = (len < sizeof(magic) ||
-						memcmp(magic, rx_buffer, sizeof(magic)));
+						memcmp(magic, rx_data, sizeof(magic)));
+
+			rx_release(dev_data, rx_buffer, rx_data, len);
 
 			if (endpoint_invalid) {
 				__ASSERT_NO_MSG(false);
@@ -493,9 +525,9 @@ int icmsg_close(const struct icmsg_config_t *conf,
 	return ret;
 }
 
-int icmsg_send(const struct icmsg_config_t *conf,
-	       struct icmsg_data_t *dev_data,
-	       const void *msg, size_t len)
+static int send_iov(const struct icmsg_config_t *conf,
+		    struct icmsg_data_t *dev_data,
+		    const struct pbuf_iovec *iov, size_t iovcnt, size_t len)
 {
 	int ret;
 	int write_ret;
@@ -515,12 +547,16 @@ int icmsg_send(const struct icmsg_config_t *conf,
 		return -ENODATA;
 	}
 
+	if (len > UINT16_MAX) {
+		return -EBADMSG;
+	}
+
 	ret = reserve_tx_buffer_if_unused(dev_data);
 	if (ret < 0) {
 		return -ENOBUFS;
 	}
 
-	write_ret = pbuf_write(dev_data->tx_pb, msg, len);
+	write_ret = pbuf_writev(dev_data->tx_pb, iov, iovcnt);
 
 	release_ret = release_tx_buffer(dev_data);
 	__ASSERT_NO_MSG(!release_ret);
@@ -542,6 +578,31 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	return sent_bytes;
 }
 
+int icmsg_send(const struct icmsg_config_t *conf,
+	       struct icmsg_data_t *dev_data,
+	       const void *msg, size_t len)
+{
+	const struct pbuf_iovec iov = {
+		.buf = msg,
+		.len = (uint16_t)len,
+	};
+
+	return send_iov(conf, dev_data, &iov, 1, len);
+}
+
+int icmsg_send_iov(const struct icmsg_config_t *conf,
+		   struct icmsg_data_t *dev_data,
+		   const struct pbuf_iovec *iov, size_t iovcnt)
+{
+	size_t len = 0;
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		len += iov[i].len;
+	}
+
+	return send_iov(conf, dev_data, iov, iovcnt, len);
+}
+
 #if defined(CONFIG_IPC_SERVICE_BACKEND_ICMSG_WQ_ENABLE)
 
 static int work_q_init(void)
@@ -10,8 +10,6 @@
 #include <zephyr/ipc/icmsg_me.h>
 #include <zephyr/sys/math_extras.h>
 
-#include <string.h>
-
 #define SEND_BUF_SIZE CONFIG_IPC_SERVICE_BACKEND_ICMSG_ME_SEND_BUF_SIZE
 #define NUM_EP        CONFIG_IPC_SERVICE_BACKEND_ICMSG_ME_NUM_EP
 
@@ -44,12 +42,6 @@ static ssize_t user_buffer_len_to_icmsg_buffer_len(size_t user_buffer_len)
 	return (ssize_t)ret;
 }
 
-static void set_ept_id_in_send_buffer(uint8_t *send_buffer,
-				      icmsg_me_ept_id_t ept_id)
-{
-	send_buffer[0] = ept_id;
-}
-
 int icmsg_me_init(const struct icmsg_config_t *conf,
 		  struct icmsg_me_data_t *data)
 {
@@ -189,17 +181,18 @@ int icmsg_me_send(const struct icmsg_config_t *conf,
 		return -EBADMSG;
 	}
 
-	k_mutex_lock(&data->send_mutex, K_FOREVER);
+	/* Send the endpoint id header and the user data as a single message. */
+	const struct pbuf_iovec iov[] = {
+		{ .buf = &id, .len = HEADER_SIZE },
+		{ .buf = msg, .len = len },
+	};
 
-	/* TODO: Optimization: How to avoid this copying? */
-	/* We could implement scatter list for icmsg_send, but it would require
-	 * scatter list also for SPSC buffer implementation.
+	/* Endpoints share the underlying icmsg instance, which may not
+	 * serialize its senders, or only with a short timeout.
 	 */
-	set_ept_id_in_send_buffer(data->send_buffer, id);
-	memcpy(icmsg_buffer_to_user_buffer(data->send_buffer), msg, len);
+	k_mutex_lock(&data->send_mutex, K_FOREVER);
 
-	r = icmsg_send(conf, &data->icmsg_data, data->send_buffer,
-		       icmsg_buffer_len);
+	r = icmsg_send_iov(conf, &data->icmsg_data, iov, ARRAY_SIZE(iov));
 	if (r > 0) {
 		sent_bytes = icmsg_buffer_len_to_user_buffer_len(r);
 	}
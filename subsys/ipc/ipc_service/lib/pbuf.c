@@ -112,13 +112,63 @@ int pbuf_rx_init(struct pbuf *pb)
 	return 0;
 }
 
+/* Helper function for copying data to the buffer, wrapping it to the buffer front. */
+static uint32_t write_wrapped(struct pbuf *pb, uint32_t wr_idx, const char *data, uint16_t len)
+{
+	uint8_t *const data_loc = pb->cfg->data_loc;
+	const uint32_t blen = pb->cfg->len;
+
+	/* Write until end of the buffer, if data will be wrapped. */
+	uint32_t tail = MIN(len, blen - wr_idx);
+
+	memcpy(&data_loc[wr_idx], data, tail);
+	sys_cache_data_flush_range(&data_loc[wr_idx], tail);
+
+	if (len > tail) {
+		/* Copy remaining data to buffer front. */
+		memcpy(&data_loc[0], data + tail, len - tail);
+		sys_cache_data_flush_range(&data_loc[0], len - tail);
+	}
+
+	return idx_wrap(blen, wr_idx + len);
+}
+
 int pbuf_write(struct pbuf *pb, const char *data, uint16_t len)
 {
-	if (pb == NULL || len == 0 || data == NULL) {
+	const struct pbuf_iovec iov = {
+		.buf = data,
+		.len = len,
+	};
+
+	if (data == NULL) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	return pbuf_writev(pb, &iov, 1);
+}
+
+int pbuf_writev(struct pbuf *pb, const struct pbuf_iovec *iov, size_t iovcnt)
+{
+	uint32_t len = 0;
+
+	if (pb == NULL || iov == NULL) {
 		/* Incorrect call. */
 		return -EINVAL;
 	}
 
+	for (size_t i = 0; i < iovcnt; i++) {
+		if (iov[i].buf == NULL && iov[i].len > 0) {
+			return -EINVAL;
+		}
+
+		len += iov[i].len;
+	}
+
+	if (len == 0 || len > UINT16_MAX) {
+		return -EINVAL;
+	}
+
 	/* Invalidate rd_idx only, local wr_idx is used to increase buffer security. */
 	sys_cache_data_invd_range((void *)(pb->cfg->rd_idx_loc), sizeof(*(pb->cfg->rd_idx_loc)));
 	__sync_synchronize();
@@ -157,19 +207,13 @@ int pbuf_write(struct pbuf *pb, const char *data, uint16_t len)
 
 	wr_idx = idx_wrap(blen, wr_idx + PBUF_PACKET_LEN_SZ);
 
-	/* Write until end of the buffer, if data will be wrapped. */
-	uint32_t tail = MIN(len, blen - wr_idx);
-
-	memcpy(&data_loc[wr_idx], data, tail);
-	sys_cache_data_flush_range(&data_loc[wr_idx], tail);
-
-	if (len > tail) {
-		/* Copy remaining data to buffer front. */
-		memcpy(&data_loc[0], data + tail, len - tail);
-		sys_cache_data_flush_range(&data_loc[0], len - tail);
+	for (size_t i = 0; i < iovcnt; i++) {
+		if (iov[i].len > 0) {
+			wr_idx = write_wrapped(pb, wr_idx, iov[i].buf, iov[i].len);
+		}
 	}
 
-	wr_idx = idx_wrap(blen, ROUND_UP(wr_idx + len, _PBUF_IDX_SIZE));
+	wr_idx = idx_wrap(blen, ROUND_UP(wr_idx, _PBUF_IDX_SIZE));
 	/* Update wr_idx. */
 	pb->data.wr_idx = wr_idx;
 	*(pb->cfg->wr_idx_loc) = wr_idx;
@@ -295,6 +339,73 @@ int pbuf_read(struct pbuf *pb, char *buf, uint16_t len)
 	return len;
 }
 
+int pbuf_claim(struct pbuf *pb, char **buf)
+{
+	if (pb == NULL || buf == NULL) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	/* Invalidate wr_idx only, local rd_idx is used to increase buffer security. */
+	sys_cache_data_invd_range((void *)(pb->cfg->wr_idx_loc), sizeof(*(pb->cfg->wr_idx_loc)));
+	__sync_synchronize();
+
+	uint8_t *const data_loc = pb->cfg->data_loc;
+	const uint32_t blen = pb->cfg->len;
+	uint32_t wr_idx = *(pb->cfg->wr_idx_loc);
+	uint32_t rd_idx = pb->data.rd_idx;
+
+	/* rd_idx must always be aligned. */
+	__ASSERT_NO_MSG(IS_PTR_ALIGNED_BYTES(rd_idx, _PBUF_IDX_SIZE));
+	/* wr_idx shall always be aligned, but its value is received from the
+	 * writer. Can not assert.
+	 */
+	if (!IS_PTR_ALIGNED_BYTES(wr_idx, _PBUF_IDX_SIZE)) {
+		return -EINVAL;
+	}
+
+	if (rd_idx == wr_idx) {
+		/* Buffer is empty. */
+		return 0;
+	}
+
+	/* Get packet len.*/
+	sys_cache_data_invd_range(&data_loc[rd_idx], PBUF_PACKET_LEN_SZ);
+	uint16_t plen = sys_get_be16(&data_loc[rd_idx]);
+
+	if (idx_occupied(blen, wr_idx, rd_idx) < plen + PBUF_PACKET_LEN_SZ) {
+		/* This should never happen. */
+		return -EAGAIN;
+	}
+
+	rd_idx = idx_wrap(blen, rd_idx + PBUF_PACKET_LEN_SZ);
+
+	if (plen > blen - rd_idx) {
+		/* Packet is wrapped, it has to be copied with pbuf_read(). */
+		*buf = NULL;
+		return (int)plen;
+	}
+
+	sys_cache_data_invd_range(&data_loc[rd_idx], plen);
+	*buf = (char *)&data_loc[rd_idx];
+
+	return (int)plen;
+}
+
+void pbuf_release(struct pbuf *pb, uint16_t len)
+{
+	const uint32_t blen = pb->cfg->len;
+	uint32_t rd_idx = pb->data.rd_idx;
+
+	/* Update rd_idx. */
+	rd_idx = idx_wrap(blen, ROUND_UP(rd_idx + PBUF_PACKET_LEN_SZ + len, _PBUF_IDX_SIZE));
+
+	pb->data.rd_idx = rd_idx;
+	*(pb->cfg->rd_idx_loc) = rd_idx;
+	__sync_synchronize();
+	sys_cache_data_flush_range((void *)pb->cfg->rd_idx_loc, sizeof(*(pb->cfg->rd_idx_loc)));
+}
+
 uint32_t pbuf_handshake_read(struct pbuf *pb)
 {
 	volatile uint32_t *ptr = pb->cfg->handshake_loc;
@@ -35,6 +35,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv4.h"
 #include "ipv6.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -213,6 +214,10 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+static bool net_if_tx_gso(struct net_if *iface, struct net_pkt *pkt);
+#endif
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = { 0 };
@@ -227,6 +232,12 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		return false;
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_pkt_gso_size(pkt) > 0U) {
+		return net_if_tx_gso(iface, pkt);
+	}
+#endif
+
 	create_time = net_pkt_create_time(pkt);
 
 	debug_check_packet(pkt);
@@ -326,6 +337,30 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Split a TCP segmentation offload packet into MSS sized segments just
+ * before they are passed to L2. If a segment cannot be allocated, the rest
+ * of the data is dropped and recovered by TCP retransmission.
+ */
+static bool net_if_tx_gso(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_pkt *seg;
+	size_t offset = 0;
+
+	while ((seg = net_tcp_gso_segment(pkt, &offset)) != NULL) {
+		/* A segment that was not sent is still ours */
+		if (!net_if_tx(iface, seg)) {
+			net_stats_update_processing_error(iface);
+			net_pkt_unref(seg);
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	return true;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 void net_process_tx_packet(struct net_pkt *pkt)
 {
 	struct net_if *iface;
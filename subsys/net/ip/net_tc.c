@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "tcp_internal.h"
 
 #define TC_RX_PSEUDO_QUEUE (COND_CODE_1(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO, (1), (0)))
 #define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_COUNT + TC_RX_PSEUDO_QUEUE)
@@ -307,7 +308,15 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 		k_sem_give(fifo_slot);
 #endif
 
+		if (IS_ENABLED(CONFIG_NET_TCP_GRO)) {
+			net_pkt_set_rx_burst(pkt, !k_fifo_is_empty(fifo));
+		}
+
 		net_process_rx_packet(pkt);
+
+		if (IS_ENABLED(CONFIG_NET_TCP_GRO) && k_fifo_is_empty(fifo)) {
+			net_tcp_gro_flush();
+		}
 	}
 }
 #endif
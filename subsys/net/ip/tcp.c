@@ -1478,6 +1478,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -1486,6 +1487,13 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
+	if (net_pkt_gso_size(pkt) > 0U && is_destination_local(pkt)) {
+		/* Packets to ourselves never reach L2, they are received
+		 * as one large segment instead.
+		 */
+		net_pkt_set_gso_size(pkt, 0U);
+	}
+
 	ret = tcp_header_add(conn, pkt, flags, seq);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1717,13 +1725,63 @@ static void tcp_setup_retransmission(struct tcp *conn)
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* The IP length fields are 16 bits, leave room for the largest IPv4 and
+ * TCP headers.
+ */
+#define TCP_GSO_MAX_LEN (UINT16_MAX - 2 * 60)
+
+/* Number of MSS sized segments the next data packet may carry. Resent data
+ * goes out one segment at a time, and 6lo needs to see every segment.
+ */
+static int tcp_gso_segs(struct tcp *conn, int mss)
+{
+	if (conn->data_mode == TCP_DATA_MODE_RESEND || tcp_send_cb != NULL ||
+	    conn->iface == NULL ||
+	    (IS_ENABLED(CONFIG_NET_L2_IEEE802154) &&
+	     net_if_get_link_addr(conn->iface)->type == NET_LINK_IEEE802154)) {
+		return 1;
+	}
+
+	return CLAMP(TCP_GSO_MAX_LEN / mss, 1, CONFIG_NET_TCP_GSO_MAX_SEGS);
+}
+
+static struct net_pkt *tcp_gso_pkt_alloc(struct tcp *conn, int len, int mss)
+{
+	struct net_pkt *pkt;
+
+	if (len <= mss) {
+		return tcp_pkt_alloc(conn, len);
+	}
+
+	/* The regular allocator caps the buffer at the interface MTU */
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	if (net_pkt_alloc_buffer_raw(pkt, len, TCP_PKT_ALLOC_TIMEOUT) < 0) {
+		tcp_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_set_gso_size(pkt, mss);
+
+	return pkt;
+}
+#else
+#define tcp_gso_segs(conn, mss) 1
+#define tcp_gso_pkt_alloc(conn, len, mss) tcp_pkt_alloc(conn, len)
+#endif /* CONFIG_NET_TCP_GSO */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
+	int mss = conn_mss(conn);
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = MIN(tcp_unsent_len(conn), mss * tcp_gso_segs(conn, mss));
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1734,7 +1792,14 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
+	/* Multi-segment packets end at an MSS boundary, the remainder is sent
+	 * on its own so that Nagle's algorithm still applies to it.
+	 */
+	if (len > mss) {
+		len -= len % mss;
+	}
+
+	pkt = tcp_gso_pkt_alloc(conn, len, mss);
 	if (!pkt) {
 		NET_ERR("[%p] packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
@@ -1757,7 +1822,10 @@ static int tcp_send_data(struct tcp *conn)
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+
+			for (int sent = 0; sent < len; sent += mss) {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
 		}
 	}
 
@@ -2214,6 +2282,187 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 	return found ? conn : NULL;
 }
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* Connections holding a coalesced segment, protected by tcp_gro_lock */
+static sys_slist_t tcp_gro_conns = SYS_SLIST_STATIC_INIT(&tcp_gro_conns);
+
+static K_MUTEX_DEFINE(tcp_gro_lock);
+
+/* Only plain in-order data of an established connection is coalesced,
+ * anything else goes to tcp_in() directly. Must be called with conn->lock
+ * held.
+ */
+static size_t tcp_gro_len(struct tcp *conn, struct net_pkt *pkt,
+			  struct tcphdr *th)
+{
+	if (conn->state != TCP_ESTABLISHED ||
+	    th_off(th) != 5 || (th_flags(th) & ~PSH) != ACK) {
+		return 0;
+	}
+
+	return tcp_data_len(pkt);
+}
+
+/* Must be called with tcp_gro_lock held */
+static struct net_pkt *tcp_gro_detach(struct tcp *conn)
+{
+	struct net_pkt *pkt = conn->gro_pkt;
+
+	if (pkt != NULL) {
+		conn->gro_pkt = NULL;
+		conn->gro_segs = 0U;
+		sys_slist_find_and_remove(&tcp_gro_conns, &conn->gro_next);
+	}
+
+	return pkt;
+}
+
+static void tcp_gro_deliver(struct tcp *conn, struct net_pkt *pkt)
+{
+	NET_DBG("[%p] coalesced len %zu", conn, tcp_data_len(pkt));
+
+	if (tcp_in(conn, pkt) == NET_DROP) {
+		tcp_pkt_unref(pkt);
+	}
+
+	/* Drop the reference taken when the segment was held */
+	tcp_conn_unref(conn);
+}
+
+/* Append the payload of pkt to head. The ACK number and window of the later
+ * segment supersede the ones of head, PSH is kept if either had it.
+ */
+static int tcp_gro_merge(struct net_pkt *head, struct net_pkt *pkt,
+			 struct tcphdr *th)
+{
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 sizeof(struct tcphdr);
+	struct tcphdr *head_th;
+	uint8_t flags = th_flags(th);
+	uint32_t ack = UNALIGNED_GET(UNALIGNED_MEMBER_ADDR(th, th_ack));
+	uint16_t win = th_win(th);
+
+	head_th = th_get(head);
+	if (head_th == NULL) {
+		return -EINVAL;
+	}
+
+	/* The headers normally sit in the first fragment, which is then
+	 * trimmed without moving the payload around. The held segment is
+	 * only updated once the merge cannot fail anymore.
+	 */
+	if (pkt->buffer->len > hdr_len) {
+		net_buf_pull(pkt->buffer, hdr_len);
+	} else {
+		net_pkt_cursor_init(pkt);
+
+		if (net_pkt_pull(pkt, hdr_len) < 0) {
+			return -ENOBUFS;
+		}
+	}
+
+	UNALIGNED_PUT(ack, UNALIGNED_MEMBER_ADDR(head_th, th_ack));
+	UNALIGNED_PUT(win, UNALIGNED_MEMBER_ADDR(head_th, th_win));
+	UNALIGNED_PUT(th_flags(head_th) | (flags & PSH), &head_th->th_flags);
+
+	net_pkt_append_buffer(head, pkt->buffer);
+	pkt->buffer = NULL;
+	tcp_pkt_unref(pkt);
+
+	return 0;
+}
+
+/* Returns NET_OK if the packet was held or merged, NET_CONTINUE if it has to
+ * be passed to tcp_in() by the caller.
+ */
+static enum net_verdict tcp_gro_receive(struct tcp *conn, struct net_pkt *pkt)
+{
+	enum net_verdict verdict = NET_CONTINUE;
+	struct net_pkt *flush = NULL;
+	struct tcphdr *th;
+	uint32_t conn_ack;
+	uint32_t seq;
+	size_t len;
+	bool push;
+
+	th = th_get(pkt);
+	if (th == NULL) {
+		return NET_CONTINUE;
+	}
+
+	seq = th_seq(th);
+	push = (th_flags(th) & PSH) != 0U;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	len = tcp_gro_len(conn, pkt, th);
+	conn_ack = conn->ack;
+	k_mutex_unlock(&conn->lock);
+
+	k_mutex_lock(&tcp_gro_lock, K_FOREVER);
+
+	if (conn->gro_pkt != NULL) {
+		if (len == 0 || seq != conn->gro_seq) {
+			/* Keep the order, the held segment goes first */
+			flush = tcp_gro_detach(conn);
+		} else if (tcp_gro_merge(conn->gro_pkt, pkt, th) < 0) {
+			flush = tcp_gro_detach(conn);
+			verdict = NET_DROP;
+		} else {
+			conn->gro_seq += len;
+			conn->gro_segs++;
+			verdict = NET_OK;
+
+			/* A pushed segment ends what the peer meant to send */
+			if (push || conn->gro_segs >= CONFIG_NET_TCP_GRO_MAX_SEGS) {
+				flush = tcp_gro_detach(conn);
+			}
+		}
+	} else if (len > 0 && !push && net_pkt_rx_burst(pkt) && seq == conn_ack) {
+		/* Holding the segment only pays off if more packets are
+		 * waiting in the RX queue, otherwise it would only add latency.
+		 */
+		tcp_conn_ref(conn);
+		conn->gro_pkt = pkt;
+		conn->gro_seq = seq + len;
+		conn->gro_segs = 1U;
+		sys_slist_append(&tcp_gro_conns, &conn->gro_next);
+		verdict = NET_OK;
+	}
+
+	k_mutex_unlock(&tcp_gro_lock);
+
+	if (flush != NULL) {
+		tcp_gro_deliver(conn, flush);
+	}
+
+	return verdict;
+}
+
+void net_tcp_gro_flush(void)
+{
+	struct net_pkt *pkt;
+	struct tcp *conn;
+	sys_snode_t *node;
+
+	while (!sys_slist_is_empty(&tcp_gro_conns)) {
+		k_mutex_lock(&tcp_gro_lock, K_FOREVER);
+
+		node = sys_slist_peek_head(&tcp_gro_conns);
+		if (node == NULL) {
+			k_mutex_unlock(&tcp_gro_lock);
+			break;
+		}
+
+		conn = CONTAINER_OF(node, struct tcp, gro_next);
+		pkt = tcp_gro_detach(conn);
+
+		k_mutex_unlock(&tcp_gro_lock);
+
+		tcp_gro_deliver(conn, pkt);
+	}
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
 static enum net_verdict tcp_recv(struct net_conn *net_conn,
@@ -2249,6 +2498,12 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	}
 in:
 	if (conn) {
+#if defined(CONFIG_NET_TCP_GRO)
+		verdict = tcp_gro_receive(conn, pkt);
+		if (verdict != NET_CONTINUE) {
+			return verdict;
+		}
+#endif
 		verdict = tcp_in(conn, pkt);
 	} else {
 		net_tcp_reply_rst(pkt);
@@ -4092,6 +4347,13 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
+	/* Segmentation offload packets get the checksum of each segment
+	 * computed when they are split.
+	 */
+	if (net_pkt_gso_size(pkt) > 0U && !force_chksum) {
+		return net_pkt_set_data(pkt, &tcp_access);
+	}
+
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
@@ -4100,6 +4362,109 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+static void tcp_gso_copy_attributes(struct net_pkt *seg, struct net_pkt *pkt)
+{
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_ext_opt_len(seg, net_pkt_ipv6_ext_opt_len(pkt));
+		net_pkt_set_ipv6_hdr_prev(seg, net_pkt_ipv6_hdr_prev(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+}
+
+struct net_pkt *net_tcp_gso_segment(struct net_pkt *pkt, size_t *offset)
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	size_t hdr_len;
+	size_t data_len;
+	size_t len;
+	uint32_t seq;
+	uint8_t flags;
+
+	th = th_get(pkt);
+	if (th == NULL) {
+		return NULL;
+	}
+
+	hdr_len = ip_len + th_off(th) * 4U;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+	if (*offset >= data_len) {
+		return NULL;
+	}
+
+	len = MIN(net_pkt_gso_size(pkt), data_len - *offset);
+	seq = th_seq(th) + *offset;
+	flags = th_flags(th);
+
+	/* Only the last segment pushes or closes */
+	if (*offset + len < data_len) {
+		flags &= ~(PSH | FIN);
+	}
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					AF_UNSPEC, 0, TCP_PKT_ALLOC_TIMEOUT);
+	if (seg == NULL) {
+		NET_DBG("Cannot allocate segment at offset %zu", *offset);
+		return NULL;
+	}
+
+	tcp_gso_copy_attributes(seg, pkt);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) < 0 ||
+	    net_pkt_skip(pkt, *offset) < 0 ||
+	    net_pkt_copy(seg, pkt, len) < 0) {
+		goto fail;
+	}
+
+	th = th_get(seg);
+	if (th == NULL) {
+		goto fail;
+	}
+
+	UNALIGNED_PUT(htonl(seq), UNALIGNED_MEMBER_ADDR(th, th_seq));
+	UNALIGNED_PUT(flags, &th->th_flags);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		NET_IPV4_HDR(seg)->chksum = 0U;
+	}
+
+	if (tcp_finalize_pkt(seg) < 0) {
+		goto fail;
+	}
+
+	*offset += len;
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
@@ -286,6 +286,43 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Pass the segments held for receive coalescing to TCP
+ *
+ * Called by the RX traffic class thread once its queue runs empty, so that
+ * segments are never held longer than the burst they arrived in.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(void);
+#else
+static inline void net_tcp_gro_flush(void) { }
+#endif
+
+/**
+ * @brief Cut the next segment out of a segmentation offload packet
+ *
+ * The returned packet carries a copy of the IP and TCP headers of @p pkt
+ * updated for the segment, followed by at most net_pkt_gso_size() bytes of
+ * payload starting at @p offset. @p offset is advanced past the segment.
+ *
+ * @param pkt Network packet created by TCP with a non-zero GSO size
+ * @param offset Payload offset of the next segment, start with 0
+ *
+ * @return Segment packet, NULL when all payload was consumed or on error
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+struct net_pkt *net_tcp_gso_segment(struct net_pkt *pkt, size_t *offset);
+#else
+static inline struct net_pkt *net_tcp_gso_segment(struct net_pkt *pkt,
+						  size_t *offset)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(offset);
+
+	return NULL;
+}
+#endif
+
 /**
  * @brief Enqueue data for transmission
  *
@@ -315,6 +315,12 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
+#if defined(CONFIG_NET_TCP_GRO)
+	sys_snode_t gro_next;    /* Entry in the list of flows to flush */
+	struct net_pkt *gro_pkt; /* Coalesced segment waiting for tcp_in() */
+	uint32_t gro_seq;        /* Sequence number expected to be merged next */
+	uint8_t gro_segs;        /* Number of segments merged in gro_pkt */
+#endif /* CONFIG_NET_TCP_GRO */
 	uint16_t recv_win_sent;
 	uint16_t recv_win_max;
 	uint16_t recv_win;
@@ -26,6 +26,11 @@ static int num_clients;
 static K_SEM_DEFINE(coap_client_recv_sem, 0, 1);
 
 static bool timeout_expired(struct coap_client_internal_request *internal_req);
+#if COAP_CLIENT_BLOCK2_WINDOW > 1
+static bool window_timeout_expired(struct coap_client_internal_request *internal_req);
+static int window_resend(struct coap_client *client,
+			 struct coap_client_internal_request *internal_req);
+#endif
 static void cancel_requests_with(struct coap_client *client, int error);
 static int recv_response(struct coap_client *client, struct coap_packet *response, bool *truncated);
 static int handle_response(struct coap_client *client, const struct coap_packet *response,
@@ -145,6 +150,11 @@ static bool has_timeout_expired(struct coap_client *client)
 		if (timeout_expired(&client->requests[i])) {
 			return true;
 		}
+#if COAP_CLIENT_BLOCK2_WINDOW > 1
+		if (window_timeout_expired(&client->requests[i])) {
+			return true;
+		}
+#endif
 	}
 	return false;
 }
@@ -544,6 +554,16 @@ static void coap_client_resend_handler(struct coap_client *client)
 				release_internal_request(&client->requests[i]);
 			}
 		}
+#if COAP_CLIENT_BLOCK2_WINDOW > 1
+		if (window_timeout_expired(&client->requests[i])) {
+			ret = window_resend(client, &client->requests[i]);
+			if (ret < 0) {
+				report_callback_error(&client->requests[i], ret);
+				client->requests[i].window_active = false;
+				release_internal_request(&client->requests[i]);
+			}
+		}
+#endif
 	}
 
 	k_mutex_unlock(&client->lock);
@@ -761,6 +781,397 @@ static struct coap_client_internal_request *get_request_with_mid(struct coap_cli
 	return NULL;
 }
 
+#if COAP_CLIENT_BLOCK2_WINDOW > 1
+/*
+ * Windowed Block2 transfers: once the first block of a block-wise response has
+ * arrived, up to COAP_CLIENT_BLOCK2_WINDOW block requests are kept in flight,
+ * each with its own token, message ID and retransmission state. Blocks that
+ * arrive out of order are buffered in their slot and handed to the callback
+ * in order.
+ */
+static uint16_t window_block_bytes(struct coap_client_internal_request *internal_req)
+{
+	return coap_block_size_to_bytes(internal_req->recv_blk_ctx.block_size);
+}
+
+static bool window_eligible(struct coap_client_internal_request *internal_req,
+			    int block_option, bool response_truncated)
+{
+	return block_option > 0 && !response_truncated &&
+	       internal_req->coap_request.confirmable && !internal_req->is_observe &&
+	       internal_req->send_blk_ctx.total_size == 0;
+}
+
+static struct coap_client_block_slot *window_slot_with_mid(
+	struct coap_client *client, uint16_t mid, struct coap_client_internal_request **req)
+{
+	for (int i = 0; i < CONFIG_COAP_CLIENT_MAX_REQUESTS; i++) {
+		struct coap_client_internal_request *internal_req = &client->requests[i];
+
+		if (!internal_req->request_ongoing || !internal_req->window_active) {
+			continue;
+		}
+
+		for (int j = 0; j < COAP_CLIENT_BLOCK2_WINDOW; j++) {
+			if (internal_req->window[j].used && internal_req->window[j].id == mid) {
+				*req = internal_req;
+				return &internal_req->window[j];
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static struct coap_client_block_slot *window_slot_with_token(
+	struct coap_client *client, const struct coap_packet *resp,
+	struct coap_client_internal_request **req)
+{
+	uint8_t response_token[COAP_TOKEN_MAX_LEN];
+	uint8_t response_tkl;
+
+	response_tkl = coap_header_get_token(resp, response_token);
+	if (response_tkl != COAP_TOKEN_MAX_LEN) {
+		return NULL;
+	}
+
+	for (int i = 0; i < CONFIG_COAP_CLIENT_MAX_REQUESTS; i++) {
+		struct coap_client_internal_request *internal_req = &client->requests[i];
+
+		if (!internal_req->request_ongoing || !internal_req->window_active) {
+			continue;
+		}
+
+		for (int j = 0; j < COAP_CLIENT_BLOCK2_WINDOW; j++) {
+			if (internal_req->window[j].used &&
+			    memcmp(internal_req->window[j].token, response_token,
+				   response_tkl) == 0) {
+				*req = internal_req;
+				return &internal_req->window[j];
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static bool window_slot_expired(struct coap_client_block_slot *slot)
+{
+	return slot->used && slot->code == 0 && slot->pending.timeout != 0 &&
+	       slot->pending.timeout <= (k_uptime_get() - slot->pending.t0);
+}
+
+static bool window_timeout_expired(struct coap_client_internal_request *internal_req)
+{
+	if (!internal_req->request_ongoing || !internal_req->window_active) {
+		return false;
+	}
+
+	for (int i = 0; i < COAP_CLIENT_BLOCK2_WINDOW; i++) {
+		if (window_slot_expired(&internal_req->window[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int window_send(struct coap_client *client,
+		       struct coap_client_internal_request *internal_req,
+		       struct coap_client_block_slot *slot, bool resend)
+{
+	int ret;
+
+	internal_req->recv_blk_ctx.current = slot->num * window_block_bytes(internal_req);
+
+	if (resend) {
+		memcpy(internal_req->request_token, slot->token, COAP_TOKEN_MAX_LEN);
+		internal_req->last_id = slot->id;
+	}
+
+	ret = coap_client_init_request(client, &internal_req->coap_request, internal_req,
+				       resend);
+	if (ret < 0) {
+		LOG_ERR("Error creating a CoAP request");
+		return ret;
+	}
+
+	if (!resend) {
+		memcpy(slot->token, internal_req->request_token, COAP_TOKEN_MAX_LEN);
+		slot->id = internal_req->last_id;
+
+		ret = coap_pending_init(&slot->pending, &internal_req->request, &client->address,
+					&internal_req->pending.params);
+		if (ret < 0) {
+			LOG_ERR("Error creating pending");
+			return ret;
+		}
+		coap_pending_cycle(&slot->pending);
+	}
+
+	ret = send_request(client->fd, internal_req->request.data, internal_req->request.offset,
+			   0, &client->address, client->socklen);
+	if (ret == -EAGAIN && !resend) {
+		/* The block is requested again when its retransmission timer expires */
+		ret = 0;
+	}
+
+	return ret < 0 ? ret : 0;
+}
+
+static int window_fill(struct coap_client *client,
+		       struct coap_client_internal_request *internal_req)
+{
+	int ret;
+
+	for (int i = 0; i < COAP_CLIENT_BLOCK2_WINDOW; i++) {
+		struct coap_client_block_slot *slot = &internal_req->window[i];
+
+		if (slot->used) {
+			continue;
+		}
+
+		if (internal_req->window_next >= internal_req->window_end) {
+			break;
+		}
+
+		slot->used = true;
+		slot->num = internal_req->window_next++;
+		slot->code = 0;
+		slot->len = 0;
+		slot->more = false;
+
+		ret = window_send(client, internal_req, slot, false);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int window_start(struct coap_client *client,
+			struct coap_client_internal_request *internal_req)
+{
+	uint16_t block_bytes = window_block_bytes(internal_req);
+
+	internal_req->window_active = true;
+	internal_req->window_next = internal_req->recv_blk_ctx.current / block_bytes;
+	internal_req->window_deliver = internal_req->window_next;
+	internal_req->window_end = UINT32_MAX;
+
+	/* Do not request blocks past the end if the server sent a Size2 option */
+	if (internal_req->recv_blk_ctx.total_size > 0) {
+		internal_req->window_end = DIV_ROUND_UP(internal_req->recv_blk_ctx.total_size,
+							block_bytes);
+	}
+
+	for (int i = 0; i < COAP_CLIENT_BLOCK2_WINDOW; i++) {
+		internal_req->window[i].used = false;
+	}
+
+	/* Retransmissions are tracked per block from now on */
+	coap_pending_clear(&internal_req->pending);
+
+	return window_fill(client, internal_req);
+}
+
+static int window_resend(struct coap_client *client,
+			 struct coap_client_internal_request *internal_req)
+{
+	int ret;
+
+	for (int i = 0; i < COAP_CLIENT_BLOCK2_WINDOW; i++) {
+		struct coap_client_block_slot *slot = &internal_req->window[i];
+		struct coap_pending tmp = slot->pending;
+
+		if (!window_slot_expired(slot)) {
+			continue;
+		}
+
+		if (!coap_pending_cycle(&slot->pending)) {
+			LOG_ERR("Timeout, no more retries left");
+			return -ETIMEDOUT;
+		}
+
+		LOG_DBG("Timeout, retrying block %u", slot->num);
+
+		ret = window_send(client, internal_req, slot, true);
+		if (ret == -EAGAIN) {
+			/* Restore the pending structure, retry later */
+			slot->pending = tmp;
+		} else if (ret < 0) {
+			LOG_ERR("Failed to resend request, %d", ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static struct coap_client_block_slot *window_slot_with_num(
+	struct coap_client_internal_request *internal_req, uint32_t num)
+{
+	for (int i = 0; i < COAP_CLIENT_BLOCK2_WINDOW; i++) {
+		if (internal_req->window[i].used && internal_req->window[i].num == num) {
+			return &internal_req->window[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int window_deliver(struct coap_client *client,
+			  struct coap_client_internal_request *internal_req)
+{
+	struct coap_client_block_slot *slot;
+
+	while (true) {
+		slot = window_slot_with_num(internal_req, internal_req->window_deliver);
+		if (slot == NULL || slot->code == 0) {
+			break;
+		}
+
+		if (slot->code < 0) {
+			return slot->code;
+		}
+
+		if (internal_req->coap_request.cb) {
+			if (!atomic_set(&internal_req->in_callback, 1)) {
+				internal_req->coap_request.cb(
+					slot->code, internal_req->offset,
+					slot->len > 0 ? slot->data : NULL, slot->len, !slot->more,
+					internal_req->coap_request.user_data);
+				atomic_clear(&internal_req->in_callback);
+			}
+			if (!internal_req->request_ongoing) {
+				/* User callback must have cancelled the request. */
+				internal_req->window_active = false;
+				return 0;
+			}
+		}
+
+		internal_req->offset += slot->len;
+		internal_req->window_deliver++;
+		slot->used = false;
+
+		if (!slot->more) {
+			internal_req->window_active = false;
+			release_internal_request(internal_req);
+			return 0;
+		}
+	}
+
+	return window_fill(client, internal_req);
+}
+
+static int window_receive(struct coap_client *client,
+			  struct coap_client_internal_request *internal_req,
+			  struct coap_client_block_slot *slot, const struct coap_packet *response,
+			  bool response_truncated)
+{
+	int ret;
+	int block_option;
+	uint16_t payload_len;
+	uint16_t block_bytes = window_block_bytes(internal_req);
+	uint8_t response_code = coap_header_get_code(response);
+	const uint8_t *payload = coap_packet_get_payload(response, &payload_len);
+
+	if (coap_header_get_type(response) == COAP_TYPE_CON) {
+		ret = send_ack(client, response, COAP_CODE_EMPTY);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (slot->code != 0) {
+		LOG_DBG("Duplicate response for block %u, dropping", slot->num);
+		return 0;
+	}
+
+	coap_pending_clear(&slot->pending);
+	slot->code = response_code;
+	slot->more = false;
+	slot->len = MIN(payload_len, block_bytes);
+
+	/* Any other class than success ends the transfer, report it as is */
+	if ((response_code >> 5) == 2) {
+		block_option = coap_get_option_int(response, COAP_OPTION_BLOCK2);
+		if (response_truncated || block_option < 0 ||
+		    GET_BLOCK_NUM(block_option) != slot->num ||
+		    GET_BLOCK_SIZE(block_option) != internal_req->recv_blk_ctx.block_size) {
+			LOG_ERR("Unexpected Block2 option in response for block %u", slot->num);
+			slot->code = -EBADMSG;
+			slot->len = 0;
+		} else {
+			slot->more = GET_MORE(block_option);
+		}
+	}
+
+	if (slot->len > 0) {
+		memcpy(slot->data, payload, slot->len);
+	}
+
+	if (!slot->more && slot->code > 0 && slot->num < internal_req->window_end) {
+		/* End of the representation, drop requests issued past it */
+		internal_req->window_end = slot->num + 1;
+
+		for (int i = 0; i < COAP_CLIENT_BLOCK2_WINDOW; i++) {
+			if (internal_req->window[i].num > slot->num) {
+				internal_req->window[i].used = false;
+			}
+		}
+	}
+
+	return window_deliver(client, internal_req);
+}
+
+static bool window_handle_response(struct coap_client *client, const struct coap_packet *response,
+				   bool response_truncated, int *ret)
+{
+	struct coap_client_internal_request *internal_req;
+	struct coap_client_block_slot *slot;
+	uint8_t response_type = coap_header_get_type(response);
+	uint8_t response_code = coap_header_get_code(response);
+	bool by_mid = response_type == COAP_TYPE_RESET ||
+		      (response_type == COAP_TYPE_ACK && response_code == COAP_CODE_EMPTY);
+
+	if (by_mid) {
+		slot = window_slot_with_mid(client, coap_header_get_id(response), &internal_req);
+	} else {
+		slot = window_slot_with_token(client, response, &internal_req);
+	}
+
+	if (slot == NULL) {
+		return false;
+	}
+
+	if (response_type == COAP_TYPE_RESET) {
+		*ret = -ECONNRESET;
+	} else if (by_mid) {
+		/* Separate response coming */
+		slot->pending.t0 = k_uptime_get();
+		slot->pending.timeout = COAP_SEPARATE_TIMEOUT;
+		slot->pending.retries = 0;
+		*ret = 1;
+		return true;
+	} else {
+		*ret = window_receive(client, internal_req, slot, response, response_truncated);
+	}
+
+	if (*ret < 0) {
+		report_callback_error(internal_req, *ret);
+		internal_req->window_active = false;
+		release_internal_request(internal_req);
+		if (*ret == -ECONNRESET) {
+			*ret = 0;
+		}
+	}
+
+	return true;
+}
+#endif /* COAP_CLIENT_BLOCK2_WINDOW > 1 */
+
 static bool find_echo_option(const struct coap_packet *response, struct coap_option *option)
 {
 	return coap_find_options(response, COAP_OPTION_ECHO, option, 1);
@@ -790,6 +1201,12 @@ static int handle_response(struct coap_client *client, const struct coap_packet
 	uint16_t response_id = coap_header_get_id(response);
 	const uint8_t *payload = coap_packet_get_payload(response, &payload_len);
 
+#if COAP_CLIENT_BLOCK2_WINDOW > 1
+	if (window_handle_response(client, response, response_truncated, &ret)) {
+		return ret;
+	}
+#endif
+
 	if (response_type == COAP_TYPE_RESET) {
 		internal_req = get_request_with_mid(client, response_id);
 		if (!internal_req) {
@@ -966,6 +1383,16 @@ static int handle_response(struct coap_client *client, const struct coap_packet
 
 	/* If this wasn't last block, send the next request */
 	if (blockwise_transfer && !last_block) {
+#if COAP_CLIENT_BLOCK2_WINDOW > 1
+		if (window_eligible(internal_req, block_option, response_truncated)) {
+			ret = window_start(client, internal_req);
+			if (ret < 0) {
+				internal_req->window_active = false;
+				goto fail;
+			}
+			return 1;
+		}
+#endif
 		ret = coap_client_init_request(client, &internal_req->coap_request, internal_req,
 					       false);
 
@@ -122,6 +122,177 @@ static int coap_service_remove_observer(const struct coap_service *service,
 	return 0;
 }
 
+#if defined(CONFIG_COAP_SERVER_RESOURCE_INDEX)
+#define INDEX_SIZE     CONFIG_COAP_SERVER_RESOURCE_INDEX_SIZE
+#define INDEX_MASK     (INDEX_SIZE - 1)
+#define INDEX_MAX_USED (INDEX_SIZE * 3 / 4)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(INDEX_SIZE),
+	     "CONFIG_COAP_SERVER_RESOURCE_INDEX_SIZE must be a power of two");
+
+enum coap_service_index_state {
+	COAP_SERVICE_INDEX_UNBUILT = 0,
+	COAP_SERVICE_INDEX_READY,
+	COAP_SERVICE_INDEX_DISABLED,
+};
+
+/* FNV-1a over the path segments, each followed by a separator */
+#define PATH_HASH_INIT  2166136261U
+#define PATH_HASH_PRIME 16777619U
+
+static uint32_t path_hash_segment(uint32_t hash, const uint8_t *segment, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ segment[i]) * PATH_HASH_PRIME;
+	}
+
+	return (hash ^ '/') * PATH_HASH_PRIME;
+}
+
+static uint32_t resource_path_hash(const char * const *path)
+{
+	uint32_t hash = PATH_HASH_INIT;
+
+	for (; *path != NULL; path++) {
+		hash = path_hash_segment(hash, (const uint8_t *)*path, strlen(*path));
+	}
+
+	return hash;
+}
+
+static uint32_t request_path_hash(struct coap_option *options, uint8_t opt_num)
+{
+	uint32_t hash = PATH_HASH_INIT;
+
+	for (uint8_t i = 0; i < opt_num; i++) {
+		if (options[i].delta == COAP_OPTION_URI_PATH) {
+			hash = path_hash_segment(hash, options[i].value, options[i].len);
+		}
+	}
+
+	return hash;
+}
+
+static bool resource_path_is_wildcard(const char * const *path)
+{
+	if (!IS_ENABLED(CONFIG_COAP_URI_WILDCARD)) {
+		return false;
+	}
+
+	for (; *path != NULL; path++) {
+		if (strcmp(*path, "+") == 0 || strcmp(*path, "#") == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool resource_paths_equal(const char * const *a, const char * const *b)
+{
+	for (; *a != NULL && *b != NULL; a++, b++) {
+		if (strcmp(*a, *b) != 0) {
+			return false;
+		}
+	}
+
+	return *a == NULL && *b == NULL;
+}
+
+static void coap_service_build_index(const struct coap_service *service)
+{
+	struct coap_service_data *data = service->data;
+	size_t count = COAP_SERVICE_RESOURCE_COUNT(service);
+	size_t used = 0;
+
+	memset(data->res_index, 0, sizeof(data->res_index));
+	data->res_first_wildcard = MIN(count, UINT16_MAX);
+
+	for (size_t i = 0; i < count; i++) {
+		const char * const *path = service->res_begin[i].path;
+		uint32_t slot;
+
+		if (resource_path_is_wildcard(path)) {
+			data->res_first_wildcard = MIN(data->res_first_wildcard, i);
+			continue;
+		}
+
+		if (used == INDEX_MAX_USED || i >= UINT16_MAX) {
+			LOG_WRN("Too many resources in %s, using linear lookup", service->name);
+			data->res_index_state = COAP_SERVICE_INDEX_DISABLED;
+			return;
+		}
+
+		/* Linear probing, a duplicate path keeps the first resource like the linear scan */
+		for (slot = resource_path_hash(path) & INDEX_MASK; data->res_index[slot] != 0;
+		     slot = (slot + 1) & INDEX_MASK) {
+			if (resource_paths_equal(service->res_begin[data->res_index[slot] - 1].path,
+						 path)) {
+				break;
+			}
+		}
+
+		if (data->res_index[slot] == 0) {
+			data->res_index[slot] = i + 1;
+			used++;
+		}
+	}
+
+	data->res_index_state = COAP_SERVICE_INDEX_READY;
+}
+
+static int coap_service_index_lookup(const struct coap_service *service,
+				     struct coap_option *options, uint8_t opt_num)
+{
+	const uint16_t *index = service->data->res_index;
+	uint32_t slot = request_path_hash(options, opt_num) & INDEX_MASK;
+
+	for (; index[slot] != 0; slot = (slot + 1) & INDEX_MASK) {
+		int pos = index[slot] - 1;
+
+		if (coap_uri_path_match(service->res_begin[pos].path, options, opt_num)) {
+			return pos;
+		}
+	}
+
+	return -ENOENT;
+}
+#endif /* CONFIG_COAP_SERVER_RESOURCE_INDEX */
+
+static int coap_service_handle_request(const struct coap_service *service,
+				       struct coap_packet *request,
+				       struct coap_option *options, uint8_t opt_num,
+				       struct sockaddr *addr, socklen_t addr_len)
+{
+	size_t count = COAP_SERVICE_RESOURCE_COUNT(service);
+
+#if defined(CONFIG_COAP_SERVER_RESOURCE_INDEX)
+	struct coap_service_data *data = service->data;
+	int pos;
+
+	if (data->res_index_state == COAP_SERVICE_INDEX_UNBUILT) {
+		coap_service_build_index(service);
+	}
+
+	if (data->res_index_state == COAP_SERVICE_INDEX_READY) {
+		pos = coap_service_index_lookup(service, options, opt_num);
+
+		/* A wildcard resource defined before the hit takes precedence */
+		if (pos >= 0 && pos < data->res_first_wildcard) {
+			return coap_handle_request_len(request, &service->res_begin[pos], 1,
+						       options, opt_num, addr, addr_len);
+		}
+
+		if (pos < 0 && data->res_first_wildcard >= count) {
+			return coap_packet_is_request(request) ? -ENOENT : -ENOTSUP;
+		}
+	}
+#endif
+
+	return coap_handle_request_len(request, service->res_begin, count, options, opt_num,
+				       addr, addr_len);
+}
+
 static int coap_server_process(int sock_fd)
 {
 	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
@@ -254,9 +425,8 @@ static int coap_server_process(int sock_fd)
 
 		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
 	} else {
-		ret = coap_handle_request_len(&request, service->res_begin,
-					      COAP_SERVICE_RESOURCE_COUNT(service),
-					      options, opt_num, &client_addr, client_addr_len);
+		ret = coap_service_handle_request(service, &request, options, opt_num,
+						  &client_addr, client_addr_len);
 
 		/* Translate errors to response codes */
 		switch (ret) {
@@ -10,7 +10,196 @@
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+#define NO_ENTRY 0U
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+#define PREFETCH_HITS    CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS
+#define PREFETCH_PERCENT CONFIG_DNS_RESOLVER_CACHE_PREFETCH_PERCENT
+#endif
+
+static uint32_t dns_cache_hash(const char *query)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	while (*query != '\0') {
+		hash ^= (uint8_t)*query++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static inline uint16_t *dns_cache_bucket(struct dns_cache const *cache, uint32_t hash)
+{
+	return &cache->buckets[hash % cache->bucket_count];
+}
+
+static inline struct dns_cache_entry *dns_cache_entry(struct dns_cache const *cache,
+						      uint16_t ref)
+{
+	return &cache->entries[ref - 1];
+}
+
+static sa_family_t dns_cache_family(enum dns_query_type type)
+{
+	if (type == DNS_QUERY_TYPE_A) {
+		return AF_INET;
+	} else if (type == DNS_QUERY_TYPE_AAAA) {
+		return AF_INET6;
+	}
+
+	return AF_UNSPEC;
+}
+
+static bool dns_cache_query_valid(char const *query)
+{
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return false;
+	}
+
+	return true;
+}
+
+/* Unlinks the entry *link points to and puts it on the free list, returns the next entry */
+static uint16_t dns_cache_release(struct dns_cache *cache, uint16_t *link)
+{
+	uint16_t ref = *link;
+	struct dns_cache_entry *entry = dns_cache_entry(cache, ref);
+
+	*link = entry->next;
+	entry->in_use = false;
+	entry->next = cache->free;
+	cache->free = ref;
+
+	return *link;
+}
+
+/* Unlinks the entry with the given reference from its hash chain */
+static void dns_cache_release_ref(struct dns_cache *cache, uint16_t ref)
+{
+	uint16_t *link = dns_cache_bucket(cache, dns_cache_entry(cache, ref)->hash);
+
+	while (*link != NO_ENTRY) {
+		if (*link == ref) {
+			dns_cache_release(cache, link);
+			return;
+		}
+
+		link = &dns_cache_entry(cache, *link)->next;
+	}
+}
+
+/*
+ * Walks the hash chain of the query, dropping expired entries on the way. Returns the link
+ * pointing to the next entry of the query or NULL at the end of the chain.
+ */
+static uint16_t *dns_cache_next(struct dns_cache *cache, uint16_t *link, uint32_t hash,
+				char const *query)
+{
+	while (*link != NO_ENTRY) {
+		struct dns_cache_entry *entry = dns_cache_entry(cache, *link);
+
+		if (sys_timepoint_expired(entry->expiry)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_release(cache, link);
+			continue;
+		}
+
+		if (entry->hash == hash && strcmp(entry->query, query) == 0) {
+			return link;
+		}
+
+		link = &entry->next;
+	}
+
+	return NULL;
+}
+
+/*
+ * Returns a free entry. If the cache is full, an expired entry or the one closest to
+ * expiry is evicted, this is the only operation that has to look at all the entries.
+ */
+static uint16_t dns_cache_alloc(struct dns_cache *cache)
+{
+	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
+	uint16_t ref = NO_ENTRY;
+
+	if (cache->free != NO_ENTRY) {
+		ref = cache->free;
+		cache->free = dns_cache_entry(cache, ref)->next;
+		return ref;
+	}
+
+	if (cache->unused < cache->size) {
+		return ++cache->unused;
+	}
+
+	for (uint16_t i = 1; i <= cache->size; i++) {
+		struct dns_cache_entry *entry = dns_cache_entry(cache, i);
+
+		if (sys_timepoint_expired(entry->expiry)) {
+			ref = i;
+			break;
+		}
+
+		if (ref == NO_ENTRY || sys_timepoint_cmp(closest_to_expiry, entry->expiry) > 0) {
+			ref = i;
+			closest_to_expiry = entry->expiry;
+		}
+	}
+
+	NET_DBG("Overwrite \"%s\"", dns_cache_entry(cache, ref)->query);
+	dns_cache_release_ref(cache, ref);
+	cache->free = dns_cache_entry(cache, ref)->next;
+
+	return ref;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_remove_locked(struct dns_cache *cache, char const *query,
+				    sa_family_t family, bool any_family)
+{
+	uint32_t hash = dns_cache_hash(query);
+	uint16_t *link = dns_cache_bucket(cache, hash);
+
+	while ((link = dns_cache_next(cache, link, hash, query)) != NULL) {
+		struct dns_cache_entry *entry = dns_cache_entry(cache, *link);
+
+		if (any_family || entry->data.ai_family == family) {
+			dns_cache_release(cache, link);
+		} else {
+			link = &entry->next;
+		}
+	}
+}
+
+static struct dns_cache_entry *dns_cache_insert(struct dns_cache *cache, char const *query,
+						uint32_t ttl)
+{
+	uint16_t ref = dns_cache_alloc(cache);
+	struct dns_cache_entry *entry = dns_cache_entry(cache, ref);
+	uint16_t *bucket;
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+	entry->hash = dns_cache_hash(query);
+	entry->ttl = ttl;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->hits = 0U;
+	entry->in_use = true;
+	entry->negative = false;
+	entry->prefetching = false;
+
+	bucket = dns_cache_bucket(cache, entry->hash);
+	entry->next = *bucket;
+	*bucket = ref;
+
+	return entry;
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
@@ -18,6 +207,9 @@ int dns_cache_flush(struct dns_cache *cache)
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
 	}
+	memset(cache->buckets, 0, cache->bucket_count * sizeof(cache->buckets[0]));
+	cache->free = NO_ENTRY;
+	cache->unused = 0U;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -26,18 +218,13 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	struct dns_cache_entry *entry;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
 
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (!dns_cache_query_valid(query)) {
 		return -EINVAL;
 	}
 
@@ -45,33 +232,62 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
-	dns_cache_clean(cache);
-
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
+	/* A positive answer replaces a cached negative one */
+	if (IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE_NEGATIVE)) {
+		uint32_t hash = dns_cache_hash(query);
+		uint16_t *link = dns_cache_bucket(cache, hash);
+
+		while ((link = dns_cache_next(cache, link, hash, query)) != NULL) {
+			entry = dns_cache_entry(cache, *link);
+			if (entry->negative && entry->data.ai_family == addrinfo->ai_family) {
+				dns_cache_release(cache, link);
+			} else {
+				link = &entry->next;
+			}
 		}
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	entry = dns_cache_insert(cache, query, ttl);
+	entry->data = *addrinfo;
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_NEGATIVE)
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	sa_family_t family = dns_cache_family(type);
+
+	if (cache == NULL || query == NULL || ttl == 0 || family == AF_UNSPEC) {
+		return -EINVAL;
+	}
+
+	if (!dns_cache_query_valid(query)) {
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_MAX_TTL);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" with TTL %" PRIu32, query, ttl);
+
+	dns_cache_remove_locked(cache, query, family, false);
+
+	entry = dns_cache_insert(cache, query, ttl);
+	memset(&entry->data, 0, sizeof(entry->data));
+	entry->data.ai_family = family;
+	entry->negative = true;
 
 	k_mutex_unlock(cache->lock);
 
 	return 0;
 }
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
@@ -80,99 +296,154 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	}
 
 	NET_DBG("Remove all entries with query \"%s\"", query);
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (!dns_cache_query_valid(query)) {
 		return -EINVAL;
 	}
 
 	k_mutex_lock(cache->lock, K_FOREVER);
+	dns_cache_remove_locked(cache, query, AF_UNSPEC, true);
+	k_mutex_unlock(cache->lock);
 
-	dns_cache_clean(cache);
+	return 0;
+}
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
-		}
+int dns_cache_remove_family(struct dns_cache *cache, char const *query, sa_family_t family)
+{
+	if (cache == NULL || query == NULL) {
+		return -EINVAL;
+	}
+
+	if (!dns_cache_query_valid(query)) {
+		return -EINVAL;
 	}
 
+	k_mutex_lock(cache->lock, K_FOREVER);
+	dns_cache_remove_locked(cache, query, family, false);
 	k_mutex_unlock(cache->lock);
 
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
-		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+/* Hot entries are refreshed when less than PREFETCH_PERCENT of their TTL is left */
+static bool dns_cache_should_prefetch(struct dns_cache_entry const *entry)
+{
+	k_ticks_t left;
+
+	if (entry->negative || entry->prefetching || entry->hits < PREFETCH_HITS) {
+		return false;
+	}
+
+	left = sys_timepoint_timeout(entry->expiry).ticks;
+
+	return left * 100 <= k_sec_to_ticks_ceil64(entry->ttl) * PREFETCH_PERCENT;
+}
+#endif
+
+int dns_cache_lookup(struct dns_cache *cache, const char *query, enum dns_query_type type,
+		     struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, bool *prefetch)
 {
 	size_t found = 0;
+	bool negative = false;
+	bool refresh = false;
 	sa_family_t family;
+	uint32_t hash;
+	uint16_t *link;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (type == DNS_QUERY_TYPE_A) {
-		family = AF_INET;
-	} else if (type == DNS_QUERY_TYPE_AAAA) {
-		family = AF_INET6;
-	} else {
+
+	family = dns_cache_family(type);
+	if (family == AF_UNSPEC) {
 		return -EINVAL;
 	}
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+
+	if (!dns_cache_query_valid(query)) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+	link = dns_cache_bucket(cache, hash);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
+	while ((link = dns_cache_next(cache, link, hash, query)) != NULL) {
+		struct dns_cache_entry *entry = dns_cache_entry(cache, *link);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+		link = &entry->next;
+
+		if (entry->data.ai_family != family) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+
+		if (entry->negative) {
+			negative = true;
 			continue;
 		}
-		if (cache->entries[i].data.ai_family != family) {
-			continue;
+
+		if (entry->hits < UINT16_MAX) {
+			entry->hits++;
+		}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+		if (dns_cache_should_prefetch(entry)) {
+			refresh = true;
 		}
+#endif
+
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
 	}
 
+	if (refresh) {
+		/* Only the first lookup close to the expiry triggers the refresh */
+		link = dns_cache_bucket(cache, hash);
+		while ((link = dns_cache_next(cache, link, hash, query)) != NULL) {
+			struct dns_cache_entry *entry = dns_cache_entry(cache, *link);
+
+			if (entry->data.ai_family == family) {
+				entry->prefetching = true;
+			}
+
+			link = &entry->next;
+		}
+
+		NET_DBG("Refresh \"%s\"", query);
+	}
+
 	k_mutex_unlock(cache->lock);
 
+	if (prefetch != NULL) {
+		*prefetch = refresh;
+	}
+
 	if (found > addrinfo_array_len) {
 		return -ENOSR;
 	}
 
 	if (found == 0) {
+		if (negative) {
+			NET_DBG("Negative entry for \"%s\"", query);
+			return -ENOENT;
+		}
+
 		NET_DBG("Could not find \"%s\"", query);
 	}
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
-
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
-		}
-	}
+	/* Lookups only update the hit counters and drop expired entries */
+	return dns_cache_lookup((struct dns_cache *)cache, query, type, addrinfo,
+			       addrinfo_array_len, NULL);
 }
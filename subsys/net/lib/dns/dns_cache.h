@@ -22,12 +22,31 @@ struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Hash of the query, compared before the query string */
+	uint32_t hash;
+	/* TTL the entry was added with in seconds */
+	uint32_t ttl;
+	/* Index + 1 of the next entry in the hash chain or in the free list */
+	uint16_t next;
+	/* Number of lookups that returned the entry */
+	uint16_t hits;
 	bool in_use;
+	/* The name does not exist, only data.ai_family is valid */
+	bool negative;
+	/* A refresh query has already been requested for the entry */
+	bool prefetching;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* Hash chains, index + 1 of the first entry or 0 if the chain is empty */
+	uint16_t *buckets;
+	size_t bucket_count;
+	/* Index + 1 of the first entry of the free list */
+	uint16_t free;
+	/* Entries from this one on have never been used */
+	uint16_t unused;
 	struct k_mutex *lock;
 };
 
@@ -41,10 +60,14 @@ struct dns_cache {
  * @param name Name of the cache.
  */
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
+	BUILD_ASSERT((cache_size) > 0 && (cache_size) < UINT16_MAX);                               \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static uint16_t name##_buckets[cache_size];                                                \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries, .size = cache_size,                                     \
+		.buckets = name##_buckets, .bucket_count = cache_size,                             \
+		.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -81,6 +104,37 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
  */
 int dns_cache_remove(struct dns_cache *cache, char const *query);
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_NEGATIVE)
+/**
+ * @brief Adds a negative entry to the dns cache recording that the name does not exist.
+ *
+ * Positive entries of the same query and type are removed. See RFC 2308.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param type Query type the negative answer was received for.
+ * @param ttl Time to live for the entry in seconds, the lower of the TTL and the MINIMUM
+ * field of the SOA record of the authority section.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl);
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
+
+/**
+ * @brief Removes all entries with the given query and address family
+ *
+ * Used to drop stale entries before the answers of a refresh query are added.
+ *
+ * @param cache Cache where the entries should be removed.
+ * @param query Query which should be searched for.
+ * @param family Address family of the entries, AF_UNSPEC for SRV entries.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_remove_family(struct dns_cache *cache, char const *query, sa_family_t family);
+
 /**
  * @brief Tries to find the specified query entry within the cache.
  *
@@ -94,8 +148,28 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * @retval On error a negative value is returned.
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
+ * -ENOENT means a negative answer is cached for the query, the name does not exist.
  */
 int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
 
+/**
+ * @brief Tries to find the specified query entry within the cache and checks whether
+ * it should be refreshed.
+ *
+ * Same as dns_cache_find(), additionally reports when an entry returned frequently is close
+ * to its expiry, see @kconfig{CONFIG_DNS_RESOLVER_CACHE_PREFETCH}. The refresh is only
+ * reported once for each entry.
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param type Query type which will control the types of addresses that will be found.
+ * @param addrinfo dns_addrinfo array which will be written if the query was found.
+ * @param addrinfo_array_len Array size of the dns_addrinfo array
+ * @param prefetch Set to true if the caller should send a query to refresh the entries.
+ * @retval Same values as dns_cache_find(). -ENOENT is returned on a negative entry hit.
+ */
+int dns_cache_lookup(struct dns_cache *cache, const char *query, enum dns_query_type type,
+		     struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, bool *prefetch);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
@@ -191,6 +191,60 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 	return 0;
 }
 
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl)
+{
+	uint16_t offset = dns_msg->answer_offset;
+	int nscount = dns_header_nscount(dns_msg->msg);
+
+	for (int i = 0; i < nscount; i++) {
+		uint8_t *rr = dns_msg->msg + offset;
+		uint16_t rdlength;
+		uint32_t minimum;
+		int dname_len;
+		int mname_len;
+		int rname_len;
+
+		dname_len = skip_fqdn(rr, dns_msg->msg_size - offset);
+		if (dname_len < 0) {
+			return dname_len;
+		}
+
+		/* type + class + ttl + rdlength, see RFC-1035 4.1.3. */
+		if (dns_msg->msg_size - offset - dname_len < 2 + 2 + 4 + 2) {
+			return -EINVAL;
+		}
+
+		rdlength = dns_answer_rdlength(dname_len, rr);
+		offset += dname_len + 2 + 2 + 4 + 2;
+		if (dns_msg->msg_size - offset < rdlength) {
+			return -EINVAL;
+		}
+
+		if (dns_answer_type(dname_len, rr) != DNS_RR_TYPE_SOA) {
+			offset += rdlength;
+			continue;
+		}
+
+		/* MNAME, RNAME, SERIAL, REFRESH, RETRY, EXPIRE and MINIMUM, RFC-1035 3.3.13. */
+		mname_len = skip_fqdn(dns_msg->msg + offset, rdlength);
+		if (mname_len < 0) {
+			return mname_len;
+		}
+
+		rname_len = skip_fqdn(dns_msg->msg + offset + mname_len, rdlength - mname_len);
+		if (rname_len < 0 || rdlength - mname_len - rname_len < 5 * 4) {
+			return -EINVAL;
+		}
+
+		minimum = sys_get_be32(dns_msg->msg + offset + mname_len + rname_len + 4 * 4);
+		*ttl = MIN((uint32_t)dns_answer_ttl(dname_len, rr), minimum);
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
 int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
 {
 	uint8_t *dns_header;
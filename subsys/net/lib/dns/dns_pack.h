@@ -89,6 +89,7 @@ enum dns_rr_type {
 	DNS_RR_TYPE_INVALID = 0,
 	DNS_RR_TYPE_A	= 1,		/* IPv4  */
 	DNS_RR_TYPE_CNAME = 5,		/* CNAME */
+	DNS_RR_TYPE_SOA = 6,		/* SOA   */
 	DNS_RR_TYPE_PTR = 12,		/* PTR   */
 	DNS_RR_TYPE_TXT = 16,		/* TXT   */
 	DNS_RR_TYPE_AAAA = 28,		/* IPv6  */
@@ -367,6 +368,21 @@ int dns_msg_pack_qname(uint16_t *len, uint8_t *buf, uint16_t size,
 int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 		      enum dns_rr_type *type);
 
+/**
+ * @brief Gets the TTL of a negative answer from its authority section
+ *
+ * The authority section is expected right after the last unpacked answer.
+ * As described in RFC 2308, the TTL is the lower of the TTL of the SOA record
+ * and of its MINIMUM field.
+ *
+ * @param dns_msg Structure
+ * @param ttl TTL of the negative answer.
+ * @retval 0 on success
+ * @retval -ENOENT if there is no SOA record in the authority section
+ * @retval -EINVAL if the message is malformed
+ */
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl);
+
 /**
  * @brief Unpacks the header's response.
  *
@@ -81,6 +81,12 @@ NET_BUF_POOL_DEFINE(dns_qname_pool, DNS_RESOLVER_BUF_CTR,
 DNS_CACHE_DEFINE(dns_cache, CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+/* The resolver keeps a pointer to the query, so refresh queries need their own copy */
+static char prefetch_query[CONFIG_DNS_NUM_CONCUR_QUERIES][CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+static ATOMIC_DEFINE(prefetch_busy, CONFIG_DNS_NUM_CONCUR_QUERIES);
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 static K_MUTEX_DEFINE(lock);
 static int init_called;
 static struct dns_resolve_context dns_default_ctx;
@@ -1082,6 +1088,45 @@ quit:
 	return ret;
 }
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+static void dns_cache_answer(struct dns_resolve_context *ctx, int query_idx,
+			     struct dns_addrinfo *info, uint32_t ttl, bool first)
+{
+	if (first) {
+		/* The answers of a new response replace the cached ones,
+		 * e.g. when an entry is refreshed before it expires.
+		 */
+		dns_cache_remove_family(&dns_cache, ctx->queries[query_idx].query,
+					info->ai_family);
+	}
+
+	dns_cache_add(&dns_cache, ctx->queries[query_idx].query, info, ttl);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+#ifdef CONFIG_DNS_RESOLVER_CACHE_NEGATIVE
+static void dns_cache_nxdomain(struct dns_resolve_context *ctx,
+			       struct dns_msg_t *dns_msg,
+			       uint16_t dns_id, int query_idx)
+{
+	uint32_t ttl;
+
+	/* mDNS responders do not send negative answers */
+	if (dns_id == 0 || query_idx < 0 ||
+	    dns_header_rcode(dns_msg->msg) != DNS_HEADER_NAMEERROR) {
+		return;
+	}
+
+	/* Without a SOA record the answer must not be cached, RFC 2308 5. */
+	if (dns_unpack_negative_ttl(dns_msg, &ttl) < 0 || ttl == 0) {
+		return;
+	}
+
+	dns_cache_add_negative(&dns_cache, ctx->queries[query_idx].query,
+			       ctx->queries[query_idx].query_type, ttl);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -1324,8 +1369,7 @@ rr_qtype_aaaa:
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
 #ifdef CONFIG_DNS_RESOLVER_CACHE
-			dns_cache_add(&dns_cache,
-				ctx->queries[*query_idx].query, &info, ttl);
+			dns_cache_answer(ctx, *query_idx, &info, ttl, items == 0);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 			items++;
 			break;
@@ -1421,8 +1465,7 @@ rr_qtype_aaaa:
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
 #ifdef CONFIG_DNS_RESOLVER_CACHE
-			dns_cache_add(&dns_cache,
-				ctx->queries[*query_idx].query, &info, ttl);
+			dns_cache_answer(ctx, *query_idx, &info, ttl, items == 0);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 			items++;
 			break;
@@ -1489,6 +1532,9 @@ rr_qtype_aaaa:
 	}
 
 	if (items == 0) {
+#ifdef CONFIG_DNS_RESOLVER_CACHE_NEGATIVE
+		dns_cache_nxdomain(ctx, dns_msg, *dns_id, *query_idx);
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -1834,6 +1880,52 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+static void dns_prefetch_cb(enum dns_resolve_status status,
+			    struct dns_addrinfo *info,
+			    void *user_data)
+{
+	int slot = POINTER_TO_INT(user_data);
+
+	ARG_UNUSED(info);
+
+	/* The answers are added to the cache by dns_validate_msg() */
+	if (status == DNS_EAI_INPROGRESS) {
+		return;
+	}
+
+	NET_DBG("Refresh of \"%s\" done (%d)", prefetch_query[slot], status);
+	atomic_clear_bit(prefetch_busy, slot);
+}
+
+static void dns_prefetch(struct dns_resolve_context *ctx, const char *query,
+			 enum dns_query_type type, int32_t timeout)
+{
+	int ret;
+
+	for (int slot = 0; slot < CONFIG_DNS_NUM_CONCUR_QUERIES; slot++) {
+		if (atomic_test_and_set_bit(prefetch_busy, slot)) {
+			continue;
+		}
+
+		strncpy(prefetch_query[slot], query, sizeof(prefetch_query[slot]) - 1);
+		prefetch_query[slot][sizeof(prefetch_query[slot]) - 1] = '\0';
+
+		ret = dns_resolve_name_internal(ctx, prefetch_query[slot], type, NULL,
+						dns_prefetch_cb, INT_TO_POINTER(slot),
+						timeout, false);
+		if (ret < 0) {
+			NET_DBG("Cannot refresh \"%s\" (%d)", query, ret);
+			atomic_clear_bit(prefetch_busy, slot);
+		}
+
+		return;
+	}
+
+	NET_DBG("No free slot to refresh \"%s\"", query);
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 int dns_resolve_name_internal(struct dns_resolve_context *ctx,
 			      const char *query,
 			      enum dns_query_type type,
@@ -1917,8 +2009,10 @@ int dns_resolve_name_internal(struct dns_resolve_context *ctx,
 try_resolve:
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 	if (use_cache) {
-		ret = dns_cache_find(&dns_cache, query, type, cached_info,
-				     ARRAY_SIZE(cached_info));
+		bool prefetch = false;
+
+		ret = dns_cache_lookup(&dns_cache, query, type, cached_info,
+				       ARRAY_SIZE(cached_info), &prefetch);
 		if (ret > 0) {
 			/* The query was cached, no
 			 * need to continue further.
@@ -1929,6 +2023,19 @@ try_resolve:
 
 			cb(DNS_EAI_ALLDONE, NULL, user_data);
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+			if (prefetch) {
+				dns_prefetch(ctx, query, type, timeout);
+			}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+			return 0;
+		}
+
+		if (ret == -ENOENT) {
+			/* The name is known not to exist */
+			cb(DNS_EAI_NODATA, NULL, user_data);
+
 			return 0;
 		}
 	}
@@ -6,10 +6,12 @@
  */
 #include <errno.h>
 #include <string.h>
+#include <strings.h>
 
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/net_core.h>
+#include <zephyr/sys/util.h>
 
 LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -96,11 +98,342 @@ const struct hpack_table_entry *http_hpack_table_get(uint32_t key)
 	return &http_hpack_table_static[key];
 }
 
-static int http_hpack_find_index(struct http_hpack_header_buf *header,
+/* Dynamic table indices follow the static table ones, RFC7541 ch 2.3.3. */
+#define HPACK_DYNAMIC_INDEX_BASE (HTTP_SERVER_HPACK_WWW_AUTHENTICATE + 1)
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+static inline uint32_t hpack_entry_size(size_t name_len, size_t value_len)
+{
+	return name_len + value_len + HTTP_HPACK_ENTRY_OVERHEAD;
+}
+
+/* Index 0 refers to the most recently inserted entry. */
+static struct http_hpack_dynamic_entry *
+hpack_dynamic_entry(struct http_hpack_dynamic_table *table, uint32_t index)
+{
+	return &table->entries[(table->first + table->count - 1 - index) %
+			       ARRAY_SIZE(table->entries)];
+}
+
+static void hpack_dynamic_evict_oldest(struct http_hpack_dynamic_table *table)
+{
+	struct http_hpack_dynamic_entry *oldest = &table->entries[table->first];
+
+	table->size -= hpack_entry_size(oldest->name_len, oldest->value_len);
+	table->first = (table->first + 1) % ARRAY_SIZE(table->entries);
+	table->count--;
+
+	/* Evicted data is only reclaimed once the end of the buffer is
+	 * reached, so a name referencing an evicted entry stays valid while
+	 * the new entry is inserted.
+	 */
+	if (table->count == 0) {
+		table->data_start = table->data_end;
+	} else {
+		table->data_start = table->entries[table->first].offset;
+	}
+}
+
+static void hpack_dynamic_evict(struct http_hpack_dynamic_table *table,
+				uint32_t max_size)
+{
+	while (table->count > 0 && table->size > max_size) {
+		hpack_dynamic_evict_oldest(table);
+	}
+}
+
+static void hpack_dynamic_compact(struct http_hpack_dynamic_table *table)
+{
+	uint16_t shift = table->data_start;
+
+	memmove(table->data, &table->data[shift], table->data_end - shift);
+
+	for (uint16_t i = 0; i < table->count; i++) {
+		table->entries[(table->first + i) % ARRAY_SIZE(table->entries)].offset -= shift;
+	}
+
+	table->data_start = 0;
+	table->data_end -= shift;
+}
+
+/* Insert a header field into the dynamic table, RFC7541 ch 4.4. On success,
+ * header name and value are updated to point to the table copy.
+ */
+static int hpack_dynamic_insert(struct http_hpack_dynamic_table *table,
+				struct http_hpack_header_buf *header)
+{
+	uint32_t entry_size = hpack_entry_size(header->name_len, header->value_len);
+	const uint8_t *name = (const uint8_t *)header->name;
+	struct http_hpack_dynamic_entry *entry;
+	uint8_t *dst;
+
+	if (entry_size > table->max_size) {
+		/* Not an error, the table just ends up empty. */
+		hpack_dynamic_evict(table, 0);
+		return 0;
+	}
+
+	hpack_dynamic_evict(table, table->max_size - entry_size);
+
+	/* Until the peer acknowledges SETTINGS_HEADER_TABLE_SIZE, its encoder
+	 * may use a larger table than the one stored here. The oldest entries
+	 * are dropped early then, a later reference to them fails to decode.
+	 */
+	while (table->count > 0 &&
+	       (table->count == ARRAY_SIZE(table->entries) ||
+		table->data_end - table->data_start + header->name_len +
+		header->value_len > sizeof(table->data))) {
+		hpack_dynamic_evict_oldest(table);
+	}
+
+	if (header->name_len + header->value_len > sizeof(table->data)) {
+		/* Skipping the entry would shift the index of all the others. */
+		return -ENOBUFS;
+	}
+
+	if (table->data_end + header->name_len + header->value_len >
+	    sizeof(table->data)) {
+		if (name >= table->data && name < table->data + sizeof(table->data)) {
+			/* Name references the table, which is about to be
+			 * compacted. Preserve it in the decoding buffer.
+			 */
+			if (header->name_len > sizeof(header->buf) - header->datalen) {
+				return -ENOBUFS;
+			}
+
+			memcpy(header->buf + header->datalen, name, header->name_len);
+			name = header->buf + header->datalen;
+		}
+
+		hpack_dynamic_compact(table);
+	}
+
+	entry = &table->entries[(table->first + table->count) %
+				ARRAY_SIZE(table->entries)];
+	entry->offset = table->data_end;
+	entry->name_len = header->name_len;
+	entry->value_len = header->value_len;
+
+	dst = &table->data[table->data_end];
+	memcpy(dst, name, header->name_len);
+	memcpy(dst + header->name_len, header->value, header->value_len);
+
+	table->data_end += header->name_len + header->value_len;
+	table->size += entry_size;
+	table->count++;
+
+	header->name = (const char *)dst;
+	header->value = (const char *)dst + header->name_len;
+
+	return 0;
+}
+
+static int hpack_dynamic_get(struct http_hpack_dynamic_table *table,
+			     uint32_t index, struct http_hpack_header_buf *header,
+			     bool with_value)
+{
+	struct http_hpack_dynamic_entry *entry;
+
+	if (table == NULL || index >= table->count) {
+		return -EBADMSG;
+	}
+
+	entry = hpack_dynamic_entry(table, index);
+
+	header->name = (const char *)&table->data[entry->offset];
+	header->name_len = entry->name_len;
+
+	if (with_value) {
+		header->value = header->name + entry->name_len;
+		header->value_len = entry->value_len;
+	}
+
+	return 0;
+}
+
+static int hpack_dynamic_find(struct http_hpack_dynamic_table *table,
+			      struct http_hpack_header_buf *header,
+			      bool *name_only)
+{
+	int candidate = -1;
+
+	if (table == NULL) {
+		return -ENOENT;
+	}
+
+	for (uint32_t i = 0; i < table->count; i++) {
+		struct http_hpack_dynamic_entry *entry = hpack_dynamic_entry(table, i);
+		const uint8_t *name = &table->data[entry->offset];
+
+		if (entry->name_len != header->name_len ||
+		    memcmp(name, header->name, header->name_len) != 0) {
+			continue;
+		}
+
+		if (entry->value_len == header->value_len &&
+		    memcmp(name + entry->name_len, header->value,
+			   header->value_len) == 0) {
+			*name_only = false;
+			return HPACK_DYNAMIC_INDEX_BASE + i;
+		}
+
+		if (candidate < 0) {
+			candidate = HPACK_DYNAMIC_INDEX_BASE + i;
+		}
+	}
+
+	if (candidate > 0) {
+		*name_only = true;
+		return candidate;
+	}
+
+	return -ENOENT;
+}
+
+static int hpack_dynamic_size_update(struct http_hpack_dynamic_table *table,
+				     uint32_t max_size)
+{
+	if (table == NULL) {
+		return 0;
+	}
+
+	if (max_size > table->size_limit) {
+		/* RFC7541 ch 6.3, must be treated as a decoding error. */
+		return -EBADMSG;
+	}
+
+	table->max_size = max_size;
+	hpack_dynamic_evict(table, max_size);
+
+	return 0;
+}
+
+void http_hpack_dynamic_table_init(struct http_hpack_dynamic_table *table,
+				   uint32_t size_limit, bool encoder)
+{
+	memset(table, 0, sizeof(*table));
+
+	if (encoder) {
+		/* The peer decoder assumes the table to be as large as its
+		 * SETTINGS_HEADER_TABLE_SIZE. Using a smaller one does not need
+		 * to be signaled, as the peer only keeps additional, older
+		 * entries which are never referenced.
+		 */
+		table->size_limit = size_limit;
+		table->max_size = MIN(size_limit, sizeof(table->data));
+		table->min_size = table->max_size;
+	} else {
+		/* The peer encoder may use the whole table from the start, see
+		 * hpack_dynamic_insert() if it does not fit.
+		 */
+		table->size_limit = size_limit;
+		table->max_size = size_limit;
+	}
+}
+
+void http_hpack_dynamic_table_set_limit(struct http_hpack_dynamic_table *table,
+					uint32_t size_limit)
+{
+	if (size_limit == table->size_limit) {
+		return;
+	}
+
+	table->size_limit = size_limit;
+	table->max_size = MIN(size_limit, sizeof(table->data));
+	table->min_size = MIN(table->min_size, table->max_size);
+	table->size_update = true;
+
+	hpack_dynamic_evict(table, table->max_size);
+}
+
+void http_hpack_dynamic_table_set_decoder_limit(struct http_hpack_dynamic_table *table,
+						uint32_t size_limit)
+{
+	/* The peer has to signal a size within the new limit at the start of
+	 * its next header block anyway, shrinking the table now is safe.
+	 */
+	table->size_limit = size_limit;
+	table->max_size = MIN(table->max_size, size_limit);
+
+	hpack_dynamic_evict(table, table->max_size);
+}
+
+void http_hpack_dynamic_table_flush(struct http_hpack_dynamic_table *table)
+{
+	/* Empty the table on both ends by signaling size 0 on the next
+	 * header block.
+	 */
+	hpack_dynamic_evict(table, 0);
+	table->min_size = 0;
+	table->size_update = true;
+}
+#else
+static inline int hpack_dynamic_insert(struct http_hpack_dynamic_table *table,
+				       struct http_hpack_header_buf *header)
+{
+	return 0;
+}
+
+static inline int hpack_dynamic_get(struct http_hpack_dynamic_table *table,
+				    uint32_t index,
+				    struct http_hpack_header_buf *header,
+				    bool with_value)
+{
+	return -EBADMSG;
+}
+
+static inline int hpack_dynamic_find(struct http_hpack_dynamic_table *table,
+				     struct http_hpack_header_buf *header,
+				     bool *name_only)
+{
+	return -ENOENT;
+}
+
+static inline int hpack_dynamic_size_update(struct http_hpack_dynamic_table *table,
+					    uint32_t max_size)
+{
+	return 0;
+}
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
+static int hpack_table_get(struct http_hpack_dynamic_table *table,
+			   uint32_t index, struct http_hpack_header_buf *header,
+			   bool with_value)
+{
+	const struct hpack_table_entry *entry;
+
+	if (index >= HPACK_DYNAMIC_INDEX_BASE) {
+		return hpack_dynamic_get(table, index - HPACK_DYNAMIC_INDEX_BASE,
+					 header, with_value);
+	}
+
+	entry = http_hpack_table_get(index);
+	if (entry == NULL) {
+		return -EBADMSG;
+	}
+
+	if (entry->name == NULL || (with_value && entry->value == NULL)) {
+		return -EBADMSG;
+	}
+
+	header->name = entry->name;
+	header->name_len = strlen(entry->name);
+
+	if (with_value) {
+		header->value = entry->value;
+		header->value_len = strlen(entry->value);
+	}
+
+	return 0;
+}
+
+static int http_hpack_find_index(struct http_hpack_dynamic_table *table,
+				 struct http_hpack_header_buf *header,
 				 bool *name_only)
 {
 	const struct hpack_table_entry *entry;
 	int candidate = -1;
+	int ret;
 
 	for (int i = HTTP_SERVER_HPACK_AUTHORITY;
 	     i <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE; i++) {
@@ -123,6 +456,14 @@ static int http_hpack_find_index(struct http_hpack_header_buf *header,
 		}
 	}
 
+	ret = hpack_dynamic_find(table, header, name_only);
+	if (ret > 0 && (!*name_only || candidate < 0)) {
+		/* Exact match in the dynamic table, or name only match not
+		 * available in the static table.
+		 */
+		return ret;
+	}
+
 	if (candidate > 0) {
 		/* Matched name only. */
 		*name_only = true;
@@ -281,10 +622,10 @@ static int hpack_string_decode(const uint8_t *buf, size_t datalen,
 	return len;
 }
 
-static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
+static int hpack_handle_indexed(struct http_hpack_dynamic_table *table,
+				const uint8_t *buf, size_t datalen,
 				struct http_hpack_header_buf *header)
 {
-	const struct hpack_table_entry *entry;
 	uint32_t index;
 	int ret;
 
@@ -298,26 +639,17 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 		return -EBADMSG;
 	}
 
-	entry = http_hpack_table_get(index);
-	if (entry == NULL) {
-		return -EBADMSG;
-	}
-
-	if (entry->name == NULL || entry->value == NULL) {
+	if (hpack_table_get(table, index, header, true) < 0) {
 		return -EBADMSG;
 	}
 
-	header->name = entry->name;
-	header->name_len = strlen(entry->name);
-	header->value = entry->value;
-	header->value_len = strlen(entry->value);
-
 	return ret;
 }
 
-static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
+static int hpack_handle_literal(struct http_hpack_dynamic_table *table,
+				const uint8_t *buf, size_t datalen,
 				struct http_hpack_header_buf *header,
-				uint8_t prefix_len)
+				uint8_t prefix_len, bool indexing)
 {
 	uint32_t index;
 	int ret, len;
@@ -346,19 +678,9 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		datalen -= ret;
 	} else {
 		/* Indexed name. */
-		const struct hpack_table_entry *entry;
-
-		entry = http_hpack_table_get(index);
-		if (entry == NULL) {
+		if (hpack_table_get(table, index, header, false) < 0) {
 			return -EBADMSG;
 		}
-
-		if (entry->name == NULL) {
-			return -EBADMSG;
-		}
-
-		header->name = entry->name;
-		header->name_len = strlen(entry->name);
 	}
 
 	ret = hpack_string_decode(buf, datalen, HPACK_HEADER_VALUE, header);
@@ -368,26 +690,35 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 
 	len += ret;
 
+	if (indexing && table != NULL) {
+		ret = hpack_dynamic_insert(table, header);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
 	return len;
 }
 
-static int hpack_handle_literal_index(const uint8_t *buf, size_t datalen,
-			       struct http_hpack_header_buf *header)
+static int hpack_handle_literal_index(struct http_hpack_dynamic_table *table,
+				      const uint8_t *buf, size_t datalen,
+				      struct http_hpack_header_buf *header)
 {
-	/* TODO Add dynamic table support, if needed. */
-
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	return hpack_handle_literal(table, buf, datalen, header,
+				    HPACK_PREFIX_LEN_LITERAL_INDEXING, true);
 }
 
-static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
-				  struct http_hpack_header_buf *header)
+static int hpack_handle_literal_no_index(struct http_hpack_dynamic_table *table,
+					 const uint8_t *buf, size_t datalen,
+					 struct http_hpack_header_buf *header)
 {
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING);
+	return hpack_handle_literal(table, buf, datalen, header,
+				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING, false);
 }
 
-static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
+static int hpack_handle_dynamic_size_update(struct http_hpack_dynamic_table *table,
+					    const uint8_t *buf, size_t datalen,
+					    struct http_hpack_header_buf *header)
 {
 	uint32_t max_size;
 	int ret;
@@ -398,13 +729,28 @@ static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
 		return ret;
 	}
 
-	/* TODO Add dynamic table support, if needed. */
+	if (hpack_dynamic_size_update(table, max_size) < 0) {
+		return -EBADMSG;
+	}
+
+	/* No header field is carried by this representation. */
+	header->name = NULL;
+	header->name_len = 0;
+	header->value = NULL;
+	header->value_len = 0;
 
 	return ret;
 }
 
 int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 			     struct http_hpack_header_buf *header)
+{
+	return http_hpack_decode_header_dynamic(NULL, buf, datalen, header);
+}
+
+int http_hpack_decode_header_dynamic(struct http_hpack_dynamic_table *table,
+				     const uint8_t *buf, size_t datalen,
+				     struct http_hpack_header_buf *header)
 {
 	uint8_t prefix;
 	int ret;
@@ -420,18 +766,18 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 	prefix = *buf;
 
 	if ((prefix & HPACK_PREFIX_INDEXED_MASK) == HPACK_PREFIX_INDEXED) {
-		ret = hpack_handle_indexed(buf, datalen, header);
+		ret = hpack_handle_indexed(table, buf, datalen, header);
 	} else if ((prefix & HPACK_PREFIX_LITERAL_INDEXING_MASK) ==
 		   HPACK_PREFIX_LITERAL_INDEXING) {
-		ret = hpack_handle_literal_index(buf, datalen, header);
+		ret = hpack_handle_literal_index(table, buf, datalen, header);
 	} else if (((prefix & HPACK_PREFIX_LITERAL_NO_INDEXING_MASK) ==
 		    HPACK_PREFIX_LITERAL_NO_INDEXING) ||
 		   ((prefix & HPACK_PREFIX_LITERAL_NEVER_INDEXED_MASK) ==
 		    HPACK_PREFIX_LITERAL_NEVER_INDEXED)) {
-		ret = hpack_handle_literal_no_index(buf, datalen, header);
+		ret = hpack_handle_literal_no_index(table, buf, datalen, header);
 	} else if ((prefix & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) ==
 		   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
-		ret = hpack_handle_dynamic_size_update(buf, datalen);
+		ret = hpack_handle_dynamic_size_update(table, buf, datalen, header);
 	} else {
 		ret = -EINVAL;
 	}
@@ -465,7 +811,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -497,9 +843,16 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 		str_len = header->value_len;
 	}
 
-	/* Try to encode string into intermediate buffer. */
-	ret = http_hpack_huffman_encode(str, str_len, header->buf,
-					sizeof(header->buf));
+	/* Try to encode string into intermediate buffer. The encoding is
+	 * abandoned as soon as it is not shorter than the original, an empty
+	 * string cannot get any shorter.
+	 */
+	ret = 0;
+	if (str_len > 0) {
+		ret = http_hpack_huffman_encode(str, str_len, header->buf,
+						MIN(sizeof(header->buf), str_len - 1));
+	}
+
 	if (ret > 0 && ret < str_len) {
 		/* Use Huffman encoded string only if smaller than the original. */
 		str = header->buf;
@@ -529,23 +882,75 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal(uint8_t *buf, size_t buflen,
+/* Header fields which are never put into the dynamic table. Sensitive values
+ * use the never indexed representation (RFC7541 ch 7.1.3), frequently
+ * changing values are just sent without indexing.
+ */
+static const struct {
+	const char *name;
+	bool sensitive;
+} hpack_no_index_headers[] = {
+	{ "authorization", true },
+	{ "cookie", true },
+	{ "proxy-authorization", true },
+	{ "set-cookie", true },
+	{ "content-length", false },
+	{ "date", false },
+};
+
+enum hpack_literal_type {
+	HPACK_LITERAL_INDEXING,
+	HPACK_LITERAL_NO_INDEXING,
+	HPACK_LITERAL_NEVER_INDEXED,
+};
+
+static enum hpack_literal_type hpack_literal_type_get(struct http_hpack_dynamic_table *table,
+						      struct http_hpack_header_buf *header)
+{
+	if (table == NULL) {
+		/* Without a dynamic table keep the original behavior. */
+		return HPACK_LITERAL_NEVER_INDEXED;
+	}
+
+	ARRAY_FOR_EACH(hpack_no_index_headers, i) {
+		const char *name = hpack_no_index_headers[i].name;
+
+		if (strlen(name) == header->name_len &&
+		    strncasecmp(name, header->name, header->name_len) == 0) {
+			return hpack_no_index_headers[i].sensitive ?
+			       HPACK_LITERAL_NEVER_INDEXED : HPACK_LITERAL_NO_INDEXING;
+		}
+	}
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	if (hpack_entry_size(header->name_len, header->value_len) <= table->max_size) {
+		return HPACK_LITERAL_INDEXING;
+	}
+#endif
+
+	return HPACK_LITERAL_NO_INDEXING;
+}
+
+static int hpack_encode_literal(uint8_t *buf, size_t buflen, int index,
+				enum hpack_literal_type type,
 				struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
+	if (type == HPACK_LITERAL_INDEXING) {
+		ret = hpack_integer_encode(buf, buflen, index,
+					   HPACK_PREFIX_LITERAL_INDEXING,
+					   HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	} else if (type == HPACK_LITERAL_NO_INDEXING) {
+		ret = hpack_integer_encode(buf, buflen, index,
+					   HPACK_PREFIX_LITERAL_NO_INDEXING,
+					   HPACK_PREFIX_LEN_LITERAL_NO_INDEXING);
+	} else {
+		ret = hpack_integer_encode(buf, buflen, index,
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
 	}
 
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
 	if (ret < 0) {
 		return ret;
 	}
@@ -554,6 +959,18 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 	buflen -= ret;
 	len += ret;
 
+	if (index == 0) {
+		/* Literal name */
+		ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
 	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
 	if (ret < 0) {
 		return ret;
@@ -564,23 +981,41 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
-				      struct http_hpack_header_buf *header)
+static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
+{
+	return hpack_integer_encode(buf, buflen, index, HPACK_PREFIX_INDEXED,
+				    HPACK_PREFIX_LEN_INDEXED);
+}
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+/* Signal the table size change, RFC7541 ch 4.2. If the size was reduced and
+ * increased again, the smallest size is signaled first.
+ */
+static int hpack_encode_size_update(struct http_hpack_dynamic_table *table,
+				    uint8_t *buf, size_t buflen)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
+	if (!table->size_update) {
+		return 0;
 	}
 
-	buf += ret;
-	buflen -= ret;
-	len += ret;
+	if (table->min_size < table->max_size) {
+		ret = hpack_integer_encode(buf, buflen, table->min_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
 
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	ret = hpack_integer_encode(buf, buflen, table->max_size,
+				   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+				   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
 	if (ret < 0) {
 		return ret;
 	}
@@ -590,21 +1025,41 @@ static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
 	return len;
 }
 
-static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
+static void hpack_size_update_sent(struct http_hpack_dynamic_table *table)
 {
-	return hpack_integer_encode(buf, buflen, index, HPACK_PREFIX_INDEXED,
-				    HPACK_PREFIX_LEN_INDEXED);
+	table->size_update = false;
+	table->min_size = table->max_size;
+}
+#else
+static inline int hpack_encode_size_update(struct http_hpack_dynamic_table *table,
+					   uint8_t *buf, size_t buflen)
+{
+	return 0;
 }
 
+static inline void hpack_size_update_sent(struct http_hpack_dynamic_table *table)
+{
+}
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header)
 {
+	return http_hpack_encode_header_dynamic(NULL, buf, buflen, header);
+}
+
+int http_hpack_encode_header_dynamic(struct http_hpack_dynamic_table *table,
+				     uint8_t *buf, size_t buflen,
+				     struct http_hpack_header_buf *header)
+{
+	enum hpack_literal_type type;
 	int ret, len = 0;
 	bool name_only;
 
+	/* Header field values may be empty, RFC9110 ch 5.5. */
 	if (buf == NULL || header == NULL ||
 	    header->name == NULL || header->name_len == 0 ||
-	    header->value == NULL || header->value_len == 0) {
+	    header->value == NULL) {
 		return -EINVAL;
 	}
 
@@ -612,16 +1067,47 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 		return -ENOBUFS;
 	}
 
-	ret = http_hpack_find_index(header, &name_only);
-	if (ret < 0) {
-		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
-	} else if (name_only) {
-		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
-	} else {
+	if (table != NULL) {
+		ret = hpack_encode_size_update(table, buf, buflen);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	ret = http_hpack_find_index(table, header, &name_only);
+	if (ret > 0 && !name_only) {
 		/* Indexed */
-		len = hpack_encode_indexed(buf, buflen, ret);
+		ret = hpack_encode_indexed(buf, buflen, ret);
+		if (ret < 0) {
+			return ret;
+		}
+
+		type = HPACK_LITERAL_NO_INDEXING;
+	} else {
+		/* Literal value, with literal name if not found. */
+		type = hpack_literal_type_get(table, header);
+
+		ret = hpack_encode_literal(buf, buflen, MAX(ret, 0), type, header);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	len += ret;
+
+	if (table != NULL) {
+		hpack_size_update_sent(table);
+
+		if (type == HPACK_LITERAL_INDEXING) {
+			ret = hpack_dynamic_insert(table, header);
+			if (ret < 0) {
+				return ret;
+			}
+		}
 	}
 
 	return len;
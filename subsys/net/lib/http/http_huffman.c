@@ -277,6 +277,42 @@ static const struct decode_elem decode_table[] = {
 	{ 30,  22, { 0b11111111, 0b11111111, 0b11111111, 0b11111000 } },
 };
 
+/* Position of each symbol in decode_table, used for encoding. */
+static const uint8_t encode_table[256] = {
+	 84, 145, 224, 225, 226, 227, 228, 229,
+	230, 174, 253, 231, 232, 254, 233, 234,
+	235, 236, 237, 238, 239, 240, 255, 241,
+	242, 243, 244, 245, 246, 247, 248, 249,
+	 10,  74,  75,  82,  85,  11,  68,  79,
+	 76,  77,  69,  80,  70,  12,  13,  14,
+	  0,   1,   2,  15,  16,  17,  18,  19,
+	 20,  21,  36,  71,  92,  22,  83,  78,
+	 86,  23,  37,  38,  39,  40,  41,  42,
+	 43,  44,  45,  46,  47,  48,  49,  50,
+	 51,  52,  53,  54,  55,  56,  57,  58,
+	 72,  59,  73,  87,  95,  88,  90,  24,
+	 93,   3,  25,   4,  26,   5,  27,  28,
+	 29,   6,  60,  61,  30,  31,  32,   7,
+	 33,  62,  34,   8,   9,  35,  63,  64,
+	 65,  66,  67,  94,  81,  91,  89, 250,
+	 98, 119,  99, 100, 120, 121, 122, 146,
+	123, 147, 148, 149, 150, 151, 175, 152,
+	176, 177, 124, 153, 178, 154, 155, 156,
+	157, 106, 125, 158, 126, 159, 160, 179,
+	127, 107, 101, 128, 129, 161, 162, 108,
+	163, 130, 131, 180, 109, 132, 164, 165,
+	110, 111, 133, 112, 166, 134, 167, 168,
+	102, 135, 136, 137, 169, 138, 139, 170,
+	190, 191, 103,  96, 140, 171, 141, 186,
+	192, 193, 194, 205, 206, 195, 181, 187,
+	 97, 113, 196, 207, 208, 197, 209, 182,
+	114, 115, 198, 199, 251, 210, 211, 212,
+	104, 183, 105, 116, 142, 117, 118, 172,
+	143, 144, 188, 189, 184, 185, 200, 173,
+	201, 213, 202, 203, 214, 215, 216, 217,
+	218, 252, 219, 220, 221, 222, 223, 204,
+};
+
 static const struct decode_elem eos = {
 	30,   0, { 0b11111111, 0b11111111, 0b11111111, 0b11111100 }
 };
@@ -313,17 +349,6 @@ static const struct decode_elem *huffman_decode_bits(uint32_t bits)
 	return NULL;
 }
 
-static const struct decode_elem *huffman_find_entry(uint8_t symbol)
-{
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (decode_table[i].symbol == symbol) {
-			return &decode_table[i];
-		}
-	}
-
-	return NULL;
-}
-
 #define MAX_PADDING_LEN 7
 
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
@@ -419,61 +444,44 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 			      uint8_t *buf, size_t buflen)
 {
 	const struct decode_elem *entry;
-	size_t buflen_bits = buflen * 8;
-	uint8_t bit_offset = 0;
+	uint64_t bits = 0;
+	uint8_t bits_len = 0;
 	int len = 0;
 
 	if (str == NULL || buf == NULL || str_len == 0) {
 		return -EINVAL;
 	}
 
+	/* Codes are accumulated in a 64-bit register (at most 7 + 30 bits
+	 * used) and flushed byte by byte.
+	 */
 	while (str_len > 0) {
-		uint32_t code;
-		uint8_t bitlen;
+		entry = &decode_table[encode_table[*str]];
 
-		entry = huffman_find_entry(*str);
-		if (entry == NULL) {
-			return -EINVAL;
-		}
+		bits = (bits << entry->bitlen) |
+		       (sys_get_be32(entry->code) >> (UINT32_BITLEN - entry->bitlen));
+		bits_len += entry->bitlen;
 
-		if (entry->bitlen > buflen_bits) {
-			return -ENOBUFS;
-		}
-
-		bitlen = entry->bitlen;
-		code = sys_get_be32(entry->code);
-
-		while (bitlen > 0) {
-			uint8_t to_copy = MIN(8 - bit_offset, bitlen);
-			uint8_t byte = (uint8_t)((code & MSB_MASK(to_copy)) >>
-						 (24 + bit_offset));
-
-			/* This is way suboptimal */
-			if (bit_offset == 0) {
-				*buf = byte;
-			} else {
-				*buf |= byte;
+		while (bits_len >= 8) {
+			if (len >= buflen) {
+				return -ENOBUFS;
 			}
 
-			code <<= to_copy;
-			bitlen -= to_copy;
-			bit_offset  = (bit_offset + to_copy) % 8;
-
-			if (bit_offset == 0) {
-				buf++;
-				len++;
-			}
+			bits_len -= 8;
+			buf[len++] = (uint8_t)(bits >> bits_len);
 		}
 
-		buflen_bits -= entry->bitlen;
 		str_len--;
 		str++;
 	}
 
 	/* Pad with ones. */
-	if (bit_offset > 0) {
-		*buf |= LSB_MASK((8 - bit_offset));
-		len++;
+	if (bits_len > 0) {
+		if (len >= buflen) {
+			return -ENOBUFS;
+		}
+
+		buf[len++] = (uint8_t)((bits << (8 - bits_len)) | LSB_MASK((8 - bits_len)));
 	}
 
 	return len;
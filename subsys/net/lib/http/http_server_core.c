@@ -442,6 +442,16 @@ static void init_client_ctx(struct http_client_ctx *client, const struct http_se
 	}
 
 	client->current_stream = NULL;
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	/* The client may use the default table size until it acknowledges
+	 * the one advertised in our SETTINGS frame.
+	 */
+	http_hpack_dynamic_table_init(&client->hpack_decoder,
+				      HTTP_HPACK_DEFAULT_TABLE_SIZE, false);
+	http_hpack_dynamic_table_init(&client->hpack_encoder,
+				      HTTP_HPACK_DEFAULT_TABLE_SIZE, true);
+#endif
 }
 
 static int handle_http_preface(struct http_client_ctx *client)
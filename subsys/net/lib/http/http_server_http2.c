@@ -117,7 +117,12 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	ret = http_hpack_encode_header_dynamic(&client->hpack_encoder, *buf, *buflen,
+					       &client->header_field);
+#else
 	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+#endif
 	if (ret < 0) {
 		LOG_DBG("Failed to encode header, err %d", ret);
 		return ret;
@@ -160,7 +165,7 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 
 	ret = add_header_field(client, &buf, &buflen, ":status", status_str);
 	if (ret < 0) {
-		return ret;
+		goto error;
 	}
 
 	for (size_t i = 0; i < extra_headers_count; i++) {
@@ -176,7 +181,7 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 
 		ret = add_header_field(client, &buf, &buflen, hdr->name, hdr->value);
 		if (ret < 0) {
-			return ret;
+			goto error;
 		}
 	}
 
@@ -184,7 +189,7 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 		ret = add_header_field(client, &buf, &buflen, "content-encoding",
 				       detail_common->content_encoding);
 		if (ret < 0) {
-			return ret;
+			goto error;
 		}
 	}
 
@@ -192,7 +197,7 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 		ret = add_header_field(client, &buf, &buflen, "content-type",
 				       detail_common->content_type);
 		if (ret < 0) {
-			return ret;
+			goto error;
 		}
 	}
 
@@ -212,6 +217,16 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 	client->current_stream->headers_sent = true;
 
 	return 0;
+
+error:
+	/* The header block is dropped, so are the entries it added to the
+	 * dynamic table. Start over with an empty table on the next one.
+	 */
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	http_hpack_dynamic_table_flush(&client->hpack_encoder);
+#endif
+
+	return ret;
 }
 
 static int send_data_frame(struct http_client_ctx *client, const char *payload,
@@ -262,7 +277,8 @@ int send_settings_frame(struct http_client_ctx *client, bool ack)
 			(settings_frame + HTTP2_FRAME_HEADER_SIZE);
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_HEADER_TABLE_SIZE),
 			      UNALIGNED_MEMBER_ADDR(setting, id));
-		UNALIGNED_PUT(0, UNALIGNED_MEMBER_ADDR(setting, value));
+		UNALIGNED_PUT(htonl(HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE),
+			      UNALIGNED_MEMBER_ADDR(setting, value));
 
 		setting++;
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS),
@@ -1561,7 +1577,12 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		struct http_hpack_header_buf *header = &client->header_field;
 		size_t datalen = MIN(client->data_len, frame->length);
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+		ret = http_hpack_decode_header_dynamic(&client->hpack_decoder,
+						       client->cursor, datalen, header);
+#else
 		ret = http_hpack_decode_header(client->cursor, datalen, header);
+#endif
 		if (ret <= 0) {
 			if (ret == -EAGAIN) {
 				ret = handle_incomplete_http_header(client);
@@ -1586,6 +1607,11 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		client->cursor += ret;
 		client->data_len -= ret;
 
+		if (header->name == NULL) {
+			/* Dynamic table size update, no header field. */
+			continue;
+		}
+
 		LOG_DBG("Parsed header: %.*s %.*s", (int)header->name_len,
 			header->name, (int)header->value_len, header->value);
 
@@ -1725,6 +1751,25 @@ int handle_http_frame_rst_stream(struct http_client_ctx *client)
 	return 0;
 }
 
+static void parse_http_frame_settings(struct http_client_ctx *client)
+{
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	struct http2_settings_field *setting =
+		(struct http2_settings_field *)client->cursor;
+	size_t count = client->current_frame.length / sizeof(*setting);
+
+	for (size_t i = 0; i < count; i++, setting++) {
+		uint16_t id = ntohs(UNALIGNED_GET(UNALIGNED_MEMBER_ADDR(setting, id)));
+		uint32_t value = ntohl(UNALIGNED_GET(UNALIGNED_MEMBER_ADDR(setting, value)));
+
+		if (id == HTTP2_SETTINGS_HEADER_TABLE_SIZE) {
+			/* Limits the table used for response header fields. */
+			http_hpack_dynamic_table_set_limit(&client->hpack_encoder, value);
+		}
+	}
+#endif
+}
+
 int handle_http_frame_settings(struct http_client_ctx *client)
 {
 	struct http2_frame *frame = &client->current_frame;
@@ -1736,6 +1781,19 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE) &&
+	    !is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		parse_http_frame_settings(client);
+	}
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	if (is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		/* The client now sticks to the request table size we advertised. */
+		http_hpack_dynamic_table_set_decoder_limit(&client->hpack_decoder,
+							   HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+	}
+#endif
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -65,6 +65,14 @@ static sys_slist_t obs_obj_path_list;
 
 static struct observe_node observe_node_data[CONFIG_LWM2M_ENGINE_MAX_OBSERVER];
 
+/* Number of observed paths per bucket. Paths above the object instance level
+ * are counted under the reserved instance ID 65535, so they match every
+ * instance of the object.
+ */
+static uint16_t obs_path_index[CONFIG_LWM2M_ENGINE_OBSERVER_INDEX_SIZE];
+
+#define OBS_PATH_INDEX_ALL_INST UINT16_MAX
+
 /* External resources */
 struct lwm2m_ctx **lwm2m_sock_ctx(void);
 
@@ -336,6 +344,42 @@ static bool lwm2m_notify_observer_list(sys_slist_t *path_list, const struct lwm2
 	return false;
 }
 
+static uint16_t *obs_path_index_bucket(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	uint32_t hash = lwm2m_obj_inst_hash(obj_id, obj_inst_id);
+
+	return &obs_path_index[hash % CONFIG_LWM2M_ENGINE_OBSERVER_INDEX_SIZE];
+}
+
+static void obs_path_index_update(const struct lwm2m_obj_path *path, bool add)
+{
+	uint16_t *count;
+
+	if (path->level >= LWM2M_PATH_LEVEL_OBJECT_INST) {
+		count = obs_path_index_bucket(path->obj_id, path->obj_inst_id);
+	} else {
+		count = obs_path_index_bucket(path->obj_id, OBS_PATH_INDEX_ALL_INST);
+	}
+
+	if (add) {
+		(*count)++;
+	} else if (*count > 0) {
+		(*count)--;
+	}
+}
+
+/* Returns false if no observed path can match the given path */
+static bool obs_path_index_match(const struct lwm2m_obj_path *path)
+{
+	/* Observations of any instance match a path on object level */
+	if (path->level < LWM2M_PATH_LEVEL_OBJECT_INST) {
+		return true;
+	}
+
+	return *obs_path_index_bucket(path->obj_id, OBS_PATH_INDEX_ALL_INST) > 0 ||
+	       *obs_path_index_bucket(path->obj_id, path->obj_inst_id) > 0;
+}
+
 int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
 {
 	struct lwm2m_obj_path path;
@@ -637,6 +681,10 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
 		return 0;
 	}
 
+	if (!obs_path_index_match(path)) {
+		return 0;
+	}
+
 	/* look for observers which match our resource */
 	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
 		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
@@ -758,6 +806,8 @@ static void engine_observe_node_init(struct observe_node *obs, const uint8_t *to
 		LOG_DBG("OBSERVER ADDED %u/%u/%u/%u(%u)", tmp->path.obj_id, tmp->path.obj_inst_id,
 			tmp->path.res_id, tmp->path.res_inst_id, tmp->path.level);
 
+		obs_path_index_update(&tmp->path, true);
+
 		if (ctx->observe_cb) {
 			ctx->observe_cb(LWM2M_OBSERVE_EVENT_OBSERVER_ADDED, &tmp->path, ctx);
 		}
@@ -776,6 +826,8 @@ static void remove_observer_path_from_list(struct lwm2m_ctx *ctx, struct observe
 	if (ctx->observe_cb) {
 		ctx->observe_cb(LWM2M_OBSERVE_EVENT_OBSERVER_REMOVED, &o_p->path, NULL);
 	}
+	obs_path_index_update(&o_p->path, false);
+
 	/* Remove from the list and add to free list */
 	sys_slist_remove(&obs->path_list, prev_node, &o_p->node);
 	sys_slist_append(&obs_obj_path_list, &o_p->node);
@@ -1719,6 +1771,10 @@ bool lwm2m_path_is_observed(const struct lwm2m_obj_path *path)
 	struct observe_node *obs;
 	struct lwm2m_ctx **sock_ctx = lwm2m_sock_ctx();
 
+	if (!obs_path_index_match(path)) {
+		return false;
+	}
+
 	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
 		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
 
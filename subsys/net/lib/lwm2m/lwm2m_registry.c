@@ -89,6 +89,22 @@ static const struct default_obj_version default_obj_versions[] = {
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
 
+/* Lookup tables, the lists above keep the registration order */
+static sys_slist_t engine_obj_hash[CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+static sys_slist_t engine_obj_inst_hash[CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+
+static inline sys_slist_t *engine_obj_bucket(uint16_t obj_id)
+{
+	return &engine_obj_hash[obj_id % CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+}
+
+static inline sys_slist_t *engine_obj_inst_bucket(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	uint32_t hash = lwm2m_obj_inst_hash(obj_id, obj_inst_id);
+
+	return &engine_obj_inst_hash[hash % CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+}
+
 /* Resource wrappers */
 sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
@@ -113,6 +129,7 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_list, &obj->node);
+	sys_slist_append(engine_obj_bucket(obj->obj_id), &obj->hash_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -124,6 +141,7 @@ void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 #endif
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+	sys_slist_find_and_remove(engine_obj_bucket(obj->obj_id), &obj->hash_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -131,7 +149,11 @@ struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
+	if (obj_id < 0 || obj_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(engine_obj_bucket(obj_id), obj, hash_node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
 		}
@@ -145,6 +167,12 @@ struct lwm2m_engine_obj_field *lwm2m_get_engine_obj_field(struct lwm2m_engine_ob
 	int i;
 
 	if (obj && obj->fields && obj->field_count > 0) {
+		/* Most objects list their fields in resource ID order */
+		if (res_id >= 0 && res_id < obj->field_count &&
+		    obj->fields[res_id].res_id == res_id) {
+			return &obj->fields[res_id];
+		}
+
 		for (i = 0; i < obj->field_count; i++) {
 			if (obj->fields[i].res_id == res_id) {
 				return &obj->fields[i];
@@ -176,6 +204,8 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_append(engine_obj_inst_bucket(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+			 &obj_inst->hash_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,13 +215,21 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(engine_obj_inst_bucket(obj_inst->obj->obj_id,
+							 obj_inst->obj_inst_id),
+				  &obj_inst->hash_node);
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
+	if (obj_id < 0 || obj_id > UINT16_MAX || obj_inst_id < 0 || obj_inst_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(engine_obj_inst_bucket(obj_id, obj_inst_id), obj_inst,
+				     hash_node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
 		}
@@ -392,10 +430,16 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
-		if (oi->resources[i].res_id == path->res_id) {
-			r = &oi->resources[i];
-			break;
+	/* Resources are usually initialized in the order of the object fields */
+	i = of - oi->obj->fields;
+	if (i < oi->resource_count && oi->resources[i].res_id == path->res_id) {
+		r = &oi->resources[i];
+	} else {
+		for (i = 0; i < oi->resource_count; i++) {
+			if (oi->resources[i].res_id == path->res_id) {
+				r = &oi->resources[i];
+				break;
+			}
 		}
 	}
 
@@ -403,10 +447,15 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < r->res_inst_count; i++) {
-		if (r->res_instances[i].res_inst_id == path->res_inst_id) {
-			ri = &r->res_instances[i];
-			break;
+	if (path->res_inst_id < r->res_inst_count &&
+	    r->res_instances[path->res_inst_id].res_inst_id == path->res_inst_id) {
+		ri = &r->res_instances[path->res_inst_id];
+	} else {
+		for (i = 0; i < r->res_inst_count; i++) {
+			if (r->res_instances[i].res_inst_id == path->res_inst_id) {
+				ri = &r->res_instances[i];
+				break;
+			}
 		}
 	}
 
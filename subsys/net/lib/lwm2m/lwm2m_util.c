@@ -529,6 +529,18 @@ bool lwm2m_obj_path_equal(const struct lwm2m_obj_path *a, const struct lwm2m_obj
 	return true;
 }
 
+uint32_t lwm2m_obj_inst_hash(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	uint32_t key = ((uint32_t)obj_id << 16) | obj_inst_id;
+
+	/* Instance IDs are usually small and sequential, spread them */
+	key ^= key >> 15;
+	key *= 0x2c1b3c6dU;
+	key ^= key >> 12;
+
+	return key;
+}
+
 /* for debugging: to print IP addresses */
 char *lwm2m_sprint_ip_addr(const struct sockaddr *addr)
 {
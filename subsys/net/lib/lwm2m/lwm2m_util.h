@@ -28,6 +28,16 @@ int lwm2m_string_to_path(const char *pathstr, struct lwm2m_obj_path *path, char
 
 bool lwm2m_obj_path_equal(const struct lwm2m_obj_path *a, const struct lwm2m_obj_path *b);
 
+/**
+ * @brief Hash of an object instance, used to index the registry and the
+ * observed paths.
+ *
+ * @param obj_id Object ID
+ * @param obj_inst_id Object instance ID
+ * @return hash value
+ */
+uint32_t lwm2m_obj_inst_hash(uint16_t obj_id, uint16_t obj_inst_id);
+
 /**
  * @brief Used for debugging to print ip addresses.
  *
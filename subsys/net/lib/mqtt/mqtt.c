@@ -25,14 +25,44 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+#if defined(CONFIG_MQTT_TX_BATCH)
+	client->internal.tx_batch_len = 0U;
+	client->internal.tx_batch = false;
+#endif
 }
 
-/** @brief Initialize tx buffer. */
-static void tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
+#if defined(CONFIG_MQTT_TX_BATCH)
+static int tx_batch_flush(struct mqtt_client *client);
+#else
+static inline int tx_batch_flush(struct mqtt_client *client)
 {
+	ARG_UNUSED(client);
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_TX_BATCH */
+
+/** @brief Initialize tx buffer.
+ *
+ * @return 0 on success or a negative error code if the batched packets could
+ *         not be sent, in which case the client has been disconnected.
+ */
+static int tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
+{
+	int err_code;
+
+	/* Batched packets have to be sent before the buffer is reused. */
+	err_code = tx_batch_flush(client);
+	if (err_code < 0) {
+		return err_code;
+	}
+
 	memset(client->tx_buf, 0, client->tx_buf_size);
 	buf->cur = client->tx_buf;
 	buf->end = client->tx_buf + client->tx_buf_size;
+
+	return 0;
 }
 
 void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt)
@@ -79,7 +109,11 @@ static int client_connect(struct mqtt_client *client)
 		return err_code;
 	}
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
+
 	MQTT_SET_STATE(client, MQTT_STATE_TCP_CONNECTED);
 
 	err_code = connect_request_encode(client, &packet);
@@ -112,10 +146,12 @@ static int client_write(struct mqtt_client *client, const uint8_t *data,
 			uint32_t datalen);
 
 #if defined(CONFIG_MQTT_VERSION_5_0)
-static void disconnect_5_0_notify(struct mqtt_client *client, int err)
+/* Returns a negative error code if the client was disconnected on a failed write */
+static int disconnect_5_0_notify(struct mqtt_client *client, int err)
 {
 	struct mqtt_disconnect_param param = { };
 	struct buf_ctx packet;
+	int err_code;
 
 	/* Parser might've set custom failure reason, in such case skip generic
 	 * mapping from errno to reason code.
@@ -127,7 +163,7 @@ static void disconnect_5_0_notify(struct mqtt_client *client, int err)
 		case ECONNREFUSED:
 		case ENOTCONN:
 			/* Connection rejected/closed, skip disconnect. */
-			return;
+			return 0;
 		case EINVAL:
 			param.reason_code = MQTT_DISCONNECT_MALFORMED_PACKET;
 			break;
@@ -143,19 +179,24 @@ static void disconnect_5_0_notify(struct mqtt_client *client, int err)
 		}
 	}
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
 
 	if (disconnect_encode(client, &param, &packet) < 0) {
-		return;
+		return 0;
 	}
 
-	(void)client_write(client, packet.cur, packet.end - packet.cur);
+	return client_write(client, packet.cur, packet.end - packet.cur);
 }
 #else
-static void disconnect_5_0_notify(struct mqtt_client *client, int err)
+static int disconnect_5_0_notify(struct mqtt_client *client, int err)
 {
 	ARG_UNUSED(client);
 	ARG_UNUSED(err);
+
+	return 0;
 }
 #endif /* CONFIG_MQTT_VERSION_5_0 */
 
@@ -170,9 +211,10 @@ static int client_read(struct mqtt_client *client)
 
 	err_code = mqtt_handle_rx(client);
 	if (err_code < 0) {
-		if (mqtt_is_version_5_0(client)) {
-			/* Best effort send, if it fails just shut the connection. */
-			disconnect_5_0_notify(client, -err_code);
+		/* Best effort send, if it fails the connection is already shut. */
+		if (mqtt_is_version_5_0(client) &&
+		    disconnect_5_0_notify(client, -err_code) < 0) {
+			return err_code;
 		}
 
 		mqtt_client_disconnect(client, err_code, true);
@@ -223,6 +265,343 @@ static int client_write_msg(struct mqtt_client *client,
 	return 0;
 }
 
+#if defined(CONFIG_MQTT_TX_BATCH)
+static int tx_batch_flush(struct mqtt_client *client)
+{
+	uint32_t len = client->internal.tx_batch_len;
+
+	if (len == 0U) {
+		return 0;
+	}
+
+	client->internal.tx_batch_len = 0U;
+
+	return client_write(client, client->tx_buf, len);
+}
+
+/** @brief Append an encoded PUBLISH packet and its payload to the batch.
+ *
+ * @return 1 if the packet was batched, 0 if it shall be sent right away or a
+ *         negative error code if the batch could not be flushed.
+ */
+static int tx_batch_publish(struct mqtt_client *client,
+			    const struct buf_ctx *packet,
+			    const struct mqtt_binstr *payload)
+{
+	uint32_t hdr_len = packet->end - packet->cur;
+	uint8_t *dst;
+	int err_code;
+
+	if (!client->internal.tx_batch) {
+		return 0;
+	}
+
+	/* The header was encoded behind the batched packets, so only the
+	 * payload may not fit.
+	 */
+	if (client->tx_buf_size - client->internal.tx_batch_len - hdr_len <
+	    payload->len) {
+		err_code = tx_batch_flush(client);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		if (client->tx_buf_size - hdr_len < payload->len) {
+			return 0;
+		}
+	}
+
+	dst = client->tx_buf + client->internal.tx_batch_len;
+
+	/* Close the gap left by the reserved fixed header space. */
+	memmove(dst, packet->cur, hdr_len);
+	if (payload->len > 0U) {
+		memcpy(dst + hdr_len, payload->data, payload->len);
+	}
+
+	client->internal.tx_batch_len += hdr_len + payload->len;
+
+	return 1;
+}
+
+static int publish_packet_encode(struct mqtt_client *client,
+				 const struct mqtt_publish_param *param,
+				 struct buf_ctx *packet)
+{
+	uint32_t batch_len = client->internal.tx_batch_len;
+	int err_code;
+
+	if (client->internal.tx_batch &&
+	    client->tx_buf_size - batch_len >= MQTT_FIXED_HEADER_MAX_SIZE) {
+		packet->cur = client->tx_buf + batch_len;
+		packet->end = client->tx_buf + client->tx_buf_size;
+
+		err_code = publish_encode(client, param, packet);
+		if (err_code != -ENOMEM || batch_len == 0U) {
+			return err_code;
+		}
+
+		/* No room left behind the batched packets, start over. */
+		err_code = tx_batch_flush(client);
+		if (err_code < 0) {
+			return err_code;
+		}
+	}
+
+	err_code = tx_buf_init(client, packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	return publish_encode(client, param, packet);
+}
+#else
+static inline int tx_batch_publish(struct mqtt_client *client,
+				   const struct buf_ctx *packet,
+				   const struct mqtt_binstr *payload)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(packet);
+	ARG_UNUSED(payload);
+
+	return 0;
+}
+
+static int publish_packet_encode(struct mqtt_client *client,
+				 const struct mqtt_publish_param *param,
+				 struct buf_ctx *packet)
+{
+	int err_code;
+
+	err_code = tx_buf_init(client, packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	return publish_encode(client, param, packet);
+}
+#endif /* CONFIG_MQTT_TX_BATCH */
+
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+static uint32_t inflight_slot_size(const struct mqtt_client *client)
+{
+	if (client->inflight_buf == NULL) {
+		return 0U;
+	}
+
+	return client->inflight_buf_size / CONFIG_MQTT_INFLIGHT_WINDOW_SIZE;
+}
+
+static uint8_t *inflight_slot_buf(struct mqtt_client *client, uint8_t slot)
+{
+	return client->inflight_buf + slot * inflight_slot_size(client);
+}
+
+static int inflight_find(const struct mqtt_client *client, uint16_t message_id)
+{
+	for (int i = 0; i < client->internal.inflight_count; i++) {
+		if (client->internal.inflight[i].message_id == message_id) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static void inflight_remove(struct mqtt_client *client, int idx)
+{
+	struct mqtt_internal *internal = &client->internal;
+
+	internal->inflight_slots &= ~BIT(internal->inflight[idx].slot);
+	internal->inflight_count--;
+
+	/* Keep the remaining messages in publication order, retransmissions
+	 * have to follow it.
+	 */
+	memmove(&internal->inflight[idx], &internal->inflight[idx + 1],
+		(internal->inflight_count - idx) * sizeof(internal->inflight[0]));
+}
+
+static int inflight_add(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			const struct buf_ctx *packet)
+{
+	struct mqtt_internal *internal = &client->internal;
+	uint32_t hdr_len = packet->end - packet->cur;
+	uint32_t len = hdr_len + param->message.payload.len;
+	uint32_t slot_size = inflight_slot_size(client);
+	struct mqtt_inflight_msg *msg;
+	int idx;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return 0;
+	}
+
+	if ((slot_size > 0U) && (len > slot_size)) {
+		return -EMSGSIZE;
+	}
+
+	/* Publishing with the id of an in-flight message replaces it. */
+	idx = inflight_find(client, param->message_id);
+	if (idx >= 0) {
+		inflight_remove(client, idx);
+	} else if (internal->inflight_count >= internal->inflight_max) {
+		return -EAGAIN;
+	}
+
+	msg = &internal->inflight[internal->inflight_count++];
+	msg->message_id = param->message_id;
+	msg->released = false;
+	msg->slot = find_lsb_set(~internal->inflight_slots) - 1;
+	msg->len = 0U;
+
+	internal->inflight_slots |= BIT(msg->slot);
+
+	if (slot_size > 0U) {
+		uint8_t *dst = inflight_slot_buf(client, msg->slot);
+
+		memcpy(dst, packet->cur, hdr_len);
+		if (param->message.payload.len > 0U) {
+			memcpy(dst + hdr_len, param->message.payload.data,
+			       param->message.payload.len);
+		}
+
+		msg->len = len;
+	}
+
+	return 0;
+}
+
+static int inflight_release_send(struct mqtt_client *client,
+				 uint16_t message_id)
+{
+	const struct mqtt_pubrel_param param = {
+		.message_id = message_id,
+	};
+	struct buf_ctx packet;
+	int err_code;
+
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	err_code = publish_release_encode(client, &param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	return mqtt_transport_write(client, packet.cur,
+				    packet.end - packet.cur);
+}
+
+int mqtt_inflight_resume(struct mqtt_client *client,
+			 const struct mqtt_connack_param *param)
+{
+	struct mqtt_internal *internal = &client->internal;
+	int err_code;
+	int i = 0;
+
+	internal->inflight_max = CONFIG_MQTT_INFLIGHT_WINDOW_SIZE;
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	if (mqtt_is_version_5_0(client) && param->prop.rx.has_receive_maximum) {
+		internal->inflight_max = MIN(internal->inflight_max,
+					     param->prop.receive_maximum);
+	}
+#endif
+
+	/* MQTT 3.1.0 has no Session Present flag. */
+	if (client->clean_session ||
+	    (!param->session_present_flag &&
+	     client->protocol_version != MQTT_VERSION_3_1_0)) {
+		internal->inflight_count = 0U;
+		internal->inflight_slots = 0U;
+		return 0;
+	}
+
+	while (i < internal->inflight_count) {
+		struct mqtt_inflight_msg *msg = &internal->inflight[i];
+
+		if (msg->released) {
+			err_code = inflight_release_send(client, msg->message_id);
+		} else if (msg->len > 0U) {
+			uint8_t *data = inflight_slot_buf(client, msg->slot);
+
+			data[0] |= MQTT_HEADER_DUP_MASK;
+			err_code = mqtt_transport_write(client, data, msg->len);
+		} else {
+			NET_DBG("[CID %p]: Message id 0x%04x not stored, dropped",
+				client, msg->message_id);
+			inflight_remove(client, i);
+			continue;
+		}
+
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		internal->last_activity = mqtt_sys_tick_in_ms_get();
+		i++;
+	}
+
+	return 0;
+}
+
+void mqtt_inflight_complete(struct mqtt_client *client, uint16_t message_id)
+{
+	int idx = inflight_find(client, message_id);
+
+	if (idx >= 0) {
+		inflight_remove(client, idx);
+	}
+}
+
+void mqtt_inflight_received(struct mqtt_client *client,
+			    const struct mqtt_pubrec_param *param)
+{
+	int idx = inflight_find(client, param->message_id);
+
+	if (idx < 0) {
+		return;
+	}
+
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	/* Reason codes of 0x80 or greater terminate the QoS 2 flow. */
+	if (param->reason_code >= 0x80) {
+		inflight_remove(client, idx);
+		return;
+	}
+#endif
+
+	client->internal.inflight[idx].released = true;
+}
+
+int mqtt_inflight_count(struct mqtt_client *client)
+{
+	int count;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+	count = client->internal.inflight_count;
+	mqtt_mutex_unlock(client);
+
+	return count;
+}
+#else
+static inline int inflight_add(struct mqtt_client *client,
+			       const struct mqtt_publish_param *param,
+			       const struct buf_ctx *packet)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(param);
+	ARG_UNUSED(packet);
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
 void mqtt_client_init(struct mqtt_client *client)
 {
 	NULL_PARAM_CHECK_VOID(client);
@@ -311,18 +690,28 @@ int mqtt_publish(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
-
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	err_code = publish_encode(client, param, &packet);
+	err_code = publish_packet_encode(client, param, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	err_code = inflight_add(client, param, &packet);
 	if (err_code < 0) {
 		goto error;
 	}
 
+	err_code = tx_batch_publish(client, &packet, &param->message.payload);
+	if (err_code != 0) {
+		/* Either batched or the batch could not be sent. */
+		err_code = MIN(err_code, 0);
+		goto error;
+	}
+
 	io_vector[0].iov_base = packet.cur;
 	io_vector[0].iov_len = packet.end - packet.cur;
 	io_vector[1].iov_base = param->message.payload.data;
@@ -344,6 +733,42 @@ error:
 	return err_code;
 }
 
+#if defined(CONFIG_MQTT_TX_BATCH)
+int mqtt_batch_begin(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	err_code = verify_tx_state(client);
+	if (err_code == 0) {
+		client->internal.tx_batch = true;
+	}
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_batch_end(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	client->internal.tx_batch = false;
+	err_code = tx_batch_flush(client);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+#endif /* CONFIG_MQTT_TX_BATCH */
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
@@ -358,7 +783,10 @@ int mqtt_publish_qos1_ack(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
@@ -395,7 +823,10 @@ int mqtt_publish_qos2_receive(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
@@ -432,7 +863,10 @@ int mqtt_publish_qos2_release(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
@@ -469,7 +903,10 @@ int mqtt_publish_qos2_complete(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
@@ -505,7 +942,10 @@ int mqtt_disconnect(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
@@ -545,7 +985,10 @@ int mqtt_subscribe(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
@@ -579,7 +1022,10 @@ int mqtt_unsubscribe(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
@@ -608,7 +1054,10 @@ int mqtt_ping(struct mqtt_client *client)
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
@@ -665,7 +1114,10 @@ int mqtt_auth(struct mqtt_client *client, const struct mqtt_auth_param *param)
 		goto error;
 	}
 
-	tx_buf_init(client, &packet);
+	err_code = tx_buf_init(client, &packet);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = verify_auth_state(client);
 	if (err_code < 0) {
@@ -208,6 +208,59 @@ int mqtt_handle_rx(struct mqtt_client *client);
  */
 void mqtt_client_disconnect(struct mqtt_client *client, int result, bool notify);
 
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+/**@brief Resume or discard the in-flight messages on connection acknowledgment.
+ *
+ * Retransmits the stored PUBLISH packets with DUP flag set and the pending
+ * PUBREL packets if the session was resumed, empties the window otherwise.
+ *
+ * @param[in] client Identifies the client which connected.
+ * @param[in] param Decoded CONNACK packet.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_inflight_resume(struct mqtt_client *client,
+			 const struct mqtt_connack_param *param);
+
+/**@brief Release an in-flight message on PUBACK or PUBCOMP.
+ *
+ * @param[in] client Identifies the client which received the acknowledgment.
+ * @param[in] message_id Message id of the acknowledged message.
+ */
+void mqtt_inflight_complete(struct mqtt_client *client, uint16_t message_id);
+
+/**@brief Mark an in-flight QoS 2 message as received by the broker on PUBREC.
+ *
+ * @param[in] client Identifies the client which received the acknowledgment.
+ * @param[in] param Decoded PUBREC packet.
+ */
+void mqtt_inflight_received(struct mqtt_client *client,
+			    const struct mqtt_pubrec_param *param);
+#else
+static inline int mqtt_inflight_resume(struct mqtt_client *client,
+				       const struct mqtt_connack_param *param)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(param);
+
+	return 0;
+}
+
+static inline void mqtt_inflight_complete(struct mqtt_client *client,
+					  uint16_t message_id)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(message_id);
+}
+
+static inline void mqtt_inflight_received(struct mqtt_client *client,
+					  const struct mqtt_pubrec_param *param)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(param);
+}
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
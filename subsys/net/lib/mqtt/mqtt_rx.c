@@ -45,6 +45,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 						MQTT_CONNECTION_ACCEPTED) {
 				/* Set state. */
 				MQTT_SET_STATE(client, MQTT_STATE_CONNECTED);
+
+				/* Retransmit before the application gets a
+				 * chance to publish anything new.
+				 */
+				err_code = mqtt_inflight_resume(
+						client, &evt.param.connack);
 			} else {
 				err_code = -ECONNREFUSED;
 			}
@@ -80,6 +86,10 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(client, buf, &evt.param.puback);
 		evt.result = err_code;
+		if (err_code == 0) {
+			mqtt_inflight_complete(client,
+					       evt.param.puback.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -89,6 +99,9 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		err_code = publish_receive_decode(client, buf,
 						  &evt.param.pubrec);
 		evt.result = err_code;
+		if (err_code == 0) {
+			mqtt_inflight_received(client, &evt.param.pubrec);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_PUBREL:
@@ -107,6 +120,10 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		err_code = publish_complete_decode(client, buf,
 						   &evt.param.pubcomp);
 		evt.result = err_code;
+		if (err_code == 0) {
+			mqtt_inflight_complete(client,
+					       evt.param.pubcomp.message_id);
+		}
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
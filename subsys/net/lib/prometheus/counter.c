@@ -6,6 +6,7 @@
 
 #include <zephyr/net/prometheus/counter.h>
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -14,6 +15,97 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_counter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS)
+
+/*
+ * A shard is folded into the counter value once it reaches PENDING_FOLD, which
+ * leaves room for PENDING_MAX more before the atomic_t wraps, even on 32-bit
+ * targets. Larger increments bypass the shards.
+ */
+#define PENDING_FOLD ((unsigned long)LONG_MAX + 1UL)
+#define PENDING_MAX (ULONG_MAX >> 2)
+
+static inline unsigned int counter_shard(void)
+{
+	return IS_ENABLED(CONFIG_SMP) ? arch_curr_cpu()->id : 0U;
+}
+
+/* Must be called with the counter lock held */
+static void counter_merge(struct prometheus_counter *counter)
+{
+	for (int i = 0; i < ARRAY_SIZE(counter->pending); i++) {
+		counter->value += (unsigned long)atomic_clear(&counter->pending[i]);
+	}
+}
+
+int prometheus_counter_add(struct prometheus_counter *counter, uint64_t value)
+{
+	k_spinlock_key_t key;
+	unsigned long pending;
+
+	if (counter == NULL) {
+		return -EINVAL;
+	}
+
+	if (likely(value <= PENDING_MAX)) {
+		pending = (unsigned long)atomic_add(&counter->pending[counter_shard()],
+						    (atomic_val_t)value) + (unsigned long)value;
+		if (likely(pending < PENDING_FOLD)) {
+			return 0;
+		}
+
+		value = 0;
+	}
+
+	key = k_spin_lock(&counter->lock);
+	counter_merge(counter);
+	counter->value += value;
+	k_spin_unlock(&counter->lock, key);
+
+	return 0;
+}
+
+int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value)
+{
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	if (counter == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&counter->lock);
+
+	counter_merge(counter);
+
+	if (value < counter->value) {
+		LOG_DBG("Cannot set counter to a lower value (%" PRIu64 " < %" PRIu64 ")",
+			value, counter->value);
+		ret = -EINVAL;
+	} else {
+		counter->value = value;
+	}
+
+	k_spin_unlock(&counter->lock, key);
+
+	return ret;
+}
+
+uint64_t prometheus_counter_get(struct prometheus_counter *counter)
+{
+	k_spinlock_key_t key;
+	uint64_t value;
+
+	key = k_spin_lock(&counter->lock);
+	counter_merge(counter);
+	value = counter->value;
+	k_spin_unlock(&counter->lock, key);
+
+	return value;
+}
+
+#else /* CONFIG_PROMETHEUS_PERCPU_METRICS */
+
 int prometheus_counter_add(struct prometheus_counter *counter, uint64_t value)
 {
 	if (counter == NULL) {
@@ -48,3 +140,10 @@ int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value)
 
 	return 0;
 }
+
+uint64_t prometheus_counter_get(struct prometheus_counter *counter)
+{
+	return counter->value;
+}
+
+#endif /* CONFIG_PROMETHEUS_PERCPU_METRICS */
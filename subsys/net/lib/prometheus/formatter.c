@@ -13,7 +13,6 @@
 #include <zephyr/net/prometheus/gauge.h>
 #include <zephyr/net/prometheus/counter.h>
 
-#include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 #include <stddef.h>
@@ -24,219 +23,189 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_formatter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-static int write_metric_to_buffer(char *buffer, size_t buffer_size, const char *format, ...)
+static const char *metric_type_str(enum prometheus_metric_type type)
 {
-	/* helper function to write formatted metric to buffer */
-	va_list args;
-	size_t len = strlen(buffer);
-
-	if (len >= buffer_size) {
-		return -ENOMEM;
-	}
-	buffer += len;
-	buffer_size -= len;
-
-	va_start(args, format);
-	len = vsnprintf(buffer, buffer_size, format, args);
-	va_end(args);
-	if (len >= buffer_size) {
-		return -ENOMEM;
+	switch (type) {
+	case PROMETHEUS_COUNTER:
+		return "counter";
+	case PROMETHEUS_GAUGE:
+		return "gauge";
+	case PROMETHEUS_HISTOGRAM:
+		return "histogram";
+	case PROMETHEUS_SUMMARY:
+		return "summary";
+	default:
+		return "untyped";
 	}
-
-	return 0;
 }
 
-int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
-				 size_t buffer_size, int *written)
+/* Merge the values updated without locking before they are formatted */
+static void metric_merge(struct prometheus_metric *metric)
 {
-	int ret = 0;
-
-	/* write HELP line if available */
-	if (metric->description[0] != '\0') {
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# HELP %s %s\n", metric->name,
-					     metric->description);
-		if (ret < 0) {
-			LOG_ERR("Error writing to buffer");
-			goto out;
-		}
+	if (!IS_ENABLED(CONFIG_PROMETHEUS_PERCPU_METRICS)) {
+		return;
 	}
 
-	/* write TYPE line */
-	switch (metric->type) {
-	case PROMETHEUS_COUNTER:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s counter\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing counter");
-			goto out;
-		}
-
-		break;
-
-	case PROMETHEUS_GAUGE:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s gauge\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing gauge");
-			goto out;
-		}
-
-		break;
-
-	case PROMETHEUS_HISTOGRAM:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s histogram\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
-		}
+	if (metric->type == PROMETHEUS_COUNTER) {
+		(void)prometheus_counter_get(CONTAINER_OF(metric, struct prometheus_counter,
+							  base));
+	} else if (metric->type == PROMETHEUS_HISTOGRAM) {
+		prometheus_histogram_merge(CONTAINER_OF(metric, struct prometheus_histogram,
+							base));
+	}
+}
 
-		break;
+/*
+ * Format one line of the exposition data of a metric. Line 0 is the HELP line,
+ * empty if there is no description, line 1 the TYPE line and the following ones
+ * the samples. Returns the length of the line as snprintf() does, or -ENOENT if
+ * the metric has no more lines.
+ */
+static int format_line(const struct prometheus_metric *metric, int line,
+		       char *buffer, size_t buffer_size)
+{
+	int sample = line - 2;
 
-	case PROMETHEUS_SUMMARY:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s summary\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+	if (line == 0) {
+		if (metric->description[0] == '\0') {
+			buffer[0] = '\0';
+			return 0;
 		}
 
-		break;
-
-	default:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s untyped\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing untyped");
-			goto out;
-		}
+		return snprintf(buffer, buffer_size, "# HELP %s %s\n", metric->name,
+				metric->description);
+	}
 
-		break;
+	if (line == 1) {
+		return snprintf(buffer, buffer_size, "# TYPE %s %s\n", metric->name,
+				metric_type_str(metric->type));
 	}
 
-	/* write metric-specific fields */
 	switch (metric->type) {
 	case PROMETHEUS_COUNTER: {
 		const struct prometheus_counter *counter =
 			CONTAINER_OF(metric, struct prometheus_counter, base);
 
-		LOG_DBG("counter->value: %llu", counter->value);
-
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %llu\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, counter->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing counter");
-				goto out;
-			}
+		if (sample >= metric->num_labels) {
+			return -ENOENT;
 		}
 
-		break;
+		LOG_DBG("counter->value: %llu", counter->value);
+
+		return snprintf(buffer, buffer_size, "%s{%s=\"%s\"} %llu\n", metric->name,
+				metric->labels[sample].key, metric->labels[sample].value,
+				counter->value);
 	}
 
 	case PROMETHEUS_GAUGE: {
 		const struct prometheus_gauge *gauge =
 			CONTAINER_OF(metric, struct prometheus_gauge, base);
 
-		LOG_DBG("gauge->value: %f", gauge->value);
-
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %f\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, gauge->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing gauge");
-				goto out;
-			}
+		if (sample >= metric->num_labels) {
+			return -ENOENT;
 		}
 
-		break;
+		LOG_DBG("gauge->value: %f", gauge->value);
+
+		return snprintf(buffer, buffer_size, "%s{%s=\"%s\"} %f\n", metric->name,
+				metric->labels[sample].key, metric->labels[sample].value,
+				gauge->value);
 	}
 
 	case PROMETHEUS_HISTOGRAM: {
 		const struct prometheus_histogram *histogram =
 			CONTAINER_OF(metric, struct prometheus_histogram, base);
 
-		LOG_DBG("histogram->count: %lu", histogram->count);
-
-		for (int i = 0; i < histogram->num_buckets; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s_bucket{le=\"%f\"} %lu\n", metric->name,
-				histogram->buckets[i].upper_bound,
-				histogram->buckets[i].count);
-			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
-				goto out;
-			}
+		if (sample < histogram->num_buckets) {
+			return snprintf(buffer, buffer_size, "%s_bucket{le=\"%f\"} %lu\n",
+					metric->name, histogram->buckets[sample].upper_bound,
+					histogram->buckets[sample].count);
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, histogram->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+		if (sample == histogram->num_buckets) {
+			return snprintf(buffer, buffer_size, "%s_sum %f\n", metric->name,
+					histogram->sum);
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     histogram->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+		if (sample == histogram->num_buckets + 1) {
+			LOG_DBG("histogram->count: %lu", histogram->count);
+
+			return snprintf(buffer, buffer_size, "%s_count %lu\n", metric->name,
+					histogram->count);
 		}
 
-		break;
+		return -ENOENT;
 	}
 
 	case PROMETHEUS_SUMMARY: {
 		const struct prometheus_summary *summary =
 			CONTAINER_OF(metric, struct prometheus_summary, base);
 
-		LOG_DBG("summary->count: %lu", summary->count);
-
-		for (int i = 0; i < summary->num_quantiles; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%f\"} %f\n", metric->name, "quantile",
-				summary->quantiles[i].quantile,
-				summary->quantiles[i].value);
-			if (ret < 0) {
-				LOG_ERR("Error writing summary");
-				goto out;
-			}
+		if (sample < summary->num_quantiles) {
+			return snprintf(buffer, buffer_size, "%s{%s=\"%f\"} %f\n",
+					metric->name, "quantile",
+					summary->quantiles[sample].quantile,
+					summary->quantiles[sample].value);
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, summary->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+		if (sample == summary->num_quantiles) {
+			return snprintf(buffer, buffer_size, "%s_sum %f\n", metric->name,
+					summary->sum);
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     summary->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+		if (sample == summary->num_quantiles + 1) {
+			LOG_DBG("summary->count: %lu", summary->count);
+
+			return snprintf(buffer, buffer_size, "%s_count %lu\n", metric->name,
+					summary->count);
 		}
 
-		break;
+		return -ENOENT;
 	}
 
 	default:
 		/* should not happen */
 		LOG_ERR("Unsupported metric type %d", metric->type);
-		ret = -EINVAL;
-		goto out;
+		return -EINVAL;
+	}
+}
+
+int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
+				 size_t buffer_size, int *written)
+{
+	size_t len;
+	int ret;
+
+	metric_merge(metric);
+
+	for (int line = 0; ; line++) {
+		/* Lines are appended to what the buffer already holds */
+		len = strlen(buffer);
+		if (len >= buffer_size) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		ret = format_line(metric, line, buffer + len, buffer_size - len);
+		if (ret == -ENOENT) {
+			ret = 0;
+			break;
+		}
+
+		if (ret < 0) {
+			break;
+		}
+
+		if ((size_t)ret >= buffer_size - len) {
+			ret = -ENOMEM;
+			break;
+		}
+	}
+
+	if (ret == -ENOMEM) {
+		LOG_ERR("Error writing %s", metric_type_str(metric->type));
 	}
 
-out:
 	return ret;
 }
 
@@ -282,3 +251,146 @@ out:
 
 	return ret;
 }
+
+int prometheus_format_stream_init(struct prometheus_format_context *ctx,
+				  struct prometheus_collector *collector)
+{
+	if (ctx == NULL || collector == NULL) {
+		return -EINVAL;
+	}
+
+	ctx->collector = collector;
+	ctx->metric = NULL;
+	ctx->line = 0;
+	ctx->len = 0;
+	ctx->offset = 0;
+	ctx->locked = false;
+	ctx->done = false;
+
+	return 0;
+}
+
+static void stream_end(struct prometheus_format_context *ctx)
+{
+	if (ctx->locked) {
+		k_mutex_unlock(&ctx->collector->lock);
+		ctx->locked = false;
+	}
+
+	ctx->metric = NULL;
+	ctx->len = 0;
+	ctx->offset = 0;
+	ctx->done = true;
+}
+
+void prometheus_format_stream_abort(struct prometheus_format_context *ctx)
+{
+	if (ctx == NULL || ctx->collector == NULL) {
+		return;
+	}
+
+	stream_end(ctx);
+}
+
+static void stream_next_metric(struct prometheus_format_context *ctx)
+{
+	ctx->metric = SYS_SLIST_PEEK_NEXT_CONTAINER(ctx->metric, node);
+	ctx->line = 0;
+}
+
+/* Format the next non-empty line into the context, returns 0 at the end */
+static int stream_next_line(struct prometheus_format_context *ctx)
+{
+	struct prometheus_collector *collector = ctx->collector;
+	int ret;
+
+	while (ctx->metric != NULL) {
+		/* If there is a user callback, use it to update the metric data. */
+		if (ctx->line == 0 && collector->user_cb) {
+			ret = collector->user_cb(collector, ctx->metric, collector->user_data);
+			if (ret == -EAGAIN) {
+				/* Skip this metric for now */
+				stream_next_metric(ctx);
+				continue;
+			}
+
+			if (ret < 0) {
+				LOG_ERR("Error in user callback (%d)", ret);
+				return ret;
+			}
+		}
+
+		if (ctx->line == 0) {
+			metric_merge(ctx->metric);
+		}
+
+		ret = format_line(ctx->metric, ctx->line, ctx->buf, sizeof(ctx->buf));
+		if (ret == -ENOENT) {
+			stream_next_metric(ctx);
+			continue;
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		if ((size_t)ret >= sizeof(ctx->buf)) {
+			LOG_ERR("Line of %s does not fit in %zu bytes", ctx->metric->name,
+				sizeof(ctx->buf));
+			return -ENOMEM;
+		}
+
+		ctx->line++;
+		ctx->len = ret;
+		ctx->offset = 0;
+
+		if (ret > 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int prometheus_format_stream(struct prometheus_format_context *ctx, char *buffer,
+			     size_t buffer_size)
+{
+	size_t copied = 0;
+	int ret = 0;
+
+	if (ctx == NULL || ctx->collector == NULL || buffer == NULL || buffer_size == 0) {
+		LOG_ERR("Invalid arguments");
+		return -EINVAL;
+	}
+
+	if (ctx->done) {
+		return 0;
+	}
+
+	/* The metric list must not change under the cursor until the end of the stream */
+	if (!ctx->locked) {
+		k_mutex_lock(&ctx->collector->lock, K_FOREVER);
+		ctx->locked = true;
+		ctx->metric = SYS_SLIST_PEEK_HEAD_CONTAINER(&ctx->collector->metrics,
+							    ctx->metric, node);
+	}
+
+	while (copied < buffer_size) {
+		if (ctx->offset < ctx->len) {
+			size_t chunk = MIN(ctx->len - ctx->offset, buffer_size - copied);
+
+			memcpy(buffer + copied, ctx->buf + ctx->offset, chunk);
+			ctx->offset += chunk;
+			copied += chunk;
+			continue;
+		}
+
+		ret = stream_next_line(ctx);
+		if (ret <= 0) {
+			stream_end(ctx);
+			break;
+		}
+	}
+
+	return ret < 0 ? ret : (int)copied;
+}
@@ -14,6 +14,107 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_histogram, CONFIG_PROMETHEUS_LOG_LEVEL);
 
+#if defined(CONFIG_PROMETHEUS_PERCPU_METRICS)
+
+#if defined(CONFIG_64BIT)
+BUILD_ASSERT(sizeof(atomic_val_t) == sizeof(double));
+
+static void shard_sum_add(struct prometheus_histogram_shard *shard, double value)
+{
+	atomic_val_t old_bits;
+	atomic_val_t new_bits;
+	double sum;
+
+	do {
+		old_bits = atomic_get(&shard->sum);
+		memcpy(&sum, &old_bits, sizeof(sum));
+		sum += value;
+		memcpy(&new_bits, &sum, sizeof(new_bits));
+	} while (!atomic_cas(&shard->sum, old_bits, new_bits));
+}
+
+static double shard_sum_take(struct prometheus_histogram_shard *shard)
+{
+	atomic_val_t bits = atomic_clear(&shard->sum);
+	double sum;
+
+	/* All zero bits is 0.0 */
+	memcpy(&sum, &bits, sizeof(sum));
+
+	return sum;
+}
+#else
+static void shard_sum_add(struct prometheus_histogram_shard *shard, double value)
+{
+	k_spinlock_key_t key = k_spin_lock(&shard->lock);
+
+	shard->sum += value;
+	k_spin_unlock(&shard->lock, key);
+}
+
+static double shard_sum_take(struct prometheus_histogram_shard *shard)
+{
+	k_spinlock_key_t key = k_spin_lock(&shard->lock);
+	double sum = shard->sum;
+
+	shard->sum = 0.0;
+	k_spin_unlock(&shard->lock, key);
+
+	return sum;
+}
+#endif /* CONFIG_64BIT */
+
+int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value)
+{
+	struct prometheus_histogram_shard *shard;
+	unsigned int cpu;
+
+	if (!histogram) {
+		return -EINVAL;
+	}
+
+	cpu = IS_ENABLED(CONFIG_SMP) ? arch_curr_cpu()->id : 0U;
+	shard = &histogram->shards[cpu];
+
+	(void)atomic_inc(&shard->count);
+	shard_sum_add(shard, value);
+
+	for (size_t i = 0; i < histogram->num_buckets; ++i) {
+		if (value <= histogram->buckets[i].upper_bound) {
+			(void)atomic_inc(&histogram->buckets[i].pending[cpu]);
+			break;
+		}
+	}
+
+	return 0;
+}
+
+void prometheus_histogram_merge(struct prometheus_histogram *histogram)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&histogram->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(histogram->shards); i++) {
+		struct prometheus_histogram_shard *shard = &histogram->shards[i];
+
+		histogram->count += (unsigned long)atomic_clear(&shard->count);
+		histogram->sum += shard_sum_take(shard);
+	}
+
+	for (size_t i = 0; i < histogram->num_buckets; ++i) {
+		struct prometheus_histogram_bucket *bucket = &histogram->buckets[i];
+
+		for (int j = 0; j < ARRAY_SIZE(bucket->pending); j++) {
+			bucket->count += (unsigned long)atomic_clear(&bucket->pending[j]);
+		}
+	}
+
+	k_spin_unlock(&histogram->lock, key);
+}
+
+#else /* CONFIG_PROMETHEUS_PERCPU_METRICS */
+
 int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value)
 {
 	if (!histogram) {
@@ -41,3 +142,10 @@ int prometheus_histogram_observe(struct prometheus_histogram *histogram, double
 
 	return 0;
 }
+
+void prometheus_histogram_merge(struct prometheus_histogram *histogram)
+{
+	ARG_UNUSED(histogram);
+}
+
+#endif /* CONFIG_PROMETHEUS_PERCPU_METRICS */
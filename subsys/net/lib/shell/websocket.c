@@ -14,7 +14,9 @@ LOG_MODULE_DECLARE(net_shell);
 
 #include "net_shell_private.h"
 
+#if defined(CONFIG_WEBSOCKET_CLIENT)
 #include "websocket/websocket_internal.h"
+#endif
 
 #include <zephyr/sys/fdtable.h>
 
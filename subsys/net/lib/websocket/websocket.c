@@ -59,7 +59,7 @@ static struct k_sem contexts_lock;
 static const struct socket_op_vtable websocket_fd_op_vtable;
 
 #if defined(CONFIG_NET_TEST)
-int verify_sent_and_received_msg(struct msghdr *msg, bool split_msg);
+int verify_sent_and_received_msg(struct msghdr *msg);
 #endif
 
 static const char *opcode2str(enum websocket_opcode opcode)
@@ -602,9 +602,10 @@ static int sendmsg_all(int sock, const struct msghdr *message, int flags,
 		if ((ret == 0) || (ret < 0 && errno == EAGAIN)) {
 			struct zsock_pollfd pfd;
 			int pollres;
-			k_ticks_t req_timeout_ticks =
-				sys_timepoint_timeout(req_end_timepoint).ticks;
-			int req_timeout_ms = k_ticks_to_ms_floor32(req_timeout_ticks);
+			k_timeout_t req_timeout =
+				sys_timepoint_timeout(req_end_timepoint);
+			int req_timeout_ms = K_TIMEOUT_EQ(req_timeout, K_FOREVER) ?
+				-1 : k_ticks_to_ms_floor32(req_timeout.ticks);
 
 			pfd.fd = sock;
 			pfd.events = ZSOCK_POLLOUT;
@@ -643,10 +644,59 @@ static int sendmsg_all(int sock, const struct msghdr *message, int flags,
 }
 #endif /* !defined(CONFIG_NET_TEST) */
 
+void websocket_mask_payload(uint8_t *buf, size_t len, uint32_t mask,
+			    uint64_t offset)
+{
+	uint8_t key[sizeof(uintptr_t)];
+	uintptr_t word_mask;
+	uintptr_t *word;
+	unsigned int phase = offset % 4;
+
+	for (size_t i = 0; i < sizeof(key); i += 4) {
+		sys_put_be32(mask, &key[i]);
+	}
+
+	/* Bytes before the first word boundary */
+	while (len > 0 && !IS_ALIGNED(buf, sizeof(uintptr_t))) {
+		*buf++ ^= key[phase];
+		phase = (phase + 1) % 4;
+		len--;
+	}
+
+	/* The word size is a multiple of the mask size, so every word is
+	 * masked with the same key rotated to the current phase.
+	 */
+	for (size_t i = 0; i < sizeof(key); i++) {
+		((uint8_t *)&word_mask)[i] = key[(phase + i) % 4];
+	}
+
+	word = (uintptr_t *)buf;
+
+	while (len >= 4 * sizeof(uintptr_t)) {
+		word[0] ^= word_mask;
+		word[1] ^= word_mask;
+		word[2] ^= word_mask;
+		word[3] ^= word_mask;
+		word += 4;
+		len -= 4 * sizeof(uintptr_t);
+	}
+
+	while (len >= sizeof(uintptr_t)) {
+		*word++ ^= word_mask;
+		len -= sizeof(uintptr_t);
+	}
+
+	buf = (uint8_t *)word;
+
+	for (size_t i = 0; i < len; i++) {
+		buf[i] ^= key[(phase + i) % 4];
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
 				      uint8_t *payload, size_t payload_len,
-				      int32_t timeout)
+				      int flags, k_timepoint_t req_end_timepoint)
 {
 	struct iovec io_vector[2];
 	struct msghdr msg;
@@ -662,7 +712,9 @@ static int websocket_prepare_and_send(struct websocket_context *ctx,
 	msg.msg_iovlen = ARRAY_SIZE(io_vector);
 
 	if (HEXDUMP_SENT_PACKETS) {
-		LOG_HEXDUMP_DBG(header, header_len, "Header");
+		if (header_len > 0) {
+			LOG_HEXDUMP_DBG(header, header_len, "Header");
+		}
 		if ((payload != NULL) && (payload_len > 0)) {
 			LOG_HEXDUMP_DBG(payload, payload_len, "Payload");
 		} else {
@@ -671,24 +723,62 @@ static int websocket_prepare_and_send(struct websocket_context *ctx,
 	}
 
 #if defined(CONFIG_NET_TEST)
-	/* Simulate a case where the payload is split to two. The unit test
-	 * does not set mask bit in this case.
-	 */
-	return verify_sent_and_received_msg(&msg, !(header[1] & BIT(7)));
+	ARG_UNUSED(flags);
+	ARG_UNUSED(req_end_timepoint);
+
+	return verify_sent_and_received_msg(&msg);
 #else
-	k_timeout_t tout = K_FOREVER;
+	return sendmsg_all(ctx->real_sock, &msg, flags, req_end_timepoint);
+#endif /* CONFIG_NET_TEST */
+}
 
-	if (timeout != SYS_FOREVER_MS) {
-		tout = K_MSEC(timeout);
+/* The payload of a masked frame is masked in the context buffer and sent in
+ * chunks, the header goes out together with the first one. Once the first
+ * chunk is out, the rest of the frame is sent without MSG_DONTWAIT and without
+ * a deadline, as giving up in the middle would leave a partial frame in the
+ * stream. The context lock is held for the whole frame so that concurrent
+ * senders neither share the buffer nor interleave their chunks.
+ */
+static int websocket_send_masked(struct websocket_context *ctx,
+				 uint8_t *header, size_t header_len,
+				 const uint8_t *payload, size_t payload_len,
+				 uint32_t mask, int flags,
+				 k_timepoint_t req_end_timepoint)
+{
+	size_t offset = 0;
+	int total = 0;
+	int ret;
+
+	ret = k_mutex_lock(&ctx->lock, sys_timepoint_timeout(req_end_timepoint));
+	if (ret < 0) {
+		return -EAGAIN;
 	}
 
-	k_timeout_t req_timeout = K_MSEC(timeout);
-	k_timepoint_t req_end_timepoint = sys_timepoint_calc(req_timeout);
+	while (offset < payload_len) {
+		size_t chunk_len = MIN(payload_len - offset,
+				       sizeof(ctx->tx_mask_buf));
 
-	return sendmsg_all(ctx->real_sock, &msg,
-			   K_TIMEOUT_EQ(tout, K_NO_WAIT) ? ZSOCK_MSG_DONTWAIT : 0,
-			   req_end_timepoint);
-#endif /* CONFIG_NET_TEST */
+		memcpy(ctx->tx_mask_buf, &payload[offset], chunk_len);
+		websocket_mask_payload(ctx->tx_mask_buf, chunk_len, mask, offset);
+
+		ret = websocket_prepare_and_send(ctx, header, header_len,
+						 ctx->tx_mask_buf, chunk_len,
+						 flags, req_end_timepoint);
+		if (ret < 0) {
+			total = ret;
+			break;
+		}
+
+		total += ret;
+		offset += chunk_len;
+		header_len = 0;
+		flags &= ~ZSOCK_MSG_DONTWAIT;
+		req_end_timepoint = sys_timepoint_calc(K_FOREVER);
+	}
+
+	k_mutex_unlock(&ctx->lock);
+
+	return total;
 }
 
 int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
@@ -697,7 +787,10 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 {
 	struct websocket_context *ctx;
 	uint8_t header[MAX_HEADER_LEN], hdr_len = 2;
-	uint8_t *data_to_send = (uint8_t *)payload;
+	k_timeout_t tout = K_FOREVER;
+	k_timepoint_t req_end_timepoint;
+	uint32_t masking_value = 0;
+	int flags;
 	int ret;
 
 	if (opcode != WEBSOCKET_OPCODE_DATA_TEXT &&
@@ -760,39 +853,30 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
-
-		ctx->masking_value = sys_rand32_get();
-
-		header[hdr_len++] |= ctx->masking_value >> 24;
-		header[hdr_len++] |= ctx->masking_value >> 16;
-		header[hdr_len++] |= ctx->masking_value >> 8;
-		header[hdr_len++] |= ctx->masking_value;
+		masking_value = sys_rand32_get();
+		sys_put_be32(masking_value, &header[hdr_len]);
+		hdr_len += sizeof(masking_value);
+	}
 
-		if ((payload != NULL) && (payload_len > 0)) {
-			data_to_send = k_malloc(payload_len);
-			if (!data_to_send) {
-				return -ENOMEM;
-			}
+	if (timeout != SYS_FOREVER_MS) {
+		tout = K_MSEC(timeout);
+	}
 
-			memcpy(data_to_send, payload, payload_len);
+	flags = K_TIMEOUT_EQ(tout, K_NO_WAIT) ? ZSOCK_MSG_DONTWAIT : 0;
+	req_end_timepoint = sys_timepoint_calc(K_MSEC(timeout));
 
-			for (i = 0; i < payload_len; i++) {
-				data_to_send[i] ^= ctx->masking_value >> (8 * (3 - i % 4));
-			}
-		}
+	if (mask && (payload != NULL) && (payload_len > 0)) {
+		ret = websocket_send_masked(ctx, header, hdr_len, payload,
+					    payload_len, masking_value, flags,
+					    req_end_timepoint);
+	} else {
+		ret = websocket_prepare_and_send(ctx, header, hdr_len,
+						 (uint8_t *)payload, payload_len,
+						 flags, req_end_timepoint);
 	}
 
-	ret = websocket_prepare_and_send(ctx, header, hdr_len,
-					 data_to_send, payload_len, timeout);
 	if (ret < 0) {
-		NET_DBG("Cannot send ws msg (%d)", -errno);
-		goto quit;
-	}
-
-quit:
-	if (data_to_send != payload) {
-		k_free(data_to_send);
+		NET_DBG("Cannot send ws msg (%d)", ret);
 	}
 
 	/* Do no math with 0 and error codes */
@@ -1093,15 +1177,8 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 	/* Unmask the data */
 	if (ctx->masked) {
-		uint8_t *mask_as_bytes = (uint8_t *)&ctx->masking_value;
-		size_t data_buf_offset = ctx->message_len - ctx->parser_remaining - payload.count;
-
-		for (size_t i = 0; i < payload.count; i++) {
-			size_t m = data_buf_offset % 4;
-
-			payload.buf[i] ^= mask_as_bytes[3 - m];
-			data_buf_offset++;
-		}
+		websocket_mask_payload(payload.buf, payload.count, ctx->masking_value,
+				       ctx->message_len - ctx->parser_remaining - payload.count);
 	}
 
 	return payload.count;
@@ -1341,4 +1418,8 @@ void websocket_context_foreach(websocket_context_cb_t cb, void *user_data)
 void websocket_init(void)
 {
 	k_sem_init(&contexts_lock, 1, K_SEM_MAX_LIMIT);
+
+	for (int i = 0; i < ARRAY_SIZE(contexts); i++) {
+		k_mutex_init(&contexts[i].lock);
+	}
 }
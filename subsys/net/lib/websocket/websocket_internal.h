@@ -122,6 +122,10 @@ __net_socket struct websocket_context {
 
 	/** 1 if this websocket is a client, 0 if a server */
 	uint8_t is_client : 1;
+
+	/** Buffer where the payload of a masked frame is masked before sending
+	 */
+	uint8_t tx_mask_buf[CONFIG_WEBSOCKET_TX_MASK_BUF_SIZE];
 };
 
 #if defined(CONFIG_NET_TEST)
@@ -144,6 +148,18 @@ struct test_data {
 };
 #endif /* CONFIG_NET_TEST */
 
+/**
+ * @brief Mask or unmask Websocket payload in place.
+ *
+ * @param buf Payload data.
+ * @param len Length of the data.
+ * @param mask Masking key, the first byte sent on the wire being the most
+ *        significant one.
+ * @param offset Position of the data within the frame payload.
+ */
+void websocket_mask_payload(uint8_t *buf, size_t len, uint32_t mask,
+			    uint64_t offset);
+
 /**
  * @brief Disconnect the Websocket.
  *
@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdarg.h>
+#include <stdio.h>
+
 #include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/socket.h>
@@ -49,11 +52,6 @@ struct sockaddr_in *zperf_get_sin(void)
 #if defined(CONFIG_ZPERF_SESSION_PER_THREAD)
 static K_EVENT_DEFINE(start_event);
 
-#define CREATE_WORK_Q(i, _)					       \
-	static struct k_work_q zperf_work_q_##i;		       \
-	static K_KERNEL_STACK_DEFINE(zperf_work_q_stack_##i,	       \
-				     CONFIG_ZPERF_WORK_Q_STACK_SIZE)
-
 /* Both UDP and TCP can have separate sessions so multiply by 2 */
 #if defined(CONFIG_NET_UDP) && defined(CONFIG_NET_TCP)
 #define MAX_SESSION_COUNT UTIL_X2(CONFIG_NET_ZPERF_MAX_SESSIONS)
@@ -63,6 +61,20 @@ static K_EVENT_DEFINE(start_event);
 #define SESSION_INDEX 0
 #endif
 
+/* The UDP sessions come first and send from a packet buffer on their stack */
+#if defined(CONFIG_NET_UDP)
+#define WORK_Q_STACK_SIZE(i)						\
+	(CONFIG_ZPERF_WORK_Q_STACK_SIZE +				\
+	 ((i) < CONFIG_NET_ZPERF_MAX_SESSIONS ? UDP_PACKET_BUF_SIZE : 0))
+#else
+#define WORK_Q_STACK_SIZE(i) CONFIG_ZPERF_WORK_Q_STACK_SIZE
+#endif
+
+#define CREATE_WORK_Q(i, _)					       \
+	static struct k_work_q zperf_work_q_##i;		       \
+	static K_KERNEL_STACK_DEFINE(zperf_work_q_stack_##i,	       \
+				     WORK_Q_STACK_SIZE(i))
+
 LISTIFY(MAX_SESSION_COUNT, CREATE_WORK_Q, (;), _);
 
 #define SET_WORK_Q(i, _)			 \
@@ -278,6 +290,159 @@ uint32_t zperf_packet_duration(uint32_t packet_size, uint32_t rate_in_kbps)
 			  (rate_in_kbps * 1024U));
 }
 
+void zperf_results_add(struct zperf_results *sum,
+		       const struct zperf_results *result)
+{
+	sum->nb_packets_sent += result->nb_packets_sent;
+	sum->nb_packets_rcvd += result->nb_packets_rcvd;
+	sum->nb_packets_lost += result->nb_packets_lost;
+	sum->nb_packets_outorder += result->nb_packets_outorder;
+	sum->nb_packets_errors += result->nb_packets_errors;
+	sum->total_len += result->total_len;
+	sum->time_in_us = MAX(sum->time_in_us, result->time_in_us);
+	sum->client_time_in_us = MAX(sum->client_time_in_us,
+				     result->client_time_in_us);
+	sum->jitter_in_us = MAX(sum->jitter_in_us, result->jitter_in_us);
+	sum->packet_size = result->packet_size;
+	sum->is_multicast = result->is_multicast;
+#ifdef CONFIG_NET_ZPERF_CPU_LOAD
+	sum->cpu_load_permille = MAX(sum->cpu_load_permille,
+				     result->cpu_load_permille);
+#endif /* CONFIG_NET_ZPERF_CPU_LOAD */
+#ifdef CONFIG_NET_ZPERF_HISTOGRAM
+	for (int i = 0; i < CONFIG_NET_ZPERF_HISTOGRAM_BUCKETS; i++) {
+		sum->latency_hist[i] += result->latency_hist[i];
+		sum->jitter_hist[i] += result->jitter_hist[i];
+	}
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
+}
+
+static uint32_t server_rate_kbps(const struct zperf_results *results)
+{
+	if (results->time_in_us == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)((results->total_len * 8ULL * USEC_PER_SEC) /
+			  (results->time_in_us * 1000ULL));
+}
+
+static uint32_t client_rate_kbps(const struct zperf_results *results)
+{
+	if (results->client_time_in_us == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)(((uint64_t)results->nb_packets_sent *
+			   results->packet_size * 8ULL * USEC_PER_SEC) /
+			  (results->client_time_in_us * 1000ULL));
+}
+
+/* Append to buf like snprintf, keeping track of the length it would need */
+static void json_append(char *buf, size_t len, int *pos, const char *fmt, ...)
+{
+	size_t off = MIN((size_t)*pos, len);
+	va_list ap;
+	int ret;
+
+	va_start(ap, fmt);
+	ret = vsnprintf(buf + off, len - off, fmt, ap);
+	va_end(ap);
+
+	if (ret > 0) {
+		*pos += ret;
+	}
+}
+
+#ifdef CONFIG_NET_ZPERF_HISTOGRAM
+static void json_append_hist(char *buf, size_t len, int *pos, const char *name,
+			     const uint32_t *hist)
+{
+	json_append(buf, len, pos, ",\"%s\":[", name);
+
+	for (int i = 0; i < CONFIG_NET_ZPERF_HISTOGRAM_BUCKETS; i++) {
+		json_append(buf, len, pos, "%s%u", i == 0 ? "" : ",", hist[i]);
+	}
+
+	json_append(buf, len, pos, "]");
+}
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
+
+int zperf_results_to_json(char *buf, size_t len, const char *type,
+			  const char *proto, int id,
+			  const struct zperf_results *results, bool with_hist)
+{
+	int pos = 0;
+
+	json_append(buf, len, &pos,
+		    "{\"type\":\"%s\",\"proto\":\"%s\",\"id\":%d,"
+		    "\"time_us\":%llu,\"client_time_us\":%llu,"
+		    "\"packets_sent\":%u,\"packets_rcvd\":%u,"
+		    "\"packets_lost\":%u,\"packets_outorder\":%u,"
+		    "\"packets_errors\":%u,\"packet_size\":%u,"
+		    "\"bytes\":%llu,\"jitter_us\":%u,"
+		    "\"rate_kbps\":%u,\"client_rate_kbps\":%u",
+		    type, proto, id,
+		    (unsigned long long)results->time_in_us,
+		    (unsigned long long)results->client_time_in_us,
+		    results->nb_packets_sent, results->nb_packets_rcvd,
+		    results->nb_packets_lost, results->nb_packets_outorder,
+		    results->nb_packets_errors, results->packet_size,
+		    (unsigned long long)results->total_len,
+		    results->jitter_in_us,
+		    server_rate_kbps(results), client_rate_kbps(results));
+
+#ifdef CONFIG_NET_ZPERF_CPU_LOAD
+	json_append(buf, len, &pos, ",\"cpu_load_permille\":%u",
+		    results->cpu_load_permille);
+#endif /* CONFIG_NET_ZPERF_CPU_LOAD */
+
+#ifdef CONFIG_NET_ZPERF_HISTOGRAM
+	if (with_hist) {
+		json_append_hist(buf, len, &pos, "latency_hist",
+				 results->latency_hist);
+		json_append_hist(buf, len, &pos, "jitter_hist",
+				 results->jitter_hist);
+	}
+#else
+	ARG_UNUSED(with_hist);
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
+
+	json_append(buf, len, &pos, "}");
+
+	return pos;
+}
+
+#ifdef CONFIG_NET_ZPERF_CPU_LOAD
+void zperf_cpu_sample_start(struct zperf_cpu_sample *sample)
+{
+	k_thread_runtime_stats_t stats;
+
+	(void)k_thread_runtime_stats_all_get(&stats);
+
+	sample->busy_cycles = stats.total_cycles;
+	sample->total_cycles = stats.execution_cycles;
+}
+
+void zperf_cpu_sample_end(const struct zperf_cpu_sample *sample,
+			  struct zperf_results *results)
+{
+	struct zperf_cpu_sample end;
+	uint64_t total;
+
+	zperf_cpu_sample_start(&end);
+
+	total = end.total_cycles - sample->total_cycles;
+	if (total == 0U) {
+		results->cpu_load_permille = 0U;
+		return;
+	}
+
+	results->cpu_load_permille =
+		(uint16_t)(((end.busy_cycles - sample->busy_cycles) * 1000U) / total);
+}
+#endif /* CONFIG_NET_ZPERF_CPU_LOAD */
+
 void zperf_async_work_submit(enum session_proto proto, int session_id, struct k_work *work)
 {
 #if defined(CONFIG_ZPERF_SESSION_PER_THREAD)
@@ -84,6 +84,10 @@ struct zperf_client_hdr_v1 {
 	int32_t num_of_bytes;
 };
 
+#define UDP_PACKET_BUF_SIZE (sizeof(struct zperf_udp_datagram) +	\
+			     sizeof(struct zperf_client_hdr_v1) +	\
+			     PACKET_SIZE_MAX)
+
 struct zperf_server_hdr {
 	int32_t flags;
 	int32_t total_len1;
@@ -109,6 +113,57 @@ static inline uint32_t time_delta(uint32_t ts, uint32_t t)
 	return (t >= ts) ? (t - ts) : (ULONG_MAX - ts + t);
 }
 
+struct zperf_cpu_sample {
+	uint64_t busy_cycles;
+	uint64_t total_cycles;
+};
+
+#ifdef CONFIG_NET_ZPERF_CPU_LOAD
+void zperf_cpu_sample_start(struct zperf_cpu_sample *sample);
+void zperf_cpu_sample_end(const struct zperf_cpu_sample *sample,
+			  struct zperf_results *results);
+#else
+static inline void zperf_cpu_sample_start(struct zperf_cpu_sample *sample)
+{
+	ARG_UNUSED(sample);
+}
+
+static inline void zperf_cpu_sample_end(const struct zperf_cpu_sample *sample,
+					struct zperf_results *results)
+{
+	ARG_UNUSED(sample);
+	ARG_UNUSED(results);
+}
+#endif /* CONFIG_NET_ZPERF_CPU_LOAD */
+
+#ifdef CONFIG_NET_ZPERF_HISTOGRAM
+static inline void zperf_hist_add(uint32_t *hist, uint32_t us)
+{
+	uint32_t bucket = (us == 0U) ? 0U : (31U - __builtin_clz(us));
+
+	hist[MIN(bucket, CONFIG_NET_ZPERF_HISTOGRAM_BUCKETS - 1U)]++;
+}
+
+#define ZPERF_JSON_HIST_LEN (2 * (16 + 11 * CONFIG_NET_ZPERF_HISTOGRAM_BUCKETS))
+#else
+#define ZPERF_JSON_HIST_LEN 0
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
+
+/* Large enough for zperf_results_to_json() with any results */
+#define ZPERF_JSON_RESULTS_LEN (448 + ZPERF_JSON_HIST_LEN)
+
+/* Accumulate the results of parallel streams into their sum */
+void zperf_results_add(struct zperf_results *sum,
+		       const struct zperf_results *result);
+
+/*
+ * Format the results as a single line JSON object, without the trailing
+ * newline. Returns the length of the full object, like snprintf().
+ */
+int zperf_results_to_json(char *buf, size_t len, const char *type,
+			  const char *proto, int id,
+			  const struct zperf_results *results, bool with_hist);
+
 int zperf_get_ipv6_addr(char *host, char *prefix_str, struct in6_addr *addr);
 struct sockaddr_in6 *zperf_get_sin6(void);
 
@@ -164,6 +164,12 @@ void zperf_reset_session_stats(struct session *session)
 	session->error = 0U;
 	session->jitter = 0;
 	session->last_transit_time = 0;
+
+#ifdef CONFIG_NET_ZPERF_HISTOGRAM
+	session->min_transit_time = 0;
+	(void)memset(session->latency_hist, 0, sizeof(session->latency_hist));
+	(void)memset(session->jitter_hist, 0, sizeof(session->jitter_hist));
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
 }
 
 void zperf_session_foreach(enum session_proto proto, session_cb_t cb,
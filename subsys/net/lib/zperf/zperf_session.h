@@ -47,6 +47,13 @@ struct session {
 	uint32_t last_time;
 	int32_t jitter;
 	int32_t last_transit_time;
+	struct zperf_cpu_sample cpu;
+
+#ifdef CONFIG_NET_ZPERF_HISTOGRAM
+	int32_t min_transit_time;
+	uint32_t latency_hist[CONFIG_NET_ZPERF_HISTOGRAM_BUCKETS];
+	uint32_t jitter_hist[CONFIG_NET_ZPERF_HISTOGRAM_BUCKETS];
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
 
 	/* Stats packet*/
 	struct zperf_server_hdr stat;
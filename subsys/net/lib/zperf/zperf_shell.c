@@ -153,6 +153,28 @@ static long parse_number(const char *string, const uint32_t *divisor_arr,
 	return (*divisor == 0U) ? dec : dec * *divisor;
 }
 
+/* Shared by the stream callbacks, which may run in parallel */
+static K_MUTEX_DEFINE(json_lock);
+static char json_buf[ZPERF_JSON_RESULTS_LEN];
+
+/*
+ * Print the results as a single line JSON object, so that test scripts
+ * can pick them from the shell output without parsing the text report.
+ */
+static void print_json_results(const struct shell *sh, const char *type,
+			       const char *proto, int id,
+			       const struct zperf_results *results,
+			       bool with_hist)
+{
+	k_mutex_lock(&json_lock, K_FOREVER);
+
+	(void)zperf_results_to_json(json_buf, sizeof(json_buf), type, proto, id,
+				    results, with_hist);
+	shell_fprintf(sh, SHELL_NORMAL, "%s\n", json_buf);
+
+	k_mutex_unlock(&json_lock);
+}
+
 static int parse_ipv6_addr(const struct shell *sh, char *host, char *port,
 			   struct sockaddr_in6 *addr)
 {
@@ -318,6 +340,9 @@ static int cmd_setip(const struct shell *sh, size_t argc, char *argv[])
 
 #ifdef CONFIG_NET_ZPERF_SERVER
 
+static bool udp_download_json;
+static bool tcp_download_json;
+
 static void udp_session_cb(enum zperf_status status,
 			   struct zperf_results *result,
 			   void *user_data)
@@ -332,6 +357,11 @@ static void udp_session_cb(enum zperf_status status,
 	case ZPERF_SESSION_FINISHED: {
 		uint32_t rate_in_kbps;
 
+		if (udp_download_json) {
+			print_json_results(sh, "server", "udp", 0, result, true);
+			break;
+		}
+
 		/* Compute baud rate */
 		if (result->time_in_us != 0U) {
 			rate_in_kbps = (uint32_t)
@@ -383,7 +413,8 @@ static void udp_session_cb(enum zperf_status status,
  */
 static int shell_cmd_download(const struct shell *sh, size_t argc,
 			      char *argv[],
-			      struct zperf_download_params *param)
+			      struct zperf_download_params *param,
+			      bool *json)
 {
 	int opt_cnt = 0;
 	size_t i;
@@ -411,6 +442,11 @@ static int shell_cmd_download(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+		case 'j':
+			*json = true;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -447,10 +483,11 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 {
 	if (IS_ENABLED(CONFIG_NET_UDP)) {
 		struct zperf_download_params param = { 0 };
+		bool json = false;
 		int ret;
 		int start;
 
-		start = shell_cmd_download(sh, argc, argv, &param);
+		start = shell_cmd_download(sh, argc, argv, &param, &json);
 		if (start < 0) {
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unable to parse option.\n");
@@ -476,6 +513,8 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 			return -ENOEXEC;
 		}
 
+		udp_download_json = json;
+
 		k_yield();
 
 		shell_fprintf(sh, SHELL_NORMAL,
@@ -759,6 +798,143 @@ static void tcp_upload_cb(enum zperf_status status,
 	}
 }
 
+/* Async uploads started by a single shell command, see -P and -j options */
+static struct upload_group {
+	const struct shell *sh;
+	struct k_spinlock lock;
+	struct zperf_results sum;
+	int streams;
+	int remaining;
+	bool is_udp;
+	bool json;
+} upload_group;
+
+static void upload_group_print(struct upload_group *group, const char *type,
+			       int id, struct zperf_results *results,
+			       bool is_async)
+{
+	if (group->json) {
+		print_json_results(group->sh, type, group->is_udp ? "udp" : "tcp",
+				   id, results, false);
+	} else if (group->is_udp) {
+		shell_udp_upload_print_stats(group->sh, results, is_async);
+	} else {
+		shell_tcp_upload_print_stats(group->sh, results, is_async);
+	}
+}
+
+static void upload_group_cb(enum zperf_status status,
+			    struct zperf_results *result,
+			    void *user_data)
+{
+	struct upload_group *group = user_data;
+	k_spinlock_key_t key;
+	bool last;
+	int id = 0;
+
+	switch (status) {
+	case ZPERF_SESSION_PERIODIC_RESULT:
+		if (!group->json) {
+			shell_tcp_upload_print_periodic(group->sh, result);
+		}
+
+		return;
+
+	case ZPERF_SESSION_FINISHED: {
+#ifdef CONFIG_ZPERF_SESSION_PER_THREAD
+		struct session *ses = CONTAINER_OF(result, struct session, result);
+
+		ses->in_progress = false;
+		ses->state = STATE_COMPLETED;
+		id = ses->id;
+#endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
+
+		upload_group_print(group, "stream", id, result, true);
+
+		key = k_spin_lock(&group->lock);
+		zperf_results_add(&group->sum, result);
+		last = --group->remaining == 0;
+		k_spin_unlock(&group->lock, key);
+		break;
+	}
+
+	case ZPERF_SESSION_ERROR:
+		shell_fprintf(group->sh, SHELL_ERROR, "%s upload failed\n",
+			      group->is_udp ? "UDP" : "TCP");
+
+		key = k_spin_lock(&group->lock);
+		last = --group->remaining == 0;
+		k_spin_unlock(&group->lock, key);
+		break;
+
+	default:
+		return;
+	}
+
+	/* Stream results are final once the last one has reported */
+	if (last && group->streams > 1) {
+		if (!group->json) {
+			shell_fprintf(group->sh, SHELL_NORMAL,
+				      "-\nSum of %d streams\n", group->streams);
+		}
+
+		upload_group_print(group, "sum", group->streams,
+				   &group->sum, false);
+	}
+}
+
+static int upload_group_start(const struct shell *sh,
+			      const struct zperf_upload_params *param,
+			      bool is_udp, int streams, bool json)
+{
+	struct upload_group *group = &upload_group;
+	k_spinlock_key_t key;
+	int started;
+	int ret = 0;
+
+	key = k_spin_lock(&group->lock);
+
+	if (group->remaining > 0) {
+		k_spin_unlock(&group->lock, key);
+		shell_fprintf(sh, SHELL_WARNING,
+			      "Previous upload streams still running\n");
+		return -EBUSY;
+	}
+
+	group->sh = sh;
+	group->streams = streams;
+	group->remaining = streams;
+	group->is_udp = is_udp;
+	group->json = json;
+	(void)memset(&group->sum, 0, sizeof(group->sum));
+
+	k_spin_unlock(&group->lock, key);
+
+	for (started = 0; started < streams; started++) {
+		if (is_udp) {
+			ret = zperf_udp_upload_async(param, upload_group_cb, group);
+		} else {
+			ret = zperf_tcp_upload_async(param, upload_group_cb, group);
+		}
+
+		if (ret < 0) {
+			shell_fprintf(sh, SHELL_ERROR,
+				      "Failed to start %s async upload (%d)\n",
+				      is_udp ? "UDP" : "TCP", ret);
+			break;
+		}
+	}
+
+	if (started < streams) {
+		key = k_spin_lock(&group->lock);
+		group->streams = started;
+		group->remaining -= streams - started;
+		k_spin_unlock(&group->lock, key);
+	}
+
+	return started > 0 ? 0 : ret;
+}
+
 static int ping_handler(struct net_icmp_ctx *ctx,
 			struct net_pkt *pkt,
 			struct net_icmp_ip_hdr *ip_hdr,
@@ -813,7 +989,7 @@ static void send_ping(const struct shell *sh,
 
 static int execute_upload(const struct shell *sh,
 			  const struct zperf_upload_params *param,
-			  bool is_udp, bool async)
+			  bool is_udp, bool async, int streams, bool json)
 {
 	struct zperf_results results = { 0 };
 	int ret;
@@ -862,7 +1038,9 @@ static int execute_upload(const struct shell *sh,
 				      (unsigned int)packet_duration);
 		}
 
-		if (async) {
+		if (async && (streams > 1 || json)) {
+			return upload_group_start(sh, param, is_udp, streams, json);
+		} else if (async) {
 			ret = zperf_udp_upload_async(param, udp_upload_cb,
 						     (void *)sh);
 			if (ret < 0) {
@@ -878,7 +1056,12 @@ static int execute_upload(const struct shell *sh,
 				return ret;
 			}
 
-			shell_udp_upload_print_stats(sh, &results, false);
+			if (json) {
+				print_json_results(sh, "stream", "udp", 0, &results,
+						   false);
+			} else {
+				shell_udp_upload_print_stats(sh, &results, false);
+			}
 		}
 	} else {
 		if (is_udp && !IS_ENABLED(CONFIG_NET_UDP)) {
@@ -888,7 +1071,9 @@ static int execute_upload(const struct shell *sh,
 	}
 
 	if (!is_udp && IS_ENABLED(CONFIG_NET_TCP)) {
-		if (async) {
+		if (async && (streams > 1 || json)) {
+			return upload_group_start(sh, param, is_udp, streams, json);
+		} else if (async) {
 			ret = zperf_tcp_upload_async(param, tcp_upload_cb,
 						     (void *)sh);
 			if (ret < 0) {
@@ -904,7 +1089,12 @@ static int execute_upload(const struct shell *sh,
 				return ret;
 			}
 
-			shell_tcp_upload_print_stats(sh, &results, false);
+			if (json) {
+				print_json_results(sh, "stream", "tcp", 0, &results,
+						   false);
+			} else {
+				shell_tcp_upload_print_stats(sh, &results, false);
+			}
 		}
 	} else {
 		if (!is_udp && !IS_ENABLED(CONFIG_NET_TCP)) {
@@ -972,7 +1162,9 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 	struct sockaddr_in ipv4 = { .sin_family = AF_INET };
 	char *port_str;
 	bool async = false;
+	bool json = false;
 	bool is_udp;
+	int streams = 1;
 	int start = 0;
 	size_t opt_cnt = 0;
 	int ret;
@@ -1034,8 +1226,26 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			param.options.wait_for_start = true;
 			opt_cnt += 1;
 			break;
+
+		case 'P':
+			streams = parse_arg(&i, argc, argv);
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_SESSIONS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n"
+					      "Valid values are [1, %d]\n",
+					      argv[i], CONFIG_NET_ZPERF_MAX_SESSIONS);
+				return -ENOEXEC;
+			}
+			opt_cnt += 2;
+			async = true;
+			break;
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
 
+		case 'j':
+			json = true;
+			opt_cnt += 1;
+			break;
+
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		case 'p':
 			param.options.priority = parse_arg(&i, argc, argv);
@@ -1208,7 +1418,7 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 		param.rate_kbps = DEF_RATE_KBPS;
 	}
 
-	return execute_upload(sh, &param, is_udp, async);
+	return execute_upload(sh, &param, is_udp, async, streams, json);
 }
 
 static int cmd_tcp_upload(const struct shell *sh, size_t argc, char *argv[])
@@ -1228,6 +1438,8 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 	sa_family_t family;
 	uint8_t is_udp;
 	bool async = false;
+	bool json = false;
+	int streams = 1;
 	int start = 0;
 	size_t opt_cnt = 0;
 	int seconds;
@@ -1287,8 +1499,26 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			param.options.wait_for_start = true;
 			opt_cnt += 1;
 			break;
+
+		case 'P':
+			streams = parse_arg(&i, argc, argv);
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_SESSIONS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n"
+					      "Valid values are [1, %d]\n",
+					      argv[i], CONFIG_NET_ZPERF_MAX_SESSIONS);
+				return -ENOEXEC;
+			}
+			opt_cnt += 2;
+			async = true;
+			break;
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
 
+		case 'j':
+			json = true;
+			opt_cnt += 1;
+			break;
+
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		case 'p':
 			param.options.priority = parse_arg(&i, argc, argv);
@@ -1414,7 +1644,7 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 		param.rate_kbps = DEF_RATE_KBPS;
 	}
 
-	return execute_upload(sh, &param, is_udp, async);
+	return execute_upload(sh, &param, is_udp, async, streams, json);
 }
 
 static int cmd_tcp_upload2(const struct shell *sh, size_t argc,
@@ -1479,6 +1709,11 @@ static void tcp_session_cb(enum zperf_status status,
 	case ZPERF_SESSION_FINISHED: {
 		uint32_t rate_in_kbps;
 
+		if (tcp_download_json) {
+			print_json_results(sh, "server", "tcp", 0, result, false);
+			break;
+		}
+
 		/* Compute baud rate */
 		if (result->time_in_us != 0U) {
 			rate_in_kbps = (uint32_t)
@@ -1536,10 +1771,11 @@ static int cmd_tcp_download(const struct shell *sh, size_t argc,
 {
 	if (IS_ENABLED(CONFIG_NET_TCP)) {
 		struct zperf_download_params param = { 0 };
+		bool json = false;
 		int ret;
 		int start;
 
-		start = shell_cmd_download(sh, argc, argv, &param);
+		start = shell_cmd_download(sh, argc, argv, &param, &json);
 		if (start < 0) {
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unable to parse option.\n");
@@ -1565,6 +1801,8 @@ static int cmd_tcp_download(const struct shell *sh, size_t argc,
 			return -ENOEXEC;
 		}
 
+		tcp_download_json = json;
+
 		shell_fprintf(sh, SHELL_NORMAL,
 			      "TCP server started on port %u\n", param.port);
 
@@ -1925,7 +2163,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
+		  "-P streams: Number of parallel streams (async only)\n"
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
+		  "-j: Print the results as JSON\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -1949,7 +2189,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
+		  "-P streams: Number of parallel streams (async only)\n"
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
+		  "-j: Print the results as JSON\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -1967,8 +2209,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  cmd_tcp_upload2),
 #ifdef CONFIG_NET_ZPERF_SERVER
 	SHELL_CMD(download, &zperf_cmd_tcp_download,
+		  "[<options>] command options (optional): [-j]\n"
 		  "[<port>]:  Server port to listen on/connect to\n"
 		  "[<host>]:  Bind to <host>, an interface address\n"
+		  "Available options:\n"
+		  "-j: Print the results as JSON\n"
 		  "Example: tcp download 5001 192.168.0.1\n",
 		  cmd_tcp_download),
 #endif
@@ -2002,7 +2247,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
+		  "-P streams: Number of parallel streams (async only)\n"
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
+		  "-j: Print the results as JSON\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -2027,7 +2274,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
+		  "-P streams: Number of parallel streams (async only)\n"
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
+		  "-j: Print the results as JSON\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -2051,6 +2300,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "[<host>]:  Bind to <host>, an interface address\n"
 		  "Available options:\n"
 		  "-I <interface name>: Specify host interface name\n"
+		  "-j: Print the results as JSON\n"
 		  "Example: udp download 5001 192.168.0.1\n",
 		  cmd_udp_download),
 #endif
@@ -63,6 +63,7 @@ static void tcp_received(const struct sockaddr *addr, size_t datalen)
 		zperf_reset_session_stats(session);
 		session->start_time = k_uptime_ticks();
 		session->state = STATE_ONGOING;
+		zperf_cpu_sample_start(&session->cpu);
 
 		if (tcp_session_cb != NULL) {
 			tcp_session_cb(ZPERF_SESSION_STARTED, NULL,
@@ -82,6 +83,7 @@ static void tcp_received(const struct sockaddr *addr, size_t datalen)
 			results.total_len = session->length;
 			results.time_in_us = k_ticks_to_us_ceil64(
 						time - session->start_time);
+			zperf_cpu_sample_end(&session->cpu, &results);
 
 			if (tcp_session_cb != NULL) {
 				tcp_session_cb(ZPERF_SESSION_FINISHED, &results,
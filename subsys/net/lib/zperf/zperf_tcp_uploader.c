@@ -50,6 +50,7 @@ static int tcp_upload(int sock,
 	uint32_t nb_packets = 0U, nb_errors = 0U;
 	uint32_t packet_size = param->packet_size;
 	uint32_t alloc_errors = 0U;
+	struct zperf_cpu_sample cpu;
 	int ret = 0;
 
 	if (packet_size > PACKET_SIZE_MAX) {
@@ -58,6 +59,7 @@ static int tcp_upload(int sock,
 	}
 
 	/* Start the loop */
+	zperf_cpu_sample_start(&cpu);
 	start_time = k_uptime_ticks();
 
 	/* Default data payload */
@@ -114,6 +116,7 @@ static int tcp_upload(int sock,
 	} while (!sys_timepoint_expired(end));
 
 	end_time = k_uptime_ticks();
+	zperf_cpu_sample_end(&cpu, results);
 
 	/* Add result coming from the client */
 	results->nb_packets_sent = nb_packets;
@@ -188,6 +191,7 @@ static void tcp_upload_async_work(struct k_work *work)
 		k_thread_name_get(k_current_get()));
 
 	result = &ses->result;
+	(void)memset(result, 0, sizeof(*result));
 
 	ses->in_progress = true;
 #else
@@ -225,6 +229,9 @@ static void tcp_upload_async_work(struct k_work *work)
 		uint32_t last_round_duration = duration - ((rounds - 1) * report_interval);
 
 		struct zperf_results periodic_result;
+		struct zperf_cpu_sample cpu;
+
+		zperf_cpu_sample_start(&cpu);
 
 		for (; rounds > 0; rounds--) {
 			uint32_t round_duration;
@@ -250,6 +257,8 @@ static void tcp_upload_async_work(struct k_work *work)
 		}
 
 		result->packet_size = periodic_result.packet_size;
+		result->total_len = (uint64_t)result->nb_packets_sent * result->packet_size;
+		zperf_cpu_sample_end(&cpu, result);
 
 	} else {
 		ret = tcp_upload(sock, param.duration_ms, &param, result, &data_offset);
@@ -140,6 +140,7 @@ static void udp_received(int sock, const struct sockaddr *addr, uint8_t *data,
 			zperf_reset_session_stats(session);
 			session->state = STATE_ONGOING;
 			session->start_time = time;
+			zperf_cpu_sample_start(&session->cpu);
 
 			/* Start a new session! */
 			if (udp_session_cb != NULL) {
@@ -184,6 +185,14 @@ static void udp_received(int sock, const struct sockaddr *addr, uint8_t *data,
 			results.time_in_us = duration;
 			results.jitter_in_us = session->jitter;
 			results.packet_size = session->length / session->counter;
+			zperf_cpu_sample_end(&session->cpu, &results);
+
+#ifdef CONFIG_NET_ZPERF_HISTOGRAM
+			memcpy(results.latency_hist, session->latency_hist,
+			       sizeof(results.latency_hist));
+			memcpy(results.jitter_hist, session->jitter_hist,
+			       sizeof(results.jitter_hist));
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
 
 			if (udp_session_cb != NULL) {
 				udp_session_cb(ZPERF_SESSION_FINISHED, &results,
@@ -209,10 +218,27 @@ static void udp_received(int sock, const struct sockaddr *addr, uint8_t *data,
 
 				session->jitter +=
 					(delta_transit - session->jitter) / 16;
+
+#ifdef CONFIG_NET_ZPERF_HISTOGRAM
+				zperf_hist_add(session->jitter_hist, delta_transit);
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
 			}
 
 			session->last_transit_time = transit_time;
 
+#ifdef CONFIG_NET_ZPERF_HISTOGRAM
+			/* The clocks are not synchronized, measure the delay
+			 * from the fastest datagram seen so far.
+			 */
+			if (session->counter == 1U ||
+			    transit_time < session->min_transit_time) {
+				session->min_transit_time = transit_time;
+			}
+
+			zperf_hist_add(session->latency_hist,
+				       transit_time - session->min_transit_time);
+#endif /* CONFIG_NET_ZPERF_HISTOGRAM */
+
 			/* Check header id */
 			if (id != session->next_id) {
 				if (id < session->next_id) {
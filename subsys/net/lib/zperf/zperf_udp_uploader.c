@@ -15,9 +15,7 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 #include "zperf_internal.h"
 #include "zperf_session.h"
 
-static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
-			     sizeof(struct zperf_client_hdr_v1) +
-			     PACKET_SIZE_MAX];
+static uint8_t sample_packet[UDP_PACKET_BUF_SIZE];
 
 #if !defined(CONFIG_ZPERF_SESSION_PER_THREAD)
 static struct zperf_async_upload_context udp_async_upload_ctx;
@@ -59,7 +57,8 @@ static inline int zperf_upload_fin(int sock,
 				   uint64_t end_time_us,
 				   uint32_t packet_size,
 				   struct zperf_results *results,
-				   bool is_mcast_pkt)
+				   bool is_mcast_pkt,
+				   uint8_t *packet)
 {
 	uint8_t stats[sizeof(struct zperf_udp_datagram) +
 		      sizeof(struct zperf_server_hdr)] = { 0 };
@@ -75,14 +74,14 @@ static inline int zperf_upload_fin(int sock,
 	};
 
 	while (ret <= 0 && loop-- > 0) {
-		datagram = (struct zperf_udp_datagram *)sample_packet;
+		datagram = (struct zperf_udp_datagram *)packet;
 
 		/* Fill the packet header */
 		datagram->id = htonl(-nb_packets);
 		datagram->tv_sec = htonl(secs);
 		datagram->tv_usec = htonl(usecs);
 
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
+		hdr = (struct zperf_client_hdr_v1 *)(packet +
 						     sizeof(*datagram));
 
 		/* According to iperf documentation (in include/Settings.hpp),
@@ -93,13 +92,13 @@ static inline int zperf_upload_fin(int sock,
 		hdr->flags = 0;
 		hdr->num_of_threads = htonl(1);
 		hdr->port = 0;
-		hdr->buffer_len = sizeof(sample_packet) -
+		hdr->buffer_len = UDP_PACKET_BUF_SIZE -
 			sizeof(*datagram) - sizeof(*hdr);
 		hdr->bandwidth = 0;
 		hdr->num_of_bytes = htonl(packet_size);
 
 		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		ret = zsock_send(sock, packet, packet_size, 0);
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			continue;
@@ -157,7 +156,8 @@ static inline int zperf_upload_fin(int sock,
 
 static int udp_upload(int sock, int port,
 		      const struct zperf_upload_params *param,
-		      struct zperf_results *results)
+		      struct zperf_results *results,
+		      uint8_t *packet)
 {
 	size_t header_size =
 		sizeof(struct zperf_udp_datagram) + sizeof(struct zperf_client_hdr_v1);
@@ -173,6 +173,7 @@ static int udp_upload(int sock, int port,
 	int64_t start_time, end_time;
 	int64_t print_time, last_loop_time;
 	uint32_t print_period;
+	struct zperf_cpu_sample cpu;
 	bool is_mcast_pkt = false;
 	int ret;
 
@@ -185,6 +186,7 @@ static int udp_upload(int sock, int port,
 	}
 
 	/* Start the loop */
+	zperf_cpu_sample_start(&cpu);
 	start_time = k_uptime_ticks();
 	last_loop_time = start_time;
 	end_time = start_time + k_ms_to_ticks_ceil64(duration_in_ms);
@@ -194,7 +196,7 @@ static int udp_upload(int sock, int port,
 	print_time = start_time + print_period;
 
 	/* Default data payload */
-	(void)memset(sample_packet, 'z', sizeof(sample_packet));
+	(void)memset(packet, 'z', UDP_PACKET_BUF_SIZE);
 
 	do {
 		struct zperf_udp_datagram *datagram;
@@ -229,18 +231,18 @@ static int udp_upload(int sock, int port,
 		usecs = usecs64 % USEC_PER_SEC;
 
 		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
+		datagram = (struct zperf_udp_datagram *)packet;
 
 		datagram->id = htonl(nb_packets);
 		datagram->tv_sec = htonl(secs);
 		datagram->tv_usec = htonl(usecs);
 
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
+		hdr = (struct zperf_client_hdr_v1 *)(packet +
 						     sizeof(*datagram));
 		hdr->flags = 0;
 		hdr->num_of_threads = htonl(1);
 		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
+		hdr->buffer_len = UDP_PACKET_BUF_SIZE -
 			sizeof(*datagram) - sizeof(*hdr);
 		hdr->bandwidth = htonl(rate_in_kbps);
 		hdr->num_of_bytes = htonl(packet_size);
@@ -248,7 +250,7 @@ static int udp_upload(int sock, int port,
 		/* Load custom data payload if requested */
 		if (param->data_loader != NULL) {
 			ret = param->data_loader(param->data_loader_ctx, data_offset,
-				sample_packet + header_size, packet_size - header_size);
+				packet + header_size, packet_size - header_size);
 			if (ret < 0) {
 				NET_ERR("Failed to load data for offset %llu", data_offset);
 				return ret;
@@ -257,7 +259,7 @@ static int udp_upload(int sock, int port,
 		data_offset += packet_size - header_size;
 
 		/* Send the packet */
-		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		ret = zsock_send(sock, packet, packet_size, 0);
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			return -errno;
@@ -286,6 +288,7 @@ static int udp_upload(int sock, int port,
 
 	end_time = k_uptime_ticks();
 	usecs64 = param->unix_offset_us + k_ticks_to_us_floor64(end_time - start_time);
+	zperf_cpu_sample_end(&cpu, results);
 
 	if (param->peer_addr.sa_family == AF_INET) {
 		if (net_ipv4_is_addr_mcast(&net_sin(&param->peer_addr)->sin_addr)) {
@@ -298,7 +301,8 @@ static int udp_upload(int sock, int port,
 	} else {
 		return -EINVAL;
 	}
-	ret = zperf_upload_fin(sock, nb_packets, usecs64, packet_size, results, is_mcast_pkt);
+	ret = zperf_upload_fin(sock, nb_packets, usecs64, packet_size, results, is_mcast_pkt,
+			       packet);
 	if (ret < 0) {
 		return ret;
 	}
@@ -313,18 +317,15 @@ static int udp_upload(int sock, int port,
 	return 0;
 }
 
-int zperf_udp_upload(const struct zperf_upload_params *param,
-		     struct zperf_results *result)
+static int udp_upload_session(const struct zperf_upload_params *param,
+			      struct zperf_results *result,
+			      uint8_t *packet)
 {
 	int port = 0;
 	int sock;
 	int ret;
 	struct ifreq req;
 
-	if (param == NULL || result == NULL) {
-		return -EINVAL;
-	}
-
 	if (param->peer_addr.sa_family == AF_INET) {
 		port = ntohs(net_sin(&param->peer_addr)->sin_port);
 	} else if (param->peer_addr.sa_family == AF_INET6) {
@@ -352,19 +353,33 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
 		}
 	}
 
-	ret = udp_upload(sock, port, param, result);
+	ret = udp_upload(sock, port, param, result, packet);
 
 	zsock_close(sock);
 
 	return ret;
 }
 
+int zperf_udp_upload(const struct zperf_upload_params *param,
+		     struct zperf_results *result)
+{
+	if (param == NULL || result == NULL) {
+		return -EINVAL;
+	}
+
+	return udp_upload_session(param, result, sample_packet);
+}
+
 static void udp_upload_async_work(struct k_work *work)
 {
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 	struct session *ses;
 	struct zperf_async_upload_context *upload_ctx;
 	struct zperf_results *result;
+	/* Sessions run in parallel, each one sends from the stack of its
+	 * own work queue, which is sized for it.
+	 */
+	uint8_t packet[UDP_PACKET_BUF_SIZE];
 
 	ses = CONTAINER_OF(work, struct session, async_upload_ctx.work);
 	upload_ctx = &ses->async_upload_ctx;
@@ -383,12 +398,14 @@ static void udp_upload_async_work(struct k_work *work)
 		k_thread_name_get(k_current_get()));
 
 	result = &ses->result;
+	(void)memset(result, 0, sizeof(*result));
 
 	ses->in_progress = true;
 #else
 	struct zperf_async_upload_context *upload_ctx = &udp_async_upload_ctx;
 	struct zperf_results result_storage = { 0 };
 	struct zperf_results *result = &result_storage;
+	uint8_t *packet = sample_packet;
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
 
 	int ret;
@@ -396,7 +413,7 @@ static void udp_upload_async_work(struct k_work *work)
 	upload_ctx->callback(ZPERF_SESSION_STARTED, NULL,
 			     upload_ctx->user_data);
 
-	ret = zperf_udp_upload(&upload_ctx->param, result);
+	ret = udp_upload_session(&upload_ctx->param, result, packet);
 	if (ret < 0) {
 		upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
 				     upload_ctx->user_data);
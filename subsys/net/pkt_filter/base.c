@@ -4,12 +4,14 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(npf_base, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt_filter.h>
 #include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
 
 /*
  * Our actual rule lists for supported test points
@@ -122,10 +124,227 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 	return NET_DROP;
 }
 
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+/*
+ * Rule list compilation
+ *
+ * Interface and Ethernet type match conditions are pulled out of the rules
+ * into small lookup tables. For each distinct value the table holds the
+ * bitmap of rules that can match a packet carrying it, i.e. the rules with
+ * that value plus the rules with no condition on that field. Evaluation
+ * ANDs the bitmaps of the packet's values and only runs the remaining tests
+ * of the candidate rules, in list order.
+ */
+
+static int index_key_add(struct npf_index_key *keys, uint8_t *nb_keys,
+			 uintptr_t value)
+{
+	int i;
+
+	for (i = 0; i < *nb_keys; i++) {
+		if (keys[i].value == value) {
+			return i;
+		}
+	}
+
+	if (*nb_keys >= CONFIG_NET_PKT_FILTER_COMPILED_MAX_KEYS) {
+		return -ENOSPC;
+	}
+
+	keys[i].value = value;
+	keys[i].rules = 0U;
+	(*nb_keys)++;
+
+	return i;
+}
+
+static uint32_t index_key_lookup(const struct npf_index_key *keys,
+				 uint8_t nb_keys, uintptr_t value,
+				 uint32_t any)
+{
+	for (int i = 0; i < nb_keys; i++) {
+		if (keys[i].value == value) {
+			return keys[i].rules;
+		}
+	}
+
+	return any;
+}
+
+static bool is_eth_type_test(struct npf_test *test)
+{
+#ifdef CONFIG_NET_L2_ETHERNET
+	return test->fn == npf_eth_type_match;
+#else
+	return false;
+#endif
+}
+
+/* Find the keys of one rule, only the first condition on a field is a key */
+static int index_add_rule(struct npf_rule_index *index, struct npf_rule *rule,
+			  uint32_t bit)
+{
+	int iface_key = -1;
+	int type_key = -1;
+
+	index->skip[index->nb_rules] = 0U;
+
+	for (uint32_t i = 0; i < MIN(rule->nb_tests, 32U); i++) {
+		struct npf_test *test = rule->tests[i];
+
+		if (test->fn == npf_iface_match && iface_key < 0) {
+			struct npf_test_iface *test_iface =
+				CONTAINER_OF(test, struct npf_test_iface, test);
+
+			iface_key = index_key_add(index->ifaces, &index->nb_ifaces,
+						  (uintptr_t)test_iface->iface);
+			if (iface_key < 0) {
+				return iface_key;
+			}
+		} else if (is_eth_type_test(test) && type_key < 0) {
+			struct npf_test_eth_type *test_eth_type =
+				CONTAINER_OF(test, struct npf_test_eth_type, test);
+
+			type_key = index_key_add(index->types, &index->nb_types,
+						 test_eth_type->type);
+			if (type_key < 0) {
+				return type_key;
+			}
+		} else {
+			continue;
+		}
+
+		index->skip[index->nb_rules] |= BIT(i);
+	}
+
+	if (iface_key < 0) {
+		index->any_iface |= bit;
+	} else {
+		index->ifaces[iface_key].rules |= bit;
+	}
+
+	if (type_key < 0) {
+		index->any_type |= bit;
+	} else {
+		index->types[type_key].rules |= bit;
+	}
+
+	index->rules[index->nb_rules++] = rule;
+
+	return 0;
+}
+
+/* Called with the rule list lock held */
+static void index_rebuild(struct npf_rule_list *rules)
+{
+	struct npf_rule_index *index = &rules->index;
+	struct npf_rule *rule;
+	uint32_t bit = BIT(0);
+
+	memset(index, 0, sizeof(*index));
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&rules->rule_head, rule, node) {
+		if (index->nb_rules >= CONFIG_NET_PKT_FILTER_COMPILED_MAX_RULES ||
+		    index_add_rule(index, rule, bit) < 0) {
+			NET_DBG("rule list %p evaluated linearly", rules);
+			return;
+		}
+
+		bit <<= 1;
+	}
+
+	/* Rules without a key are compatible with every key value */
+	for (int i = 0; i < index->nb_ifaces; i++) {
+		index->ifaces[i].rules |= index->any_iface;
+	}
+
+	for (int i = 0; i < index->nb_types; i++) {
+		index->types[i].rules |= index->any_type;
+	}
+
+	index->valid = true;
+}
+
+static bool apply_other_tests(struct npf_rule *rule, uint32_t skip,
+			      struct net_pkt *pkt)
+{
+	struct npf_test *test;
+
+	for (uint32_t i = 0; i < rule->nb_tests; i++) {
+		if (i < 32U && (skip & BIT(i)) != 0U) {
+			continue;
+		}
+
+		test = rule->tests[i];
+		if (!test->fn(test, pkt)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static enum net_verdict evaluate_index(struct npf_rule_list *rules,
+				       struct net_pkt *pkt)
+{
+	struct npf_rule_index *index = &rules->index;
+	uint32_t candidates;
+
+	if (!index->valid || sys_slist_is_empty(&rules->rule_head)) {
+		return evaluate(&rules->rule_head, pkt);
+	}
+
+	/* Ethernet type keys need a readable link layer header */
+	if (index->nb_types > 0 &&
+	    (pkt->buffer == NULL || pkt->buffer->len < sizeof(struct net_eth_hdr))) {
+		return evaluate(&rules->rule_head, pkt);
+	}
+
+	candidates = (uint32_t)BIT64_MASK(index->nb_rules);
+
+	if (index->nb_ifaces > 0) {
+		candidates &= index_key_lookup(index->ifaces, index->nb_ifaces,
+					       (uintptr_t)net_pkt_iface(pkt),
+					       index->any_iface);
+	}
+
+	if (index->nb_types > 0) {
+		struct net_eth_hdr *eth_hdr = NET_ETH_HDR(pkt);
+
+		candidates &= index_key_lookup(index->types, index->nb_types,
+					       eth_hdr->type, index->any_type);
+	}
+
+	while (candidates != 0U) {
+		int i = find_lsb_set(candidates) - 1;
+
+		candidates &= candidates - 1U;
+
+		if (apply_other_tests(index->rules[i], index->skip[i], pkt)) {
+			return index->rules[i]->result;
+		}
+	}
+
+	NET_DBG("no matching rules from rule list %p", rules);
+	return NET_DROP;
+}
+#else
+static inline void index_rebuild(struct npf_rule_list *rules)
+{
+	ARG_UNUSED(rules);
+}
+
+static inline enum net_verdict evaluate_index(struct npf_rule_list *rules,
+					      struct net_pkt *pkt)
+{
+	return evaluate(&rules->rule_head, pkt);
+}
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
 static enum net_verdict lock_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt)
 {
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
-	enum net_verdict result = evaluate(&rules->rule_head, pkt);
+	enum net_verdict result = evaluate_index(rules, pkt);
 
 	k_spin_unlock(&rules->lock, key);
 	return result;
@@ -180,6 +399,7 @@ void npf_insert_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 
 	NET_DBG("inserting rule %p into %p", rule, rules);
 	sys_slist_prepend(&rules->rule_head, &rule->node);
+	index_rebuild(rules);
 
 	k_spin_unlock(&rules->lock, key);
 }
@@ -193,6 +413,7 @@ void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 
 	NET_DBG("appending rule %p into %p", rule, rules);
 	sys_slist_append(&rules->rule_head, &rule->node);
+	index_rebuild(rules);
 
 	k_spin_unlock(&rules->lock, key);
 }
@@ -202,6 +423,10 @@ bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 	bool result = sys_slist_find_and_remove(&rules->rule_head, &rule->node);
 
+	if (result) {
+		index_rebuild(rules);
+	}
+
 	k_spin_unlock(&rules->lock, key);
 	NET_DBG("removing rule %p from %p: %d", rule, rules, result);
 	return result;
@@ -214,6 +439,7 @@ bool npf_remove_all_rules(struct npf_rule_list *rules)
 
 	if (result) {
 		sys_slist_init(&rules->rule_head);
+		index_rebuild(rules);
 		NET_DBG("removing all rules from %p", rules);
 	}
 
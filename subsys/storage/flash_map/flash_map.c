@@ -56,53 +56,88 @@ void flash_area_close(const struct flash_area *fa)
 int flash_area_read(const struct flash_area *fa, off_t off, void *dst,
 		    size_t len)
 {
+	uint32_t start;
+	int rc;
+
 	if (!is_in_flash_area_bounds(fa, off, len)) {
 		return -EINVAL;
 	}
 
-	return flash_read(fa->fa_dev, fa->fa_off + off, dst, len);
+	start = flash_map_telemetry_start();
+	rc = flash_read(fa->fa_dev, fa->fa_off + off, dst, len);
+	FLASH_MAP_TELEMETRY_RECORD(fa, READ, off, len, start, rc);
+
+	return rc;
 }
 
 int flash_area_write(const struct flash_area *fa, off_t off, const void *src,
 		     size_t len)
 {
+	uint32_t start;
+	int rc;
+
 	if (!is_in_flash_area_bounds(fa, off, len)) {
 		return -EINVAL;
 	}
 
-	return flash_write(fa->fa_dev, fa->fa_off + off, (void *)src, len);
+	start = flash_map_telemetry_start();
+	rc = flash_write(fa->fa_dev, fa->fa_off + off, (void *)src, len);
+	FLASH_MAP_TELEMETRY_RECORD(fa, WRITE, off, len, start, rc);
+
+	return rc;
 }
 
 int flash_area_erase(const struct flash_area *fa, off_t off, size_t len)
 {
+	uint32_t start;
+	int rc;
+
 	if (!is_in_flash_area_bounds(fa, off, len)) {
 		return -EINVAL;
 	}
 
-	return flash_erase(fa->fa_dev, fa->fa_off + off, len);
+	start = flash_map_telemetry_start();
+	rc = flash_erase(fa->fa_dev, fa->fa_off + off, len);
+	FLASH_MAP_TELEMETRY_RECORD(fa, ERASE, off, len, start, rc);
+
+	return rc;
 }
 
 int flash_area_copy(const struct flash_area *src_fa, off_t src_off,
 		    const struct flash_area *dst_fa, off_t dst_off,
 		    off_t len, uint8_t *buf, size_t buf_size)
 {
+	uint32_t start;
+	int rc;
+
 	if (!(is_in_flash_area_bounds(src_fa, src_off, len) &&
 	      is_in_flash_area_bounds(dst_fa, dst_off, len))) {
 		return -EINVAL;
 	}
 
-	return flash_copy(src_fa->fa_dev, src_fa->fa_off + src_off,
-			  dst_fa->fa_dev, dst_fa->fa_off + dst_off, len, buf,
-			  buf_size);
+	start = flash_map_telemetry_start();
+	rc = flash_copy(src_fa->fa_dev, src_fa->fa_off + src_off,
+			dst_fa->fa_dev, dst_fa->fa_off + dst_off, len, buf,
+			buf_size);
+	FLASH_MAP_TELEMETRY_RECORD(dst_fa, COPY, dst_off, len, start, rc);
+
+	return rc;
 }
 
 int flash_area_flatten(const struct flash_area *fa, off_t off, size_t len)
 {
+	uint32_t start;
+	int rc;
+
 	if (!is_in_flash_area_bounds(fa, off, len)) {
 		return -EINVAL;
 	}
 
-	return flash_flatten(fa->fa_dev, fa->fa_off + off, len);
+	start = flash_map_telemetry_start();
+	rc = flash_flatten(fa->fa_dev, fa->fa_off + off, len);
+	FLASH_MAP_TELEMETRY_RECORD(fa, ERASE, off, len, start, rc);
+
+	return rc;
 }
 
 uint32_t flash_area_align(const struct flash_area *fa)
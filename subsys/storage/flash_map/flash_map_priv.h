@@ -36,4 +36,28 @@ static inline bool is_in_flash_area_bounds(const struct flash_area *fa,
 	return (off >= 0) && (off < fa->fa_size) && (len <= (fa->fa_size - off));
 }
 
+#ifdef CONFIG_FLASH_MAP_TELEMETRY
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+
+static inline uint32_t flash_map_telemetry_start(void)
+{
+	return k_cycle_get_32();
+}
+
+void flash_map_telemetry_record(const struct flash_area *fa,
+				enum flash_area_telemetry_op op, off_t off,
+				size_t len, uint32_t start, int rc);
+
+#define FLASH_MAP_TELEMETRY_RECORD(fa, op, off, len, start, rc) \
+	flash_map_telemetry_record(fa, FLASH_AREA_TELEMETRY_##op, off, len, start, rc)
+#else
+static inline uint32_t flash_map_telemetry_start(void)
+{
+	return 0;
+}
+
+#define FLASH_MAP_TELEMETRY_RECORD(fa, op, off, len, start, rc) ARG_UNUSED(start)
+#endif /* CONFIG_FLASH_MAP_TELEMETRY */
+
 #endif /* ZEPHYR_SUBSYS_STORAGE_FLASH_MAP_PRIV_H_ */
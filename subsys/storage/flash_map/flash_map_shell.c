@@ -56,9 +56,131 @@ static int cmd_flash_map_list(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+#if defined(CONFIG_FLASH_MAP_TELEMETRY)
+static const char *const telemetry_op_names[] = {
+	[FLASH_AREA_TELEMETRY_READ] = "read",
+	[FLASH_AREA_TELEMETRY_WRITE] = "write",
+	[FLASH_AREA_TELEMETRY_ERASE] = "erase",
+	[FLASH_AREA_TELEMETRY_COPY] = "copy",
+};
+
+static void print_telemetry(const struct shell *sh, const struct flash_area *fa)
+{
+	struct flash_area_telemetry t;
+
+	if (flash_area_telemetry_get(fa, &t) != 0) {
+		shell_print(sh, "Flash area %d: no telemetry", (int)fa->fa_id);
+		return;
+	}
+
+	shell_print(sh, "Flash area %d:", (int)fa->fa_id);
+	shell_print(sh, "  op     count      errors     bytes          avg[us]    max[us]");
+
+	for (int op = 0; op < FLASH_AREA_TELEMETRY_OPS; op++) {
+		const struct flash_area_op_telemetry *ot = &t.ops[op];
+
+		shell_print(sh, "  %-6s %-10u %-10u %-14llu %-10u %u", telemetry_op_names[op],
+			    ot->count, ot->errors, (unsigned long long)ot->bytes,
+			    ot->count ? (uint32_t)(ot->total_us / ot->count) : 0U, ot->max_us);
+	}
+
+	for (int op = 0; op < FLASH_AREA_TELEMETRY_OPS; op++) {
+		const struct flash_area_op_telemetry *ot = &t.ops[op];
+
+		if (ot->count == 0U) {
+			continue;
+		}
+
+		shell_fprintf(sh, SHELL_NORMAL, "  %s latency:", telemetry_op_names[op]);
+		for (int i = 0; i < CONFIG_FLASH_MAP_TELEMETRY_HIST_BUCKETS; i++) {
+			if (ot->latency[i] != 0U) {
+				shell_fprintf(sh, SHELL_NORMAL, " <%uus:%u", 2U << i, ot->latency[i]);
+			}
+		}
+		shell_fprintf(sh, SHELL_NORMAL, "\n");
+	}
+
+	if (t.sectors_per_counter != 0U) {
+		shell_fprintf(sh, SHELL_NORMAL, "  erases per %u sector(s):",
+			      t.sectors_per_counter);
+		for (int i = 0; i < CONFIG_FLASH_MAP_TELEMETRY_SECTORS; i++) {
+			if ((i % 16) == 0) {
+				shell_fprintf(sh, SHELL_NORMAL, "\n   ");
+			}
+			shell_fprintf(sh, SHELL_NORMAL, " %u", t.sector_erases[i]);
+		}
+		shell_fprintf(sh, SHELL_NORMAL, "\n");
+	}
+}
+
+static void fa_telemetry_cb(const struct flash_area *fa, void *user_data)
+{
+	print_telemetry(user_data, fa);
+}
+
+static int parse_area(const struct shell *sh, const char *arg, const struct flash_area **fa)
+{
+	char *end;
+	long id = strtol(arg, &end, 0);
+
+	if (*end != '\0' || id < 0 || id > UINT8_MAX || flash_area_open(id, fa) != 0) {
+		shell_error(sh, "Invalid flash area: %s", arg);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int cmd_flash_map_telemetry(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct flash_area *fa;
+
+	if (argc < 2) {
+		flash_area_foreach(fa_telemetry_cb, (struct shell *)sh);
+		return 0;
+	}
+
+	if (parse_area(sh, argv[1], &fa) != 0) {
+		return -EINVAL;
+	}
+
+	print_telemetry(sh, fa);
+	flash_area_close(fa);
+
+	return 0;
+}
+
+static int cmd_flash_map_telemetry_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct flash_area *fa;
+
+	if (parse_area(sh, argv[1], &fa) != 0) {
+		return -EINVAL;
+	}
+
+	flash_area_telemetry_reset(fa);
+	flash_area_close(fa);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_flash_map_telemetry,
+	SHELL_CMD_ARG(reset, NULL, "Clear the telemetry of a flash area\n"
+				    "Usage: reset <id>",
+		      cmd_flash_map_telemetry_reset, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+#endif /* CONFIG_FLASH_MAP_TELEMETRY */
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_flash_map,
 	/* Alphabetically sorted. */
 	SHELL_CMD(list, NULL, "List flash areas", cmd_flash_map_list),
+#if defined(CONFIG_FLASH_MAP_TELEMETRY)
+	SHELL_CMD_ARG(telemetry, &sub_flash_map_telemetry,
+		      "Show wear and latency telemetry\n"
+		      "Usage: telemetry [<id>]",
+		      cmd_flash_map_telemetry, 1, 1),
+#endif
 	SHELL_SUBCMD_SET_END /* Array terminated. */
 );
 
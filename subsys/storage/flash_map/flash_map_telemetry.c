@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include "flash_map_priv.h"
+
+#define HIST_BUCKETS CONFIG_FLASH_MAP_TELEMETRY_HIST_BUCKETS
+#define SECTOR_COUNTERS CONFIG_FLASH_MAP_TELEMETRY_SECTORS
+
+struct fa_telemetry {
+	struct flash_area_telemetry data;
+	/* Index of the first flash page of the area, valid if sectors_per_counter != 0 */
+	uint32_t first_page;
+};
+
+static struct fa_telemetry telemetry[CONFIG_FLASH_MAP_TELEMETRY_AREAS];
+static struct k_spinlock lock;
+
+#ifdef CONFIG_FLASH_MAP_TELEMETRY_STATS
+STATS_SECT_START(flash_area_stats)
+STATS_SECT_ENTRY32(reads)
+STATS_SECT_ENTRY32(read_bytes)
+STATS_SECT_ENTRY32(writes)
+STATS_SECT_ENTRY32(write_bytes)
+STATS_SECT_ENTRY32(erases)
+STATS_SECT_ENTRY32(erase_bytes)
+STATS_SECT_ENTRY32(copies)
+STATS_SECT_ENTRY32(copy_bytes)
+STATS_SECT_ENTRY32(errors)
+STATS_SECT_END;
+
+STATS_NAME_START(flash_area_stats)
+STATS_NAME(flash_area_stats, reads)
+STATS_NAME(flash_area_stats, read_bytes)
+STATS_NAME(flash_area_stats, writes)
+STATS_NAME(flash_area_stats, write_bytes)
+STATS_NAME(flash_area_stats, erases)
+STATS_NAME(flash_area_stats, erase_bytes)
+STATS_NAME(flash_area_stats, copies)
+STATS_NAME(flash_area_stats, copy_bytes)
+STATS_NAME(flash_area_stats, errors)
+STATS_NAME_END(flash_area_stats);
+
+static STATS_SECT_DECL(flash_area_stats) stats[CONFIG_FLASH_MAP_TELEMETRY_AREAS];
+
+#define FA_STAT_NAME_LEN sizeof("flash_area_XXX")
+static char names[CONFIG_FLASH_MAP_TELEMETRY_AREAS][FA_STAT_NAME_LEN];
+
+static int flash_map_telemetry_init(void)
+{
+	int count = MIN(flash_map_entries, CONFIG_FLASH_MAP_TELEMETRY_AREAS);
+
+	for (int i = 0; i < count; i++) {
+		snprintk(names[i], FA_STAT_NAME_LEN, "flash_area_%d", flash_map[i].fa_id);
+		stats_init(&stats[i].s_hdr, STATS_SIZE_32, 9U,
+			   STATS_NAME_INIT_PARMS(flash_area_stats));
+		stats_register(names[i], &stats[i].s_hdr);
+	}
+
+	return 0;
+}
+
+SYS_INIT(flash_map_telemetry_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static void update_stats(int idx, enum flash_area_telemetry_op op, size_t len, int rc)
+{
+	if (rc != 0) {
+		STATS_INC(stats[idx], errors);
+		return;
+	}
+
+	switch (op) {
+	case FLASH_AREA_TELEMETRY_READ:
+		STATS_INC(stats[idx], reads);
+		STATS_INCN(stats[idx], read_bytes, len);
+		break;
+	case FLASH_AREA_TELEMETRY_WRITE:
+		STATS_INC(stats[idx], writes);
+		STATS_INCN(stats[idx], write_bytes, len);
+		break;
+	case FLASH_AREA_TELEMETRY_COPY:
+		STATS_INC(stats[idx], copies);
+		STATS_INCN(stats[idx], copy_bytes, len);
+		break;
+	default:
+		STATS_INC(stats[idx], erases);
+		STATS_INCN(stats[idx], erase_bytes, len);
+		break;
+	}
+}
+#else
+static inline void update_stats(int idx, enum flash_area_telemetry_op op, size_t len, int rc)
+{
+}
+#endif /* CONFIG_FLASH_MAP_TELEMETRY_STATS */
+
+/*
+ * Flash areas are matched by ID, as FIXED_PARTITION() objects are not the
+ * entries of the flash map.
+ */
+static int telemetry_index(const struct flash_area *fa)
+{
+	int count = MIN(flash_map_entries, CONFIG_FLASH_MAP_TELEMETRY_AREAS);
+
+	if (flash_map == NULL) {
+		return -ENOENT;
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (flash_map[i].fa_id == fa->fa_id) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static uint32_t latency_bucket(uint32_t us)
+{
+	uint32_t bucket = (us == 0U) ? 0U : (31U - __builtin_clz(us));
+
+	return MIN(bucket, HIST_BUCKETS - 1U);
+}
+
+/*
+ * Spread the sectors of the area evenly over the erase counters. Called on
+ * the first erase of the area, page lookups do not touch the hardware.
+ */
+static int init_sector_map(const struct flash_area *fa, uint32_t *first_page,
+			   uint32_t *sectors_per_counter)
+{
+	struct flash_pages_info first;
+	struct flash_pages_info last;
+	uint32_t sectors;
+	int rc;
+
+	rc = flash_get_page_info_by_offs(fa->fa_dev, fa->fa_off, &first);
+	if (rc == 0) {
+		rc = flash_get_page_info_by_offs(fa->fa_dev, fa->fa_off + fa->fa_size - 1,
+						 &last);
+	}
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	sectors = last.index - first.index + 1U;
+	*first_page = first.index;
+	*sectors_per_counter = DIV_ROUND_UP(sectors, SECTOR_COUNTERS);
+
+	return 0;
+}
+
+static void record_sector_erases(struct fa_telemetry *t, const struct flash_area *fa,
+				 off_t off, size_t len)
+{
+	struct flash_pages_info info;
+	uint32_t first_page;
+	uint32_t sectors_per_counter;
+	off_t addr = fa->fa_off + off;
+	off_t end = addr + len;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+	first_page = t->first_page;
+	sectors_per_counter = t->data.sectors_per_counter;
+	k_spin_unlock(&lock, key);
+
+	if (sectors_per_counter == 0U) {
+		if (init_sector_map(fa, &first_page, &sectors_per_counter) != 0) {
+			return;
+		}
+
+		key = k_spin_lock(&lock);
+		t->first_page = first_page;
+		t->data.sectors_per_counter = sectors_per_counter;
+		k_spin_unlock(&lock, key);
+	}
+
+	while (addr < end) {
+		uint32_t counter;
+
+		if (flash_get_page_info_by_offs(fa->fa_dev, addr, &info) != 0) {
+			return;
+		}
+
+		counter = (info.index - first_page) / sectors_per_counter;
+		if (counter < SECTOR_COUNTERS) {
+			key = k_spin_lock(&lock);
+			t->data.sector_erases[counter]++;
+			k_spin_unlock(&lock, key);
+		}
+
+		addr = info.start_offset + info.size;
+	}
+}
+
+void flash_map_telemetry_record(const struct flash_area *fa,
+				enum flash_area_telemetry_op op, off_t off,
+				size_t len, uint32_t start, int rc)
+{
+	uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	struct flash_area_op_telemetry *ot;
+	struct fa_telemetry *t;
+	k_spinlock_key_t key;
+	int idx;
+
+	idx = telemetry_index(fa);
+	if (idx < 0) {
+		return;
+	}
+
+	t = &telemetry[idx];
+	ot = &t->data.ops[op];
+
+	key = k_spin_lock(&lock);
+	ot->count++;
+	if (rc != 0) {
+		ot->errors++;
+	} else {
+		ot->bytes += len;
+	}
+	ot->total_us += us;
+	ot->max_us = MAX(ot->max_us, us);
+	ot->latency[latency_bucket(us)]++;
+	k_spin_unlock(&lock, key);
+
+	update_stats(idx, op, len, rc);
+
+	if (op == FLASH_AREA_TELEMETRY_ERASE && rc == 0) {
+		record_sector_erases(t, fa, off, len);
+	}
+}
+
+int flash_area_telemetry_get(const struct flash_area *fa,
+			     struct flash_area_telemetry *data)
+{
+	k_spinlock_key_t key;
+	int idx;
+
+	idx = telemetry_index(fa);
+	if (idx < 0) {
+		return idx;
+	}
+
+	key = k_spin_lock(&lock);
+	memcpy(data, &telemetry[idx].data, sizeof(*data));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int flash_area_telemetry_reset(const struct flash_area *fa)
+{
+	struct flash_area_telemetry *data;
+	k_spinlock_key_t key;
+	int idx;
+
+	idx = telemetry_index(fa);
+	if (idx < 0) {
+		return idx;
+	}
+
+	data = &telemetry[idx].data;
+
+	key = k_spin_lock(&lock);
+	memset(data->ops, 0, sizeof(data->ops));
+	memset(data->sector_erases, 0, sizeof(data->sector_erases));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
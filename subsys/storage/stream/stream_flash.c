@@ -16,6 +16,38 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 
 #include <zephyr/storage/stream_flash.h>
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+static int flash_sync_wait(struct stream_flash_ctx *ctx);
+
+/* Wait for the work queue to be done with the pending buffer and keep it from
+ * taking the context, so that the write and erase positions can be used.
+ */
+static inline void stream_flash_lock(struct stream_flash_ctx *ctx)
+{
+	if (ctx->async) {
+		/* A failed program is left to be reported by the next write */
+		(void)flash_sync_wait(ctx);
+	}
+}
+
+static inline void stream_flash_unlock(struct stream_flash_ctx *ctx)
+{
+	if (ctx->async) {
+		k_sem_give(&ctx->idle);
+	}
+}
+#else
+static inline void stream_flash_lock(struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void stream_flash_unlock(struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 #include <zephyr/settings/settings.h>
 
@@ -131,9 +163,9 @@ static int stream_flash_erase_to_append(struct stream_flash_ctx *ctx, size_t siz
 
 #if defined(CONFIG_STREAM_FLASH_ERASE)
 
-int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
-{
 #if defined(CONFIG_FLASH_HAS_EXPLICIT_ERASE)
+static int erase_page(struct stream_flash_ctx *ctx, off_t off)
+{
 	int rc;
 	struct flash_pages_info page;
 
@@ -176,6 +208,19 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 		ctx->erased_up_to = page.start_offset + page.size;
 	}
 
+	return rc;
+}
+#endif /* CONFIG_FLASH_HAS_EXPLICIT_ERASE */
+
+int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
+{
+#if defined(CONFIG_FLASH_HAS_EXPLICIT_ERASE)
+	int rc;
+
+	stream_flash_lock(ctx);
+	rc = erase_page(ctx, off);
+	stream_flash_unlock(ctx);
+
 	return rc;
 #else
 	return 0;
@@ -184,7 +229,10 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+/* Erase, when needed, and program len bytes of buf at the current write
+ * position; does not update the context write position.
+ */
+static int flash_program(struct stream_flash_ctx *ctx, uint8_t *buf, size_t len)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
@@ -192,33 +240,28 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	size_t fill_length;
 	uint8_t filler;
 
-
-	if (ctx->buf_bytes == 0) {
-		return 0;
-	}
-
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
-		rc = stream_flash_erase_to_append(ctx, ctx->buf_bytes);
+		rc = stream_flash_erase_to_append(ctx, len);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_forward_erase %d range=0x%08zx",
-				rc, ctx->buf_bytes);
+				rc, len);
 			return rc;
 		}
 	}
 
 	fill_length = ctx->write_block_size;
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (len % fill_length) {
+		fill_length -= len % fill_length;
 		filler = ctx->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + len, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = len + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -232,18 +275,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < len; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, len);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, len, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
@@ -252,6 +294,128 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 
 #endif
 
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+static K_THREAD_STACK_DEFINE(stream_flash_work_q_stack,
+			     CONFIG_STREAM_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q stream_flash_work_q;
+
+static int stream_flash_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "stream_flash"};
+
+	k_work_queue_start(&stream_flash_work_q, stream_flash_work_q_stack,
+			   K_THREAD_STACK_SIZEOF(stream_flash_work_q_stack),
+			   CONFIG_STREAM_FLASH_ASYNC_THREAD_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static void flash_program_work(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx = CONTAINER_OF(work, struct stream_flash_ctx, work);
+
+	/* The pending buffer is the spare one until the caller takes ctx->idle
+	 * again, and ctx->bytes_written is not modified before that either.
+	 */
+	ctx->pending_rc = flash_program(ctx, ctx->spare_buf, ctx->pending_bytes);
+
+	k_sem_give(&ctx->idle);
+}
+
+/* Wait for the pending buffer to be programmed and account for it. Returns
+ * with ctx->idle taken.
+ */
+static int flash_sync_wait(struct stream_flash_ctx *ctx)
+{
+	k_sem_take(&ctx->idle, K_FOREVER);
+
+	if (ctx->pending_rc != 0) {
+		return ctx->pending_rc;
+	}
+
+	ctx->bytes_written += ctx->pending_bytes;
+	ctx->pending_bytes = 0U;
+
+	return 0;
+}
+
+static int flash_sync_async(struct stream_flash_ctx *ctx)
+{
+	uint8_t *buf;
+	int rc;
+
+	rc = flash_sync_wait(ctx);
+	if (rc != 0) {
+		k_sem_give(&ctx->idle);
+		return rc;
+	}
+
+	/* Hand the filled buffer over and keep filling the one just programmed */
+	buf = ctx->spare_buf;
+	ctx->spare_buf = ctx->buf;
+	ctx->buf = buf;
+	ctx->pending_bytes = ctx->buf_bytes;
+	ctx->buf_bytes = 0U;
+
+	k_work_submit_to_queue(&stream_flash_work_q, &ctx->work);
+
+	return 0;
+}
+
+static int flash_flush_async(struct stream_flash_ctx *ctx)
+{
+	int rc = flash_sync_wait(ctx);
+
+	k_sem_give(&ctx->idle);
+
+	return rc;
+}
+
+int stream_flash_async_enable(struct stream_flash_ctx *ctx, uint8_t *buf)
+{
+	if (!ctx || !buf) {
+		return -EFAULT;
+	}
+
+	if (ctx->async) {
+		return -EALREADY;
+	}
+
+	k_work_init(&ctx->work, flash_program_work);
+	k_sem_init(&ctx->idle, 1, 1);
+	ctx->spare_buf = buf;
+	ctx->pending_bytes = 0U;
+	ctx->pending_rc = 0;
+	ctx->async = true;
+
+	return 0;
+}
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	if (ctx->buf_bytes == 0) {
+		return 0;
+	}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async) {
+		return flash_sync_async(ctx);
+	}
+#endif
+
+	rc = flash_program(ctx, ctx->buf, ctx->buf_bytes);
+	if (rc != 0) {
+		return rc;
+	}
+
 	ctx->bytes_written += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
@@ -269,7 +433,8 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (stream_flash_bytes_written(ctx) + stream_flash_bytes_buffered(ctx) + len >
+	    ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -299,6 +464,12 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (flush && rc == 0 && ctx->async) {
+		rc = flash_flush_async(ctx);
+	}
+#endif
+
 	return rc;
 }
 
@@ -309,7 +480,11 @@ size_t stream_flash_bytes_written(const struct stream_flash_ctx *ctx)
 
 size_t stream_flash_bytes_buffered(const struct stream_flash_ctx *ctx)
 {
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	return ctx->buf_bytes + ctx->pending_bytes;
+#else
 	return ctx->buf_bytes;
+#endif
 }
 
 #ifdef CONFIG_STREAM_FLASH_INSPECT
@@ -400,6 +575,10 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	ctx->offset = offset;
 	ctx->available = size;
 	ctx->write_block_size = params->write_block_size;
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	ctx->async = false;
+	ctx->pending_bytes = 0U;
+#endif
 
 #if !defined(CONFIG_STREAM_FLASH_POST_WRITE_CALLBACK)
 	ARG_UNUSED(cb);
@@ -448,8 +627,10 @@ int stream_flash_progress_load(struct stream_flash_ctx *ctx,
 	int rc = stream_flash_settings_init();
 
 	if (rc == 0) {
+		stream_flash_lock(ctx);
 		rc = settings_load_subtree_direct(settings_key, settings_direct_loader,
 						  (void *)ctx);
+		stream_flash_unlock(ctx);
 	}
 
 	if (rc != 0) {
@@ -470,8 +651,13 @@ int stream_flash_progress_save(const struct stream_flash_ctx *ctx,
 	int rc = stream_flash_settings_init();
 
 	if (rc == 0) {
+		/* Only the asynchronous state is modified, not the progress */
+		struct stream_flash_ctx *sctx = (struct stream_flash_ctx *)ctx;
+
+		stream_flash_lock(sctx);
 		rc = settings_save_one(settings_key, &ctx->bytes_written,
 				       sizeof(ctx->bytes_written));
+		stream_flash_unlock(sctx);
 	}
 
 	if (rc != 0) {
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/base64.h>
+#include <zephyr/sys/util_utf8.h>
+#include <zephyr/timing/timing.h>
+
+#define RAW_SIZE   3072
+#define ITERATIONS 32
+
+static uint8_t raw[RAW_SIZE];
+static uint8_t encoded[(RAW_SIZE / 3) * 4 + 1];
+static uint8_t decoded[RAW_SIZE];
+static char text[RAW_SIZE];
+
+static timing_t start_time;
+
+static void bench_start(void)
+{
+	start_time = timing_counter_get();
+}
+
+static void bench_end(const char *metric, const char *desc, size_t bytes)
+{
+	timing_t end_time = timing_counter_get();
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(&start_time, &end_time));
+	uint64_t kbps;
+
+	kbps = (ns == 0U) ? 0U : ((uint64_t)bytes * ITERATIONS * NSEC_PER_SEC) / (ns * 1024U);
+
+	TC_PRINT("REC: %s - %s:%llu KB/s\n", metric, desc, (unsigned long long)kbps);
+}
+
+ZTEST(base64_utf8_perf, test_base64_encode)
+{
+	size_t olen;
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		zassert_ok(base64_encode(encoded, sizeof(encoded), &olen, raw, sizeof(raw)));
+	}
+	bench_end("base64.encode", "base64_encode() of 3 KiB", sizeof(raw));
+}
+
+ZTEST(base64_utf8_perf, test_base64_decode)
+{
+	size_t elen;
+	size_t olen;
+
+	zassert_ok(base64_encode(encoded, sizeof(encoded), &elen, raw, sizeof(raw)));
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		zassert_ok(base64_decode(decoded, sizeof(decoded), &olen, encoded, elen));
+	}
+	bench_end("base64.decode", "base64_decode() of 4 KiB", elen);
+
+	zassert_mem_equal(decoded, raw, sizeof(raw));
+}
+
+ZTEST(base64_utf8_perf, test_utf8_validate_ascii)
+{
+	memset(text, 'a', sizeof(text));
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		zassert_true(utf8_validate(text, sizeof(text)));
+	}
+	bench_end("utf8.validate.ascii", "utf8_validate() of 3 KiB ASCII", sizeof(text));
+}
+
+ZTEST(base64_utf8_perf, test_utf8_validate_mixed)
+{
+	/* "z€" and "ж" repeated, one in every two bytes is not ASCII */
+	static const char pattern[] = "z\xE2\x82\xAC\xD0\xB6";
+
+	for (size_t i = 0; i < sizeof(text); i++) {
+		text[i] = pattern[i % (sizeof(pattern) - 1)];
+	}
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		zassert_true(utf8_validate(text, sizeof(text)));
+	}
+	bench_end("utf8.validate.mixed", "utf8_validate() of 3 KiB mixed text", sizeof(text));
+}
+
+static void *base64_utf8_perf_setup(void)
+{
+	for (size_t i = 0; i < sizeof(raw); i++) {
+		raw[i] = (uint8_t)(i * 7U + 3U);
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void base64_utf8_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(base64_utf8_perf, NULL, base64_utf8_perf_setup, NULL, NULL,
+	    base64_utf8_perf_teardown);
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/timing/timing.h>
+
+#define BUF_SIZE   4096
+#define ITERATIONS 64
+
+static uint8_t buf[BUF_SIZE];
+
+/* Keep the results alive so the calls are not optimized out */
+static volatile uint32_t sink;
+
+enum crc_bench {
+	BENCH_CRC32_IEEE,
+	BENCH_CRC32_C,
+	BENCH_CRC16_CCITT,
+	BENCH_CRC16_ITU_T,
+};
+
+static uint32_t run_one(enum crc_bench bench, const uint8_t *data, size_t len)
+{
+	switch (bench) {
+	case BENCH_CRC32_IEEE:
+		return crc32_ieee(data, len);
+	case BENCH_CRC32_C:
+		return crc32_c(0, data, len, true, true);
+	case BENCH_CRC16_CCITT:
+		return crc16_ccitt(0xffff, data, len);
+	default:
+		return crc16_itu_t(0xffff, data, len);
+	}
+}
+
+static void bench_crc(enum crc_bench bench, const char *name, size_t len)
+{
+	timing_t start;
+	timing_t end;
+	uint64_t ns;
+	uint64_t kbps;
+
+	/* Warm up the caches and the lookup tables */
+	sink = run_one(bench, buf, len);
+
+	start = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		sink = run_one(bench, buf, len);
+	}
+	end = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	kbps = (ns == 0U) ? 0U : ((uint64_t)len * ITERATIONS * NSEC_PER_SEC) / (ns * 1024U);
+
+	TC_PRINT("REC: %s/%zu - %zu byte buffers:%llu KB/s\n", name, len, len,
+		 (unsigned long long)kbps);
+}
+
+static void bench_all_sizes(enum crc_bench bench, const char *name)
+{
+	static const size_t sizes[] = {16, 64, 256, 1024, BUF_SIZE};
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		bench_crc(bench, name, sizes[i]);
+	}
+}
+
+ZTEST(crc_perf, test_crc32_ieee)
+{
+	bench_all_sizes(BENCH_CRC32_IEEE, "crc32_ieee");
+}
+
+ZTEST(crc_perf, test_crc32_c)
+{
+	bench_all_sizes(BENCH_CRC32_C, "crc32_c");
+}
+
+ZTEST(crc_perf, test_crc16_ccitt)
+{
+	bench_all_sizes(BENCH_CRC16_CCITT, "crc16_ccitt");
+}
+
+ZTEST(crc_perf, test_crc16_itu_t)
+{
+	bench_all_sizes(BENCH_CRC16_ITU_T, "crc16_itu_t");
+}
+
+static void *crc_perf_setup(void)
+{
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 31U + 7U);
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void crc_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(crc_perf, NULL, crc_perf_setup, NULL, NULL, crc_perf_teardown);
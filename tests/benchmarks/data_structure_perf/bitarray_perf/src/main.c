@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/timing/timing.h>
+
+/* As many blocks as a large sys_mem_blocks pool */
+#define NUM_BITS   65536
+#define ITERATIONS 256
+
+SYS_BITARRAY_DEFINE_STATIC(ba, NUM_BITS);
+
+static void report(const char *metric, const char *desc, timing_t *start, timing_t *end)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("REC: %s - %s:%llu ns\n", metric, desc,
+		 (unsigned long long)(ns / ITERATIONS));
+}
+
+static void bench_alloc_free(const char *metric, const char *desc, size_t num_bits)
+{
+	timing_t start;
+	timing_t end;
+	size_t offset;
+	int ret;
+
+	start = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		ret = sys_bitarray_alloc(&ba, num_bits, &offset);
+		zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+		ret = sys_bitarray_free(&ba, num_bits, offset);
+		zassert_equal(ret, 0, "sys_bitarray_free() failed: %d", ret);
+	}
+	end = timing_counter_get();
+
+	report(metric, desc, &start, &end);
+}
+
+ZTEST(bitarray_perf, test_alloc_mostly_full)
+{
+	/* Only the last 1024 blocks are free */
+	zassert_equal(sys_bitarray_set_region(&ba, NUM_BITS - 1024, 0), 0);
+
+	bench_alloc_free("alloc.full.1", "alloc/free 1 block, 64K blocks mostly full", 1);
+	bench_alloc_free("alloc.full.16", "alloc/free 16 blocks, 64K blocks mostly full", 16);
+}
+
+ZTEST(bitarray_perf, test_alloc_fragmented)
+{
+	/* A free block every 64 blocks, then 1024 free blocks */
+	zassert_equal(sys_bitarray_set_region(&ba, NUM_BITS - 1024, 0), 0);
+	for (size_t i = 0; i < NUM_BITS - 1024; i += 64) {
+		zassert_equal(sys_bitarray_clear_bit(&ba, i), 0);
+	}
+
+	bench_alloc_free("alloc.frag.16", "alloc/free 16 blocks, 64K blocks fragmented", 16);
+}
+
+ZTEST(bitarray_perf, test_alloc_empty)
+{
+	bench_alloc_free("alloc.empty.16", "alloc/free 16 blocks, 64K blocks free", 16);
+}
+
+ZTEST(bitarray_perf, test_find_nth_set_sparse)
+{
+	timing_t start;
+	timing_t end;
+	size_t found_at;
+	int ret;
+
+	zassert_equal(sys_bitarray_set_bit(&ba, 100), 0);
+	zassert_equal(sys_bitarray_set_bit(&ba, NUM_BITS - 3), 0);
+
+	start = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		ret = sys_bitarray_find_nth_set(&ba, 2, NUM_BITS, 0, &found_at);
+		zassert_equal(ret, 0, "sys_bitarray_find_nth_set() failed: %d", ret);
+	}
+	end = timing_counter_get();
+
+	zassert_equal(found_at, NUM_BITS - 3);
+	report("find_nth_set.sparse", "find 2nd set bit, 64K blocks sparse", &start, &end);
+}
+
+static void *bitarray_perf_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void bitarray_perf_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_equal(sys_bitarray_clear_region(&ba, NUM_BITS, 0), 0);
+}
+
+static void bitarray_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(bitarray_perf, NULL, bitarray_perf_setup, bitarray_perf_before, NULL,
+	    bitarray_perf_teardown);
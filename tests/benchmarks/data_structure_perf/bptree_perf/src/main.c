@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/bptree.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/rb.h>
+#include <zephyr/timing/timing.h>
+
+#define NUM_ENTRIES 1024
+/* Key distance covering about 16 entries */
+#define RANGE_SPAN  ((UINT32_MAX / NUM_ENTRIES) * 16)
+#define NUM_RANGES  64
+
+struct entry {
+	struct rbnode rb_node;
+	sys_dnode_t dnode;
+	uint64_t key;
+};
+
+static struct entry entries[NUM_ENTRIES];
+
+SYS_BPTREE_DEFINE(bptree, SYS_BPTREE_POOL_SIZE(NUM_ENTRIES));
+
+static bool entry_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct entry, rb_node)->key <
+	       CONTAINER_OF(b, struct entry, rb_node)->key;
+}
+
+static struct rbtree rbtree = {
+	.lessthan_fn = entry_lessthan,
+};
+
+static sys_dlist_t dlist = SYS_DLIST_STATIC_INIT(&dlist);
+
+static void bptree_insert(struct entry *e)
+{
+	zassert_ok(sys_bptree_insert(&bptree, e->key, e));
+}
+
+static bool bptree_find(uint64_t key)
+{
+	return sys_bptree_get(&bptree, key, NULL);
+}
+
+static size_t bptree_range(uint64_t from, uint64_t to)
+{
+	struct sys_bptree_iter it;
+	uint64_t key;
+	void *value;
+	size_t count = 0;
+
+	SYS_BPTREE_FOR_EACH_RANGE(&bptree, it, from, to, key, value) {
+		count++;
+	}
+
+	return count;
+}
+
+static void bptree_remove(struct entry *e)
+{
+	zassert_true(sys_bptree_remove(&bptree, e->key, NULL));
+}
+
+static void rbtree_insert(struct entry *e)
+{
+	rb_insert(&rbtree, &e->rb_node);
+}
+
+static bool rbtree_find(uint64_t key)
+{
+	struct rbnode *node = rbtree.root;
+
+	while (node != NULL) {
+		uint64_t node_key = CONTAINER_OF(node, struct entry, rb_node)->key;
+
+		if (node_key == key) {
+			return true;
+		}
+
+		node = z_rb_child(node, key > node_key);
+	}
+
+	return false;
+}
+
+/* The red/black tree cannot start iterating from a key, so skip to it */
+static size_t rbtree_range(uint64_t from, uint64_t to)
+{
+	struct entry *e;
+	size_t count = 0;
+
+	RB_FOR_EACH_CONTAINER(&rbtree, e, rb_node) {
+		if (e->key >= to) {
+			break;
+		}
+
+		if (e->key >= from) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static void rbtree_remove(struct entry *e)
+{
+	rb_remove(&rbtree, &e->rb_node);
+}
+
+static void dlist_insert(struct entry *e)
+{
+	struct entry *pos;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&dlist, pos, dnode) {
+		if (pos->key > e->key) {
+			sys_dlist_insert(&pos->dnode, &e->dnode);
+			return;
+		}
+	}
+
+	sys_dlist_append(&dlist, &e->dnode);
+}
+
+static bool dlist_find(uint64_t key)
+{
+	struct entry *e;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&dlist, e, dnode) {
+		if (e->key >= key) {
+			return e->key == key;
+		}
+	}
+
+	return false;
+}
+
+static size_t dlist_range(uint64_t from, uint64_t to)
+{
+	struct entry *e;
+	size_t count = 0;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&dlist, e, dnode) {
+		if (e->key >= to) {
+			break;
+		}
+
+		if (e->key >= from) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static void dlist_remove(struct entry *e)
+{
+	sys_dlist_remove(&e->dnode);
+}
+
+static const struct container_ops {
+	const char *name;
+	void (*insert)(struct entry *e);
+	bool (*find)(uint64_t key);
+	size_t (*range)(uint64_t from, uint64_t to);
+	void (*remove)(struct entry *e);
+} containers[] = {
+	{ "bptree", bptree_insert, bptree_find, bptree_range, bptree_remove },
+	{ "rbtree", rbtree_insert, rbtree_find, rbtree_range, rbtree_remove },
+	{ "dlist", dlist_insert, dlist_find, dlist_range, dlist_remove },
+};
+
+static void report(const char *op, const char *container, const char *desc, timing_t *start,
+		   timing_t *end, uint32_t n_ops)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("REC: ordered_set.%s.%s - %s, %s:%llu ns\n", op, container, desc, container,
+		 (unsigned long long)(ns / n_ops));
+}
+
+static void fill(const struct container_ops *c)
+{
+	ARRAY_FOR_EACH(entries, i) {
+		c->insert(&entries[i]);
+	}
+}
+
+ZTEST(bptree_perf, test_insert)
+{
+	timing_t start;
+	timing_t end;
+
+	ARRAY_FOR_EACH(containers, i) {
+		start = timing_counter_get();
+		fill(&containers[i]);
+		end = timing_counter_get();
+
+		report("insert", containers[i].name, "insert 1024 keys in random order", &start,
+		       &end, NUM_ENTRIES);
+	}
+}
+
+ZTEST(bptree_perf, test_find)
+{
+	timing_t start;
+	timing_t end;
+
+	ARRAY_FOR_EACH(containers, i) {
+		fill(&containers[i]);
+
+		start = timing_counter_get();
+		ARRAY_FOR_EACH(entries, j) {
+			zassert_true(containers[i].find(entries[j].key));
+		}
+		end = timing_counter_get();
+
+		report("find", containers[i].name, "look up present keys", &start, &end,
+		       NUM_ENTRIES);
+	}
+}
+
+ZTEST(bptree_perf, test_range)
+{
+	timing_t start;
+	timing_t end;
+	size_t count;
+
+	ARRAY_FOR_EACH(containers, i) {
+		fill(&containers[i]);
+
+		count = 0;
+		start = timing_counter_get();
+		for (uint64_t j = 0; j < NUM_RANGES; j++) {
+			uint64_t from = j * (UINT32_MAX / NUM_RANGES);
+
+			count += containers[i].range(from, from + RANGE_SPAN);
+		}
+		end = timing_counter_get();
+
+		zassert_true(count > 0);
+		report("range", containers[i].name, "visit the keys of a range of 16 keys", &start,
+		       &end, NUM_RANGES);
+	}
+}
+
+ZTEST(bptree_perf, test_remove)
+{
+	timing_t start;
+	timing_t end;
+
+	ARRAY_FOR_EACH(containers, i) {
+		fill(&containers[i]);
+
+		start = timing_counter_get();
+		ARRAY_FOR_EACH(entries, j) {
+			containers[i].remove(&entries[j]);
+		}
+		end = timing_counter_get();
+
+		report("remove", containers[i].name, "remove all keys", &start, &end,
+		       NUM_ENTRIES);
+	}
+}
+
+static void *bptree_perf_setup(void)
+{
+	/* Distinct keys spread over 32 bits in a scrambled order */
+	ARRAY_FOR_EACH(entries, i) {
+		entries[i].key = (uint32_t)((i + 1) * 2654435761U);
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void bptree_perf_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Empty the containers for the next test */
+	ARRAY_FOR_EACH(entries, i) {
+		(void)sys_bptree_remove(&bptree, entries[i].key, NULL);
+
+		if (sys_dnode_is_linked(&entries[i].dnode)) {
+			sys_dlist_remove(&entries[i].dnode);
+		}
+	}
+
+	rbtree.root = NULL;
+}
+
+static void bptree_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(bptree_perf, NULL, bptree_perf_setup, NULL, bptree_perf_after,
+	    bptree_perf_teardown);
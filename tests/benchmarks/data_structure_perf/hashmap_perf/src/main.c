@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/timing/timing.h>
+
+#define NUM_ENTRIES 1024
+
+SYS_HASHMAP_SC_DEFINE_STATIC(sc_map);
+SYS_HASHMAP_OA_LP_DEFINE_STATIC(oa_lp_map);
+SYS_HASHMAP_OA_RH_DEFINE_STATIC(oa_rh_map);
+
+/* Tables that only grow once 90% of the buckets are used */
+SYS_HASHMAP_OA_LP_DEFINE_STATIC_ADVANCED(oa_lp_90_map, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,
+					  SYS_HASHMAP_CONFIG(SIZE_MAX, 90));
+SYS_HASHMAP_OA_RH_DEFINE_STATIC_ADVANCED(oa_rh_90_map, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,
+					  SYS_HASHMAP_CONFIG(SIZE_MAX, 90));
+
+static const struct {
+	const char *name;
+	struct sys_hashmap *map;
+} maps[] = {
+	{ "sc", &sc_map },
+	{ "oa_lp", &oa_lp_map },
+	{ "oa_rh", &oa_rh_map },
+	{ "oa_lp.lf90", &oa_lp_90_map },
+	{ "oa_rh.lf90", &oa_rh_90_map },
+};
+
+static void report(const char *op, const char *map, const char *desc, timing_t *start,
+		   timing_t *end)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("REC: hashmap.%s.%s - %s, %s:%llu ns\n", op, map, desc, map,
+		 (unsigned long long)(ns / NUM_ENTRIES));
+}
+
+static void fill(struct sys_hashmap *map)
+{
+	for (uint64_t key = 0; key < NUM_ENTRIES; key++) {
+		zassert_equal(sys_hashmap_insert(map, key, key, NULL), 1);
+	}
+}
+
+ZTEST(hashmap_perf, test_insert)
+{
+	timing_t start;
+	timing_t end;
+	int ret;
+
+	ARRAY_FOR_EACH(maps, i) {
+		start = timing_counter_get();
+		for (uint64_t key = 0; key < NUM_ENTRIES; key++) {
+			ret = sys_hashmap_insert(maps[i].map, key, key, NULL);
+			zassert_equal(ret, 1, "sys_hashmap_insert() failed: %d", ret);
+		}
+		end = timing_counter_get();
+
+		report("insert", maps[i].name, "insert 1024 keys into an empty map", &start, &end);
+	}
+}
+
+ZTEST(hashmap_perf, test_get_hit)
+{
+	timing_t start;
+	timing_t end;
+	uint64_t value;
+
+	ARRAY_FOR_EACH(maps, i) {
+		fill(maps[i].map);
+
+		start = timing_counter_get();
+		for (uint64_t key = 0; key < NUM_ENTRIES; key++) {
+			zassert_true(sys_hashmap_get(maps[i].map, key, &value));
+		}
+		end = timing_counter_get();
+
+		report("get.hit", maps[i].name, "look up present keys", &start, &end);
+	}
+}
+
+ZTEST(hashmap_perf, test_get_miss)
+{
+	timing_t start;
+	timing_t end;
+
+	ARRAY_FOR_EACH(maps, i) {
+		fill(maps[i].map);
+
+		start = timing_counter_get();
+		for (uint64_t key = NUM_ENTRIES; key < 2 * NUM_ENTRIES; key++) {
+			zassert_false(sys_hashmap_get(maps[i].map, key, NULL));
+		}
+		end = timing_counter_get();
+
+		report("get.miss", maps[i].name, "look up absent keys", &start, &end);
+	}
+}
+
+ZTEST(hashmap_perf, test_remove)
+{
+	timing_t start;
+	timing_t end;
+
+	ARRAY_FOR_EACH(maps, i) {
+		fill(maps[i].map);
+
+		start = timing_counter_get();
+		for (uint64_t key = 0; key < NUM_ENTRIES; key++) {
+			zassert_true(sys_hashmap_remove(maps[i].map, key, NULL));
+		}
+		end = timing_counter_get();
+
+		report("remove", maps[i].name, "remove all keys", &start, &end);
+	}
+}
+
+ZTEST(hashmap_perf, test_churn)
+{
+	timing_t start;
+	timing_t end;
+	uint64_t value;
+
+	ARRAY_FOR_EACH(maps, i) {
+		fill(maps[i].map);
+
+		/* Slide a window of live keys, as a connection or session table would */
+		start = timing_counter_get();
+		for (uint64_t key = 0; key < NUM_ENTRIES; key++) {
+			zassert_true(sys_hashmap_remove(maps[i].map, key, NULL));
+			/* the linear probe map reports a reused tombstone as an update */
+			zassert_true(sys_hashmap_insert(maps[i].map, key + NUM_ENTRIES, key, NULL) >= 0);
+			zassert_true(sys_hashmap_get(maps[i].map, key + NUM_ENTRIES / 2, &value));
+		}
+		end = timing_counter_get();
+
+		report("churn", maps[i].name, "remove, insert and look up a key", &start, &end);
+	}
+}
+
+static void *hashmap_perf_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void hashmap_perf_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	ARRAY_FOR_EACH(maps, i) {
+		sys_hashmap_clear(maps[i].map, NULL, NULL);
+	}
+}
+
+static void hashmap_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(hashmap_perf, NULL, hashmap_perf_setup, NULL, hashmap_perf_after,
+	    hashmap_perf_teardown);
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/min_heap.h>
+#include <zephyr/sys/rb.h>
+#include <zephyr/timing/timing.h>
+
+#define NUM_TIMERS 1024
+#define NUM_OPS    4096
+
+struct timer {
+	struct rbnode rb_node;
+	uint32_t expiry;
+	size_t heap_index;
+};
+
+static struct timer timers[NUM_TIMERS];
+static struct timer *timer_ptrs[NUM_TIMERS];
+static uint32_t rand_state;
+
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1664525U + 1013904223U;
+
+	return rand_state >> 8;
+}
+
+static int timer_cmp(const void *a, const void *b)
+{
+	const struct timer *ta = *(struct timer *const *)a;
+	const struct timer *tb = *(struct timer *const *)b;
+
+	return (ta->expiry > tb->expiry) - (ta->expiry < tb->expiry);
+}
+
+static void timer_track(void *node, size_t index)
+{
+	(*(struct timer **)node)->heap_index = index;
+}
+
+MIN_HEAP_DEFINE_STATIC(heap, NUM_TIMERS, sizeof(struct timer *), __alignof__(struct timer *),
+		       timer_cmp);
+
+/* Break ties on the address, as rb_remove() needs a strict order */
+static bool timer_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	const struct timer *ta = CONTAINER_OF(a, struct timer, rb_node);
+	const struct timer *tb = CONTAINER_OF(b, struct timer, rb_node);
+
+	return ta->expiry < tb->expiry || (ta->expiry == tb->expiry && ta < tb);
+}
+
+static struct rbtree rbtree = {
+	.lessthan_fn = timer_lessthan,
+};
+
+static void heap_insert(struct timer *t)
+{
+	zassert_ok(min_heap_push(&heap, &t));
+}
+
+static void heap_insert_all(void)
+{
+	zassert_ok(min_heap_push_bulk(&heap, timer_ptrs, NUM_TIMERS));
+}
+
+static struct timer *heap_pop_min(void)
+{
+	struct timer *t;
+
+	zassert_true(min_heap_pop(&heap, &t));
+
+	return t;
+}
+
+static void heap_update(struct timer *t, uint32_t expiry)
+{
+	t->expiry = expiry;
+	zassert_true(min_heap_update(&heap, t->heap_index));
+}
+
+static void heap_remove(struct timer *t)
+{
+	struct timer *removed;
+
+	zassert_true(min_heap_remove(&heap, t->heap_index, &removed));
+}
+
+static void rbtree_insert(struct timer *t)
+{
+	rb_insert(&rbtree, &t->rb_node);
+}
+
+static struct timer *rbtree_pop_min(void)
+{
+	struct rbnode *node = rb_get_min(&rbtree);
+
+	rb_remove(&rbtree, node);
+
+	return CONTAINER_OF(node, struct timer, rb_node);
+}
+
+static void rbtree_update(struct timer *t, uint32_t expiry)
+{
+	rb_remove(&rbtree, &t->rb_node);
+	t->expiry = expiry;
+	rb_insert(&rbtree, &t->rb_node);
+}
+
+static void rbtree_remove(struct timer *t)
+{
+	rb_remove(&rbtree, &t->rb_node);
+}
+
+static const struct queue_ops {
+	const char *name;
+	void (*insert)(struct timer *t);
+	struct timer *(*pop_min)(void);
+	void (*update)(struct timer *t, uint32_t expiry);
+	void (*remove)(struct timer *t);
+} queues[] = {
+	{ "min_heap", heap_insert, heap_pop_min, heap_update, heap_remove },
+	{ "rbtree", rbtree_insert, rbtree_pop_min, rbtree_update, rbtree_remove },
+};
+
+static void report(const char *op, const char *queue, const char *desc, timing_t *start,
+		   timing_t *end, uint32_t n_ops)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("REC: priority_queue.%s.%s - %s, %s:%llu ns\n", op, queue, desc, queue,
+		 (unsigned long long)(ns / n_ops));
+}
+
+static void fill(const struct queue_ops *q)
+{
+	ARRAY_FOR_EACH(timers, i) {
+		q->insert(&timers[i]);
+	}
+}
+
+ZTEST(min_heap_perf, test_insert)
+{
+	timing_t start;
+	timing_t end;
+
+	ARRAY_FOR_EACH(queues, i) {
+		start = timing_counter_get();
+		fill(&queues[i]);
+		end = timing_counter_get();
+
+		report("insert", queues[i].name, "insert 1024 timers one by one", &start, &end,
+		       NUM_TIMERS);
+	}
+
+	heap.size = 0;
+
+	start = timing_counter_get();
+	heap_insert_all();
+	end = timing_counter_get();
+
+	report("insert", "min_heap_bulk", "insert 1024 timers at once", &start, &end,
+	       NUM_TIMERS);
+}
+
+/* Classic hold model: expire the earliest timer and rearm it later */
+ZTEST(min_heap_perf, test_hold)
+{
+	timing_t start;
+	timing_t end;
+	struct timer *t;
+
+	ARRAY_FOR_EACH(queues, i) {
+		fill(&queues[i]);
+
+		start = timing_counter_get();
+		for (uint32_t j = 0; j < NUM_OPS; j++) {
+			t = queues[i].pop_min();
+			t->expiry += next_rand() % NUM_TIMERS;
+			queues[i].insert(t);
+		}
+		end = timing_counter_get();
+
+		report("hold", queues[i].name, "pop the earliest timer and rearm it", &start,
+		       &end, NUM_OPS);
+	}
+}
+
+ZTEST(min_heap_perf, test_decrease_key)
+{
+	timing_t start;
+	timing_t end;
+	struct timer *t;
+
+	ARRAY_FOR_EACH(queues, i) {
+		fill(&queues[i]);
+
+		start = timing_counter_get();
+		for (uint32_t j = 0; j < NUM_OPS; j++) {
+			t = &timers[next_rand() % NUM_TIMERS];
+			queues[i].update(t, t->expiry - MIN(t->expiry, next_rand() % NUM_TIMERS));
+		}
+		end = timing_counter_get();
+
+		report("decrease_key", queues[i].name, "move a timer earlier", &start, &end,
+		       NUM_OPS);
+	}
+}
+
+ZTEST(min_heap_perf, test_remove)
+{
+	timing_t start;
+	timing_t end;
+
+	ARRAY_FOR_EACH(queues, i) {
+		fill(&queues[i]);
+
+		start = timing_counter_get();
+		for (size_t j = 0; j < NUM_TIMERS; j++) {
+			/* Cancel timers in a scrambled order */
+			queues[i].remove(&timers[(j * 617) % NUM_TIMERS]);
+		}
+		end = timing_counter_get();
+
+		report("remove", queues[i].name, "cancel a timer", &start, &end, NUM_TIMERS);
+	}
+}
+
+static void *min_heap_perf_setup(void)
+{
+	min_heap_set_index_cb(&heap, timer_track);
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void min_heap_perf_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	rand_state = 1;
+
+	ARRAY_FOR_EACH(timers, i) {
+		timers[i].expiry = next_rand();
+		timer_ptrs[i] = &timers[i];
+	}
+}
+
+static void min_heap_perf_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	heap.size = 0;
+	rbtree.root = NULL;
+}
+
+static void min_heap_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(min_heap_perf, NULL, min_heap_perf_setup, min_heap_perf_before, min_heap_perf_after,
+	    min_heap_perf_teardown);
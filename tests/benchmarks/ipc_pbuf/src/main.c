@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/ipc/pbuf.h>
+#include <zephyr/timing/timing.h>
+
+#define MEM_AREA_SZ 4096
+#define MESSAGES    10000
+#define HDR_SZ      4
+
+static char memory_area[MEM_AREA_SZ] __aligned(32);
+
+static PBUF_MAYBE_CONST struct pbuf_cfg cfg = PBUF_CFG_INIT(memory_area, MEM_AREA_SZ, 0, 0);
+
+static struct pbuf pb = {
+	.cfg = &cfg,
+};
+
+static const uint16_t payload_sizes[] = { 16, 256, 1024 };
+
+static char hdr[HDR_SZ];
+static char payload[1024];
+/* Where a sender assembles a message, or a receiver copies it to */
+static char msg_buf[HDR_SZ + sizeof(payload)] __aligned(4);
+static volatile uint32_t sink;
+
+static void report(const char *metric, uint16_t size, const char *desc, timing_t *start,
+		   timing_t *end)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("REC: pbuf.%s.%u - %s, %u byte payload:%llu ns\n", metric, size, desc, size,
+		 (unsigned long long)(ns / MESSAGES));
+}
+
+static void send_copy(uint16_t size)
+{
+	memcpy(msg_buf, hdr, HDR_SZ);
+	memcpy(&msg_buf[HDR_SZ], payload, size);
+	zassert_equal(pbuf_write(&pb, msg_buf, HDR_SZ + size), HDR_SZ + size);
+}
+
+static void send_writev(uint16_t size)
+{
+	const struct pbuf_iovec iov[] = {
+		{ .buf = hdr, .len = HDR_SZ },
+		{ .buf = payload, .len = size },
+	};
+
+	zassert_equal(pbuf_writev(&pb, iov, ARRAY_SIZE(iov)), HDR_SZ + size);
+}
+
+static void receive_read(void)
+{
+	int len = pbuf_read(&pb, msg_buf, sizeof(msg_buf));
+
+	zassert_true(len > 0);
+	sink += msg_buf[len - 1];
+}
+
+static void receive_claim(void)
+{
+	char *buf;
+	int len = pbuf_claim(&pb, &buf);
+
+	zassert_true(len > 0);
+	if (buf != NULL) {
+		sink += buf[len - 1];
+		pbuf_release(&pb, len);
+	} else {
+		/* The message wraps around the end of the buffer */
+		zassert_equal(pbuf_read(&pb, msg_buf, sizeof(msg_buf)), len);
+		sink += msg_buf[len - 1];
+	}
+}
+
+static void run(const char *metric, const char *desc, void (*send)(uint16_t size),
+		void (*receive)(void))
+{
+	timing_t start;
+	timing_t end;
+
+	ARRAY_FOR_EACH(payload_sizes, i) {
+		zassert_ok(pbuf_tx_init(&pb));
+
+		start = timing_counter_get();
+		for (int j = 0; j < MESSAGES; j++) {
+			send(payload_sizes[i]);
+			receive();
+		}
+		end = timing_counter_get();
+
+		report(metric, payload_sizes[i], desc, &start, &end);
+	}
+}
+
+ZTEST(ipc_pbuf, test_copy)
+{
+	run("copy", "assemble message, write and read", send_copy, receive_read);
+}
+
+ZTEST(ipc_pbuf, test_writev)
+{
+	run("writev", "gather message and read", send_writev, receive_read);
+}
+
+ZTEST(ipc_pbuf, test_zero_copy)
+{
+	run("zero_copy", "gather message and claim", send_writev, receive_claim);
+}
+
+static void *ipc_pbuf_setup(void)
+{
+	memset(payload, 0x5a, sizeof(payload));
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void ipc_pbuf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(ipc_pbuf, NULL, ipc_pbuf_setup, NULL, NULL, ipc_pbuf_teardown);
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/ztest.h>
+#include <zephyr/data/json.h>
+#include <zephyr/timing/timing.h>
+
+#define RECORDS    32
+#define CHUNK_SIZE 64
+#define ITERATIONS 32
+#define FIELDS     48
+
+struct record {
+	const char *n;
+	const char *u;
+	int32_t v;
+	bool ok;
+};
+
+struct document {
+	const char *device;
+	struct record records[RECORDS];
+	size_t records_len;
+};
+
+static const struct json_obj_descr record_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct record, n, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct record, u, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct record, v, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct record, ok, JSON_TOK_TRUE),
+};
+
+static const struct json_obj_descr document_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct document, device, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct document, records, RECORDS, records_len, record_descr,
+				 ARRAY_SIZE(record_descr)),
+};
+
+#define WIDE_FIELD(i, _)	int32_t field_##i
+#define WIDE_FIELD_DESCR(i, _)	JSON_OBJ_DESCR_PRIM(struct wide, field_##i, JSON_TOK_NUMBER)
+
+/* Object with many fields, as found in REST APIs */
+struct wide {
+	LISTIFY(FIELDS, WIDE_FIELD, (;));
+};
+
+static const struct json_obj_descr wide_descr[] = {
+	LISTIFY(FIELDS, WIDE_FIELD_DESCR, (,)),
+};
+
+static char json[RECORDS * 64 + 64];
+static char work[sizeof(json)];
+static size_t json_len;
+
+static char wide_json[FIELDS * 20];
+static char wide_json_reversed[sizeof(wide_json)];
+static size_t wide_len;
+
+static uint32_t tape_entries[RECORDS * 10 + 8];
+static char tape_strings[sizeof(json)];
+static char token_buf[64];
+
+static timing_t start_time;
+
+static void bench_start(void)
+{
+	start_time = timing_counter_get();
+}
+
+static void bench_end(const char *metric, const char *desc, size_t bytes)
+{
+	timing_t end_time = timing_counter_get();
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(&start_time, &end_time));
+	uint64_t kbps;
+
+	kbps = (ns == 0U) ? 0U : ((uint64_t)bytes * ITERATIONS * NSEC_PER_SEC) / (ns * 1024U);
+
+	TC_PRINT("REC: %s - %s:%llu KB/s\n", metric, desc, (unsigned long long)kbps);
+}
+
+static int count_token(const struct json_stream_token *tok, void *user_data)
+{
+	size_t *count = user_data;
+
+	ARG_UNUSED(tok);
+	(*count)++;
+
+	return 0;
+}
+
+static int stream_parse(size_t chunk, char *buf, size_t buf_size, json_stream_cb_t cb,
+			void *user_data)
+{
+	struct json_stream_parser parser;
+	int ret;
+
+	json_stream_init(&parser, buf, buf_size, cb, user_data);
+
+	for (size_t off = 0; off < json_len; off += chunk) {
+		ret = json_stream_feed(&parser, json + off, MIN(chunk, json_len - off));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_stream_finish(&parser);
+}
+
+ZTEST(json_perf, test_obj_parse)
+{
+	struct document doc;
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		/* json_obj_parse() modifies its input */
+		memcpy(work, json, json_len);
+		zassert_equal(json_obj_parse(work, json_len, document_descr,
+					     ARRAY_SIZE(document_descr), &doc),
+			      BIT_MASK(ARRAY_SIZE(document_descr)));
+	}
+	bench_end("json.obj_parse", "json_obj_parse() of the whole document", json_len);
+
+	zassert_equal(doc.records_len, RECORDS);
+}
+
+static void wide_parse(const char *wide, const char *desc)
+{
+	struct wide obj;
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		memcpy(work, wide, wide_len);
+		zassert_equal(json_obj_parse(work, wide_len, wide_descr, ARRAY_SIZE(wide_descr),
+					     &obj),
+			      BIT64_MASK(FIELDS));
+	}
+	bench_end("json.obj_parse.wide", desc, wide_len);
+
+	zassert_equal(obj.field_47, 47);
+}
+
+ZTEST(json_perf, test_obj_parse_wide)
+{
+	wide_parse(wide_json, "json_obj_parse() of 48 fields in order");
+	wide_parse(wide_json_reversed, "json_obj_parse() of 48 fields in reverse order");
+}
+
+ZTEST(json_perf, test_obj_encode)
+{
+	struct document doc = {
+		.device = "sensor-01",
+		.records_len = RECORDS,
+	};
+
+	for (int i = 0; i < RECORDS; i++) {
+		doc.records[i] = (struct record){ .n = "temperature", .u = "Cel", .v = i, .ok = true };
+	}
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		zassert_ok(json_obj_encode_buf(document_descr, ARRAY_SIZE(document_descr), &doc,
+					       work, sizeof(work)));
+	}
+	bench_end("json.obj_encode", "json_obj_encode_buf() of the whole document", json_len);
+
+	zassert_mem_equal(work, json, json_len + 1);
+}
+
+ZTEST(json_perf, test_obj_encode_wide)
+{
+	struct wide obj;
+
+	memcpy(work, wide_json, wide_len);
+	zassert_equal(json_obj_parse(work, wide_len, wide_descr, ARRAY_SIZE(wide_descr), &obj),
+		      BIT64_MASK(FIELDS));
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		zassert_ok(json_obj_encode_buf(wide_descr, ARRAY_SIZE(wide_descr), &obj, work,
+					       sizeof(work)));
+	}
+	bench_end("json.obj_encode.wide", "json_obj_encode_buf() of 48 fields", wide_len);
+
+	zassert_mem_equal(work, wide_json, wide_len + 1);
+}
+
+ZTEST(json_perf, test_stream_whole)
+{
+	size_t count;
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		count = 0;
+		zassert_ok(stream_parse(json_len, NULL, 0, count_token, &count));
+	}
+	bench_end("json.stream.whole", "json_stream_feed() of the whole document", json_len);
+
+	zassert_equal(count, RECORDS * 6 + 5);
+}
+
+ZTEST(json_perf, test_stream_chunked)
+{
+	size_t count;
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		count = 0;
+		zassert_ok(stream_parse(CHUNK_SIZE, token_buf, sizeof(token_buf), count_token,
+					&count));
+	}
+	bench_end("json.stream.chunked", "json_stream_feed() in 64 byte chunks", json_len);
+
+	zassert_equal(count, RECORDS * 6 + 5);
+}
+
+ZTEST(json_perf, test_stream_tape)
+{
+	struct json_tape tape;
+	size_t records, rec, v;
+	char expected[12];
+
+	bench_start();
+	for (int i = 0; i < ITERATIONS; i++) {
+		json_tape_init(&tape, tape_entries, ARRAY_SIZE(tape_entries), tape_strings,
+			       sizeof(tape_strings));
+		zassert_ok(stream_parse(CHUNK_SIZE, token_buf, sizeof(token_buf),
+					json_tape_stream_cb, &tape));
+	}
+	bench_end("json.stream.tape", "tape of 64 byte chunks", json_len);
+
+	zassert_ok(json_tape_obj_get(&tape, 0, "records", &records));
+	zassert_ok(json_tape_arr_get(&tape, records, RECORDS - 1, &rec));
+	zassert_ok(json_tape_obj_get(&tape, rec, "v", &v));
+	snprintf(expected, sizeof(expected), "%d", RECORDS - 1);
+	zassert_str_equal(json_tape_str(&tape, v), expected);
+}
+
+static void *json_perf_setup(void)
+{
+	int len;
+
+	len = snprintf(json, sizeof(json), "{\"device\":\"sensor-01\",\"records\":[");
+	for (int i = 0; i < RECORDS; i++) {
+		len += snprintf(json + len, sizeof(json) - len,
+				"%s{\"n\":\"temperature\",\"u\":\"Cel\",\"v\":%d,\"ok\":true}",
+				i > 0 ? "," : "", i);
+	}
+	len += snprintf(json + len, sizeof(json) - len, "]}");
+	zassert_true(len < sizeof(json));
+	json_len = len;
+
+	len = 0;
+	for (int i = 0; i < FIELDS; i++) {
+		len += snprintf(wide_json + len, sizeof(wide_json) - len, "%c\"field_%d\":%d",
+				i > 0 ? ',' : '{', i, i);
+	}
+	len += snprintf(wide_json + len, sizeof(wide_json) - len, "}");
+	zassert_true(len < sizeof(wide_json));
+	wide_len = len;
+
+	len = 0;
+	for (int i = FIELDS - 1; i >= 0; i--) {
+		len += snprintf(wide_json_reversed + len, sizeof(wide_json_reversed) - len,
+				"%c\"field_%d\":%d", i < FIELDS - 1 ? ',' : '{', i, i);
+	}
+	snprintf(wide_json_reversed + len, sizeof(wide_json_reversed) - len, "}");
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void json_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(json_perf, NULL, json_perf_setup, NULL, NULL, json_perf_teardown);
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mpmc_lockfree.h>
+#include <zephyr/timing/timing.h>
+
+#define QUEUE_SIZE  16
+#define MESSAGES    10000
+#define PRODUCERS   2
+#define CONSUMERS   2
+#define THREADS     (PRODUCERS + CONSUMERS)
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct msg {
+	uint32_t producer;
+	uint32_t seq;
+};
+
+struct fifo_msg {
+	void *fifo_reserved;
+	struct msg msg;
+};
+
+MPMC_BLOCKING_DEFINE(mpmc_q, sizeof(struct msg), QUEUE_SIZE);
+K_MSGQ_DEFINE(msgq, sizeof(struct msg), QUEUE_SIZE, 4);
+K_FIFO_DEFINE(fifo);
+K_FIFO_DEFINE(free_fifo);
+
+static struct fifo_msg fifo_msgs[QUEUE_SIZE];
+
+static void mpmc_put(const struct msg *msg)
+{
+	(void)mpmc_blocking_push(&mpmc_q, msg, K_FOREVER);
+}
+
+static void mpmc_get(struct msg *msg)
+{
+	(void)mpmc_blocking_pop(&mpmc_q, msg, K_FOREVER);
+}
+
+static void msgq_put(const struct msg *msg)
+{
+	(void)k_msgq_put(&msgq, msg, K_FOREVER);
+}
+
+static void msgq_get(struct msg *msg)
+{
+	(void)k_msgq_get(&msgq, msg, K_FOREVER);
+}
+
+/* k_fifo is intrusive, so bound it like the other queues with a free list */
+static void fifo_put(const struct msg *msg)
+{
+	struct fifo_msg *m = k_fifo_get(&free_fifo, K_FOREVER);
+
+	m->msg = *msg;
+	k_fifo_put(&fifo, m);
+}
+
+static void fifo_get(struct msg *msg)
+{
+	struct fifo_msg *m = k_fifo_get(&fifo, K_FOREVER);
+
+	*msg = m->msg;
+	k_fifo_put(&free_fifo, m);
+}
+
+static const struct queue_ops {
+	const char *name;
+	void (*put)(const struct msg *msg);
+	void (*get)(struct msg *msg);
+} queues[] = {
+	{ "mpmc", mpmc_put, mpmc_get },
+	{ "k_msgq", msgq_put, msgq_get },
+	{ "k_fifo", fifo_put, fifo_get },
+};
+
+static struct k_thread threads[THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, THREADS, STACK_SIZE);
+static uint32_t received[CONSUMERS];
+
+static void report(const char *metric, const char *queue, const char *desc, timing_t *start,
+		   timing_t *end, uint32_t messages)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("REC: %s.%s - %s, %s:%llu ns\n", metric, queue, desc, queue,
+		 (unsigned long long)(ns / messages));
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	const struct queue_ops *q = p1;
+	struct msg msg = { .producer = (uint32_t)(uintptr_t)p2 };
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < MESSAGES; i++) {
+		msg.seq = i;
+		q->put(&msg);
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	const struct queue_ops *q = p1;
+	uint32_t id = (uint32_t)(uintptr_t)p2;
+	struct msg msg;
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < MESSAGES * PRODUCERS / CONSUMERS; i++) {
+		q->get(&msg);
+		received[id]++;
+	}
+}
+
+ZTEST(mpmc_queue, test_single_thread)
+{
+	timing_t start;
+	timing_t end;
+	struct msg msg = { 0 };
+
+	ARRAY_FOR_EACH(queues, i) {
+		start = timing_counter_get();
+		for (uint32_t j = 0; j < MESSAGES; j++) {
+			queues[i].put(&msg);
+			queues[i].get(&msg);
+		}
+		end = timing_counter_get();
+
+		report("queue.single", queues[i].name, "put and get from one thread", &start, &end,
+		       MESSAGES);
+	}
+}
+
+ZTEST(mpmc_queue, test_threads)
+{
+	timing_t start;
+	timing_t end;
+
+	ARRAY_FOR_EACH(queues, i) {
+		memset(received, 0, sizeof(received));
+
+		for (int j = 0; j < CONSUMERS; j++) {
+			k_thread_create(&threads[j], stacks[j], STACK_SIZE, consumer,
+					(void *)&queues[i], (void *)(uintptr_t)j, NULL,
+					K_PRIO_PREEMPT(5), 0, K_FOREVER);
+		}
+
+		for (int j = 0; j < PRODUCERS; j++) {
+			k_thread_create(&threads[CONSUMERS + j], stacks[CONSUMERS + j], STACK_SIZE,
+					producer, (void *)&queues[i], (void *)(uintptr_t)j, NULL,
+					K_PRIO_PREEMPT(5), 0, K_FOREVER);
+		}
+
+		start = timing_counter_get();
+		for (int j = 0; j < THREADS; j++) {
+			k_thread_start(&threads[j]);
+		}
+
+		for (int j = 0; j < THREADS; j++) {
+			k_thread_join(&threads[j], K_FOREVER);
+		}
+		end = timing_counter_get();
+
+		for (int j = 0; j < CONSUMERS; j++) {
+			zassert_equal(received[j], MESSAGES * PRODUCERS / CONSUMERS);
+		}
+
+		report("queue.threads", queues[i].name, "2 producers and 2 consumers", &start,
+		       &end, MESSAGES * PRODUCERS);
+	}
+}
+
+static void *mpmc_queue_setup(void)
+{
+	ARRAY_FOR_EACH(fifo_msgs, i) {
+		k_fifo_put(&free_fifo, &fifo_msgs[i]);
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void mpmc_queue_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(mpmc_queue, NULL, mpmc_queue_setup, NULL, NULL, mpmc_queue_teardown);
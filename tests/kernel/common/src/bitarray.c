@@ -890,6 +890,80 @@ ZTEST(bitarray, test_bitarray_find_nth_set)
 		      ret);
 }
 
+/**
+ * @brief Test allocation in a large, mostly allocated bitarray
+ *
+ * Exercises skipping over runs of fully allocated and free bundles.
+ *
+ * @see sys_bitarray_alloc()
+ * @see sys_bitarray_find_nth_set()
+ */
+ZTEST(bitarray, test_bitarray_alloc_large)
+{
+	int ret;
+	size_t offset;
+	size_t found_at;
+
+	/* Bitarrays have embedded spinlocks and can't on the stack. */
+	if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
+		ztest_test_skip();
+	}
+
+	SYS_BITARRAY_DEFINE(ba, 2048);
+
+	/* Allocate everything but a few holes */
+	ret = sys_bitarray_set_region(&ba, ba.num_bits, 0);
+	zassert_equal(ret, 0, "sys_bitarray_set_region() failed: %d", ret);
+	zassert_equal(sys_bitarray_clear_region(&ba, 3, 700), 0);
+	zassert_equal(sys_bitarray_clear_region(&ba, 40, 1500), 0);
+	zassert_equal(sys_bitarray_clear_bit(&ba, 2047), 0);
+
+	ret = sys_bitarray_alloc(&ba, 1, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 700, "sys_bitarray_alloc() offset expected %d, got %d", 700, offset);
+
+	ret = sys_bitarray_alloc(&ba, 4, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 1500, "sys_bitarray_alloc() offset expected %d, got %d", 1500,
+		      offset);
+
+	ret = sys_bitarray_alloc(&ba, 36, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 1504, "sys_bitarray_alloc() offset expected %d, got %d", 1504,
+		      offset);
+
+	ret = sys_bitarray_alloc(&ba, 3, &offset);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc() should fail but not: %d", ret);
+
+	ret = sys_bitarray_alloc(&ba, 1, &offset);
+	zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 701, "sys_bitarray_alloc() offset expected %d, got %d", 701, offset);
+
+	/* Free everything but a few bits */
+	zassert_equal(sys_bitarray_clear_region(&ba, ba.num_bits, 0), 0);
+	zassert_equal(sys_bitarray_set_bit(&ba, 5), 0);
+	zassert_equal(sys_bitarray_set_bit(&ba, 1400), 0);
+	zassert_equal(sys_bitarray_set_bit(&ba, 2046), 0);
+
+	ret = sys_bitarray_find_nth_set(&ba, 2, ba.num_bits, 0, &found_at);
+	zassert_equal(ret, 0, "sys_bitarray_find_nth_set() failed: %d", ret);
+	zassert_equal(found_at, 1400, "sys_bitarray_find_nth_set() expected %d, got %d", 1400,
+		      found_at);
+
+	ret = sys_bitarray_find_nth_set(&ba, 1, 2000, 10, &found_at);
+	zassert_equal(ret, 0, "sys_bitarray_find_nth_set() failed: %d", ret);
+	zassert_equal(found_at, 1400, "sys_bitarray_find_nth_set() expected %d, got %d", 1400,
+		      found_at);
+
+	ret = sys_bitarray_find_nth_set(&ba, 3, ba.num_bits, 0, &found_at);
+	zassert_equal(ret, 0, "sys_bitarray_find_nth_set() failed: %d", ret);
+	zassert_equal(found_at, 2046, "sys_bitarray_find_nth_set() expected %d, got %d", 2046,
+		      found_at);
+
+	ret = sys_bitarray_find_nth_set(&ba, 4, ba.num_bits, 0, &found_at);
+	zassert_equal(ret, 1, "sys_bitarray_find_nth_set() returned unexpected value: %d", ret);
+}
+
 ZTEST(bitarray, test_bitarray_region_set_clear)
 {
 	int ret;
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/bptree.h>
+#include <zephyr/random/random.h>
+
+#define N_KEYS 1000
+
+SYS_BPTREE_DEFINE(tree, SYS_BPTREE_POOL_SIZE(N_KEYS));
+
+static uint8_t present[2 * N_KEYS];
+static size_t n_present;
+
+static void *key_value(uint64_t key)
+{
+	return (void *)(uintptr_t)(key + 1);
+}
+
+/* Check the entries against the reference set, in order and through lookups */
+static void verify_tree(void)
+{
+	struct sys_bptree_iter it;
+	uint64_t prev = 0;
+	uint64_t key;
+	size_t count = 0;
+	void *value;
+
+	zassert_equal(sys_bptree_size(&tree), n_present);
+
+	SYS_BPTREE_FOR_EACH(&tree, it, key, value) {
+		zassert_true(key < ARRAY_SIZE(present) && present[key], "Unexpected key %llu",
+			     (unsigned long long)key);
+		zassert_true(count == 0 || key > prev, "Keys should be visited in order");
+		zassert_equal(value, key_value(key));
+		prev = key;
+		count++;
+	}
+
+	zassert_equal(count, n_present);
+
+	for (key = 0; key < ARRAY_SIZE(present); key++) {
+		zassert_equal(sys_bptree_get(&tree, key, NULL), present[key]);
+	}
+}
+
+static void tree_insert(uint64_t key)
+{
+	int ret = sys_bptree_insert(&tree, key, key_value(key));
+
+	if (present[key]) {
+		zassert_equal(ret, -EEXIST, "Insert of key %llu: %d", (unsigned long long)key, ret);
+	} else {
+		zassert_ok(ret, "Insert of key %llu: %d", (unsigned long long)key, ret);
+		present[key] = 1;
+		n_present++;
+	}
+}
+
+static void tree_remove(uint64_t key)
+{
+	void *value = NULL;
+	bool ret = sys_bptree_remove(&tree, key, &value);
+
+	zassert_equal(ret, present[key], "Remove of key %llu", (unsigned long long)key);
+	if (ret) {
+		zassert_equal(value, key_value(key));
+		present[key] = 0;
+		n_present--;
+	}
+}
+
+ZTEST(bptree, test_empty)
+{
+	struct sys_bptree_iter it;
+
+	zassert_false(sys_bptree_get(&tree, 0, NULL));
+	zassert_false(sys_bptree_remove(&tree, 0, NULL));
+
+	sys_bptree_first(&tree, &it);
+	zassert_false(sys_bptree_iter_next(&it, NULL, NULL));
+
+	sys_bptree_lower_bound(&tree, 0, &it);
+	zassert_false(sys_bptree_iter_next(&it, NULL, NULL));
+}
+
+ZTEST(bptree, test_sequential)
+{
+	for (uint64_t key = 0; key < N_KEYS; key++) {
+		tree_insert(key);
+	}
+
+	verify_tree();
+
+	/* Insert an existing key */
+	tree_insert(N_KEYS / 2);
+
+	for (uint64_t key = 0; key < N_KEYS; key += 2) {
+		tree_remove(key);
+	}
+
+	verify_tree();
+
+	for (uint64_t key = N_KEYS; key > 0; key--) {
+		tree_remove(key - 1);
+	}
+
+	verify_tree();
+}
+
+ZTEST(bptree, test_random)
+{
+	for (int i = 0; i < 20 * N_KEYS; i++) {
+		uint64_t key = sys_rand32_get() % ARRAY_SIZE(present);
+
+		/* Grow to about N_KEYS entries, then shrink back */
+		if ((i < 10 * N_KEYS ? sys_rand32_get() % 3 != 0 : sys_rand32_get() % 3 == 0) &&
+		    n_present < N_KEYS) {
+			tree_insert(key);
+		} else {
+			tree_remove(key);
+		}
+
+		if (i % 1000 == 0) {
+			verify_tree();
+		}
+	}
+
+	verify_tree();
+}
+
+ZTEST(bptree, test_range)
+{
+	struct sys_bptree_iter it;
+	uint64_t key;
+	void *value;
+	uint64_t expected;
+
+	for (key = 0; key < 2 * N_KEYS; key += 10) {
+		tree_insert(key);
+	}
+
+	/* Ranges starting on, between and past the keys */
+	for (uint64_t from = 0; from < 2 * N_KEYS + 10; from += 7) {
+		uint64_t to = from + 95;
+
+		expected = ROUND_UP(from, 10);
+		SYS_BPTREE_FOR_EACH_RANGE(&tree, it, from, to, key, value) {
+			zassert_equal(key, expected);
+			zassert_equal(value, key_value(key));
+			expected += 10;
+		}
+
+		zassert_equal(expected, MAX(ROUND_UP(from, 10), MIN(ROUND_UP(to, 10), 2 * N_KEYS)));
+	}
+}
+
+ZTEST(bptree, test_pool_exhaustion)
+{
+	static struct sys_bptree_node pool[2];
+	struct sys_bptree small;
+	uint64_t key;
+	int ret = 0;
+
+	sys_bptree_init(&small, pool, ARRAY_SIZE(pool));
+
+	for (key = 0; ret == 0; key++) {
+		ret = sys_bptree_insert(&small, key, key_value(key));
+	}
+
+	zassert_equal(ret, -ENOMEM);
+	zassert_equal(sys_bptree_size(&small), key - 1);
+
+	/* Removing entries gives nodes back to the pool */
+	for (uint64_t i = 0; i < key - 1; i++) {
+		zassert_true(sys_bptree_remove(&small, i, NULL));
+	}
+
+	zassert_equal(sys_bptree_size(&small), 0);
+	zassert_ok(sys_bptree_insert(&small, 0, NULL));
+}
+
+static void bptree_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (uint64_t key = 0; key < ARRAY_SIZE(present); key++) {
+		if (present[key]) {
+			tree_remove(key);
+		}
+	}
+}
+
+ZTEST_SUITE(bptree, NULL, NULL, NULL, bptree_after, NULL);
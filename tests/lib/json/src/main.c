@@ -589,6 +589,53 @@ ZTEST(lib_json_test, test_json_decoding)
 			  "String buffer in second object array element not decoded correctly");
 }
 
+struct test_order {
+	int a;
+	int b;
+	int c;
+	int quoted;
+};
+
+static const struct json_obj_descr test_order_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct test_order, a, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct test_order, b, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct test_order, c, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM_NAMED(struct test_order, "q\"t\td", quoted, JSON_TOK_NUMBER),
+};
+
+ZTEST(lib_json_test, test_json_field_order)
+{
+	static const char *const docs[] = {
+		"{\"a\":1,\"b\":2,\"c\":3}",
+		"{\"c\":3,\"b\":2,\"a\":1}",
+		"{\"b\":2,\"x\":[0],\"a\":1,\"c\":3}",
+		"{\"c\":3,\"c\":9,\"a\":1,\"b\":2,\"a\":9}",
+	};
+	static const char encoded[] = "{\"a\":1,\"b\":2,\"c\":3,\"q\\\"t\\td\":4}";
+	struct test_order order;
+	char buf[64];
+
+	/* Keys are not unescaped when decoding, leave the last field out */
+	for (int i = 0; i < ARRAY_SIZE(docs); i++) {
+		memset(&order, 0, sizeof(order));
+		strcpy(buf, docs[i]);
+		zassert_equal(json_obj_parse(buf, strlen(buf), test_order_descr,
+					     ARRAY_SIZE(test_order_descr) - 1, &order),
+			      BIT_MASK(ARRAY_SIZE(test_order_descr) - 1), "%s", docs[i]);
+		zassert_equal(order.a, 1, "%s", docs[i]);
+		zassert_equal(order.b, 2, "%s", docs[i]);
+		zassert_equal(order.c, 3, "%s", docs[i]);
+	}
+
+	order.quoted = 4;
+	zassert_ok(json_obj_encode_buf(test_order_descr, ARRAY_SIZE(test_order_descr), &order,
+				       buf, sizeof(buf)));
+	zassert_str_equal(buf, encoded);
+	zassert_equal(json_calc_encoded_len(test_order_descr, ARRAY_SIZE(test_order_descr),
+					    &order),
+		      strlen(encoded));
+}
+
 ZTEST(lib_json_test, test_json_limits)
 {
 	int ret = 0;
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+#include <zephyr/ztest.h>
+#include <zephyr/data/json.h>
+
+static const char doc[] =
+	"{ \"device\": \"sensor-01\", \"uptime\": 123456,\n"
+	"  \"values\": [1.5, -2, 3e10, true, false, null, \"a\\\"b\\\\c\\u00e9\"],\n"
+	"  \"nested\": {\"empty_obj\": {}, \"empty_arr\": [], \"deep\": [[[{\"x\": 0}]]]},\n"
+	"  \"records\": [{\"n\": \"temp\", \"v\": 21.5}, {\"n\": \"hum\", \"v\": 40}],\n"
+	"  \"last\": \"end\" }";
+
+/* Serialization of the tokens of doc, one per line */
+static const char doc_tokens[] =
+	"={\n"
+	"device=\"sensor-01\n"
+	"uptime=0123456\n"
+	"values=[\n"
+	"=01.5\n"
+	"=0-2\n"
+	"=03e10\n"
+	"=ttrue\n"
+	"=ffalse\n"
+	"=nnull\n"
+	"=\"a\\\"b\\\\c\\u00e9\n"
+	"=]\n"
+	"nested={\n"
+	"empty_obj={\n"
+	"=}\n"
+	"empty_arr=[\n"
+	"=]\n"
+	"deep=[\n"
+	"=[\n"
+	"=[\n"
+	"={\n"
+	"x=00\n"
+	"=}\n"
+	"=]\n"
+	"=]\n"
+	"=]\n"
+	"=}\n"
+	"records=[\n"
+	"={\n"
+	"n=\"temp\n"
+	"v=021.5\n"
+	"=}\n"
+	"={\n"
+	"n=\"hum\n"
+	"v=040\n"
+	"=}\n"
+	"=]\n"
+	"last=\"end\n"
+	"=}\n";
+
+struct token_log {
+	char text[1024];
+	size_t len;
+	int tokens;
+	int abort_at;
+};
+
+static int log_token(const struct json_stream_token *tok, void *user_data)
+{
+	struct token_log *log = user_data;
+	int ret;
+
+	if (log->tokens++ == log->abort_at) {
+		return -ECANCELED;
+	}
+
+	ret = snprintf(log->text + log->len, sizeof(log->text) - log->len, "%.*s=%c%.*s\n",
+		       (int)tok->key_len, tok->key != NULL ? tok->key : "", (char)tok->type,
+		       (int)tok->value_len, tok->value != NULL ? tok->value : "");
+	zassert_true(ret > 0 && ret < sizeof(log->text) - log->len, "log overflow");
+	log->len += ret;
+
+	return 0;
+}
+
+static int parse_chunked(const char *json, size_t len, size_t chunk, char *buf, size_t buf_size,
+			 json_stream_cb_t cb, void *user_data)
+{
+	struct json_stream_parser parser;
+	char copy[sizeof(doc)];
+	size_t off;
+	int ret;
+
+	json_stream_init(&parser, buf, buf_size, cb, user_data);
+
+	for (off = 0; off < len; off += chunk) {
+		size_t n = MIN(chunk, len - off);
+
+		/* Chunks do not have to outlive json_stream_feed() */
+		memcpy(copy, json + off, n);
+		ret = json_stream_feed(&parser, copy, n);
+		memset(copy, '#', n);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_stream_finish(&parser);
+}
+
+static int parse_log(const char *json, size_t chunk, struct token_log *log)
+{
+	static char buf[64];
+
+	memset(log, 0, sizeof(*log));
+	log->abort_at = -1;
+
+	return parse_chunked(json, strlen(json), chunk, buf, sizeof(buf), log_token, log);
+}
+
+ZTEST(lib_json_stream, test_json_stream_tokens)
+{
+	struct token_log log;
+	size_t chunk;
+
+	for (chunk = 1; chunk <= sizeof(doc); chunk++) {
+		zassert_ok(parse_log(doc, chunk, &log), "chunk %zu", chunk);
+		zassert_equal(log.len, strlen(doc_tokens), "chunk %zu", chunk);
+		zassert_mem_equal(log.text, doc_tokens, log.len, "chunk %zu", chunk);
+	}
+}
+
+ZTEST(lib_json_stream, test_json_stream_split)
+{
+	struct json_stream_parser parser;
+	static char buf[64];
+	struct token_log log;
+	size_t len = strlen(doc);
+	size_t split;
+
+	/* Split the document in two at every position */
+	for (split = 0; split <= len; split++) {
+		memset(&log, 0, sizeof(log));
+		log.abort_at = -1;
+		json_stream_init(&parser, buf, sizeof(buf), log_token, &log);
+
+		zassert_ok(json_stream_feed(&parser, doc, split));
+		zassert_ok(json_stream_feed(&parser, doc + split, len - split));
+		zassert_ok(json_stream_finish(&parser));
+		zassert_mem_equal(log.text, doc_tokens, strlen(doc_tokens), "split %zu", split);
+	}
+}
+
+ZTEST(lib_json_stream, test_json_stream_scalars)
+{
+	static const char *const docs[] = {
+		"42", " -7 ", "\"str\"", "true", "null", "[]", "{}",
+	};
+	static const char *const tokens[] = {
+		"=042\n", "=0-7\n", "=\"str\n", "=ttrue\n", "=nnull\n", "=[\n=]\n", "={\n=}\n",
+	};
+	struct token_log log;
+
+	for (int i = 0; i < ARRAY_SIZE(docs); i++) {
+		for (size_t chunk = 1; chunk <= strlen(docs[i]); chunk++) {
+			zassert_ok(parse_log(docs[i], chunk, &log), "%s", docs[i]);
+			zassert_equal(log.len, strlen(tokens[i]), "%s", docs[i]);
+			zassert_mem_equal(log.text, tokens[i], log.len, "%s", docs[i]);
+		}
+
+		/* A document fed in one chunk needs no token buffer */
+		memset(&log, 0, sizeof(log));
+		log.abort_at = -1;
+		zassert_ok(parse_chunked(docs[i], strlen(docs[i]), strlen(docs[i]), NULL, 0,
+					 log_token, &log), "%s", docs[i]);
+		zassert_equal(log.len, strlen(tokens[i]), "%s", docs[i]);
+		zassert_mem_equal(log.text, tokens[i], log.len, "%s", docs[i]);
+	}
+
+	if (IS_ENABLED(CONFIG_JSON_LIBRARY_FP_SUPPORT)) {
+		zassert_ok(parse_log("[NaN,-Infinity,Infinity]", 1, &log));
+		zassert_mem_equal(log.text, "=[\n=0NaN\n=0-Infinity\n=0Infinity\n=]\n", log.len);
+	}
+}
+
+ZTEST(lib_json_stream, test_json_stream_invalid)
+{
+	static const char *const docs[] = {
+		"", "{", "[1,", "[1 2]", "{\"a\" 1}", "{\"a\":}", "{1:2}", "{\"a\":1,}",
+		"[1,]", "[}", "{]", "\"abc", "\"\\x\"", "\"\\u12g4\"", "tru", "trux",
+		"nul", "-", "[-]", "1 2", "{} {}", "[1]]", "@",
+	};
+	struct token_log log;
+
+	for (int i = 0; i < ARRAY_SIZE(docs); i++) {
+		for (size_t chunk = 1; chunk <= MAX(strlen(docs[i]), 1); chunk++) {
+			zassert_equal(parse_log(docs[i], chunk, &log), -EINVAL, "%s", docs[i]);
+		}
+	}
+}
+
+ZTEST(lib_json_stream, test_json_stream_limits)
+{
+	struct json_stream_parser parser;
+	char deep[JSON_STREAM_MAX_DEPTH * 2 + 2];
+	struct token_log log;
+	char buf[8];
+
+	/* Tokens spanning chunks must fit in the buffer, key included */
+	memset(&log, 0, sizeof(log));
+	log.abort_at = -1;
+	zassert_ok(parse_chunked("{\"key\":\"abc\"}", 13, 9, buf, sizeof(buf), log_token, &log));
+	zassert_equal(parse_chunked("{\"key\":\"abcdef\"}", 16, 10, buf, sizeof(buf), log_token,
+				    &log),
+		      -ENOMEM);
+
+	/* Without a buffer, a single chunk must hold the whole document */
+	zassert_ok(parse_chunked(doc, strlen(doc), strlen(doc), NULL, 0, log_token, &log));
+	zassert_equal(parse_chunked("\"abc\"", 5, 2, NULL, 0, log_token, &log), -ENOMEM);
+
+	/* Nesting depth */
+	memset(deep, '[', JSON_STREAM_MAX_DEPTH);
+	memset(deep + JSON_STREAM_MAX_DEPTH, ']', JSON_STREAM_MAX_DEPTH);
+	json_stream_init(&parser, NULL, 0, log_token, &log);
+	log.len = 0;
+	zassert_ok(json_stream_feed(&parser, deep, JSON_STREAM_MAX_DEPTH * 2));
+	zassert_ok(json_stream_finish(&parser));
+
+	memset(deep, '[', JSON_STREAM_MAX_DEPTH + 1);
+	memset(deep + JSON_STREAM_MAX_DEPTH + 1, ']', JSON_STREAM_MAX_DEPTH + 1);
+	json_stream_init(&parser, NULL, 0, log_token, &log);
+	log.len = 0;
+	zassert_equal(json_stream_feed(&parser, deep, sizeof(deep)), -ENOMEM);
+
+	/* Errors are sticky, callback errors abort parsing */
+	zassert_equal(json_stream_feed(&parser, "[]", 2), -ENOMEM);
+	memset(&log, 0, sizeof(log));
+	log.abort_at = 3;
+	zassert_equal(parse_chunked(doc, strlen(doc), strlen(doc), NULL, 0, log_token, &log),
+		      -ECANCELED);
+	zassert_equal(log.tokens, 4);
+}
+
+ZTEST(lib_json_stream, test_json_stream_tape)
+{
+	static uint32_t entries[64];
+	static char strings[256];
+	static char buf[64];
+	struct json_tape tape;
+	size_t records, rec, v, idx;
+
+	for (size_t chunk = 1; chunk <= sizeof(doc); chunk += 5) {
+		json_tape_init(&tape, entries, ARRAY_SIZE(entries), strings, sizeof(strings));
+		zassert_ok(parse_chunked(doc, strlen(doc), chunk, buf, sizeof(buf),
+					 json_tape_stream_cb, &tape));
+
+		zassert_equal(json_tape_type(&tape, 0), JSON_TOK_OBJECT_START);
+		zassert_equal(json_tape_next(&tape, 0), tape.len);
+		zassert_equal(json_tape_type(&tape, tape.len - 1), JSON_TOK_OBJECT_END);
+		zassert_equal(json_tape_type(&tape, tape.len), JSON_TOK_EOF);
+
+		zassert_ok(json_tape_obj_get(&tape, 0, "device", &idx));
+		zassert_str_equal(json_tape_str(&tape, idx), "sensor-01");
+		zassert_ok(json_tape_obj_get(&tape, 0, "last", &idx));
+		zassert_str_equal(json_tape_str(&tape, idx), "end");
+		zassert_equal(json_tape_obj_get(&tape, 0, "missing", &idx), -ENOENT);
+		zassert_equal(json_tape_obj_get(&tape, idx, "last", &idx), -EINVAL);
+
+		zassert_ok(json_tape_obj_get(&tape, 0, "values", &idx));
+		zassert_ok(json_tape_arr_get(&tape, idx, 2, &v));
+		zassert_equal(json_tape_type(&tape, v), JSON_TOK_NUMBER);
+		zassert_str_equal(json_tape_str(&tape, v), "3e10");
+		zassert_ok(json_tape_arr_get(&tape, idx, 5, &v));
+		zassert_equal(json_tape_type(&tape, v), JSON_TOK_NULL);
+		zassert_is_null(json_tape_str(&tape, v));
+		zassert_ok(json_tape_arr_get(&tape, idx, 6, &v));
+		zassert_str_equal(json_tape_str(&tape, v), "a\\\"b\\\\c\\u00e9");
+		zassert_equal(json_tape_arr_get(&tape, idx, 7, &v), -ENOENT);
+
+		zassert_ok(json_tape_obj_get(&tape, 0, "records", &records));
+		zassert_ok(json_tape_arr_get(&tape, records, 1, &rec));
+		zassert_ok(json_tape_obj_get(&tape, rec, "v", &v));
+		zassert_str_equal(json_tape_str(&tape, v), "40");
+
+		zassert_ok(json_tape_obj_get(&tape, 0, "nested", &idx));
+		zassert_ok(json_tape_obj_get(&tape, idx, "empty_arr", &v));
+		zassert_equal(json_tape_arr_get(&tape, v, 0, &v), -ENOENT);
+		zassert_ok(json_tape_obj_get(&tape, idx, "deep", &v));
+		zassert_ok(json_tape_arr_get(&tape, v, 0, &v));
+		zassert_ok(json_tape_arr_get(&tape, v, 0, &v));
+		zassert_ok(json_tape_arr_get(&tape, v, 0, &v));
+		zassert_ok(json_tape_obj_get(&tape, v, "x", &v));
+		zassert_str_equal(json_tape_str(&tape, v), "0");
+	}
+
+	/* Tape exhaustion */
+	json_tape_init(&tape, entries, 4, strings, sizeof(strings));
+	zassert_equal(parse_chunked(doc, strlen(doc), 16, buf, sizeof(buf), json_tape_stream_cb,
+				    &tape),
+		      -ENOMEM);
+	json_tape_init(&tape, entries, ARRAY_SIZE(entries), strings, 16);
+	zassert_equal(parse_chunked(doc, strlen(doc), 16, buf, sizeof(buf), json_tape_stream_cb,
+				    &tape),
+		      -ENOMEM);
+}
+
+ZTEST_SUITE(lib_json_stream, NULL, NULL, NULL, NULL, NULL);
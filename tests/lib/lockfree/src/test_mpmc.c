@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mpmc_lockfree.h>
+
+struct test_mpmc_elem {
+	uint32_t id;
+	uint32_t seq;
+	uint32_t pad;
+};
+
+MPMC_DEFINE(mpmc_q, sizeof(struct test_mpmc_elem), 4);
+
+/*
+ * @brief Push and pop elements, filling and draining the queue over several laps
+ *
+ * @see mpmc_push(), mpmc_pop()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpmc, test_push_pop)
+{
+	struct test_mpmc_elem elem;
+	uint32_t next_push = 0;
+	uint32_t next_pop = 0;
+
+	zassert_false(mpmc_pop(&mpmc_q, &elem), "Pop on empty queue should fail");
+
+	for (int lap = 0; lap < 5; lap++) {
+		/* Fill up, then drain a different number of elements each lap */
+		for (;;) {
+			elem = (struct test_mpmc_elem){ .id = 1, .seq = next_push };
+			if (!mpmc_push(&mpmc_q, &elem)) {
+				break;
+			}
+			next_push++;
+		}
+
+		zassert_equal(next_push - next_pop, 4, "Queue should hold 4 elements");
+
+		for (int i = 0; i < 1 + lap % 4; i++) {
+			zassert_true(mpmc_pop(&mpmc_q, &elem), "Pop should succeed");
+			zassert_equal(elem.seq, next_pop++, "Elements should be popped in order");
+		}
+	}
+
+	while (mpmc_pop(&mpmc_q, &elem)) {
+		zassert_equal(elem.seq, next_pop++, "Elements should be popped in order");
+	}
+
+	zassert_equal(next_pop, next_push, "All elements should be popped");
+}
+
+#define MPMC_ITERATIONS 100000
+#define MPMC_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MPMC_PRODUCERS  2
+#define MPMC_CONSUMERS  2
+#define MPMC_THREADS    (MPMC_PRODUCERS + MPMC_CONSUMERS)
+
+static struct k_thread mpmc_thread[MPMC_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(mpmc_stack, MPMC_THREADS, MPMC_STACK_SIZE);
+
+MPMC_DEFINE(threaded_q, sizeof(struct test_mpmc_elem), 8);
+MPMC_BLOCKING_DEFINE(blocking_q, sizeof(struct test_mpmc_elem), 2);
+
+static uint64_t mpmc_sums[MPMC_CONSUMERS];
+
+static void push(bool blocking, const struct test_mpmc_elem *elem)
+{
+	if (blocking) {
+		zassert_ok(mpmc_blocking_push(&blocking_q, elem, K_FOREVER));
+		return;
+	}
+
+	while (!mpmc_push(&threaded_q, elem)) {
+		k_yield();
+	}
+}
+
+static void pop(bool blocking, struct test_mpmc_elem *elem)
+{
+	if (blocking) {
+		zassert_ok(mpmc_blocking_pop(&blocking_q, elem, K_FOREVER));
+		return;
+	}
+
+	while (!mpmc_pop(&threaded_q, elem)) {
+		k_yield();
+	}
+}
+
+static void mpmc_producer(void *p1, void *p2, void *p3)
+{
+	struct test_mpmc_elem elem = { .id = (uint32_t)(uintptr_t)p1 };
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < MPMC_ITERATIONS; i++) {
+		elem.seq = i;
+		push((bool)(uintptr_t)p2, &elem);
+	}
+}
+
+static void mpmc_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t id = (uint32_t)(uintptr_t)p1;
+	int64_t last[MPMC_PRODUCERS];
+	struct test_mpmc_elem elem;
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < MPMC_PRODUCERS; i++) {
+		last[i] = -1;
+	}
+
+	for (int i = 0; i < MPMC_ITERATIONS * MPMC_PRODUCERS / MPMC_CONSUMERS; i++) {
+		pop((bool)(uintptr_t)p2, &elem);
+
+		zassert_true(elem.id < MPMC_PRODUCERS, "Invalid producer %u", elem.id);
+		zassert_true((int64_t)elem.seq > last[elem.id],
+			     "Elements of a producer should be popped in order");
+		last[elem.id] = elem.seq;
+		mpmc_sums[id] += elem.seq;
+	}
+}
+
+static void run_threaded(bool blocking)
+{
+	uint64_t sum = 0;
+
+	memset(mpmc_sums, 0, sizeof(mpmc_sums));
+
+	for (int i = 0; i < MPMC_CONSUMERS; i++) {
+		k_thread_create(&mpmc_thread[i], mpmc_stack[i], MPMC_STACK_SIZE, mpmc_consumer,
+				(void *)(uintptr_t)i, (void *)(uintptr_t)blocking, NULL,
+				K_PRIO_PREEMPT(5), K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < MPMC_PRODUCERS; i++) {
+		k_thread_create(&mpmc_thread[MPMC_CONSUMERS + i], mpmc_stack[MPMC_CONSUMERS + i],
+				MPMC_STACK_SIZE, mpmc_producer, (void *)(uintptr_t)i,
+				(void *)(uintptr_t)blocking, NULL, K_PRIO_PREEMPT(5),
+				K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < MPMC_THREADS; i++) {
+		k_thread_join(&mpmc_thread[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < MPMC_CONSUMERS; i++) {
+		sum += mpmc_sums[i];
+	}
+
+	zassert_equal(sum, (uint64_t)MPMC_PRODUCERS * MPMC_ITERATIONS * (MPMC_ITERATIONS - 1) / 2,
+		      "Every element should be popped once");
+}
+
+/**
+ * @brief Test that multiple producers and consumers are indeed thread safe
+ *
+ * This can and should be validated on SMP machines where incoherent
+ * memory could cause issues.
+ */
+ZTEST(mpmc, test_mpmc_threaded)
+{
+	run_threaded(false);
+}
+
+/**
+ * @brief Test that blocking producers and consumers wake each other up
+ */
+ZTEST(mpmc, test_mpmc_blocking_threaded)
+{
+	run_threaded(true);
+}
+
+ZTEST(mpmc, test_mpmc_blocking_timeout)
+{
+	struct test_mpmc_elem elem = { 0 };
+
+	zassert_equal(mpmc_blocking_pop(&blocking_q, &elem, K_NO_WAIT), -ENOMSG);
+	zassert_equal(mpmc_blocking_pop(&blocking_q, &elem, K_MSEC(10)), -EAGAIN);
+
+	zassert_ok(mpmc_blocking_push(&blocking_q, &elem, K_NO_WAIT));
+	zassert_ok(mpmc_blocking_push(&blocking_q, &elem, K_MSEC(10)));
+	zassert_equal(mpmc_blocking_push(&blocking_q, &elem, K_NO_WAIT), -ENOMSG);
+	zassert_equal(mpmc_blocking_push(&blocking_q, &elem, K_MSEC(10)), -EAGAIN);
+
+	zassert_ok(mpmc_blocking_pop(&blocking_q, &elem, K_NO_WAIT));
+	zassert_ok(mpmc_blocking_pop(&blocking_q, &elem, K_NO_WAIT));
+	zassert_equal(atomic_get(&blocking_q.pop_waiters), 0);
+	zassert_equal(atomic_get(&blocking_q.push_waiters), 0);
+}
+
+ZTEST_SUITE(mpmc, NULL, NULL, NULL, NULL, NULL);
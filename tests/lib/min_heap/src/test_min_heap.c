@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <limits.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/sys/min_heap.h>
@@ -191,4 +192,110 @@ ZTEST(min_heap_api, test_find_and_remove)
 	zassert_true(min_heap_is_empty(&my_heap), "Empty check fail");
 }
 
+ZTEST(min_heap_api, test_push_bulk)
+{
+	int ret;
+
+	ret = min_heap_push(&my_heap, &elements[0]);
+	zassert_ok(ret, "min_heap_push failed");
+
+	ret = min_heap_push_bulk(&my_heap, elements, ARRAY_SIZE(elements));
+	zassert_equal(ret, -ENOMEM, "bulk push past capacity should return -ENOMEM");
+	zassert_equal(my_heap.size, 1, "failed bulk push should not insert elements");
+
+	ret = min_heap_push_bulk(&my_heap, &elements[1], ARRAY_SIZE(elements) - 1);
+	zassert_ok(ret, "min_heap_push_bulk failed");
+	zassert_equal(my_heap.size, ARRAY_SIZE(elements), "bulk push size error");
+
+	validate_heap_order_ls(&my_heap);
+
+	zassert_ok(min_heap_push_bulk(&my_heap, elements, 0), "empty bulk push failed");
+	zassert_ok(min_heap_push_bulk(&my_heap, elements, 1), "single bulk push failed");
+	validate_heap_order_ls(&my_heap);
+}
+
+#define TASK_COUNT 32
+
+struct task {
+	int prio;
+	size_t heap_index;
+};
+
+static struct task tasks[TASK_COUNT];
+static struct task *task_ptrs[TASK_COUNT];
+
+static int compare_task(const void *a, const void *b)
+{
+	const struct task *ta = *(struct task *const *)a;
+	const struct task *tb = *(struct task *const *)b;
+
+	return ta->prio - tb->prio;
+}
+
+static void track_task(void *node, size_t index)
+{
+	(*(struct task **)node)->heap_index = index;
+}
+
+MIN_HEAP_DEFINE_STATIC(task_heap, TASK_COUNT, sizeof(struct task *),
+		       __alignof__(struct task *), compare_task);
+
+static void validate_task_handles(struct min_heap *h)
+{
+	struct task **node;
+
+	MIN_HEAP_FOREACH(h, node) {
+		zassert_equal_ptr(min_heap_get_element(h, (*node)->heap_index), node,
+				  "stale handle for task of priority %d", (*node)->prio);
+	}
+}
+
+ZTEST(min_heap_api, test_update_and_remove_by_handle)
+{
+	struct task *task;
+	int last = INT_MIN;
+
+	min_heap_set_index_cb(&task_heap, track_task);
+
+	for (int i = 0; i < TASK_COUNT; i++) {
+		tasks[i].prio = (i * 7) % TASK_COUNT;
+		task_ptrs[i] = &tasks[i];
+	}
+
+	zassert_ok(min_heap_push_bulk(&task_heap, task_ptrs, TASK_COUNT / 2),
+		   "min_heap_push_bulk failed");
+	for (int i = TASK_COUNT / 2; i < TASK_COUNT; i++) {
+		zassert_ok(min_heap_push(&task_heap, &task_ptrs[i]), "min_heap_push failed");
+	}
+	validate_task_handles(&task_heap);
+
+	/* Decrease the key of some tasks and increase it for others */
+	for (int i = 0; i < TASK_COUNT; i += 3) {
+		tasks[i].prio += (i % 2 == 0) ? -TASK_COUNT : TASK_COUNT;
+		zassert_true(min_heap_update(&task_heap, tasks[i].heap_index),
+			     "min_heap_update failed");
+		validate_task_handles(&task_heap);
+	}
+
+	zassert_equal(*(struct task **)min_heap_peek(&task_heap), &tasks[0],
+		      "decreased task should be on top");
+	zassert_false(min_heap_update(&task_heap, TASK_COUNT), "update with invalid index");
+
+	/* Remove every other task through its handle */
+	for (int i = 1; i < TASK_COUNT; i += 2) {
+		zassert_true(min_heap_remove(&task_heap, tasks[i].heap_index, &task),
+			     "remove by handle failed");
+		zassert_equal_ptr(task, &tasks[i], "removed the wrong task");
+		validate_task_handles(&task_heap);
+	}
+
+	zassert_equal(task_heap.size, TASK_COUNT / 2, "heap size error");
+
+	while (min_heap_pop(&task_heap, &task)) {
+		zassert_true(task->prio >= last, "Heap order violated: %d < %d", task->prio, last);
+		last = task->prio;
+		validate_task_handles(&task_heap);
+	}
+}
+
 ZTEST_SUITE(min_heap_api, NULL, NULL, NULL, NULL, NULL);
@@ -370,6 +370,41 @@ ZTEST(test_spsc_pbuf, test_largest_alloc)
 	PACKET_WRITE(pb, SPSC_PBUF_MAX_LEN - 1, 0, 1, 12);
 }
 
+ZTEST(test_spsc_pbuf, test_writev)
+{
+	static uint8_t buffer[128] __aligned(MAX(Z_SPSC_PBUF_DCACHE_LINE, 4));
+	static const char hdr[] = {'h', 'd'};
+	static const char payload[] = {'p', 'a', 'y', 'l', 'o', 'a', 'd'};
+	struct spsc_pbuf_iovec iov[] = {
+		{ .buf = hdr, .len = sizeof(hdr) },
+		{ .buf = NULL, .len = 0 },
+		{ .buf = payload, .len = sizeof(payload) },
+	};
+	struct spsc_pbuf *pb;
+	char rbuf[sizeof(hdr) + sizeof(payload)];
+	int rv;
+
+	pb = spsc_pbuf_init(buffer, sizeof(buffer), 0);
+
+	rv = spsc_pbuf_writev(pb, iov, 0);
+	zassert_equal(rv, -EINVAL, "Unexpected rv:%d", rv);
+
+	rv = spsc_pbuf_writev(pb, iov, ARRAY_SIZE(iov));
+	zassert_equal(rv, sizeof(rbuf), "Unexpected rv:%d", rv);
+
+	rv = spsc_pbuf_read(pb, rbuf, sizeof(rbuf));
+	zassert_equal(rv, sizeof(rbuf), "Unexpected rv:%d", rv);
+	zassert_mem_equal(rbuf, hdr, sizeof(hdr));
+	zassert_mem_equal(&rbuf[sizeof(hdr)], payload, sizeof(payload));
+
+	/* A packet which does not fit is not written partially. */
+	iov[1].buf = buffer;
+	iov[1].len = spsc_pbuf_capacity(pb);
+	rv = spsc_pbuf_writev(pb, iov, ARRAY_SIZE(iov));
+	zassert_equal(rv, -ENOMEM, "Unexpected rv:%d", rv);
+	zassert_equal(spsc_pbuf_read(pb, NULL, 0), 0, "Buffer should be empty");
+}
+
 ZTEST(test_spsc_pbuf, test_utilization)
 {
 	static uint8_t buffer[128] __aligned(MAX(Z_SPSC_PBUF_DCACHE_LINE, 4));
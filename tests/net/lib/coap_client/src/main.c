@@ -451,6 +451,135 @@ static ssize_t z_impl_zsock_recvfrom_custom_fake_observe(int sock, void *buf, si
 	return ret;
 }
 
+/* Emulated server for a block-wise GET, responses are released after a fixed latency */
+#define BLOCK2_TEST_BLOCKS    16
+#define BLOCK2_TEST_SZX       COAP_BLOCK_32
+#define BLOCK2_TEST_BLOCK_LEN 32
+#define BLOCK2_TEST_LAST_LEN  10
+#define BLOCK2_TEST_LEN       ((BLOCK2_TEST_BLOCKS - 1) * BLOCK2_TEST_BLOCK_LEN + \
+			       BLOCK2_TEST_LAST_LEN)
+#define BLOCK2_TEST_RTT_MS    40
+#define BLOCK2_TEST_QUEUE     8
+
+static struct {
+	uint8_t data[MAX_COAP_MSG_LEN];
+	uint16_t len;
+	int64_t due;
+} block2_queue[BLOCK2_TEST_QUEUE];
+static int block2_queued;
+static int block2_in_flight;
+static int block2_max_in_flight;
+static size_t block2_received;
+static bool block2_error;
+static uint8_t block2_data[BLOCK2_TEST_LEN];
+
+static ssize_t z_impl_zsock_sendto_custom_fake_block2(int sock, void *buf, size_t len, int flags,
+						      const struct sockaddr *dest_addr,
+						      socklen_t addrlen)
+{
+	struct coap_packet request;
+	struct coap_packet response;
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t payload[BLOCK2_TEST_BLOCK_LEN];
+	uint8_t tkl;
+	int block_num = 0;
+	int option;
+	bool more;
+
+	/* Called from the client thread, failures are checked by the test */
+	if (coap_packet_parse(&request, buf, len, NULL, 0) < 0 ||
+	    coap_header_get_type(&request) != COAP_TYPE_CON ||
+	    block2_queued == BLOCK2_TEST_QUEUE) {
+		block2_error = true;
+		return len;
+	}
+
+	option = coap_get_option_int(&request, COAP_OPTION_BLOCK2);
+	if (option > 0) {
+		block_num = GET_BLOCK_NUM(option);
+	}
+
+	block2_in_flight++;
+	block2_max_in_flight = MAX(block2_max_in_flight, block2_in_flight);
+
+	tkl = coap_header_get_token(&request, token);
+	(void)coap_packet_init(&response, block2_queue[block2_queued].data, MAX_COAP_MSG_LEN,
+			       COAP_VERSION_1, COAP_TYPE_ACK, tkl, token,
+			       block_num < BLOCK2_TEST_BLOCKS ? COAP_RESPONSE_CODE_CONTENT :
+								COAP_RESPONSE_CODE_BAD_OPTION,
+			       coap_header_get_id(&request));
+
+	if (block_num < BLOCK2_TEST_BLOCKS) {
+		more = block_num < BLOCK2_TEST_BLOCKS - 1;
+		for (int i = 0; i < sizeof(payload); i++) {
+			payload[i] = (uint8_t)(block_num * BLOCK2_TEST_BLOCK_LEN + i);
+		}
+
+		(void)coap_append_option_int(&response, COAP_OPTION_BLOCK2,
+					     (block_num << 4) | (more << 3) | BLOCK2_TEST_SZX);
+		(void)coap_packet_append_payload_marker(&response);
+		(void)coap_packet_append_payload(&response, payload,
+						 more ? BLOCK2_TEST_BLOCK_LEN : BLOCK2_TEST_LAST_LEN);
+	}
+
+	block2_queue[block2_queued].len = response.offset;
+	block2_queue[block2_queued].due = k_uptime_get() + BLOCK2_TEST_RTT_MS;
+	block2_queued++;
+	set_socket_events(sock, ZSOCK_POLLIN);
+
+	return len;
+}
+
+static ssize_t z_impl_zsock_recvfrom_custom_fake_block2(int sock, void *buf, size_t max_len,
+							int flags, struct sockaddr *src_addr,
+							socklen_t *addrlen)
+{
+	/* Hand out the newest due response first to reorder the blocks */
+	for (int i = block2_queued - 1; i >= 0; i--) {
+		uint16_t len = block2_queue[i].len;
+
+		if (block2_queue[i].due > k_uptime_get()) {
+			continue;
+		}
+
+		memcpy(buf, block2_queue[i].data, len);
+		memmove(&block2_queue[i], &block2_queue[i + 1],
+			(block2_queued - i - 1) * sizeof(block2_queue[0]));
+		block2_queued--;
+		block2_in_flight--;
+
+		if (block2_queued == 0) {
+			clear_socket_events(sock, ZSOCK_POLLIN);
+		}
+
+		return len;
+	}
+
+	errno = EAGAIN;
+	return -1;
+}
+
+static void coap_callback_block2(int16_t code, size_t offset, const uint8_t *payload, size_t len,
+				 bool last_block, void *user_data)
+{
+	last_response_code = code;
+
+	if (code != COAP_RESPONSE_CODE_CONTENT || offset != block2_received ||
+	    offset + len > sizeof(block2_data)) {
+		LOG_ERR("Unexpected block at %zu, len %zu, code %d", offset, len, code);
+		block2_error = true;
+		k_sem_give((struct k_sem *)user_data);
+		return;
+	}
+
+	memcpy(&block2_data[offset], payload, len);
+	block2_received += len;
+
+	if (last_block) {
+		k_sem_give((struct k_sem *)user_data);
+	}
+}
+
 void coap_callback(int16_t code, size_t offset, const uint8_t *payload, size_t len, bool last_block,
 		   void *user_data)
 {
@@ -935,3 +1064,49 @@ ZTEST(coap_client, test_non_confirmable)
 	/* No callbacks from non-confirmable */
 	zassert_not_ok(k_sem_take(&sem1, K_MSEC(MORE_THAN_EXCHANGE_LIFETIME_MS)));
 }
+
+ZTEST(coap_client, test_block2_window)
+{
+	struct coap_client_option block2 = {
+		.code = COAP_OPTION_BLOCK2,
+		.len = 1,
+		.value[0] = BLOCK2_TEST_SZX,
+	};
+	struct coap_client_request req = {
+		.method = COAP_METHOD_GET,
+		.confirmable = true,
+		.path = test_path,
+		.cb = coap_callback_block2,
+		.options = &block2,
+		.num_options = 1,
+		.user_data = &sem1,
+	};
+	int64_t start;
+	int64_t elapsed;
+
+	block2_queued = 0;
+	block2_in_flight = 0;
+	block2_max_in_flight = 0;
+	block2_received = 0;
+	block2_error = false;
+
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_custom_fake_block2;
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_custom_fake_block2;
+
+	start = k_uptime_get();
+	zassert_ok(coap_client_req(&client, 0, &dst_address, &req, NULL));
+	zassert_ok(k_sem_take(&sem1, K_MSEC(BLOCK2_TEST_BLOCKS * BLOCK2_TEST_RTT_MS * 4)));
+	elapsed = k_uptime_get() - start;
+
+	zassert_false(block2_error);
+	zassert_equal(block2_received, BLOCK2_TEST_LEN);
+	for (int i = 0; i < BLOCK2_TEST_LEN; i++) {
+		zassert_equal(block2_data[i], (uint8_t)i, "Wrong data at %d", i);
+	}
+
+	TC_PRINT("%d blocks, %d ms RTT, window %d: %lld ms, %d requests in flight\n",
+		 BLOCK2_TEST_BLOCKS, BLOCK2_TEST_RTT_MS, COAP_CLIENT_BLOCK2_WINDOW, elapsed,
+		 block2_max_in_flight);
+
+	zassert_equal(block2_max_in_flight, COAP_CLIENT_BLOCK2_WINDOW);
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/coap_service.h>
+#include <zephyr/net/socket.h>
+
+/*
+ * The requests are dispatched by the CoAP server to the resources below and
+ * must resolve to the same resource with and without
+ * CONFIG_COAP_SERVER_RESOURCE_INDEX. Resources are ordered by name within a
+ * service.
+ */
+
+static const struct coap_resource *dispatched;
+static int sock = -1;
+
+static int coap_handler(struct coap_resource *resource, struct coap_packet *request,
+			struct sockaddr *addr, socklen_t addr_len)
+{
+	ARG_UNUSED(request);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addr_len);
+
+	dispatched = resource;
+
+	return COAP_RESPONSE_CODE_CONTENT;
+}
+
+#define TEST_RESOURCE_DEFINE(_name, _service, ...)					\
+	static const char * const _name##_path[] = { __VA_ARGS__, NULL };		\
+	COAP_RESOURCE_DEFINE(_name, _service, {						\
+		.path = _name##_path,							\
+		.get = coap_handler,							\
+	})
+
+/* Exact and wildcard paths, with a duplicate */
+static const uint16_t indexed_port = 5701;
+COAP_SERVICE_DEFINE(service_indexed, "127.0.0.1", &indexed_port, 0);
+
+TEST_RESOURCE_DEFINE(indexed_0_exact, service_indexed, "exact", "a");
+TEST_RESOURCE_DEFINE(indexed_1_dup, service_indexed, "dup");
+TEST_RESOURCE_DEFINE(indexed_2_dup, service_indexed, "dup");
+TEST_RESOURCE_DEFINE(indexed_3_exact_wildcard, service_indexed, "exact", "+");
+TEST_RESOURCE_DEFINE(indexed_4_wildcard, service_indexed, "wild", "+");
+TEST_RESOURCE_DEFINE(indexed_5_wild_exact, service_indexed, "wild", "a");
+
+/* No wildcard, a miss of the table is final */
+static const uint16_t exact_port = 5702;
+COAP_SERVICE_DEFINE(service_exact, "127.0.0.1", &exact_port, 0);
+
+TEST_RESOURCE_DEFINE(exact_0, service_exact, "only", "path");
+
+/* More resources than the table of the test configuration takes */
+static const uint16_t full_port = 5703;
+COAP_SERVICE_DEFINE(service_full, "127.0.0.1", &full_port, 0);
+
+TEST_RESOURCE_DEFINE(full_0, service_full, "a");
+TEST_RESOURCE_DEFINE(full_1, service_full, "b");
+TEST_RESOURCE_DEFINE(full_2, service_full, "c");
+TEST_RESOURCE_DEFINE(full_3, service_full, "d");
+TEST_RESOURCE_DEFINE(full_4, service_full, "e", "+");
+
+/* Sends a GET for path and returns the response code of the server */
+static uint8_t request(uint16_t port, const char *path)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+	struct coap_packet pkt;
+	uint8_t buf[64];
+	ssize_t len;
+
+	dispatched = NULL;
+
+	zassert_ok(coap_packet_init(&pkt, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON, 0,
+				    NULL, COAP_METHOD_GET, coap_next_id()));
+	zassert_ok(coap_packet_set_path(&pkt, path));
+
+	len = zsock_sendto(sock, buf, pkt.offset, 0, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(len, pkt.offset, "Cannot send %s (%d)", path, errno);
+
+	len = zsock_recv(sock, buf, sizeof(buf), 0);
+	zassert_true(len > 0, "No response to %s (%d)", path, errno);
+
+	zassert_ok(coap_packet_parse(&pkt, buf, len, NULL, 0));
+	zassert_equal(coap_header_get_type(&pkt), COAP_TYPE_ACK);
+
+	return coap_header_get_code(&pkt);
+}
+
+static void assert_dispatched(uint16_t port, const char *path,
+			      const struct coap_resource *resource)
+{
+	zassert_equal(request(port, path), COAP_RESPONSE_CODE_CONTENT, "%s not found", path);
+	zassert_equal_ptr(dispatched, resource, "%s dispatched to %p instead of %p", path,
+			  dispatched, resource);
+}
+
+static void assert_not_found(uint16_t port, const char *path)
+{
+	zassert_equal(request(port, path), COAP_RESPONSE_CODE_NOT_FOUND, "%s found", path);
+	zassert_is_null(dispatched);
+}
+
+ZTEST(coap_resource_index, test_exact)
+{
+	assert_dispatched(indexed_port, "exact/a", &indexed_0_exact);
+	assert_dispatched(exact_port, "only/path", &exact_0);
+
+	assert_not_found(exact_port, "only");
+	assert_not_found(exact_port, "only/path/more");
+	assert_not_found(exact_port, "other");
+}
+
+ZTEST(coap_resource_index, test_wildcard_precedence)
+{
+	/* An exact resource defined before a matching wildcard one is used */
+	assert_dispatched(indexed_port, "exact/a", &indexed_0_exact);
+	assert_dispatched(indexed_port, "exact/b", &indexed_3_exact_wildcard);
+
+	/* A wildcard resource defined before a matching exact one is used */
+	assert_dispatched(indexed_port, "wild/a", &indexed_4_wildcard);
+	assert_dispatched(indexed_port, "wild/b", &indexed_4_wildcard);
+
+	assert_not_found(indexed_port, "other");
+}
+
+ZTEST(coap_resource_index, test_duplicate)
+{
+	/* The first of the resources with the same path is used */
+	assert_dispatched(indexed_port, "dup", &indexed_1_dup);
+	assert_dispatched(indexed_port, "dup", &indexed_1_dup);
+}
+
+ZTEST(coap_resource_index, test_full)
+{
+	/* A service which does not fit in the table is served by the linear lookup */
+	assert_dispatched(full_port, "a", &full_0);
+	assert_dispatched(full_port, "b", &full_1);
+	assert_dispatched(full_port, "c", &full_2);
+	assert_dispatched(full_port, "d", &full_3);
+	assert_dispatched(full_port, "e/a", &full_4);
+
+	assert_not_found(full_port, "f");
+}
+
+static void *coap_resource_index_setup(void)
+{
+	struct timeval timeout = {
+		.tv_sec = 1,
+	};
+
+	zassert_ok(coap_service_start(&service_indexed));
+	zassert_ok(coap_service_start(&service_exact));
+	zassert_ok(coap_service_start(&service_full));
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)));
+
+	return NULL;
+}
+
+static void coap_resource_index_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)zsock_close(sock);
+	(void)coap_service_stop(&service_indexed);
+	(void)coap_service_stop(&service_exact);
+	(void)coap_service_stop(&service_full);
+}
+
+ZTEST_SUITE(coap_resource_index, NULL, coap_resource_index_setup, NULL, NULL,
+	    coap_resource_index_teardown);
@@ -267,3 +267,92 @@ ZTEST(net_dns_cache_test, test_remove_null_parameters)
 	zassert_equal(-EINVAL, dns_cache_remove(&test_dns_cache, NULL),
 		      "NULL query should return error.");
 }
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "nonexistent.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative entry adding should work.");
+	zassert_equal(-ENOENT, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					      &info_read, 1),
+		      "Negative entry should replace the positive one.");
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					&info_read, 1));
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1),
+		      "Positive entry should replace the negative one.");
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					  TEST_DNS_CACHE_DEFAULT_TTL));
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_prefetch_hot_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+	bool prefetch;
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+
+	for (int i = 0; i < CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS; i++) {
+		zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+						  &info_read, 1, &prefetch));
+		zassert_false(prefetch, "Entry refreshed too early");
+	}
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 10 *
+		       (100 - CONFIG_DNS_RESOLVER_CACHE_PREFETCH_PERCENT / 2)));
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1,
+					  &prefetch));
+	zassert_true(prefetch, "Hot entry close to expiry not refreshed");
+
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1,
+					  &prefetch));
+	zassert_false(prefetch, "Refresh requested twice");
+
+	zassert_ok(dns_cache_remove_family(&test_dns_cache, query, AF_INET));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+}
+
+#define TEST_DNS_CACHE_BIG_SIZE 64
+DNS_CACHE_DEFINE(test_dns_cache_big, TEST_DNS_CACHE_BIG_SIZE);
+
+ZTEST(net_dns_cache_test, test_many_entries)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[32];
+	uint32_t start;
+	uint32_t cycles;
+
+	for (int i = 0; i < TEST_DNS_CACHE_BIG_SIZE; i++) {
+		snprintk(query, sizeof(query), "host%d.example.com", i);
+		zassert_ok(dns_cache_add(&test_dns_cache_big, query, &info_write, 3600));
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < TEST_DNS_CACHE_BIG_SIZE; i++) {
+		snprintk(query, sizeof(query), "host%d.example.com", i);
+		zassert_equal(1, dns_cache_find(&test_dns_cache_big, query, DNS_QUERY_TYPE_A,
+						&info_read, 1),
+			      "Entry %d not found", i);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("%d lookups in %u cycles\n", TEST_DNS_CACHE_BIG_SIZE, cycles);
+
+	/* One more entry evicts a single one */
+	zassert_ok(dns_cache_add(&test_dns_cache_big, "new.example.com", &info_write, 3600));
+	zassert_equal(1, dns_cache_find(&test_dns_cache_big, "new.example.com", DNS_QUERY_TYPE_A,
+					&info_read, 1));
+	zassert_ok(dns_cache_flush(&test_dns_cache_big));
+}
@@ -1286,6 +1286,55 @@ ZTEST(dns_packet, test_dns_invalid_answer)
 	zassert_equal(ret, -EINVAL, "DNS message answer check succeed (%d)", ret);
 }
 
+static uint8_t nxdomain_resp_ipv4[] = {
+	/* DNS msg header (12 bytes), NXDOMAIN, one authority RR */
+	0x12, 0x34, 0x81, 0x83, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x01, 0x00, 0x00,
+
+	/* Query string (foo.example.com) */
+	0x03, 0x66, 0x6f, 0x6f, 0x07, 0x65, 0x78, 0x61,
+	0x6d, 0x70, 0x6c, 0x65, 0x03, 0x63, 0x6f, 0x6d,
+	0x00,
+
+	/* Type and class */
+	0x00, 0x01, 0x00, 0x01,
+
+	/* Authority: example.com SOA, TTL 3600, RDLENGTH 32 */
+	0xc0, 0x10, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00,
+	0x0e, 0x10, 0x00, 0x20,
+
+	/* MNAME ns.example.com, RNAME host.example.com */
+	0x02, 0x6e, 0x73, 0xc0, 0x10, 0x04, 0x68, 0x6f,
+	0x73, 0x74, 0xc0, 0x10,
+
+	/* SERIAL, REFRESH, RETRY, EXPIRE, MINIMUM 300 */
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x04,
+	0x00, 0x00, 0x01, 0x2c,
+};
+
+ZTEST(dns_packet, test_dns_negative_ttl)
+{
+	struct dns_msg_t dns_msg = { 0 };
+	uint32_t ttl = 0;
+	int ret;
+
+	dns_msg.msg = nxdomain_resp_ipv4;
+	dns_msg.msg_size = sizeof(nxdomain_resp_ipv4);
+
+	ret = dns_unpack_response_query(&dns_msg);
+	zassert_equal(ret, 0, "Cannot unpack query (%d)", ret);
+
+	ret = dns_unpack_negative_ttl(&dns_msg, &ttl);
+	zassert_equal(ret, 0, "Cannot get negative TTL (%d)", ret);
+	zassert_equal(ttl, 300, "Invalid negative TTL %u", ttl);
+
+	/* Truncated SOA record */
+	dns_msg.msg_size = sizeof(nxdomain_resp_ipv4) - 3;
+	ret = dns_unpack_negative_ttl(&dns_msg, &ttl);
+	zassert_equal(ret, -EINVAL, "Truncated SOA accepted (%d)", ret);
+}
+
 static uint8_t recursive_query_resp_ipv4[] = {
 	/* DNS msg header (12 bytes) */
 	0x74, 0xe1, 0x81, 0x80, 0x00, 0x01, 0x00, 0x01,
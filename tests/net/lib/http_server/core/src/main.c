@@ -623,6 +623,24 @@ static void expect_http2_settings_frame(size_t *offset, bool ack)
 	}
 }
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+/* Decoder side of the server response header compression context. */
+static struct http_hpack_dynamic_table response_hpack_table;
+static struct http_hpack_dynamic_table response_hpack_table_copy;
+#endif
+
+static int test_hpack_decode(bool update, const uint8_t *buffer, size_t len,
+			     struct http_hpack_header_buf *header_buf)
+{
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	return http_hpack_decode_header_dynamic(update ? &response_hpack_table :
+						&response_hpack_table_copy,
+						buffer, len, header_buf);
+#else
+	return http_hpack_decode_header(buffer, len, header_buf);
+#endif
+}
+
 static void expect_contains_header(const uint8_t *buffer, size_t len,
 				   const struct http_header *header)
 {
@@ -631,12 +649,18 @@ static void expect_contains_header(const uint8_t *buffer, size_t len,
 	struct http_hpack_header_buf header_buf;
 	size_t consumed = 0;
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	/* Headers are looked up without altering the decoder state. */
+	response_hpack_table_copy = response_hpack_table;
+#endif
+
 	while (consumed < len) {
-		ret = http_hpack_decode_header(buffer + consumed, len, &header_buf);
+		ret = test_hpack_decode(false, buffer + consumed, len - consumed, &header_buf);
 		zassert_true(ret >= 0, "Failed to decode header");
 		zassert_true(consumed + ret <= len, "Frame length exceeded");
 
-		if (strncasecmp(header_buf.name, header->name, header_buf.name_len) == 0 &&
+		if (header_buf.name != NULL &&
+		    strncasecmp(header_buf.name, header->name, header_buf.name_len) == 0 &&
 		    strncasecmp(header_buf.value, header->value, header_buf.value_len) == 0) {
 			found = true;
 			break;
@@ -648,6 +672,19 @@ static void expect_contains_header(const uint8_t *buffer, size_t len,
 	zassert_true(found, "Header '%s: %s' not found", header->name, header->value);
 }
 
+static void update_response_hpack_table(const uint8_t *buffer, size_t len)
+{
+	struct http_hpack_header_buf header_buf;
+	size_t consumed = 0;
+	int ret;
+
+	while (consumed < len) {
+		ret = test_hpack_decode(true, buffer + consumed, len - consumed, &header_buf);
+		zassert_true(ret > 0, "Failed to decode header");
+		consumed += ret;
+	}
+}
+
 static void expect_http2_headers_frame(size_t *offset, int stream_id, uint8_t flags,
 				       const struct http_header *headers, size_t headers_count)
 {
@@ -669,6 +706,8 @@ static void expect_http2_headers_frame(size_t *offset, int stream_id, uint8_t fl
 		expect_contains_header(buf, frame.length, &headers[i]);
 	}
 
+	update_response_hpack_table(buf, frame.length);
+
 	test_consume_data(offset, frame.length);
 }
 
@@ -2799,6 +2838,11 @@ static void http_server_tests_before(void *fixture)
 	dynamic_payload_len = 0;
 	dynamic_error = false;
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	http_hpack_dynamic_table_init(&response_hpack_table, HTTP_HPACK_DEFAULT_TABLE_SIZE,
+				      false);
+#endif
+
 	ret = http_server_start();
 	if (ret < 0) {
 		printk("Failed to start the server\n");
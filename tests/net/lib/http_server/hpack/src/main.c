@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdio.h>
+
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/ztest.h>
@@ -494,4 +496,374 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+ZTEST(http2_hpack, test_http2_hpack_empty_value)
+{
+	struct http_hpack_header_buf hdr = {
+		.name = "x-empty",
+		.name_len = strlen("x-empty"),
+		.value = "",
+		.value_len = 0,
+	};
+	int len;
+	int ret;
+
+	len = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr);
+	zassert_true(len > 0, "Failed to encode header (%d)", len);
+
+	ret = http_hpack_decode_header(test_buf, len, &hdr);
+	zassert_equal(ret, len, "Failed to decode header (%d)", ret);
+	zassert_equal(hdr.name_len, strlen("x-empty"), "Wrong name length");
+	zassert_mem_equal(hdr.name, "x-empty", hdr.name_len, "Wrong name");
+	zassert_equal(hdr.value_len, 0, "Wrong value length");
+}
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+static struct http_hpack_dynamic_table test_table;
+
+struct example_header_block {
+	const uint8_t *encoded;
+	size_t encoded_len;
+	const char *const *headers;
+	size_t headers_count;
+	uint32_t table_size;
+};
+
+static void test_hpack_verify_block(const struct example_header_block *block)
+{
+	struct http_hpack_header_buf hdr;
+	size_t offset = 0;
+	size_t count = 0;
+	int ret;
+
+	while (offset < block->encoded_len) {
+		const char *expected;
+
+		ret = http_hpack_decode_header_dynamic(&test_table,
+						       block->encoded + offset,
+						       block->encoded_len - offset,
+						       &hdr);
+		zassert_true(ret > 0, "Failed to decode header (%d)", ret);
+		offset += ret;
+
+		if (hdr.name == NULL) {
+			continue;
+		}
+
+		zassert_true(count < block->headers_count, "Too many headers decoded");
+		expected = block->headers[count++];
+
+		zassert_equal(hdr.name_len + hdr.value_len + 2, strlen(expected),
+			      "Wrong decoded header length");
+		zassert_mem_equal(hdr.name, expected, hdr.name_len,
+				  "Header name wrongly decoded");
+		zassert_mem_equal(hdr.value, expected + hdr.name_len + 2, hdr.value_len,
+				  "Header value wrongly decoded");
+	}
+
+	zassert_equal(count, block->headers_count, "Missing headers");
+	zassert_equal(test_table.size, block->table_size, "Wrong dynamic table size");
+}
+
+/* Request examples without Huffman coding, RFC7541 ch C.3 */
+static const uint8_t test_c3_1[] = {
+	0x82, 0x86, 0x84, 0x41, 0x0f, 0x77, 0x77, 0x77, 0x2e, 0x65, 0x78, 0x61,
+	0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d,
+};
+static const uint8_t test_c3_2[] = {
+	0x82, 0x86, 0x84, 0xbe, 0x58, 0x08, 0x6e, 0x6f, 0x2d, 0x63, 0x61, 0x63,
+	0x68, 0x65,
+};
+static const uint8_t test_c3_3[] = {
+	0x82, 0x87, 0x85, 0xbf, 0x40, 0x0a, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d,
+	0x2d, 0x6b, 0x65, 0x79, 0x0c, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x2d,
+	0x76, 0x61, 0x6c, 0x75, 0x65,
+};
+static const char *const test_c3_1_headers[] = {
+	":method: GET", ":scheme: http", ":path: /", ":authority: www.example.com",
+};
+static const char *const test_c3_2_headers[] = {
+	":method: GET", ":scheme: http", ":path: /", ":authority: www.example.com",
+	"cache-control: no-cache",
+};
+static const char *const test_c3_3_headers[] = {
+	":method: GET", ":scheme: https", ":path: /index.html",
+	":authority: www.example.com", "custom-key: custom-value",
+};
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_decode_requests)
+{
+	const struct example_header_block blocks[] = {
+		{ test_c3_1, sizeof(test_c3_1), test_c3_1_headers,
+		  ARRAY_SIZE(test_c3_1_headers), 57 },
+		{ test_c3_2, sizeof(test_c3_2), test_c3_2_headers,
+		  ARRAY_SIZE(test_c3_2_headers), 110 },
+		{ test_c3_3, sizeof(test_c3_3), test_c3_3_headers,
+		  ARRAY_SIZE(test_c3_3_headers), 164 },
+	};
+
+	http_hpack_dynamic_table_init(&test_table, HTTP_HPACK_DEFAULT_TABLE_SIZE, false);
+
+	ARRAY_FOR_EACH(blocks, i) {
+		test_hpack_verify_block(&blocks[i]);
+	}
+}
+
+/* Response examples with Huffman coding and evictions, RFC7541 ch C.6 */
+static const uint8_t test_c6_1[] = {
+	0x48, 0x82, 0x64, 0x02, 0x58, 0x85, 0xae, 0xc3, 0x77, 0x1a, 0x4b, 0x61,
+	0x96, 0xd0, 0x7a, 0xbe, 0x94, 0x10, 0x54, 0xd4, 0x44, 0xa8, 0x20, 0x05,
+	0x95, 0x04, 0x0b, 0x81, 0x66, 0xe0, 0x82, 0xa6, 0x2d, 0x1b, 0xff, 0x6e,
+	0x91, 0x9d, 0x29, 0xad, 0x17, 0x18, 0x63, 0xc7, 0x8f, 0x0b, 0x97, 0xc8,
+	0xe9, 0xae, 0x82, 0xae, 0x43, 0xd3,
+};
+static const uint8_t test_c6_2[] = {
+	0x48, 0x83, 0x64, 0x0e, 0xff, 0xc1, 0xc0, 0xbf,
+};
+static const uint8_t test_c6_3[] = {
+	0x88, 0xc1, 0x61, 0x96, 0xd0, 0x7a, 0xbe, 0x94, 0x10, 0x54, 0xd4, 0x44,
+	0xa8, 0x20, 0x05, 0x95, 0x04, 0x0b, 0x81, 0x66, 0xe0, 0x84, 0xa6, 0x2d,
+	0x1b, 0xff, 0xc0, 0x5a, 0x83, 0x9b, 0xd9, 0xab, 0x77, 0xad, 0x94, 0xe7,
+	0x82, 0x1d, 0xd7, 0xf2, 0xe6, 0xc7, 0xb3, 0x35, 0xdf, 0xdf, 0xcd, 0x5b,
+	0x39, 0x60, 0xd5, 0xaf, 0x27, 0x08, 0x7f, 0x36, 0x72, 0xc1, 0xab, 0x27,
+	0x0f, 0xb5, 0x29, 0x1f, 0x95, 0x87, 0x31, 0x60, 0x65, 0xc0, 0x03, 0xed,
+	0x4e, 0xe5, 0xb1, 0x06, 0x3d, 0x50, 0x07,
+};
+static const char *const test_c6_1_headers[] = {
+	":status: 302", "cache-control: private",
+	"date: Mon, 21 Oct 2013 20:13:21 GMT", "location: https://www.example.com",
+};
+static const char *const test_c6_2_headers[] = {
+	":status: 307", "cache-control: private",
+	"date: Mon, 21 Oct 2013 20:13:21 GMT", "location: https://www.example.com",
+};
+static const char *const test_c6_3_headers[] = {
+	":status: 200", "cache-control: private",
+	"date: Mon, 21 Oct 2013 20:13:22 GMT", "location: https://www.example.com",
+	"content-encoding: gzip",
+	"set-cookie: foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1",
+};
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_decode_responses)
+{
+	const struct example_header_block blocks[] = {
+		{ test_c6_1, sizeof(test_c6_1), test_c6_1_headers,
+		  ARRAY_SIZE(test_c6_1_headers), 222 },
+		{ test_c6_2, sizeof(test_c6_2), test_c6_2_headers,
+		  ARRAY_SIZE(test_c6_2_headers), 222 },
+		{ test_c6_3, sizeof(test_c6_3), test_c6_3_headers,
+		  ARRAY_SIZE(test_c6_3_headers), 215 },
+	};
+
+	http_hpack_dynamic_table_init(&test_table, 256, false);
+
+	ARRAY_FOR_EACH(blocks, i) {
+		test_hpack_verify_block(&blocks[i]);
+	}
+
+	zassert_equal(test_table.count, 3, "Wrong number of entries");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_size_update)
+{
+	const uint8_t too_large[] = { 0x3f, 0xe1, 0x1f }; /* 4096 */
+	const uint8_t to_zero[] = { 0x20 };
+	struct http_hpack_header_buf hdr;
+	int ret;
+
+	http_hpack_dynamic_table_init(&test_table, 256, false);
+	test_hpack_verify_block(&(struct example_header_block){
+		test_c6_1, sizeof(test_c6_1), test_c6_1_headers,
+		ARRAY_SIZE(test_c6_1_headers), 222 });
+
+	ret = http_hpack_decode_header_dynamic(&test_table, too_large,
+					       sizeof(too_large), &hdr);
+	zassert_equal(ret, -EBADMSG, "Size above the limit should be rejected");
+
+	ret = http_hpack_decode_header_dynamic(&test_table, to_zero,
+					       sizeof(to_zero), &hdr);
+	zassert_equal(ret, sizeof(to_zero), "Failed to decode size update");
+	zassert_is_null(hdr.name, "No header expected");
+	zassert_equal(test_table.count, 0, "Table should be empty");
+	zassert_equal(test_table.size, 0, "Table should be empty");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_evict_referenced_name)
+{
+	/* Literal with incremental indexing, referencing the name of the
+	 * entry which gets evicted by the insertion (RFC7541 ch 4.4).
+	 */
+	uint8_t first[34] = { 0x40, 30 };
+	uint8_t second[12] = { 0x7e, 10 };
+	struct http_hpack_header_buf hdr;
+	int ret;
+
+	memset(&first[2], 'a', 30);
+	first[32] = 1;
+	first[33] = 'v';
+	memset(&second[2], 'b', 10);
+
+	http_hpack_dynamic_table_init(&test_table, 100, false);
+
+	ret = http_hpack_decode_header_dynamic(&test_table, first, sizeof(first), &hdr);
+	zassert_equal(ret, sizeof(first), "Failed to decode header");
+
+	for (int i = 0; i < 10; i++) {
+		ret = http_hpack_decode_header_dynamic(&test_table, second,
+						       sizeof(second), &hdr);
+		zassert_equal(ret, sizeof(second), "Failed to decode header");
+		zassert_equal(test_table.count, 1, "Wrong number of entries");
+		zassert_equal(hdr.name_len, 30, "Wrong header name length");
+		zassert_equal(hdr.name[0], 'a', "Header name wrongly decoded");
+		zassert_equal(hdr.name[29], 'a', "Header name wrongly decoded");
+		zassert_mem_equal(hdr.value, &second[2], 10, "Header value wrongly decoded");
+	}
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_default_size)
+{
+	const uint8_t default_size[] = { 0x3f, 0xe1, 0x1f }; /* 4096 */
+	const uint8_t newest[] = { 0xbe }; /* Indexed, dynamic index 0 */
+	uint8_t literal[2 + 10 + 1 + 10] = { 0x40, 10 };
+	struct http_hpack_header_buf hdr;
+	int ret;
+
+	/* Before SETTINGS ACK, the peer may use the default table size */
+	http_hpack_dynamic_table_init(&test_table, HTTP_HPACK_DEFAULT_TABLE_SIZE, false);
+
+	ret = http_hpack_decode_header_dynamic(&test_table, default_size,
+					       sizeof(default_size), &hdr);
+	zassert_equal(ret, sizeof(default_size), "Default size should be accepted");
+
+	/* Insert more entries than the table can store */
+	literal[12] = 10;
+
+	for (int i = 0; i < HTTP_HPACK_DEFAULT_TABLE_SIZE / 52; i++) {
+		char field[11];
+
+		snprintf(field, sizeof(field), "header-%03d", i);
+		memcpy(&literal[2], field, 10);
+		snprintf(field, sizeof(field), "value-%04d", i);
+		memcpy(&literal[13], field, 10);
+
+		ret = http_hpack_decode_header_dynamic(&test_table, literal,
+						       sizeof(literal), &hdr);
+		zassert_equal(ret, sizeof(literal), "Failed to decode header (%d)", ret);
+		zassert_true(test_table.count <= ARRAY_SIZE(test_table.entries),
+			     "Table overflow");
+	}
+
+	ret = http_hpack_decode_header_dynamic(&test_table, newest, sizeof(newest), &hdr);
+	zassert_equal(ret, sizeof(newest), "Failed to decode header (%d)", ret);
+	zassert_mem_equal(hdr.name, &literal[2], 10, "Header name wrongly decoded");
+	zassert_mem_equal(hdr.value, &literal[13], 10, "Header value wrongly decoded");
+
+	/* The advertised size applies once it is acknowledged */
+	http_hpack_dynamic_table_set_decoder_limit(&test_table,
+						   HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+	zassert_true(test_table.size <= HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE,
+		     "Table not shrunk");
+
+	if (HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE < HTTP_HPACK_DEFAULT_TABLE_SIZE) {
+		ret = http_hpack_decode_header_dynamic(&test_table, default_size,
+						       sizeof(default_size), &hdr);
+		zassert_equal(ret, -EBADMSG, "Size above the limit should be rejected");
+	}
+}
+
+static int test_encode_response(struct http_hpack_dynamic_table *enc,
+				struct http_hpack_dynamic_table *dec,
+				const char *const names[], const char *const values[],
+				size_t count)
+{
+	struct http_hpack_header_buf hdr;
+	size_t len = 0;
+	size_t offset = 0;
+	size_t decoded = 0;
+	int ret;
+
+	for (size_t i = 0; i < count; i++) {
+		hdr.name = names[i];
+		hdr.name_len = strlen(names[i]);
+		hdr.value = values[i];
+		hdr.value_len = strlen(values[i]);
+
+		ret = http_hpack_encode_header_dynamic(enc, test_buf + len,
+						       sizeof(test_buf) - len, &hdr);
+		zassert_true(ret > 0, "Failed to encode header (%d)", ret);
+		len += ret;
+	}
+
+	while (offset < len) {
+		ret = http_hpack_decode_header_dynamic(dec, test_buf + offset,
+						       len - offset, &hdr);
+		zassert_true(ret > 0, "Failed to decode header (%d)", ret);
+		offset += ret;
+
+		if (hdr.name == NULL) {
+			continue;
+		}
+
+		zassert_equal(hdr.name_len, strlen(names[decoded]), "Wrong name length");
+		zassert_mem_equal(hdr.name, names[decoded], hdr.name_len, "Wrong name");
+		zassert_equal(hdr.value_len, strlen(values[decoded]), "Wrong value length");
+		zassert_mem_equal(hdr.value, values[decoded], hdr.value_len, "Wrong value");
+		decoded++;
+	}
+
+	zassert_equal(decoded, count, "Missing headers");
+	zassert_equal(enc->size, dec->size, "Encoder and decoder tables differ");
+	zassert_equal(enc->count, dec->count, "Encoder and decoder tables differ");
+
+	return len;
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_encode)
+{
+	static struct http_hpack_dynamic_table decoder;
+	static const char *const names[] = {
+		":status", "content-type", "content-encoding", "set-cookie",
+	};
+	static const char *const values[] = {
+		"200", "text/html", "gzip", "id=1",
+	};
+	struct http_hpack_header_buf cookie = {
+		.name = names[3],
+		.name_len = strlen(names[3]),
+		.value = values[3],
+		.value_len = strlen(values[3]),
+	};
+	uint8_t cookie_buf[32];
+	int cookie_len;
+	int first, len;
+
+	cookie_len = http_hpack_encode_header(cookie_buf, sizeof(cookie_buf), &cookie);
+	zassert_true(cookie_len > 0, "Failed to encode header");
+
+	http_hpack_dynamic_table_init(&test_table, HTTP_HPACK_DEFAULT_TABLE_SIZE, true);
+	http_hpack_dynamic_table_init(&decoder, HTTP_HPACK_DEFAULT_TABLE_SIZE, false);
+
+	first = test_encode_response(&test_table, &decoder, names, values,
+				     ARRAY_SIZE(names));
+
+	/* All but the never indexed set-cookie are single byte now. */
+	len = test_encode_response(&test_table, &decoder, names, values,
+				   ARRAY_SIZE(names));
+	zassert_true(len < first, "Repeated response not compressed");
+	zassert_equal(len, 3 + cookie_len, "Unexpected repeated response length %d", len);
+
+	/* Table flushed and shrunk by the peer, tables must stay in sync. */
+	http_hpack_dynamic_table_flush(&test_table);
+	(void)test_encode_response(&test_table, &decoder, names, values,
+				   ARRAY_SIZE(names));
+
+	http_hpack_dynamic_table_set_limit(&test_table, 64);
+	http_hpack_dynamic_table_set_limit(&test_table, HTTP_HPACK_DEFAULT_TABLE_SIZE);
+	(void)test_encode_response(&test_table, &decoder, names, values,
+				   ARRAY_SIZE(names));
+	zassert_equal(test_table.max_size,
+		      MIN(HTTP_HPACK_DEFAULT_TABLE_SIZE, HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE),
+		      "Wrong table size");
+}
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
@@ -571,6 +571,43 @@ ZTEST(lwm2m_registry, test_next_engine_obj_inst)
 	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 1)));
 }
 
+ZTEST(lwm2m_registry, test_obj_inst_lookup)
+{
+	const uint16_t ids[] = {3, 100, 17, 65000};
+	struct lwm2m_engine_obj_inst *oi;
+	double value;
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		zassert_equal(lwm2m_create_object_inst(&LWM2M_OBJ(3303, ids[i])), 0);
+		zassert_equal(lwm2m_set_f64(&LWM2M_OBJ(3303, ids[i], 5700), ids[i]), 0);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		oi = lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, ids[i]));
+		zassert_not_null(oi);
+		zassert_equal(oi->obj_inst_id, ids[i]);
+		zassert_equal(oi->obj->obj_id, 3303);
+		zassert_equal(lwm2m_get_f64(&LWM2M_OBJ(3303, ids[i], 5700), &value), 0);
+		zassert_equal(value, ids[i]);
+	}
+
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 4)));
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3304, 3)));
+
+	zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, 100)), 0);
+	zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 100)));
+	zassert_equal(lwm2m_get_f64(&LWM2M_OBJ(3303, 100, 5700), &value), -ENOENT);
+	zassert_not_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, 17)));
+	zassert_equal(next_engine_obj_inst(3303, 3)->obj_inst_id, 17);
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		if (ids[i] != 100) {
+			zassert_equal(lwm2m_delete_object_inst(&LWM2M_OBJ(3303, ids[i])), 0);
+		}
+		zassert_is_null(lwm2m_engine_get_obj_inst(&LWM2M_OBJ(3303, ids[i])));
+	}
+}
+
 ZTEST(lwm2m_registry, test_null_strings)
 {
 	int ret;
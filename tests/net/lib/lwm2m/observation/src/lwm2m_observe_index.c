@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "lwm2m_engine.h"
+#include "lwm2m_message_handling.h"
+#include "lwm2m_observation.h"
+#include "lwm2m_util.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/ztest.h>
+
+#define DEVICE_OBJ_ID 3
+#define UNUSED_OBJ_ID 5
+
+static struct lwm2m_ctx ctx;
+static struct lwm2m_message msg;
+
+/* Object instance ID that shares the observed path index bucket with 3/0 */
+static uint16_t colliding_inst_id;
+
+static int observe(const struct lwm2m_obj_path *path, uint8_t token, int observe)
+{
+	memset(&msg, 0, sizeof(msg));
+	msg.ctx = &ctx;
+	msg.path = *path;
+	msg.token = &token;
+	msg.tkl = sizeof(token);
+	msg.out.out_cpkt = &msg.cpkt;
+
+	zassert_ok(coap_packet_init(&msg.cpkt, msg.msg_data, sizeof(msg.msg_data),
+				    COAP_VERSION_1, COAP_TYPE_ACK, 0, NULL,
+				    COAP_RESPONSE_CODE_CONTENT, 0));
+
+	return lwm2m_engine_observation_handler(&msg, observe, LWM2M_FORMAT_PLAIN_TEXT, false);
+}
+
+static void assert_observed(const struct lwm2m_obj_path *path, bool observed)
+{
+	zassert_equal(lwm2m_path_is_observed(path), observed, "%u/%u/%u/%u(%u)", path->obj_id,
+		      path->obj_inst_id, path->res_id, path->res_inst_id, path->level);
+	zassert_equal(lwm2m_notify_observer_path(path), observed ? 1 : 0, "%u/%u/%u/%u(%u)",
+		      path->obj_id, path->obj_inst_id, path->res_id, path->res_inst_id,
+		      path->level);
+}
+
+ZTEST(lwm2m_observe_index, test_observed_path)
+{
+	zassert_ok(observe(&LWM2M_OBJ(DEVICE_OBJ_ID, 0), 1, 0));
+
+	/* The observed path, its parent and its children */
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0), true);
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID), true);
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0, 0), true);
+	zassert_true(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0, 0, 0)));
+
+	/* Unrelated paths, including one from the same index bucket */
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id), false);
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id, 0), false);
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id + 1), false);
+	assert_observed(&LWM2M_OBJ(UNUSED_OBJ_ID), false);
+	assert_observed(&LWM2M_OBJ(UNUSED_OBJ_ID, 0, 0), false);
+
+	zassert_ok(observe(&LWM2M_OBJ(DEVICE_OBJ_ID, 0), 1, 1));
+
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0), false);
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID), false);
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0, 0), false);
+}
+
+ZTEST(lwm2m_observe_index, test_observed_object)
+{
+	zassert_ok(observe(&LWM2M_OBJ(DEVICE_OBJ_ID), 1, 0));
+
+	/* Observations on object level match every instance */
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID), true);
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0), true);
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0, 0), true);
+	zassert_true(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id + 1)));
+	assert_observed(&LWM2M_OBJ(UNUSED_OBJ_ID, 0), false);
+
+	zassert_ok(observe(&LWM2M_OBJ(DEVICE_OBJ_ID), 1, 1));
+
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID), false);
+	assert_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0), false);
+	zassert_false(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id + 1)));
+}
+
+ZTEST(lwm2m_observe_index, test_cancel_shared_bucket)
+{
+	zassert_ok(observe(&LWM2M_OBJ(DEVICE_OBJ_ID, 0), 1, 0));
+	zassert_ok(observe(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id), 2, 0));
+
+	zassert_true(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0)));
+	zassert_true(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id)));
+
+	/* Cancelling one observation keeps the other one in the shared bucket */
+	zassert_ok(observe(&LWM2M_OBJ(DEVICE_OBJ_ID, 0), 1, 1));
+
+	zassert_false(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0)));
+	zassert_false(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, 0, 0)));
+	zassert_true(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id)));
+	zassert_true(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id, 0)));
+
+	zassert_ok(observe(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id), 2, 1));
+
+	zassert_false(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID, colliding_inst_id)));
+	zassert_false(lwm2m_path_is_observed(&LWM2M_OBJ(DEVICE_OBJ_ID)));
+}
+
+static void *lwm2m_observe_index_setup(void)
+{
+	uint32_t bucket = lwm2m_obj_inst_hash(DEVICE_OBJ_ID, 0) %
+			  CONFIG_LWM2M_ENGINE_OBSERVER_INDEX_SIZE;
+
+	for (colliding_inst_id = 1; colliding_inst_id < UINT16_MAX - 1; colliding_inst_id++) {
+		if (lwm2m_obj_inst_hash(DEVICE_OBJ_ID, colliding_inst_id) %
+		    CONFIG_LWM2M_ENGINE_OBSERVER_INDEX_SIZE == bucket) {
+			break;
+		}
+	}
+
+	zassert_not_equal(colliding_inst_id, UINT16_MAX - 1, "No colliding instance found");
+
+	return NULL;
+}
+
+static void lwm2m_observe_index_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.sock_fd = -1;
+	lwm2m_engine_context_init(&ctx);
+	zassert_ok(lwm2m_socket_add(&ctx));
+}
+
+static void lwm2m_observe_index_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	lwm2m_socket_del(&ctx);
+}
+
+ZTEST_SUITE(lwm2m_observe_index, NULL, lwm2m_observe_index_setup, lwm2m_observe_index_before,
+	    lwm2m_observe_index_after, NULL);
@@ -26,6 +26,9 @@ static size_t broker_offset;
 static uint8_t broker_topic[32];
 static uint8_t rx_buffer[BUFFER_SIZE];
 static uint8_t tx_buffer[BUFFER_SIZE];
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+static uint8_t inflight_buffer[CONFIG_MQTT_INFLIGHT_WINDOW_SIZE * BUFFER_SIZE];
+#endif
 static struct mqtt_client client_ctx;
 static struct sockaddr broker;
 int s_sock = -1, c_sock = -1;
@@ -40,6 +43,8 @@ static struct mqtt_test_ctx {
 	bool pubcomp_handled;
 	bool suback_handled;
 	bool unsuback_handled;
+	bool session_present;
+	bool dup;
 	uint16_t msg_id;
 	int payload_left;
 	const uint8_t *payload;
@@ -200,7 +205,14 @@ static void broker_validate_packet(uint8_t *buf, size_t length, uint8_t type,
 {
 	switch (type) {
 	case MQTT_PKT_TYPE_CONNECT: {
-		test_send_reply(connect_ack_reply, sizeof(connect_ack_reply));
+		uint8_t reply[sizeof(connect_ack_reply)];
+
+		memcpy(reply, connect_ack_reply, sizeof(reply));
+		if (test_ctx.session_present) {
+			reply[2] = MQTT_CONNACK_FLAG_SESSION_PRESENT;
+		}
+
+		test_send_reply(reply, sizeof(reply));
 		break;
 	}
 	case MQTT_PKT_TYPE_PUBLISH: {
@@ -225,6 +237,9 @@ static void broker_validate_packet(uint8_t *buf, size_t length, uint8_t type,
 			zassert_unreachable("Invalid qos received");
 		}
 
+		zassert_equal(flags & MQTT_HEADER_DUP_MASK,
+			      test_ctx.dup ? MQTT_HEADER_DUP_MASK : 0,
+			      "Invalid DUP flag");
 		zassert_equal(topic_len, strlen(get_mqtt_topic()), "Invalid topic length");
 		zassert_mem_equal(buf + 2, get_mqtt_topic(), topic_len, "Invalid topic");
 		zassert_equal(length - var_len, strlen(test_ctx.payload),
@@ -572,6 +587,11 @@ static void client_init(struct mqtt_client *client)
 	client->rx_buf_size = sizeof(rx_buffer);
 	client->tx_buf = tx_buffer;
 	client->tx_buf_size = sizeof(tx_buffer);
+
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+	client->inflight_buf = inflight_buffer;
+	client->inflight_buf_size = sizeof(inflight_buffer);
+#endif
 }
 
 static void test_connect(void)
@@ -818,6 +838,187 @@ ZTEST(mqtt_client, test_mqtt_pubsub_long)
 	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
 }
 
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW) || defined(CONFIG_MQTT_TX_BATCH)
+static int publish_msg(enum mqtt_qos qos, uint16_t message_id)
+{
+	struct mqtt_publish_param param;
+
+	param.message.topic.qos = qos;
+	param.message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param.message.topic.topic.size =
+			strlen(param.message.topic.topic.utf8);
+	param.message.payload.data = (uint8_t *)test_ctx.payload;
+	param.message.payload.len = strlen(test_ctx.payload);
+	param.message_id = message_id;
+	param.dup_flag = 0U;
+	param.retain_flag = 0U;
+
+	return mqtt_publish(&client_ctx, &param);
+}
+#endif
+
+#if defined(CONFIG_MQTT_TX_BATCH)
+#define BATCH_BURST  4
+#define BATCH_ROUNDS 32
+
+ZTEST(mqtt_client, test_mqtt_publish_batch)
+{
+	struct zsock_pollfd fds[1];
+	int ret;
+
+	test_ctx.payload = payload_short;
+
+	test_connect();
+
+	ret = mqtt_batch_begin(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to start batch (%d)", ret);
+
+	for (int i = 0; i < BATCH_BURST; i++) {
+		ret = publish_msg(MQTT_QOS_0_AT_MOST_ONCE, 0);
+		zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	}
+
+	fds[0].fd = c_sock;
+	fds[0].events = ZSOCK_POLLIN;
+	ret = zsock_poll(fds, ARRAY_SIZE(fds), TIMEOUT);
+	zassert_equal(ret, 0, "Batched packets should not be sent yet");
+
+	ret = mqtt_batch_end(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to end batch (%d)", ret);
+
+	for (int i = 0; i < BATCH_BURST; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	test_disconnect();
+}
+
+static uint32_t publish_rounds_us(bool batch)
+{
+	uint32_t start = k_cycle_get_32();
+	int ret;
+
+	for (int round = 0; round < BATCH_ROUNDS; round++) {
+		if (batch) {
+			ret = mqtt_batch_begin(&client_ctx);
+			zassert_ok(ret, "MQTT client failed to start batch (%d)", ret);
+		}
+
+		for (int i = 0; i < BATCH_BURST; i++) {
+			ret = publish_msg(MQTT_QOS_0_AT_MOST_ONCE, 0);
+			zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+		}
+
+		if (batch) {
+			ret = mqtt_batch_end(&client_ctx);
+			zassert_ok(ret, "MQTT client failed to end batch (%d)", ret);
+		}
+
+		for (int i = 0; i < BATCH_BURST; i++) {
+			broker_process(MQTT_PKT_TYPE_PUBLISH);
+		}
+	}
+
+	return k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_batch_benchmark)
+{
+	uint32_t single_us, batch_us;
+
+	test_ctx.payload = payload_short;
+
+	test_connect();
+
+	single_us = publish_rounds_us(false);
+	batch_us = publish_rounds_us(true);
+
+	TC_PRINT("%d PUBLISH packets in bursts of %d: %u us unbatched, %u us batched\n",
+		 BATCH_ROUNDS * BATCH_BURST, BATCH_BURST, single_us, batch_us);
+
+	test_disconnect();
+}
+#endif /* CONFIG_MQTT_TX_BATCH */
+
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+ZTEST(mqtt_client, test_mqtt_inflight_window)
+{
+	uint16_t id;
+	int ret;
+
+	test_ctx.payload = payload_short;
+
+	test_connect();
+
+	for (id = 1; id <= CONFIG_MQTT_INFLIGHT_WINDOW_SIZE; id++) {
+		ret = publish_msg(MQTT_QOS_1_AT_LEAST_ONCE, id);
+		zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	}
+
+	zassert_equal(mqtt_inflight_count(&client_ctx),
+		      CONFIG_MQTT_INFLIGHT_WINDOW_SIZE, "Invalid in-flight count");
+
+	ret = publish_msg(MQTT_QOS_1_AT_LEAST_ONCE, id);
+	zassert_equal(ret, -EAGAIN, "Publish should fail with full window (%d)", ret);
+
+	ret = publish_msg(MQTT_QOS_0_AT_MOST_ONCE, 0);
+	zassert_ok(ret, "QoS 0 publish should not be limited (%d)", ret);
+
+	for (id = 1; id <= CONFIG_MQTT_INFLIGHT_WINDOW_SIZE; id++) {
+		test_ctx.msg_id = id;
+		test_ctx.puback_handled = false;
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+		client_wait(false);
+		ret = mqtt_input(&client_ctx);
+		zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+		zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
+	}
+
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	zassert_equal(mqtt_inflight_count(&client_ctx), 0, "Window should be empty");
+
+	test_disconnect();
+}
+
+ZTEST(mqtt_client, test_mqtt_inflight_resend)
+{
+	int ret;
+
+	test_ctx.payload = payload_short;
+	test_ctx.msg_id = 1;
+	client_ctx.clean_session = 0;
+
+	test_connect();
+
+	ret = publish_msg(MQTT_QOS_1_AT_LEAST_ONCE, test_ctx.msg_id);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+
+	/* Connection lost before the broker processed the message. */
+	mqtt_abort(&client_ctx);
+	zsock_close(c_sock);
+	c_sock = -1;
+	broker_offset = 0;
+
+	test_ctx.session_present = true;
+	test_connect();
+	zassert_equal(mqtt_inflight_count(&client_ctx), 1,
+		      "Message should still be in flight");
+
+	test_ctx.dup = true;
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	client_wait(false);
+	ret = mqtt_input(&client_ctx);
+	zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
+	zassert_equal(mqtt_inflight_count(&client_ctx), 0, "Window should be empty");
+
+	test_disconnect();
+}
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
 static void mqtt_tests_before(void *fixture)
 {
 	ARG_UNUSED(fixture);
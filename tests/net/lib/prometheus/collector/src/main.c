@@ -37,12 +37,12 @@ ZTEST(test_collector, test_prometheus_collector_register)
 			  "Counter not found in collector (expected %p, got %p)",
 			  &test_counter_m, counter);
 
-	zassert_equal(test_counter_m.value, 0, "Counter value is not 0");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 0, "Counter value is not 0");
 
 	ret = prometheus_counter_inc(counter);
 	zassert_ok(ret, "Error incrementing counter");
 
-	zassert_equal(counter->value, 1, "Counter value is not 1");
+	zassert_equal(prometheus_counter_get(counter), 1, "Counter value is not 1");
 }
 
 ZTEST_SUITE(test_collector, NULL, NULL, NULL, NULL, NULL);
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <limits.h>
+
 #include <zephyr/ztest.h>
 
 #include <zephyr/net/prometheus/counter.h>
@@ -21,17 +23,17 @@ ZTEST(test_counter, test_prometheus_counter_01_inc)
 {
 	int ret;
 
-	zassert_equal(test_counter_m.value, 0, "Counter value is not 0");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 0, "Counter value is not 0");
 
 	ret = prometheus_counter_inc(&test_counter_m);
 	zassert_ok(ret, "Error incrementing counter");
 
-	zassert_equal(test_counter_m.value, 1, "Counter value is not 1");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 1, "Counter value is not 1");
 
 	ret = prometheus_counter_inc(&test_counter_m);
 	zassert_ok(ret, "Error incrementing counter");
 
-	zassert_equal(test_counter_m.value, 2, "Counter value is not 2");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 2, "Counter value is not 2");
 }
 
 /**
@@ -46,12 +48,12 @@ ZTEST(test_counter, test_prometheus_counter_02_add)
 	ret = prometheus_counter_add(&test_counter_m, 2);
 	zassert_ok(ret, "Error adding counter");
 
-	zassert_equal(test_counter_m.value, 4, "Counter value is not 4");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 4, "Counter value is not 4");
 
 	ret = prometheus_counter_add(&test_counter_m, 0);
 	zassert_ok(ret, "Error adding counter");
 
-	zassert_equal(test_counter_m.value, 4, "Counter value is not 4");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 4, "Counter value is not 4");
 }
 
 /**
@@ -66,12 +68,63 @@ ZTEST(test_counter, test_prometheus_counter_03_set)
 	ret = prometheus_counter_set(&test_counter_m, 20);
 	zassert_ok(ret, "Error setting counter");
 
-	zassert_equal(test_counter_m.value, 20, "Counter value is not 20");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 20, "Counter value is not 20");
 
 	ret = prometheus_counter_set(&test_counter_m, 15);
 	zassert_equal(ret, -EINVAL, "Error setting counter");
 
-	zassert_equal(test_counter_m.value, 20, "Counter value is not 20");
+	zassert_equal(prometheus_counter_get(&test_counter_m), 20, "Counter value is not 20");
+}
+
+#define ADD_THREADS 2
+#define ADD_LOOPS 10000
+
+static K_THREAD_STACK_ARRAY_DEFINE(add_stacks, ADD_THREADS, 1024);
+static struct k_thread add_threads[ADD_THREADS];
+
+static void add_thread(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < ADD_LOOPS; i++) {
+		(void)prometheus_counter_inc(&test_counter_m);
+
+		if ((i % 100) == 0) {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Test concurrent counter updates
+ * @details The test shall increment the counter from several threads while
+ * reading it, and check that no increment is lost.
+ */
+ZTEST(test_counter, test_prometheus_counter_04_concurrent)
+{
+	uint64_t start;
+
+	/* Plain counters are not safe against concurrent updates */
+	Z_TEST_SKIP_IFNDEF(CONFIG_PROMETHEUS_PERCPU_METRICS);
+
+	start = prometheus_counter_get(&test_counter_m);
+
+	for (int i = 0; i < ADD_THREADS; i++) {
+		k_thread_create(&add_threads[i], add_stacks[i],
+				K_THREAD_STACK_SIZEOF(add_stacks[i]), add_thread,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < ADD_THREADS; i++) {
+		zassert_ok(k_thread_join(&add_threads[i], K_FOREVER));
+	}
+
+	zassert_equal(prometheus_counter_get(&test_counter_m),
+		      start + ADD_THREADS * ADD_LOOPS, "Counter increments lost");
+
+	/* Increments above LONG_MAX do not fit in a shard and bypass them */
+	zassert_ok(prometheus_counter_add(&test_counter_m, (uint64_t)LONG_MAX + 1U));
+	zassert_equal(prometheus_counter_get(&test_counter_m),
+		      start + ADD_THREADS * ADD_LOOPS + LONG_MAX + 1U,
+		      "Counter value is wrong");
 }
 
 ZTEST_SUITE(test_counter, NULL, NULL, NULL, NULL, NULL);
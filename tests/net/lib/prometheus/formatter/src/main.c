@@ -45,7 +45,7 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 
 	zassert_equal(counter, &test_counter, "Counter not found in collector");
 
-	zassert_equal(test_counter.value, 0, "Counter value is not 0");
+	zassert_equal(prometheus_counter_get(&test_counter), 0, "Counter value is not 0");
 
 	ret = prometheus_counter_inc(&test_counter);
 	zassert_ok(ret, "Error incrementing counter");
@@ -53,7 +53,7 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 	ret = prometheus_counter_inc(&test_counter2);
 	zassert_ok(ret, "Error incrementing counter 2");
 
-	zassert_equal(counter->value, 1, "Counter value is not 1");
+	zassert_equal(prometheus_counter_get(counter), 1, "Counter value is not 1");
 
 	ret = prometheus_format_exposition(&test_custom_collector, formatted, sizeof(formatted));
 	zassert_ok(ret, "Error formatting exposition data");
@@ -63,4 +63,64 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 		      exposed, formatted);
 }
 
+/**
+ * @brief Test Prometheus streaming formatter
+ * @details The test shall format the exposition data in chunks of various
+ * sizes and compare the concatenated chunks with the output of the buffer
+ * based formatter.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_stream)
+{
+	static char expected[MAX_BUFFER_SIZE];
+	static char streamed[MAX_BUFFER_SIZE];
+	struct prometheus_format_context ctx;
+	size_t total;
+	int ret;
+
+	prometheus_collector_register_metric(&test_custom_collector, &test_counter.base);
+	prometheus_collector_register_metric(&test_custom_collector, &test_counter2.base);
+
+	ret = prometheus_counter_add(&test_counter, 41);
+	zassert_ok(ret, "Error adding counter");
+
+	(void)memset(expected, 0, sizeof(expected));
+
+	ret = prometheus_format_exposition(&test_custom_collector, expected, sizeof(expected));
+	zassert_ok(ret, "Error formatting exposition data");
+
+	for (size_t chunk = 1; chunk <= strlen(expected) + 1; chunk++) {
+		ret = prometheus_format_stream_init(&ctx, &test_custom_collector);
+		zassert_ok(ret, "Error initializing stream");
+
+		total = 0;
+
+		do {
+			zassert_true(total + chunk <= sizeof(streamed), "Stream too long");
+
+			ret = prometheus_format_stream(&ctx, streamed + total, chunk);
+			zassert_true(ret >= 0, "Error streaming exposition data (%d)", ret);
+
+			total += ret;
+		} while (ret == chunk);
+
+		zassert_equal(total, strlen(expected), "Wrong length with %zu byte chunks",
+			      chunk);
+		zassert_mem_equal(streamed, expected, total,
+				  "Streamed data differs with %zu byte chunks", chunk);
+
+		/* The collector is released at the end of the stream */
+		zassert_equal(test_custom_collector.lock.lock_count, 0, "Collector still locked");
+		zassert_equal(prometheus_format_stream(&ctx, streamed, chunk), 0);
+	}
+
+	/* An aborted stream releases the collector as well */
+	ret = prometheus_format_stream_init(&ctx, &test_custom_collector);
+	zassert_ok(ret, "Error initializing stream");
+	ret = prometheus_format_stream(&ctx, streamed, 1);
+	zassert_equal(ret, 1, "Error streaming exposition data (%d)", ret);
+	prometheus_format_stream_abort(&ctx);
+	zassert_equal(prometheus_format_stream(&ctx, streamed, 1), 0);
+	zassert_equal(test_custom_collector.lock.lock_count, 0, "Collector still locked");
+}
+
 ZTEST_SUITE(test_formatter, NULL, NULL, NULL, NULL, NULL);
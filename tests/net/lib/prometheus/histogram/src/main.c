@@ -29,11 +29,15 @@ ZTEST(test_histogram, test_histogram_observe)
 	ret = prometheus_histogram_observe(&test_histogram_m, 1);
 	zassert_ok(ret, "Error observing histogram");
 
+	prometheus_histogram_merge(&test_histogram_m);
+
 	zassert_equal(test_histogram_m.sum, 1.0, "Histogram value is not 1");
 
 	ret = prometheus_histogram_observe(&test_histogram_m, 2);
 	zassert_ok(ret, "Error observing histogram");
 
+	prometheus_histogram_merge(&test_histogram_m);
+
 	zassert_equal(test_histogram_m.sum, 3.0, "Histogram value is not 2");
 }
 
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/zperf.h>
+
+#include "zperf_internal.h"
+#include "zperf_session.h"
+
+#define BUCKETS CONFIG_NET_ZPERF_HISTOGRAM_BUCKETS
+
+static uint32_t hist_bucket(uint32_t us)
+{
+	uint32_t hist[BUCKETS] = { 0 };
+
+	zperf_hist_add(hist, us);
+
+	for (int i = 0; i < BUCKETS; i++) {
+		if (hist[i] != 0U) {
+			zassert_equal(hist[i], 1U);
+			return i;
+		}
+	}
+
+	zassert_unreachable("%u us was not counted", us);
+
+	return 0;
+}
+
+ZTEST(zperf, test_hist_buckets)
+{
+	/* Zero has no power of two, it goes with 1 us */
+	zassert_equal(hist_bucket(0U), 0U);
+	zassert_equal(hist_bucket(1U), 0U);
+
+	for (uint32_t i = 1U; i < BUCKETS; i++) {
+		zassert_equal(hist_bucket(BIT(i) - 1U), i - 1U, "bucket %u", i);
+		zassert_equal(hist_bucket(BIT(i)), i, "bucket %u", i);
+	}
+
+	/* The top bucket has no upper bound */
+	zassert_equal(hist_bucket(BIT(BUCKETS)), BUCKETS - 1U);
+	zassert_equal(hist_bucket(UINT32_MAX), BUCKETS - 1U);
+}
+
+ZTEST(zperf, test_results_add)
+{
+	struct zperf_results sum = { 0 };
+	struct zperf_results a = {
+		.nb_packets_sent = 10,
+		.nb_packets_rcvd = 9,
+		.nb_packets_lost = 1,
+		.nb_packets_outorder = 2,
+		.nb_packets_errors = 3,
+		.total_len = 1000,
+		.time_in_us = 500,
+		.client_time_in_us = 700,
+		.jitter_in_us = 40,
+		.packet_size = 100,
+		.latency_hist = { 1, 2, 3, 4 },
+		.jitter_hist = { 5, 6, 7, 8 },
+	};
+	struct zperf_results b = {
+		.nb_packets_sent = 20,
+		.nb_packets_rcvd = 20,
+		.nb_packets_outorder = 1,
+		.total_len = 2000,
+		.time_in_us = 600,
+		.client_time_in_us = 300,
+		.jitter_in_us = 10,
+		.packet_size = 100,
+		.latency_hist = { 10, 0, 0, 1 },
+		.jitter_hist = { 0, 20, 0, 0 },
+	};
+	static const uint32_t latency[] = { 11, 2, 3, 5 };
+	static const uint32_t jitter[] = { 5, 26, 7, 8 };
+
+	BUILD_ASSERT(BUCKETS == 4, "Expected values assume 4 buckets");
+
+	zperf_results_add(&sum, &a);
+	zperf_results_add(&sum, &b);
+
+	/* Counters add up, times are the ones of the longest stream */
+	zassert_equal(sum.nb_packets_sent, 30U);
+	zassert_equal(sum.nb_packets_rcvd, 29U);
+	zassert_equal(sum.nb_packets_lost, 1U);
+	zassert_equal(sum.nb_packets_outorder, 3U);
+	zassert_equal(sum.nb_packets_errors, 3U);
+	zassert_equal(sum.total_len, 3000U);
+	zassert_equal(sum.time_in_us, 600U);
+	zassert_equal(sum.client_time_in_us, 700U);
+	zassert_equal(sum.jitter_in_us, 40U);
+	zassert_equal(sum.packet_size, 100U);
+	zassert_mem_equal(sum.latency_hist, latency, sizeof(latency));
+	zassert_mem_equal(sum.jitter_hist, jitter, sizeof(jitter));
+}
+
+ZTEST(zperf, test_session_reset)
+{
+	struct session session;
+
+	(void)memset(&session, 0xaa, sizeof(session));
+	session.state = STATE_ONGOING;
+
+	zperf_reset_session_stats(&session);
+
+	zassert_equal(session.counter, 0U);
+	zassert_equal(session.start_time, 0);
+	zassert_equal(session.length, 0U);
+	zassert_equal(session.next_id, 1U);
+	zassert_equal(session.outorder, 0U);
+	zassert_equal(session.error, 0U);
+	zassert_equal(session.jitter, 0);
+	zassert_equal(session.last_transit_time, 0);
+	zassert_equal(session.min_transit_time, 0);
+
+	for (int i = 0; i < BUCKETS; i++) {
+		zassert_equal(session.latency_hist[i], 0U, "latency bucket %d", i);
+		zassert_equal(session.jitter_hist[i], 0U, "jitter bucket %d", i);
+	}
+
+	/* The session itself is left alone */
+	zassert_equal(session.state, STATE_ONGOING);
+}
+
+static const struct zperf_results json_results = {
+	.nb_packets_sent = 100,
+	.nb_packets_rcvd = 98,
+	.nb_packets_lost = 2,
+	.nb_packets_outorder = 1,
+	.total_len = 125000,
+	.time_in_us = 1000000,
+	.client_time_in_us = 1000000,
+	.jitter_in_us = 15,
+	.packet_size = 1250,
+	.latency_hist = { 90, 5, 2, 1 },
+	.jitter_hist = { 80, 10, 5, 3 },
+};
+
+#define JSON_COMMON                                                                                \
+	"{\"type\":\"sum\",\"proto\":\"udp\",\"id\":2,"                                            \
+	"\"time_us\":1000000,\"client_time_us\":1000000,"                                          \
+	"\"packets_sent\":100,\"packets_rcvd\":98,"                                                \
+	"\"packets_lost\":2,\"packets_outorder\":1,"                                               \
+	"\"packets_errors\":0,\"packet_size\":1250,"                                               \
+	"\"bytes\":125000,\"jitter_us\":15,"                                                       \
+	"\"rate_kbps\":1000,\"client_rate_kbps\":1000"
+
+ZTEST(zperf, test_json)
+{
+	static const char expected[] = JSON_COMMON "}";
+	static const char expected_hist[] = JSON_COMMON
+		",\"latency_hist\":[90,5,2,1],\"jitter_hist\":[80,10,5,3]}";
+	char buf[ZPERF_JSON_RESULTS_LEN];
+	int len;
+
+	len = zperf_results_to_json(buf, sizeof(buf), "sum", "udp", 2, &json_results, false);
+	zassert_equal(len, strlen(expected));
+	zassert_str_equal(buf, expected);
+
+	len = zperf_results_to_json(buf, sizeof(buf), "sum", "udp", 2, &json_results, true);
+	zassert_equal(len, strlen(expected_hist));
+	zassert_str_equal(buf, expected_hist);
+}
+
+ZTEST(zperf, test_json_truncated)
+{
+	static const char expected[] = JSON_COMMON "}";
+	char buf[16];
+	int len;
+
+	/* Like snprintf(), report the length that would have been needed */
+	len = zperf_results_to_json(buf, sizeof(buf), "sum", "udp", 2, &json_results, false);
+	zassert_equal(len, strlen(expected));
+	zassert_equal(strlen(buf), sizeof(buf) - 1);
+	zassert_mem_equal(buf, expected, sizeof(buf) - 1);
+}
+
+ZTEST(zperf, test_json_max_len)
+{
+	struct zperf_results results;
+	char buf[ZPERF_JSON_RESULTS_LEN];
+
+	(void)memset(&results, 0xff, sizeof(results));
+	results.is_multicast = true;
+
+	zassert_true(zperf_results_to_json(buf, sizeof(buf), "stream", "tcp", INT32_MIN,
+					   &results, true) < sizeof(buf));
+}
+
+ZTEST_SUITE(zperf, NULL, NULL, NULL, NULL, NULL);
@@ -608,4 +608,107 @@ ZTEST(net_pkt_filter_test_suite, test_npf_vlan_filtering)
 	zassert_true(npf_remove_recv_rule(&vlan_small_ip_pkt), "");
 }
 
+/*
+ * Rules mixing interface and Ethernet type conditions, the verdicts must not
+ * depend on whether the rule list is compiled into lookup tables.
+ */
+
+static NPF_IFACE_MATCH(match_iface_b, &dummy_iface_b);
+static NPF_ETH_TYPE_MATCH(arp_packet, NET_ETH_PTYPE_ARP);
+
+static NPF_RULE(drop_arp_iface_a, NET_DROP, match_iface_a, arp_packet);
+static NPF_RULE(accept_arp_iface_a, NET_OK, arp_packet, match_iface_a);
+static NPF_RULE(accept_iface_b, NET_OK, match_iface_b);
+
+static void check_verdict(int type, int size, struct net_if *iface, bool ok)
+{
+	struct net_pkt *pkt = build_test_pkt(type, size, iface);
+
+	zassert_equal(net_pkt_filter_recv_ok(pkt), ok,
+		      "type 0x%04x size %d iface %p", type, size, iface);
+	net_pkt_unref(pkt);
+}
+
+ZTEST(net_pkt_filter_test_suite, test_npf_mixed_rules)
+{
+	npf_append_recv_rule(&drop_arp_iface_a);
+	npf_append_recv_rule(&small_ip_pkt);
+	npf_append_recv_rule(&accept_iface_b);
+	npf_append_recv_rule(&npf_default_drop);
+
+	check_verdict(NET_ETH_PTYPE_ARP, 100, &dummy_iface_a, false);
+	check_verdict(NET_ETH_PTYPE_ARP, 100, &dummy_iface_b, true);
+	check_verdict(NET_ETH_PTYPE_IP, 100, &dummy_iface_a, true);
+	check_verdict(NET_ETH_PTYPE_IP, 300, &dummy_iface_a, false);
+	check_verdict(NET_ETH_PTYPE_IP, 300, &dummy_iface_b, true);
+	check_verdict(NET_ETH_PTYPE_IP, 100, NULL, true);
+	check_verdict(NET_ETH_PTYPE_ARP, 100, NULL, false);
+
+	/* an earlier rule takes precedence */
+	npf_insert_recv_rule(&accept_arp_iface_a);
+	check_verdict(NET_ETH_PTYPE_ARP, 100, &dummy_iface_a, true);
+
+	zassert_true(npf_remove_recv_rule(&accept_arp_iface_a), "");
+	check_verdict(NET_ETH_PTYPE_ARP, 100, &dummy_iface_a, false);
+
+	zassert_true(npf_remove_recv_rule(&accept_iface_b), "");
+	check_verdict(NET_ETH_PTYPE_ARP, 100, &dummy_iface_b, false);
+	check_verdict(NET_ETH_PTYPE_IP, 100, &dummy_iface_b, true);
+
+	zassert_true(npf_remove_all_recv_rules(), "");
+}
+
+/*
+ * Per packet filter cost against the number of rules. None of the rules
+ * match the packet, so a linear evaluation runs the tests of every rule.
+ */
+
+#define BENCH_RULE_PAIRS 8
+#define BENCH_PKT_COUNT 1000
+
+#define BENCH_RULE_PAIR(n, _)							\
+	static NPF_ETH_TYPE_MATCH(bench_type_##n, 0x9000 + n);			\
+	static NPF_RULE(bench_rule_a_##n, NET_DROP, match_iface_a, bench_type_##n); \
+	static NPF_RULE(bench_rule_b_##n, NET_DROP, match_iface_b, bench_type_##n)
+
+LISTIFY(BENCH_RULE_PAIRS, BENCH_RULE_PAIR, (;));
+
+#define BENCH_RULE_PTR(n, _) &bench_rule_a_##n, &bench_rule_b_##n
+
+static struct npf_rule *bench_rules[] = {
+	LISTIFY(BENCH_RULE_PAIRS, BENCH_RULE_PTR, (,))
+};
+
+ZTEST(net_pkt_filter_test_suite, test_npf_rule_count_cost)
+{
+	struct net_pkt *pkt;
+
+	pkt = build_test_pkt(NET_ETH_PTYPE_IP, 100, &dummy_iface_a);
+
+	for (int i = 0; i <= ARRAY_SIZE(bench_rules); i += 2) {
+		uint32_t start;
+		uint32_t cycles;
+
+		if (i > 0) {
+			zassert_true(npf_remove_recv_rule(&npf_default_ok), "");
+			npf_append_recv_rule(bench_rules[i - 2]);
+			npf_append_recv_rule(bench_rules[i - 1]);
+		}
+
+		npf_append_recv_rule(&npf_default_ok);
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < BENCH_PKT_COUNT; j++) {
+			zassert_true(net_pkt_filter_recv_ok(pkt), "");
+		}
+		cycles = k_cycle_get_32() - start;
+
+		TC_PRINT("%2d rules: %u cycles per packet\n", i + 1,
+			 cycles / BENCH_PKT_COUNT);
+	}
+
+	zassert_true(npf_remove_all_recv_rules(), "");
+	net_pkt_unref(pkt);
+}
+
 ZTEST_SUITE(net_pkt_filter_test_suite, NULL, test_npf_iface, NULL, NULL, NULL);
@@ -289,7 +289,11 @@ ZTEST(net_websocket, test_recv_two_msg)
 	test_recv_2(sizeof(frame1) + FRAME1_HDR_SIZE / 2);
 }
 
-int verify_sent_and_received_msg(struct msghdr *msg, bool split_msg)
+/* Receive the frame that was sent, split_msg simulates a case where the
+ * payload is received in two parts.
+ */
+static void verify_received_msg(uint8_t *header, size_t header_len,
+				uint8_t *data, bool split_msg)
 {
 	static struct websocket_context ctx;
 	uint32_t msg_type = -1;
@@ -303,8 +307,7 @@ int verify_sent_and_received_msg(struct msghdr *msg, bool split_msg)
 	ctx.recv_buf.size = sizeof(temp_recv_buf);
 
 	/* Read first the header */
-	ret = test_recv_buf(msg->msg_iov[0].iov_base,
-			    msg->msg_iov[0].iov_len,
+	ret = test_recv_buf(header, header_len,
 			    &ctx, &msg_type, &remaining,
 			    recv_buf, sizeof(recv_buf));
 	if (remaining > 0) {
@@ -315,10 +318,9 @@ int verify_sent_and_received_msg(struct msghdr *msg, bool split_msg)
 
 	/* Then the first split if it is enabled */
 	if (split_msg) {
-		split_len = msg->msg_iov[1].iov_len / 2;
+		split_len = test_msg_len / 2;
 
-		ret = test_recv_buf(msg->msg_iov[1].iov_base,
-				    split_len,
+		ret = test_recv_buf(data, split_len,
 				    &ctx, &msg_type, &remaining,
 				    recv_buf, sizeof(recv_buf));
 		zassert_true(ret > 0, "Cannot read data (%d)", ret);
@@ -328,9 +330,8 @@ int verify_sent_and_received_msg(struct msghdr *msg, bool split_msg)
 
 	/* Then the data */
 	while (remaining > 0) {
-		ret = test_recv_buf((uint8_t *)msg->msg_iov[1].iov_base +
-								total_read,
-				    msg->msg_iov[1].iov_len - total_read,
+		ret = test_recv_buf(data + total_read,
+				    test_msg_len - total_read,
 				    &ctx, &msg_type, &remaining,
 				    recv_buf, sizeof(recv_buf));
 		zassert_true(ret > 0, "Cannot read data (%d)", ret);
@@ -350,10 +351,84 @@ int verify_sent_and_received_msg(struct msghdr *msg, bool split_msg)
 		      "Msg body not valid, received %d instead of %zd",
 		      total_read, test_msg_len);
 
-	NET_DBG("Received %zd header and %zd body",
-		msg->msg_iov[0].iov_len, total_read);
+	NET_DBG("Received %zd header and %zd body", header_len, total_read);
+}
+
+/* Called by the Websocket library instead of sending the data. A frame may be
+ * sent in several parts, it is verified once all of it has been collected.
+ */
+int verify_sent_and_received_msg(struct msghdr *msg)
+{
+	static uint8_t sent_header[MAX_HEADER_LEN];
+	static uint8_t sent_data[sizeof(lorem_ipsum)];
+	static size_t sent_header_len;
+	static size_t sent_data_len;
+	size_t len = msg->msg_iov[0].iov_len + msg->msg_iov[1].iov_len;
+
+	if (msg->msg_iov[0].iov_len > 0) {
+		zassert_true(msg->msg_iov[0].iov_len <= sizeof(sent_header),
+			     "Invalid header length");
+		memcpy(sent_header, msg->msg_iov[0].iov_base,
+		       msg->msg_iov[0].iov_len);
+		sent_header_len = msg->msg_iov[0].iov_len;
+		sent_data_len = 0;
+	}
+
+	zassert_true(sent_data_len + msg->msg_iov[1].iov_len <= test_msg_len,
+		     "Too much data sent");
+	if (msg->msg_iov[1].iov_len > 0) {
+		memcpy(sent_data + sent_data_len, msg->msg_iov[1].iov_base,
+		       msg->msg_iov[1].iov_len);
+		sent_data_len += msg->msg_iov[1].iov_len;
+	}
+
+	if (sent_data_len == test_msg_len) {
+		/* The unit test does not set mask bit when splitting the
+		 * payload.
+		 */
+		verify_received_msg(sent_header, sent_header_len, sent_data,
+				    !(sent_header[1] & BIT(7)));
+	}
+
+	return len;
+}
+
+/* Byte at a time reference for the payload masking */
+static void mask_bytewise(uint8_t *buf, size_t len, uint32_t mask,
+			  uint64_t offset)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] ^= mask >> (8 * (3 - (offset + i) % 4));
+	}
+}
+
+ZTEST(net_websocket, test_mask_payload)
+{
+	static uint8_t buf[72];
+	static uint8_t expected[72];
+	const uint32_t mask = 0xe17e8eb9;
+
+	for (size_t start = 0; start < 8; start++) {
+		for (size_t len = 0; len <= sizeof(buf) - start; len++) {
+			for (uint64_t offset = 0; offset < 4; offset++) {
+				memcpy(buf, lorem_ipsum, sizeof(buf));
+				memcpy(expected, lorem_ipsum, sizeof(expected));
+
+				websocket_mask_payload(buf + start, len, mask, offset);
+				mask_bytewise(expected + start, len, mask, offset);
+
+				zassert_mem_equal(buf, expected, sizeof(buf),
+						  "Invalid masking (start %zd len %zd "
+						  "offset %d)", start, len, (int)offset);
+			}
+		}
+	}
 
-	return msg->msg_iov[0].iov_len + total_read;
+	/* Masking twice gives back the original data */
+	memcpy(buf, lorem_ipsum, sizeof(buf));
+	websocket_mask_payload(buf + 3, sizeof(buf) - 3, mask, 1);
+	websocket_mask_payload(buf + 3, sizeof(buf) - 3, mask, 1);
+	zassert_mem_equal(buf, lorem_ipsum, sizeof(buf), "Unmasking failed");
 }
 
 ZTEST(net_websocket, test_send_and_recv_lorem_ipsum)
@@ -362,6 +437,7 @@ ZTEST(net_websocket, test_send_and_recv_lorem_ipsum)
 	int fd, ret;
 
 	memset(&ctx, 0, sizeof(ctx));
+	k_mutex_init(&ctx.lock);
 
 	ctx.recv_buf.buf = temp_recv_buf;
 	ctx.recv_buf.size = sizeof(temp_recv_buf);
@@ -32,6 +32,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include "ipv6.h"
 #include "tcp.h"
 #include "tcp_private.h"
+#include "net_private.h"
 #include "net_stats.h"
 
 #include <zephyr/ztest.h>
@@ -117,6 +118,8 @@ static enum test_case_no {
 	TEST_CLIENT_SEQ_VALIDATION = 19,
 	TEST_SERVER_ACK_VALIDATION = 20,
 	TEST_SERVER_FIN_ACK_AFTER_DATA = 21,
+	TEST_SERVER_GSO = 22,
+	TEST_SERVER_GRO = 23,
 } test_case_no;
 
 static enum test_state t_state;
@@ -144,6 +147,8 @@ static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *
 static void handle_client_seq_validation_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_ack_validation_test(struct net_pkt *pkt);
 static void handle_server_fin_ack_after_data_test(sa_family_t af, struct tcphdr *th);
+static void handle_server_gso_test(struct net_pkt *pkt, struct tcphdr *th);
+static void handle_server_gro_test(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -499,6 +504,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_SERVER_FIN_ACK_AFTER_DATA:
 		handle_server_fin_ack_after_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_SERVER_GSO:
+		handle_server_gso_test(pkt, &th);
+		break;
+	case TEST_SERVER_GRO:
+		handle_server_gro_test(pkt, &th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -3207,4 +3218,335 @@ ZTEST(net_tcp, test_server_fin_ack_after_data)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
+#define GSO_SEGS 3
+
+static uint32_t gso_seq_base;
+static uint16_t gso_mss;
+static int gso_seg_count;
+static uint8_t gso_data[128];
+
+/* Each segment must be a complete TCP packet of its own: consecutive
+ * sequence numbers, MSS sized payload, a valid checksum, and PSH only on
+ * the last one.
+ */
+static void handle_server_gso_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 th->th_off * 4U;
+	uint32_t offset = gso_seg_count * gso_mss;
+	bool last = (gso_seg_count == GSO_SEGS - 1);
+	struct net_pkt *reply;
+
+	zassert_true(gso_seg_count < GSO_SEGS, "Unexpected segment");
+	zassert_equal(ntohl(th->th_seq), gso_seq_base + offset,
+		      "Unexpected SEQ in segment %d, got %u, expected %u",
+		      gso_seg_count, ntohl(th->th_seq), gso_seq_base + offset);
+	zassert_equal(net_pkt_get_len(pkt) - hdr_len, gso_mss,
+		      "Unexpected length of segment %d, got %zu, expected %u",
+		      gso_seg_count, net_pkt_get_len(pkt) - hdr_len, gso_mss);
+	zassert_equal(ntohs(NET_IPV6_HDR(pkt)->len), net_pkt_get_len(pkt) - NET_IPV6H_LEN,
+		      "Invalid IPv6 payload length in segment %d", gso_seg_count);
+	test_verify_flags(th, last ? (PSH | ACK) : ACK);
+	zassert_equal(net_calc_chksum_tcp(pkt), 0U,
+		      "Invalid checksum in segment %d", gso_seg_count);
+
+	zassert_true(gso_mss <= sizeof(gso_data), "MSS too large for the test");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_skip(pkt, hdr_len));
+	zassert_ok(net_pkt_read(pkt, gso_data, gso_mss));
+	zassert_mem_equal(gso_data, lorem_ipsum + offset, gso_mss,
+			  "Invalid payload in segment %d", gso_seg_count);
+
+	gso_seg_count++;
+
+	if (last) {
+		ack = gso_seq_base + GSO_SEGS * gso_mss;
+		reply = prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+		zassert_not_null(reply, "Cannot create pkt");
+		zassert_ok(net_recv_data(net_iface, reply), "recv data failed");
+
+		test_sem_give();
+	}
+}
+
+/* Test case scenario IPv6
+ *   send SYN,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   send data worth of GSO_SEGS MSS from the server side,
+ *   expect GSO_SEGS MSS sized segments, only the last one with PSH,
+ *   send ACK,
+ *   send RST.
+ */
+ZTEST(net_tcp, test_server_gso)
+{
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	struct tcp *conn;
+	int len;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GSO);
+
+	k_sem_reset(&test_sem);
+
+	ctx = create_server_socket(0, 0);
+
+	conn = accepted_ctx->tcp;
+	gso_seq_base = ack;
+	gso_mss = conn_mss(conn);
+	gso_seg_count = 0;
+
+	len = GSO_SEGS * gso_mss;
+	zassert_true(len <= sizeof(lorem_ipsum) - 1, "MSS too large for the test");
+
+	test_case_no = TEST_SERVER_GSO;
+
+	/* The data leaves TCP as one packet and is split into segments
+	 * only when handed to the network interface.
+	 */
+	ret = net_context_send(accepted_ctx, lorem_ipsum, len, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, len, "Failed to send data to peer %d", ret);
+
+	/* handle_server_gso_test() will release the semaphore after the last
+	 * segment.
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_equal(gso_seg_count, GSO_SEGS, "Unexpected number of segments %d",
+		      gso_seg_count);
+
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define GRO_SEG_LEN 10
+
+/* Longer than the delayed ACK timeout of the TCP stack */
+#define GRO_WAIT K_MSEC(200)
+
+struct gro_seg {
+	/* Payload starts at idx * GRO_SEG_LEN of the stream */
+	uint8_t idx;
+	uint8_t flags;
+};
+
+static uint32_t gro_seq_base;
+static uint8_t gro_rx_data[128];
+static size_t gro_rx_len;
+static int gro_rx_count;
+static int gro_acks;
+static uint32_t gro_last_ack;
+
+/* The peer only sends data, everything the server sends back is an ACK */
+static void handle_server_gro_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	test_verify_flags(th, ACK);
+	zassert_equal(net_pkt_get_len(pkt), net_pkt_ip_hdr_len(pkt) +
+		      net_pkt_ip_opts_len(pkt) + th->th_off * 4U,
+		      "Unexpected data from server");
+
+	gro_last_ack = ntohl(th->th_ack);
+	gro_acks++;
+}
+
+static void gro_recv_cb(struct net_context *context,
+			struct net_pkt *pkt,
+			union net_ip_header *ip_hdr,
+			union net_proto_header *proto_hdr,
+			int status,
+			void *user_data)
+{
+	size_t len;
+
+	if (status && status != -ECONNRESET) {
+		zassert_true(false, "failed to recv the data");
+	}
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	len = net_pkt_remaining_data(pkt);
+	zassert_true(gro_rx_len + len <= sizeof(gro_rx_data), "Too much data");
+	zassert_ok(net_pkt_read(pkt, &gro_rx_data[gro_rx_len], len));
+
+	gro_rx_len += len;
+	gro_rx_count++;
+
+	net_pkt_unref(pkt);
+}
+
+static struct net_context *gro_connect(void)
+{
+	struct net_context *ctx;
+
+	k_sem_reset(&test_sem);
+
+	ctx = create_server_socket(0, 0);
+
+	accepted_ctx->recv_cb = gro_recv_cb;
+	gro_seq_base = seq;
+	gro_rx_len = 0;
+	gro_rx_count = 0;
+
+	test_case_no = TEST_SERVER_GRO;
+
+	return ctx;
+}
+
+static void gro_send_burst(const struct gro_seg *segs, size_t count)
+{
+	struct net_pkt *pkts[4];
+	int ret = 0;
+
+	zassert_true(count <= ARRAY_SIZE(pkts), "Burst too long");
+
+	for (size_t i = 0; i < count; i++) {
+		seq = gro_seq_base + segs[i].idx * GRO_SEG_LEN;
+		pkts[i] = tester_prepare_tcp_pkt(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+						 segs[i].flags,
+						 lorem_ipsum + segs[i].idx * GRO_SEG_LEN,
+						 (segs[i].flags & FIN) ? 0U : GRO_SEG_LEN);
+		zassert_not_null(pkts[i], "Cannot create pkt");
+	}
+
+	gro_acks = 0;
+
+	/* Queue all the segments before the RX thread gets to run, so that
+	 * they are seen as one burst.
+	 */
+	k_sched_lock();
+
+	for (size_t i = 0; i < count && ret == 0; i++) {
+		ret = net_recv_data(net_iface, pkts[i]);
+	}
+
+	k_sched_unlock();
+
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	k_sleep(GRO_WAIT);
+}
+
+static void gro_close(struct net_context *ctx, uint32_t end)
+{
+	struct net_pkt *rst;
+	int ret;
+
+	seq = gro_seq_base + end;
+
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+/* An in-order burst is delivered to the application at once, a pushed
+ * segment ends the merge.
+ */
+ZTEST(net_tcp, test_server_gro_merge)
+{
+	static const struct gro_seg in_order[] = {
+		{ 0, ACK }, { 1, ACK }, { 2, ACK }, { 3, PSH | ACK },
+	};
+	static const struct gro_seg pushed[] = {
+		{ 4, ACK }, { 5, PSH | ACK }, { 6, ACK }, { 7, PSH | ACK },
+	};
+	struct net_context *ctx;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	ctx = gro_connect();
+
+	gro_send_burst(in_order, ARRAY_SIZE(in_order));
+
+	zassert_equal(gro_rx_count, 1, "Burst not coalesced (%d deliveries)", gro_rx_count);
+	zassert_equal(gro_rx_len, 4 * GRO_SEG_LEN, "Unexpected length %zu", gro_rx_len);
+	zassert_equal(gro_acks, 1, "Unexpected number of ACKs %d", gro_acks);
+	zassert_equal(gro_last_ack, gro_seq_base + 4 * GRO_SEG_LEN,
+		      "Unexpected ACK %u", gro_last_ack);
+
+	gro_send_burst(pushed, ARRAY_SIZE(pushed));
+
+	zassert_equal(gro_rx_count, 3, "PSH did not end the merge (%d deliveries)",
+		      gro_rx_count);
+	zassert_equal(gro_rx_len, 8 * GRO_SEG_LEN, "Unexpected length %zu", gro_rx_len);
+	zassert_equal(gro_acks, 2, "Unexpected number of ACKs %d", gro_acks);
+	zassert_equal(gro_last_ack, gro_seq_base + 8 * GRO_SEG_LEN,
+		      "Unexpected ACK %u", gro_last_ack);
+
+	zassert_mem_equal(gro_rx_data, lorem_ipsum, gro_rx_len, "Data corrupted or reordered");
+
+	gro_close(ctx, 8 * GRO_SEG_LEN);
+}
+
+/* Out of order data and FIN flush the held segment before they are
+ * processed.
+ */
+ZTEST(net_tcp, test_server_gro_flush)
+{
+	static const struct gro_seg out_of_order[] = {
+		{ 0, ACK }, { 2, PSH | ACK },
+	};
+	static const struct gro_seg missing[] = {
+		{ 1, PSH | ACK },
+	};
+	static const struct gro_seg fin[] = {
+		{ 3, ACK }, { 4, ACK }, { 5, FIN | ACK },
+	};
+	struct net_context *ctx;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_GRO);
+
+	/* Out of order data is dropped without the receive queue */
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	ctx = gro_connect();
+
+	gro_send_burst(out_of_order, ARRAY_SIZE(out_of_order));
+
+	zassert_equal(gro_rx_count, 1, "Unexpected number of deliveries %d", gro_rx_count);
+	zassert_equal(gro_rx_len, GRO_SEG_LEN, "Unexpected length %zu", gro_rx_len);
+	zassert_equal(gro_last_ack, gro_seq_base + GRO_SEG_LEN,
+		      "Unexpected ACK %u", gro_last_ack);
+
+	/* The queued out of order data follows the missing segment */
+	gro_send_burst(missing, ARRAY_SIZE(missing));
+
+	zassert_equal(gro_rx_count, 2, "Unexpected number of deliveries %d", gro_rx_count);
+	zassert_equal(gro_rx_len, 3 * GRO_SEG_LEN, "Unexpected length %zu", gro_rx_len);
+	zassert_equal(gro_last_ack, gro_seq_base + 3 * GRO_SEG_LEN,
+		      "Unexpected ACK %u", gro_last_ack);
+
+	gro_send_burst(fin, ARRAY_SIZE(fin));
+
+	zassert_equal(gro_rx_count, 3, "Unexpected number of deliveries %d", gro_rx_count);
+	zassert_equal(gro_rx_len, 5 * GRO_SEG_LEN, "Unexpected length %zu", gro_rx_len);
+	zassert_equal(gro_last_ack, gro_seq_base + 5 * GRO_SEG_LEN + 1,
+		      "FIN not acknowledged, ACK %u", gro_last_ack);
+
+	zassert_mem_equal(gro_rx_data, lorem_ipsum, gro_rx_len, "Data corrupted or reordered");
+
+	gro_close(ctx, 5 * GRO_SEG_LEN + 1);
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
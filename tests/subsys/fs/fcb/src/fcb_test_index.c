@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+#define BENCH_SECTOR_CNT	4
+#define BENCH_ENTRIES		10000
+#define BENCH_ELEM_CNT		(BENCH_ENTRIES / (BENCH_SECTOR_CNT - 1))
+
+static struct fcb_sector_index bench_index[BENCH_SECTOR_CNT];
+static uint16_t bench_index_elems[BENCH_SECTOR_CNT * BENCH_ELEM_CNT];
+
+static int fcb_test_bench_walk_cb(struct fcb_entry_ctx *entry_ctx, void *arg)
+{
+	(*(int *)arg)++;
+	return 0;
+}
+
+static void fcb_test_bench_init_walk(struct fcb *fcb, bool index, int elem_cnt,
+				     struct fcb_entry *last)
+{
+	uint32_t start;
+	uint32_t init_us;
+	uint32_t walk_us;
+	int var_cnt = 0;
+	int rc;
+
+	(void)memset(fcb, 0, sizeof(*fcb));
+	fcb->f_erase_value = fcb_test_erase_value;
+	fcb->f_sector_cnt = BENCH_SECTOR_CNT;
+	fcb->f_sectors = test_fcb_sector;
+	if (index) {
+		fcb->f_index = bench_index;
+		fcb->f_index_elems = bench_index_elems;
+		fcb->f_index_elem_cnt = BENCH_ELEM_CNT;
+	}
+
+	start = k_cycle_get_32();
+	rc = fcb_init(TEST_FCB_FLASH_AREA_ID, fcb);
+	init_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	zassert_true(rc == 0, "fcb_init call failure");
+
+	start = k_cycle_get_32();
+	rc = fcb_walk(fcb, NULL, fcb_test_bench_walk_cb, &var_cnt);
+	walk_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_true(var_cnt == elem_cnt,
+		     "fcb_walk: elements count read different than expected");
+
+	rc = fcb_offset_last_n(fcb, 1, last);
+	zassert_true(rc == 0, "fcb_offset_last_n call failure");
+
+	TC_PRINT("%d entries, %s index: init %u us, walk %u us\n", elem_cnt,
+		 index ? "with" : "without", init_us, walk_us);
+}
+
+ZTEST(fcb_test_with_4sectors_set, test_fcb_index_bench)
+{
+	struct fcb *fcb;
+	struct fcb_entry loc;
+	struct fcb_entry last_flash;
+	struct fcb_entry last_index;
+	uint8_t test_data[4];
+	int elem_cnt;
+	int rc;
+	int i;
+
+	fcb = &test_fcb;
+	fcb->f_scratch_cnt = 0U;
+
+	for (elem_cnt = 0; elem_cnt < BENCH_ENTRIES; elem_cnt++) {
+		rc = fcb_append(fcb, sizeof(test_data), &loc);
+		if (rc == -ENOSPC) {
+			break;
+		}
+		zassert_true(rc == 0, "fcb_append call failure");
+
+		for (i = 0; i < sizeof(test_data); i++) {
+			test_data[i] = fcb_test_append_data(elem_cnt, i);
+		}
+		rc = flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc), test_data,
+				      sizeof(test_data));
+		zassert_true(rc == 0, "flash_area_write call failure");
+
+		rc = fcb_append_finish(fcb, &loc);
+		zassert_true(rc == 0, "fcb_append_finish call failure");
+	}
+
+	fcb_test_bench_init_walk(fcb, false, elem_cnt, &last_flash);
+	fcb_test_bench_init_walk(fcb, true, elem_cnt, &last_index);
+
+	zassert_true(last_flash.fe_sector == last_index.fe_sector &&
+		     last_flash.fe_data_off == last_index.fe_data_off &&
+		     last_flash.fe_data_len == last_index.fe_data_len,
+		     "fcb_offset_last_n: fetched wrong location with index");
+
+	/* Appending keeps the index up to date */
+	rc = fcb_rotate(fcb);
+	zassert_true(rc == 0, "fcb_rotate call failure");
+
+	rc = fcb_append(fcb, sizeof(test_data), &loc);
+	zassert_true(rc == 0, "fcb_append call failure");
+	rc = flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(loc), test_data,
+			      sizeof(test_data));
+	zassert_true(rc == 0, "flash_area_write call failure");
+	rc = fcb_append_finish(fcb, &loc);
+	zassert_true(rc == 0, "fcb_append_finish call failure");
+
+	rc = fcb_offset_last_n(fcb, 1, &last_index);
+	zassert_true(rc == 0, "fcb_offset_last_n call failure");
+	zassert_true(loc.fe_sector == last_index.fe_sector &&
+		     loc.fe_data_off == last_index.fe_data_off,
+		     "fcb_offset_last_n: fetched wrong location after append");
+}
+
+static void fcb_test_index_append(struct fcb *fcb, int elem, struct fcb_entry *loc)
+{
+	uint8_t test_data[4];
+	int rc;
+	int i;
+
+	rc = fcb_append(fcb, sizeof(test_data), loc);
+	zassert_true(rc == 0, "fcb_append call failure");
+
+	for (i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = fcb_test_append_data(elem, i);
+	}
+	rc = flash_area_write(fcb->fap, FCB_ENTRY_FA_DATA_OFF(*loc), test_data,
+			      sizeof(test_data));
+	zassert_true(rc == 0, "flash_area_write call failure");
+
+	rc = fcb_append_finish(fcb, loc);
+	zassert_true(rc == 0, "fcb_append_finish call failure");
+}
+
+ZTEST(fcb_test_with_2sectors_set, test_fcb_index_append_gap)
+{
+	struct fcb_sector_index *index;
+	struct fcb_entry loc;
+	struct fcb_entry last;
+	struct fcb *fcb;
+	int var_cnt = 0;
+	int rc;
+
+	fcb = &test_fcb;
+	index = fcb->f_index;
+
+	fcb_test_index_append(fcb, 0, &loc);
+
+	/* An element the index does not know about leaves a gap in it */
+	fcb->f_index = NULL;
+	fcb_test_index_append(fcb, 1, &loc);
+	fcb->f_index = index;
+
+	fcb_test_index_append(fcb, 2, &loc);
+
+	rc = fcb_walk(fcb, NULL, fcb_test_bench_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_true(var_cnt == 3, "fcb_walk: elements count read different than expected");
+
+	rc = fcb_offset_last_n(fcb, 1, &last);
+	zassert_true(rc == 0, "fcb_offset_last_n call failure");
+	zassert_true(loc.fe_sector == last.fe_sector && loc.fe_data_off == last.fe_data_off,
+		     "fcb_offset_last_n: fetched wrong location after a gap");
+}
@@ -49,6 +49,14 @@ struct flash_sector test_fcb_sector[] = {
 	}
 };
 
+#ifdef CONFIG_FCB_SECTOR_INDEX
+/* Small enough for the tests to also cover elements read from flash */
+#define TEST_FCB_INDEX_ELEM_CNT 64
+
+static struct fcb_sector_index test_fcb_index[ARRAY_SIZE(test_fcb_sector)];
+static uint16_t test_fcb_index_elems[ARRAY_SIZE(test_fcb_sector) * TEST_FCB_INDEX_ELEM_CNT];
+#endif
+
 
 void test_fcb_wipe(void)
 {
@@ -120,6 +128,11 @@ void fcb_tc_pretest(int sectors, struct fcb *_fcb)
 	_fcb->f_erase_value = fcb_test_erase_value;
 	_fcb->f_sector_cnt = sectors;
 	_fcb->f_sectors = test_fcb_sector; /* XXX */
+#ifdef CONFIG_FCB_SECTOR_INDEX
+	_fcb->f_index = test_fcb_index;
+	_fcb->f_index_elems = test_fcb_index_elems;
+	_fcb->f_index_elem_cnt = TEST_FCB_INDEX_ELEM_CNT;
+#endif
 
 	rc = 0;
 	rc = fcb_init(TEST_FCB_FLASH_AREA_ID, _fcb);
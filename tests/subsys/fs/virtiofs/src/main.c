@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include "virtiofs_cache.h"
+
+#define CACHE_SIZE CONFIG_VIRTIOFS_ENTRY_CACHE_SIZE
+
+#define DIR_A 2
+#define DIR_B 3
+
+/* the cache only compares device pointers */
+static const struct device dev;
+
+static struct fuse_entry_out entry(uint64_t nodeid, uint64_t size)
+{
+	struct fuse_entry_out out = {
+		.nodeid = nodeid,
+		.entry_valid = 60,
+		.attr_valid = 60,
+		.attr = {
+			.ino = nodeid,
+			.size = size,
+		},
+	};
+
+	return out;
+}
+
+/* inserts an entry which reference is owned by the cache, returns the evicted node */
+static uint64_t insert(uint64_t parent, const char *name, uint64_t nodeid, uint64_t *nlookup)
+{
+	struct fuse_entry_out out = entry(nodeid, 0);
+	uint64_t evict_nodeid;
+	uint64_t evict_nlookup;
+
+	virtiofs_entry_cache_insert(
+		&dev, parent, name, strlen(name), &out, false, &evict_nodeid, &evict_nlookup
+	);
+
+	if (nlookup != NULL) {
+		*nlookup = evict_nlookup;
+	}
+
+	return evict_nodeid;
+}
+
+/* looks an entry up and returns the reference right away, returns the node or 0 on miss */
+static uint64_t lookup(uint64_t parent, const char *name)
+{
+	struct fuse_entry_out out;
+
+	if (!virtiofs_entry_cache_lookup(&dev, parent, name, strlen(name), false, &out)) {
+		return 0;
+	}
+
+	zassert_true(virtiofs_entry_cache_put(&dev, out.nodeid, 1));
+
+	return out.nodeid;
+}
+
+ZTEST(virtiofs_entry_cache, test_insert)
+{
+	struct fuse_entry_out out = entry(10, 1234);
+	struct fuse_entry_out hit;
+	uint64_t evict_nodeid;
+	uint64_t evict_nlookup;
+
+	virtiofs_entry_cache_insert(
+		&dev, DIR_A, "file", 4, &out, false, &evict_nodeid, &evict_nlookup
+	);
+	zassert_equal(evict_nodeid, 0);
+
+	zassert_true(virtiofs_entry_cache_lookup(&dev, DIR_A, "file", 4, true, &hit));
+	zassert_equal(hit.nodeid, 10);
+	zassert_equal(hit.attr.size, 1234);
+
+	/* the reference lent by the lookup is absorbed, a second one would need FUSE_FORGET */
+	zassert_true(virtiofs_entry_cache_put(&dev, 10, 1));
+	zassert_false(virtiofs_entry_cache_put(&dev, 10, 1));
+
+	/* names are per directory */
+	zassert_equal(lookup(DIR_B, "file"), 0);
+	zassert_equal(lookup(DIR_A, "fil"), 0);
+
+	/* the same node looked up again adds a reference to the existing entry */
+	zassert_equal(insert(DIR_A, "file", 10, NULL), 0);
+	zassert_equal(lookup(DIR_A, "file"), 10);
+}
+
+ZTEST(virtiofs_entry_cache, test_insert_expired)
+{
+	struct fuse_entry_out out = entry(10, 0);
+	uint64_t evict_nodeid;
+	uint64_t evict_nlookup;
+
+	out.entry_valid = 0;
+	virtiofs_entry_cache_insert(
+		&dev, DIR_A, "file", 4, &out, false, &evict_nodeid, &evict_nlookup
+	);
+
+	zassert_equal(lookup(DIR_A, "file"), 0);
+}
+
+ZTEST(virtiofs_entry_cache, test_insert_long_name)
+{
+	char name[CONFIG_VIRTIOFS_ENTRY_CACHE_NAME_LEN + 2];
+	uint64_t nlookup;
+
+	memset(name, 'a', sizeof(name) - 1);
+	name[sizeof(name) - 1] = '\0';
+
+	/* names that don't fit are not cached and have to be forgotten right away */
+	zassert_equal(insert(DIR_A, name, 10, &nlookup), 10);
+	zassert_equal(nlookup, 1);
+	zassert_equal(lookup(DIR_A, name), 0);
+}
+
+ZTEST(virtiofs_entry_cache, test_evict_forget)
+{
+	struct fuse_entry_out held;
+	char name[8];
+	uint64_t nlookup;
+
+	for (int i = 0; i < CACHE_SIZE; i++) {
+		snprintf(name, sizeof(name), "f%d", i);
+		zassert_equal(insert(DIR_A, name, 100 + i, NULL), 0, "entry %d", i);
+	}
+
+	/* f0 is the least recently used one, but it is still used by a caller */
+	zassert_true(virtiofs_entry_cache_lookup(&dev, DIR_A, "f0", 2, false, &held));
+	/* f1 becomes more recently used than f2 */
+	zassert_equal(lookup(DIR_A, "f1"), 101);
+
+	zassert_equal(insert(DIR_A, "new", 200, &nlookup), 102);
+	zassert_equal(nlookup, 1);
+	zassert_equal(lookup(DIR_A, "f2"), 0);
+	zassert_equal(lookup(DIR_A, "new"), 200);
+
+	/* all the references owned by the evicted entry are forgotten at once */
+	zassert_equal(insert(DIR_A, "f3", 103, NULL), 0);
+	zassert_equal(insert(DIR_A, "f3", 103, NULL), 0);
+	zassert_equal(lookup(DIR_A, "f1"), 101);
+	zassert_equal(lookup(DIR_A, "new"), 200);
+	zassert_equal(insert(DIR_A, "other", 300, &nlookup), 103);
+	zassert_equal(nlookup, 3);
+
+	zassert_true(virtiofs_entry_cache_put(&dev, 100, 1));
+	zassert_equal(lookup(DIR_A, "f0"), 100);
+}
+
+ZTEST(virtiofs_entry_cache, test_invalidate_unlink)
+{
+	char name[8];
+	uint64_t nlookup;
+
+	zassert_equal(insert(DIR_A, "file", 10, NULL), 0);
+	zassert_equal(insert(DIR_B, "file", 11, NULL), 0);
+
+	/* unlink of DIR_A/file leaves the file of the same name in DIR_B alone */
+	virtiofs_entry_cache_invalidate(&dev, DIR_A, "file", 4);
+
+	zassert_equal(lookup(DIR_A, "file"), 0);
+	zassert_equal(lookup(DIR_B, "file"), 11);
+
+	/* the unlinked node still holds its reference and is the first one to be forgotten */
+	for (int i = 2; i < CACHE_SIZE; i++) {
+		snprintf(name, sizeof(name), "f%d", i);
+		zassert_equal(insert(DIR_B, name, 100 + i, NULL), 0, "entry %d", i);
+	}
+	zassert_equal(insert(DIR_B, "z", 30, &nlookup), 10);
+	zassert_equal(nlookup, 1);
+}
+
+ZTEST(virtiofs_entry_cache, test_invalidate_rename)
+{
+	zassert_equal(insert(DIR_A, "old", 10, NULL), 0);
+	zassert_equal(insert(DIR_B, "new", 11, NULL), 0);
+
+	/* rename of DIR_A/old over DIR_B/new */
+	virtiofs_entry_cache_invalidate(&dev, DIR_A, "old", 3);
+	virtiofs_entry_cache_invalidate(&dev, DIR_B, "new", 3);
+
+	zassert_equal(lookup(DIR_A, "old"), 0);
+	zassert_equal(lookup(DIR_B, "new"), 0);
+
+	/* the next lookup of the new name caches the renamed node */
+	zassert_equal(insert(DIR_B, "new", 10, NULL), 0);
+	zassert_equal(lookup(DIR_B, "new"), 10);
+}
+
+static void virtiofs_entry_cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	virtiofs_entry_cache_clear(&dev);
+}
+
+ZTEST_SUITE(virtiofs_entry_cache, NULL, NULL, virtiofs_entry_cache_before, NULL, NULL);
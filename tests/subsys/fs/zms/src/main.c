@@ -999,3 +999,205 @@ ZTEST_F(zms, test_zms_id_64bit)
 		zassert_true(len == -ENOENT, "zms_read_hist unexpected failure: %d", len);
 	}
 }
+
+#ifdef CONFIG_ZMS_WRITE_MULTI
+#define TEST_MULTI_ENTRIES 20
+#define TEST_MULTI_ID_BASE 0x100
+
+static void fill_multi_entries(struct zms_write_entry *entries, uint64_t *values,
+			       uint8_t generation)
+{
+	for (int i = 0; i < TEST_MULTI_ENTRIES; i++) {
+		values[i] = ((uint64_t)generation << 32) | i;
+		entries[i].id = TEST_MULTI_ID_BASE + i;
+		entries[i].data = &values[i];
+		entries[i].len = sizeof(values[i]);
+	}
+}
+
+static void check_multi_entries(struct zms_fs *fs, uint8_t generation)
+{
+	ssize_t len;
+	uint64_t value;
+
+	for (int i = 0; i < TEST_MULTI_ENTRIES; i++) {
+		len = zms_read(fs, TEST_MULTI_ID_BASE + i, &value, sizeof(value));
+		zassert_true(len == sizeof(value), "zms_read unexpected failure: %d", len);
+		zassert_equal(value, ((uint64_t)generation << 32) | i,
+			      "unexpected value for entry %d", i);
+	}
+}
+
+ZTEST_F(zms, test_zms_write_multi)
+{
+	int err;
+	ssize_t len;
+	uint8_t buf[64];
+	uint8_t rd_buf[64];
+	uint64_t values[TEST_MULTI_ENTRIES];
+	struct zms_write_entry entries[TEST_MULTI_ENTRIES];
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	err = zms_write_multi(&fixture->fs, entries, 0);
+	zassert_true(err == -EINVAL, "zms_write_multi call with no entry failure: %d", err);
+
+	fill_multi_entries(entries, values, 1);
+	err = zms_write_multi(&fixture->fs, entries, TEST_MULTI_ENTRIES);
+	zassert_true(err == 0, "zms_write_multi call failure: %d", err);
+	check_multi_entries(&fixture->fs, 1);
+
+	/* Mix data stored in and out of the ATEs with a delete */
+	memset(buf, 0xA5, sizeof(buf));
+	entries[0].data = buf;
+	entries[0].len = sizeof(buf);
+	entries[1].data = NULL;
+	entries[1].len = 0;
+	err = zms_write_multi(&fixture->fs, entries, 2);
+	zassert_true(err == 0, "zms_write_multi call failure: %d", err);
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	len = zms_read(&fixture->fs, TEST_MULTI_ID_BASE, rd_buf, sizeof(rd_buf));
+	zassert_true(len == sizeof(rd_buf), "zms_read unexpected failure: %d", len);
+	zassert_mem_equal(buf, rd_buf, sizeof(rd_buf), "RD buff should be equal to the WR buff");
+
+	len = zms_read(&fixture->fs, TEST_MULTI_ID_BASE + 1, rd_buf, sizeof(rd_buf));
+	zassert_true(len == -ENOENT, "zms_read unexpected failure: %d", len);
+}
+
+#ifdef CONFIG_TEST_ZMS_SIMULATOR
+ZTEST_F(zms, test_zms_write_multi_flash_writes)
+{
+	int err;
+	ssize_t len;
+	uint32_t single_writes;
+	uint32_t multi_writes;
+	uint32_t *flash_write_stat;
+	uint64_t values[TEST_MULTI_ENTRIES];
+	struct zms_write_entry entries[TEST_MULTI_ENTRIES];
+
+	stats_walk(fixture->sim_stats, flash_sim_write_calls_find, &flash_write_stat);
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	fill_multi_entries(entries, values, 1);
+	*flash_write_stat = 0;
+	for (int i = 0; i < TEST_MULTI_ENTRIES; i++) {
+		len = zms_write(&fixture->fs, entries[i].id, entries[i].data, entries[i].len);
+		zassert_true(len == entries[i].len, "zms_write failed: %d", len);
+	}
+	single_writes = *flash_write_stat;
+
+	fill_multi_entries(entries, values, 2);
+	*flash_write_stat = 0;
+	err = zms_write_multi(&fixture->fs, entries, TEST_MULTI_ENTRIES);
+	zassert_true(err == 0, "zms_write_multi call failure: %d", err);
+	multi_writes = *flash_write_stat;
+
+	check_multi_entries(&fixture->fs, 2);
+
+	TC_PRINT("%d entries: %u flash writes with zms_write(), %u with zms_write_multi()\n",
+		 TEST_MULTI_ENTRIES, single_writes, multi_writes);
+	zassert_true(multi_writes < single_writes, "zms_write_multi() should need less writes");
+}
+
+ZTEST_F(zms, test_zms_write_multi_corrupted)
+{
+	int err;
+	uint32_t multi_writes;
+	uint32_t *flash_write_stat;
+	uint32_t *flash_max_write_calls;
+	uint64_t values[TEST_MULTI_ENTRIES];
+	struct zms_write_entry entries[TEST_MULTI_ENTRIES];
+
+	stats_walk(fixture->sim_thresholds, flash_sim_max_write_calls_find, &flash_max_write_calls);
+	stats_walk(fixture->sim_stats, flash_sim_write_calls_find, &flash_write_stat);
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	fill_multi_entries(entries, values, 1);
+	*flash_write_stat = 0;
+	err = zms_write_multi(&fixture->fs, entries, TEST_MULTI_ENTRIES);
+	zassert_true(err == 0, "zms_write_multi call failure: %d", err);
+	multi_writes = *flash_write_stat;
+
+	/* Simulate a power down right before the commit ATE of the next transaction,
+	 * all the other ATEs and data of the transaction are written.
+	 */
+	fill_multi_entries(entries, values, 2);
+	*flash_max_write_calls = multi_writes - 1;
+	*flash_write_stat = 0;
+	err = zms_write_multi(&fixture->fs, entries, TEST_MULTI_ENTRIES);
+	zassert_true(err == 0, "zms_write_multi call failure: %d", err);
+
+	/* Make the flash simulator functional again and reinitialize the ZMS. */
+	*flash_max_write_calls = 0;
+	memset(&fixture->fs, 0, sizeof(fixture->fs));
+	(void)setup();
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	/* None of the entries of the uncommitted transaction must be found */
+	check_multi_entries(&fixture->fs, 1);
+
+	/* Ensure that the ZMS is able to store new content. */
+	fill_multi_entries(entries, values, 3);
+	err = zms_write_multi(&fixture->fs, entries, TEST_MULTI_ENTRIES);
+	zassert_true(err == 0, "zms_write_multi call failure: %d", err);
+	check_multi_entries(&fixture->fs, 3);
+}
+
+ZTEST_F(zms, test_zms_write_multi_torn)
+{
+	int err;
+	uint64_t begin_addr;
+	uint64_t ate_addr;
+	uint8_t zeros[sizeof(struct zms_ate)] = {0};
+	uint64_t values[TEST_MULTI_ENTRIES];
+	struct zms_write_entry entries[TEST_MULTI_ENTRIES];
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_FLASH_SIMULATOR_DOUBLE_WRITES);
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	fill_multi_entries(entries, values, 1);
+	err = zms_write_multi(&fixture->fs, entries, TEST_MULTI_ENTRIES);
+	zassert_true(err == 0, "zms_write_multi call failure: %d", err);
+
+	fill_multi_entries(entries, values, 2);
+	begin_addr = fixture->fs.ate_wra;
+	err = zms_write_multi(&fixture->fs, entries, TEST_MULTI_ENTRIES);
+	zassert_true(err == 0, "zms_write_multi call failure: %d", err);
+	check_multi_entries(&fixture->fs, 2);
+
+	/* Corrupt one ATE of the committed transaction, its commit ATE now counts one
+	 * entry more than what is found on flash.
+	 */
+	ate_addr = begin_addr - (TEST_MULTI_ENTRIES / 2) * fixture->fs.ate_size;
+	err = flash_write(fixture->fs.flash_device,
+			  fixture->fs.offset + SECTOR_NUM(ate_addr) * fixture->fs.sector_size +
+				  SECTOR_OFFSET(ate_addr),
+			  zeros, sizeof(zeros));
+	zassert_true(err == 0, "flash_write failed: %d", err);
+
+	memset(&fixture->fs, 0, sizeof(fixture->fs));
+	(void)setup();
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	/* The whole torn transaction must be discarded, not only the corrupted entry */
+	check_multi_entries(&fixture->fs, 1);
+
+	fill_multi_entries(entries, values, 3);
+	err = zms_write_multi(&fixture->fs, entries, TEST_MULTI_ENTRIES);
+	zassert_true(err == 0, "zms_write_multi call failure: %d", err);
+	check_multi_entries(&fixture->fs, 3);
+}
+#endif /* CONFIG_TEST_ZMS_SIMULATOR */
+#endif /* CONFIG_ZMS_WRITE_MULTI */
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/ipc/icmsg_me.h>
+
+#define MSG_LEN      16
+#define MSGS_PER_EPT 50
+#define NUM_SENDERS  2
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static const struct icmsg_config_t icmsg_conf;
+static struct icmsg_me_data_t icmsg_me_data;
+
+static atomic_t in_send;
+static bool overlapped;
+static uint8_t sent[NUM_SENDERS * MSGS_PER_EPT][sizeof(icmsg_me_ept_id_t) + MSG_LEN];
+static size_t sent_count;
+
+int icmsg_open(const struct icmsg_config_t *conf, struct icmsg_data_t *dev_data,
+	       const struct ipc_service_cb *cb, void *ctx)
+{
+	return 0;
+}
+
+/* Fake icmsg instance that does not serialize its senders, like icmsg with
+ * CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC disabled. It gives up the CPU
+ * between the fragments to let another sender in.
+ */
+int icmsg_send_iov(const struct icmsg_config_t *conf, struct icmsg_data_t *dev_data,
+		   const struct pbuf_iovec *iov, size_t iovcnt)
+{
+	uint8_t *msg = sent[sent_count];
+	size_t len = 0;
+
+	if (!atomic_cas(&in_send, 0, 1)) {
+		overlapped = true;
+		return -EIO;
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		zassert_true(len + iov[i].len <= sizeof(sent[0]));
+		memcpy(&msg[len], iov[i].buf, iov[i].len);
+		len += iov[i].len;
+		k_sleep(K_TICKS(1));
+	}
+
+	sent_count++;
+	atomic_set(&in_send, 0);
+
+	return len;
+}
+
+static struct k_thread threads[NUM_SENDERS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_SENDERS, STACK_SIZE);
+
+static void sender(void *p1, void *p2, void *p3)
+{
+	icmsg_me_ept_id_t id = (icmsg_me_ept_id_t)(uintptr_t)p1;
+	uint8_t msg[MSG_LEN];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	memset(msg, id, sizeof(msg));
+
+	for (int i = 0; i < MSGS_PER_EPT; i++) {
+		zassert_equal(icmsg_me_send(&icmsg_conf, &icmsg_me_data, id, msg, sizeof(msg)),
+			      sizeof(msg));
+	}
+}
+
+/**
+ * @brief Test that senders on different endpoints do not interleave their messages
+ */
+ZTEST(icmsg_me, test_concurrent_send)
+{
+	for (int i = 0; i < NUM_SENDERS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, sender,
+				(void *)(uintptr_t)(i + 1), NULL, NULL, K_PRIO_PREEMPT(5), 0,
+				K_NO_WAIT);
+	}
+
+	for (int i = 0; i < NUM_SENDERS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	zassert_false(overlapped, "Endpoints should not send concurrently");
+	zassert_equal(sent_count, NUM_SENDERS * MSGS_PER_EPT);
+
+	for (size_t i = 0; i < sent_count; i++) {
+		icmsg_me_ept_id_t id = sent[i][0];
+
+		zassert_true(id >= 1 && id <= NUM_SENDERS, "Invalid endpoint id %u", id);
+		for (size_t j = sizeof(id); j < sizeof(sent[i]); j++) {
+			zassert_equal(sent[i][j], id, "Message %zu is corrupted", i);
+		}
+	}
+}
+
+static void *icmsg_me_setup(void)
+{
+	zassert_ok(icmsg_me_init(&icmsg_conf, &icmsg_me_data));
+
+	return NULL;
+}
+
+ZTEST_SUITE(icmsg_me, NULL, icmsg_me_setup, NULL, NULL, NULL);
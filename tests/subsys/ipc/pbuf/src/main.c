@@ -106,6 +106,84 @@ ZTEST(test_pbuf, test_rw)
 	zassert_mem_equal(write_buf, read_buf, MPS);
 }
 
+/* Scatter-gather write and in-place read tests. */
+ZTEST(test_pbuf, test_writev_claim)
+{
+	uint8_t read_buf[MEM_AREA_SZ] = {0};
+	uint8_t write_buf[MEM_AREA_SZ];
+	char *claimed;
+	int ret;
+
+	static PBUF_MAYBE_CONST struct pbuf_cfg cfg = PBUF_CFG_INIT(memory_area, MEM_AREA_SZ, 0, 0);
+
+	static struct pbuf pb = {
+		.cfg = &cfg,
+	};
+
+	struct pbuf_iovec iov[] = {
+		{ .buf = write_buf, .len = 1 },
+		{ .buf = NULL, .len = 0 },
+		{ .buf = write_buf + 1, .len = MSGA_SZ - 1 },
+	};
+
+	for (size_t i = 0; i < MEM_AREA_SZ; i++) {
+		write_buf[i] = i+1;
+	}
+
+	zassert_equal(pbuf_tx_init(&pb), 0);
+
+	/* Incorrect fragments. */
+	ret = pbuf_writev(&pb, iov, 0);
+	zassert_equal(ret, -EINVAL);
+	iov[1].len = 1;
+	ret = pbuf_writev(&pb, iov, ARRAY_SIZE(iov));
+	zassert_equal(ret, -EINVAL);
+	iov[1].len = 0;
+
+	/* Nothing to claim. */
+	ret = pbuf_claim(&pb, &claimed);
+	zassert_equal(ret, 0);
+
+	/* Write MSGA_SZ bytes packet from fragments and claim it. */
+	ret = pbuf_writev(&pb, iov, ARRAY_SIZE(iov));
+	zassert_equal(ret, MSGA_SZ);
+	ret = pbuf_claim(&pb, &claimed);
+	zassert_equal(ret, MSGA_SZ);
+	zassert_not_null(claimed);
+	zassert_mem_equal(claimed, write_buf, MSGA_SZ);
+
+	/* Claiming again returns the same packet until it is released. */
+	ret = pbuf_claim(&pb, &claimed);
+	zassert_equal(ret, MSGA_SZ);
+	pbuf_release(&pb, ret);
+	ret = pbuf_claim(&pb, &claimed);
+	zassert_equal(ret, 0);
+
+	/* A wrapped packet must be read instead. */
+	iov[0].len = MSGB_SZ;
+	iov[2].buf = write_buf + MSGB_SZ;
+	iov[2].len = MPS - MSGB_SZ;
+	ret = pbuf_writev(&pb, iov, ARRAY_SIZE(iov));
+	zassert_equal(ret, MPS);
+	ret = pbuf_claim(&pb, &claimed);
+	zassert_equal(ret, MPS);
+	zassert_is_null(claimed);
+	ret = pbuf_read(&pb, read_buf, ret);
+	zassert_equal(ret, MPS);
+	zassert_mem_equal(read_buf, write_buf, MPS);
+
+	/* Both indexes are back in sync after mixing claims and reads. */
+	ret = pbuf_write(&pb, write_buf, MSGB_SZ);
+	zassert_equal(ret, MSGB_SZ);
+	ret = pbuf_claim(&pb, &claimed);
+	zassert_equal(ret, MSGB_SZ);
+	zassert_not_null(claimed);
+	zassert_mem_equal(claimed, write_buf, MSGB_SZ);
+	pbuf_release(&pb, ret);
+	zassert_equal(pb.data.rd_idx, pb.data.wr_idx);
+	zassert_equal(pbuf_read(&pb, NULL, 0), 0);
+}
+
 /* API ret codes tests. */
 ZTEST(test_pbuf, test_retcodes)
 {
@@ -295,4 +295,88 @@ ZTEST(flash_map, test_parameter_overflows)
 	zassert_equal(rc, -EINVAL, "2: Overflow should have been detected");
 }
 
+#if CONFIG_FLASH_MAP_TELEMETRY
+static uint32_t latency_sum(const struct flash_area_op_telemetry *ot)
+{
+	uint32_t sum = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(ot->latency); i++) {
+		sum += ot->latency[i];
+	}
+
+	return sum;
+}
+
+ZTEST(flash_map, test_flash_area_telemetry)
+{
+	const struct flash_area *fa;
+	struct flash_area_telemetry t;
+	uint8_t buf[FLASH_AREA_COPY_SIZE];
+	uint32_t sec_cnt = ARRAY_SIZE(fs_sectors);
+	uint32_t erases = 0;
+	int rc;
+
+	fa = FIXED_PARTITION(SLOT1_PARTITION);
+
+	rc = flash_area_telemetry_reset(fa);
+	zassert_equal(rc, 0, "Unexpected error %d", rc);
+
+	rc = flash_area_sectors(fa, &sec_cnt, fs_sectors);
+	zassert_equal(rc, 0, "Unexpected error %d", rc);
+
+	rc = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_equal(rc, 0, "flash area erase fail");
+	rc = flash_area_erase(fa, 0, fs_sectors[0].fs_size);
+	zassert_equal(rc, 0, "flash area erase fail");
+
+	memset(buf, 0x5a, sizeof(buf));
+	for (int i = 0; i < 3; i++) {
+		rc = flash_area_write(fa, i * sizeof(buf), buf, sizeof(buf));
+		zassert_equal(rc, 0, "flash area write fail");
+	}
+
+	rc = flash_area_read(fa, 0, buf, sizeof(buf));
+	zassert_equal(rc, 0, "flash area read fail");
+
+	rc = flash_area_copy(fa, 0, fa, 3 * sizeof(buf), sizeof(buf), buf, sizeof(buf));
+	zassert_equal(rc, 0, "flash area copy fail");
+
+	rc = flash_area_telemetry_get(fa, &t);
+	zassert_equal(rc, 0, "Unexpected error %d", rc);
+
+	zassert_equal(t.ops[FLASH_AREA_TELEMETRY_ERASE].count, 2);
+	zassert_equal(t.ops[FLASH_AREA_TELEMETRY_ERASE].bytes,
+		      fa->fa_size + fs_sectors[0].fs_size);
+	zassert_equal(t.ops[FLASH_AREA_TELEMETRY_WRITE].count, 3);
+	zassert_equal(t.ops[FLASH_AREA_TELEMETRY_WRITE].bytes, 3 * sizeof(buf));
+	zassert_equal(t.ops[FLASH_AREA_TELEMETRY_READ].count, 1);
+	zassert_equal(t.ops[FLASH_AREA_TELEMETRY_READ].bytes, sizeof(buf));
+	/* A copy is one operation, its read and write halves are not accounted on their own */
+	zassert_equal(t.ops[FLASH_AREA_TELEMETRY_COPY].count, 1);
+	zassert_equal(t.ops[FLASH_AREA_TELEMETRY_COPY].bytes, sizeof(buf));
+
+	for (int op = 0; op < FLASH_AREA_TELEMETRY_OPS; op++) {
+		zassert_equal(t.ops[op].errors, 0);
+		zassert_equal(latency_sum(&t.ops[op]), t.ops[op].count,
+			      "Histogram does not match the operation count");
+	}
+
+	/* Every sector was erased once, the first one twice */
+	zassert_equal(t.sectors_per_counter,
+		      DIV_ROUND_UP(sec_cnt, CONFIG_FLASH_MAP_TELEMETRY_SECTORS));
+	zassert_equal(t.sector_erases[0], t.sectors_per_counter + 1);
+	for (int i = 0; i < CONFIG_FLASH_MAP_TELEMETRY_SECTORS; i++) {
+		erases += t.sector_erases[i];
+	}
+	zassert_equal(erases, sec_cnt + 1);
+
+	rc = flash_area_telemetry_reset(fa);
+	zassert_equal(rc, 0, "Unexpected error %d", rc);
+	rc = flash_area_telemetry_get(fa, &t);
+	zassert_equal(rc, 0, "Unexpected error %d", rc);
+	zassert_equal(t.ops[FLASH_AREA_TELEMETRY_ERASE].count, 0);
+	zassert_equal(t.sector_erases[0], 0);
+}
+#endif
+
 ZTEST_SUITE(flash_map, NULL, NULL, NULL, NULL, NULL);
@@ -638,6 +638,178 @@ ZTEST(lib_stream_flash, test_stream_flash_progress_clear)
 #endif
 }
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+static uint8_t async_buf[BUF_LEN];
+
+static void init_target_async(void)
+{
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_async_enable(&ctx, async_buf);
+	zassert_equal(rc, 0, "expected success");
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_buffered_write)
+{
+	int rc;
+	size_t total = 0;
+
+	init_target_async();
+
+	rc = stream_flash_async_enable(&ctx, async_buf);
+	zassert_equal(rc, -EALREADY, "expected failure as already enabled");
+
+	/* Write chunks that do not match the buffer size, across pages */
+	while (total + 100 <= page_size * 2) {
+		rc = stream_flash_buffered_write(&ctx, write_buf, 100, false);
+		zassert_equal(rc, 0, "expected success");
+		total += 100;
+
+		zassert_equal(stream_flash_bytes_written(&ctx) +
+			      stream_flash_bytes_buffered(&ctx), total,
+			      "expected all bytes to be accounted for");
+	}
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Flush returns once everything has been programmed */
+	zassert_equal(stream_flash_bytes_written(&ctx), total, "expected all bytes written");
+	zassert_equal(stream_flash_bytes_buffered(&ctx), 0, "expected no buffered bytes");
+	VERIFY_WRITTEN(0, total);
+	VERIFY_ERASED(total, page_size * 2 - total);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_callback)
+{
+	int rc;
+
+	init_target_async();
+
+	/* Callback parameters are not verified, as buffers get swapped */
+	cb_ret = -EFAULT;
+
+	/* The first buffer is handed over to the work queue */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Its failure is reported once the second buffer is full */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, -EFAULT, "expected failure from callback");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0, "expected no bytes written");
+	zassert_equal(stream_flash_bytes_buffered(&ctx), BUF_LEN * 2,
+		      "expected bytes to be left in buffers");
+
+	/* Flushing reports the failure too */
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, -EFAULT, "expected failure from callback");
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_progress_resume)
+{
+	int rc;
+	size_t bytes_written_old;
+	size_t bytes_written;
+
+	clear_all_progress();
+	init_target_async();
+
+	/* Only programmed data is saved as progress */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN + 128, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_progress_save(&ctx, progress_key);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN,
+		      "expected only the programmed buffer to be saved");
+
+	bytes_written_old = write_and_save_progress(page_size, progress_key);
+	zassert_equal(bytes_written_old, BUF_LEN + 128 + page_size,
+		      "expected all bytes written after flush");
+
+	init_target_async();
+
+	bytes_written = load_progress(progress_key);
+	zassert_equal(bytes_written, bytes_written_old, "expected bytes_written to be loaded");
+
+	/* Resume writing after the loaded progress */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, 0, "expected success");
+	VERIFY_WRITTEN(bytes_written_old, BUF_LEN);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_erase_page)
+{
+	int rc;
+
+	init_target_async();
+
+	/* The first buffer is being programmed into the first page */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Erasing waits for the buffer, which got the first page erased */
+	rc = stream_flash_erase_page(&ctx, FLASH_BASE);
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN,
+		      "expected the pending buffer to be programmed");
+#if defined(CONFIG_FLASH_HAS_EXPLICIT_ERASE)
+	zassert_equal(rc, -EINVAL, "expected failure as page already erased");
+#else
+	zassert_equal(rc, 0, "expected success");
+#endif
+
+	rc = stream_flash_erase_page(&ctx, FLASH_BASE + page_size);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, page_size, true);
+	zassert_equal(rc, 0, "expected success");
+	VERIFY_WRITTEN(0, BUF_LEN + page_size);
+}
+
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+/* Time a download where each chunk takes as long to receive as it takes to
+ * program BUF_LEN bytes.
+ */
+static uint64_t download_time_us(bool async)
+{
+	int rc;
+	int64_t start;
+
+	if (async) {
+		init_target_async();
+	} else {
+		init_target();
+	}
+
+	start = k_uptime_ticks();
+
+	for (size_t total = 0; total < page_size * 2; total += BUF_LEN) {
+		k_usleep(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+
+		rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+
+	return k_ticks_to_us_near64(k_uptime_ticks() - start);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_throughput)
+{
+	uint64_t sync_us = download_time_us(false);
+	uint64_t async_us = download_time_us(true);
+
+	TC_PRINT("download of %d bytes: %llu us synchronous, %llu us asynchronous\n",
+		 page_size * 2, (unsigned long long)sync_us, (unsigned long long)async_us);
+	zassert_true(async_us <= sync_us, "expected asynchronous writes not to be slower");
+}
+#endif /* CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING */
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 void lib_stream_flash_before(void *data)
 {
 	zassume_true(device_is_ready(fdev), "Device is not ready");
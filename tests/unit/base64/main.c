@@ -28,6 +28,7 @@
 #include <zephyr/ztest.h>
 
 #include "../../../lib/utils/base64.c"
+#include "base64_ref.c"
 
 static const unsigned char base64_test_dec[64] = {
 	0x24, 0x48, 0x6E, 0x56, 0x87, 0x62, 0x5A, 0xBD,
@@ -129,4 +130,89 @@ ZTEST(lib_base64, test_base64_codec)
 	zassert_equal(rc, -ENOMEM, "Error: dst NULL: decode test return value");
 }
 
+static uint32_t fuzz_state = 0x2545F491;
+
+static uint32_t fuzz_rand(void)
+{
+	/* xorshift32 */
+	fuzz_state ^= fuzz_state << 13;
+	fuzz_state ^= fuzz_state >> 17;
+	fuzz_state ^= fuzz_state << 5;
+
+	return fuzz_state;
+}
+
+ZTEST(lib_base64, test_base64_encode_fuzz)
+{
+	uint8_t src[100];
+	uint8_t out[140];
+	uint8_t ref[140];
+	size_t len, ref_len;
+	int rc, ref_rc;
+
+	for (int iter = 0; iter < 2000; iter++) {
+		size_t slen = fuzz_rand() % sizeof(src);
+		size_t dlen = fuzz_rand() % sizeof(out);
+
+		for (size_t i = 0; i < slen; i++) {
+			src[i] = (uint8_t)fuzz_rand();
+		}
+
+		rc = base64_encode(out, dlen, &len, src, slen);
+		ref_rc = ref_base64_encode(ref, dlen, &ref_len, src, slen);
+
+		zassert_equal(rc, ref_rc, "slen %zu dlen %zu", slen, dlen);
+		zassert_equal(len, ref_len, "slen %zu dlen %zu", slen, dlen);
+		if (rc == 0) {
+			zassert_mem_equal(out, ref, len + 1, "slen %zu", slen);
+		}
+	}
+}
+
+ZTEST(lib_base64, test_base64_decode_fuzz)
+{
+	static const char noise[] = "= \r\n=A+/\x80";
+	uint8_t data[64];
+	uint8_t src[128];
+	uint8_t out[100];
+	uint8_t ref[100];
+	size_t len, ref_len, slen;
+	int rc, ref_rc;
+
+	for (int iter = 0; iter < 5000; iter++) {
+		size_t dlen = fuzz_rand() % sizeof(out);
+		size_t n = fuzz_rand() % sizeof(data);
+
+		for (size_t i = 0; i < n; i++) {
+			data[i] = (uint8_t)fuzz_rand();
+		}
+
+		zassert_ok(base64_encode(src, sizeof(src), &slen, data, n));
+
+		/* Damage some of the inputs with padding, whitespace and
+		 * invalid characters.
+		 */
+		for (int k = fuzz_rand() % 4; k > 0 && slen > 0; k--) {
+			size_t pos = fuzz_rand() % slen;
+
+			if (fuzz_rand() & 1) {
+				src[pos] = noise[fuzz_rand() % (sizeof(noise) - 1)];
+			} else {
+				src[pos] = (uint8_t)fuzz_rand();
+			}
+		}
+
+		memset(out, 0xAA, sizeof(out));
+		memset(ref, 0xAA, sizeof(ref));
+		rc = base64_decode(out, dlen, &len, src, slen);
+		ref_rc = ref_base64_decode(ref, dlen, &ref_len, src, slen);
+
+		zassert_equal(rc, ref_rc, "iter %d", iter);
+		if (rc != -EINVAL) {
+			zassert_equal(len, ref_len, "iter %d", iter);
+		}
+		zassert_mem_equal(out, ref, sizeof(out), "iter %d", iter);
+	}
+}
+
 ZTEST_SUITE(lib_base64, NULL, NULL, NULL, NULL, NULL);
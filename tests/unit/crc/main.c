@@ -205,6 +205,60 @@ ZTEST(crc, test_crc16_itu_t)
 
 }
 
+static uint32_t crc32_reflect_bitwise(uint32_t poly, uint32_t crc, const uint8_t *data,
+				      size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+
+		for (int j = 0; j < 8; j++) {
+			crc = (crc >> 1) ^ ((crc & 1U) ? poly : 0U);
+		}
+	}
+
+	return crc;
+}
+
+/* Exercise the table and slicing paths on unaligned buffers of varying length */
+ZTEST(crc, test_crc_long_buffers)
+{
+	static uint8_t buf[300];
+	uint32_t seed = 0x12345678;
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		seed = seed * 1103515245U + 12345U;
+		buf[i] = (uint8_t)(seed >> 16);
+	}
+
+	for (size_t off = 0; off < 8; off++) {
+		for (size_t len = 0; len <= sizeof(buf) - off; len += (len < 40) ? 1 : 37) {
+			const uint8_t *data = &buf[off];
+			uint32_t crc;
+
+			crc = ~crc32_reflect_bitwise(0xEDB88320, 0xFFFFFFFF, data, len);
+			zassert_equal(crc32_ieee(data, len), crc, "off %zu len %zu", off, len);
+
+			crc = ~crc32_reflect_bitwise(0x82F63B78, 0xFFFFFFFF, data, len);
+			zassert_equal(crc32_c(0, data, len, true, true), crc, "off %zu len %zu",
+				      off, len);
+
+			zassert_equal(crc16_ccitt(0xffff, data, len),
+				      crc16_reflect(0x8408, 0xffff, data, len), "off %zu len %zu",
+				      off, len);
+			zassert_equal(crc16_itu_t(0xffff, data, len),
+				      crc16(0x1021, 0xffff, data, len), "off %zu len %zu", off,
+				      len);
+		}
+	}
+
+	/* Chained updates match a single pass */
+	zassert_equal(crc32_ieee_update(crc32_ieee(buf, 13), &buf[13], sizeof(buf) - 13),
+		      crc32_ieee(buf, sizeof(buf)));
+	zassert_equal(crc32_c(crc32_c(0, buf, 13, true, false), &buf[13], sizeof(buf) - 13,
+			      false, true),
+		      crc32_c(0, buf, sizeof(buf), true, true));
+}
+
 ZTEST(crc, test_crc4)
 {
 	uint8_t test1[] = {'A'};
@@ -1057,6 +1057,116 @@ ZTEST(util, test_utf8_count_chars_invalid_utf)
 	zassert_equal(count, expected_result, "Failed to detect invalid UTF");
 }
 
+ZTEST(util, test_utf8_validate)
+{
+	static const struct {
+		const char *str;
+		bool valid;
+	} tests[] = {
+		{ "", true },
+		{ "plain ASCII text, long enough to span words", true },
+		{ "Hello دنیا!🌍 €", true },
+		{ "\xC2\x80\xDF\xBF\xE0\xA0\x80\xEF\xBF\xBF", true },
+		{ "\xF0\x90\x80\x80\xF4\x8F\xBF\xBF", true },
+		{ "\x80", false },                 /* lone continuation byte */
+		{ "\xC0\xAF", false },             /* overlong '/' */
+		{ "\xE0\x80\xAF", false },         /* overlong '/' */
+		{ "\xED\xA0\x80", false },         /* surrogate U+D800 */
+		{ "\xF4\x90\x80\x80", false },     /* above U+10FFFF */
+		{ "\xF5\x80\x80\x80", false },
+		{ "abcdefgh\xE2\x82", false },      /* truncated */
+		{ "abcdefghijklmnop\xFF", false },
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(tests); i++) {
+		zassert_equal(utf8_validate(tests[i].str, strlen(tests[i].str)), tests[i].valid,
+			      "test %zu", i);
+	}
+
+	/* The length is honored, not the NULL terminator */
+	zassert_true(utf8_validate("\xE2\x82\xAC", 3));
+	zassert_false(utf8_validate("\xE2\x82\xAC", 2));
+	zassert_true(utf8_validate("a\0b", 3));
+}
+
+/* Code point by code point reference for utf8_validate() */
+static bool utf8_validate_ref(const uint8_t *s, size_t n)
+{
+	size_t i = 0;
+
+	while (i < n) {
+		uint32_t cp;
+		size_t len;
+
+		if (s[i] < 0x80) {
+			len = 1;
+			cp = s[i];
+		} else if ((s[i] & 0xE0) == 0xC0) {
+			len = 2;
+			cp = s[i] & 0x1F;
+		} else if ((s[i] & 0xF0) == 0xE0) {
+			len = 3;
+			cp = s[i] & 0x0F;
+		} else if ((s[i] & 0xF8) == 0xF0) {
+			len = 4;
+			cp = s[i] & 0x07;
+		} else {
+			return false;
+		}
+
+		if (n - i < len) {
+			return false;
+		}
+
+		for (size_t k = 1; k < len; k++) {
+			if ((s[i + k] & 0xC0) != 0x80) {
+				return false;
+			}
+			cp = (cp << 6) | (s[i + k] & 0x3F);
+		}
+
+		if ((len == 2 && cp < 0x80) || (len == 3 && cp < 0x800) ||
+		    (len == 4 && cp < 0x10000) || cp > 0x10FFFF ||
+		    (cp >= 0xD800 && cp <= 0xDFFF)) {
+			return false;
+		}
+
+		i += len;
+	}
+
+	return true;
+}
+
+ZTEST(util, test_utf8_validate_fuzz)
+{
+	/* Mostly ASCII with some lead and continuation bytes */
+	static const uint8_t bytes[] = {
+		'a', 'b', ' ', '~', 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF,
+		0xC0, 0xC2, 0xDF, 0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF,
+	};
+	uint32_t state = 0x2545F491;
+	uint8_t buf[40];
+
+	for (int iter = 0; iter < 20000; iter++) {
+		size_t n;
+
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		n = state % sizeof(buf);
+
+		for (size_t i = 0; i < n; i++) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			buf[i] = ((state >> 8) & 3) ? 'x' : bytes[state % sizeof(bytes)];
+		}
+
+		zassert_equal(utf8_validate((const char *)buf, n), utf8_validate_ref(buf, n),
+			      "iter %d", iter);
+	}
+}
+
 ZTEST(util, test_util_eq)
 {
 	uint8_t src1[16];